@@ -0,0 +1,261 @@
+#!/usr/bin/env python3
+"""
+Burjuva Betik Assembler
+
+Metin betiği -> firmware bytecode'u (stm32-firmware-beta/src/betik.h).
+Çıktı burjuva_manager.py ile yüklenir (betik:begin/data/end) veya host
+simülatöründe aynen çalıştırılır:
+
+    python3 betik_asm.py ornek.s -o ornek.bin -l
+    stm32-firmware-beta/sim/build/burjuva-sim --betik ornek.bin
+
+Sözdizimi (';' veya '#' yorum, satır başına bir komut):
+
+    .equ BUTON 3            ; sabit
+    bekle:                  ; etiket
+        din 0 BUTON         ; IO16 slot 0 pin 3 -> yığın
+        jnz basildi
+        yield               ; tarama sonu, sonraki taramada devam
+        jmp bekle
+    basildi:
+        push 1
+        dout 0 8            ; IO16 slot 0 pin 8 = 1 (tarama sonunda)
+        push 100
+        wait                ; 100 ms
+        push 0
+        dout 0 8
+        push 5000
+        push 200
+        mgoto 2 0           ; FPGA slot 2 kanal 0 -> 5000, hız 200
+        end
+
+Değişkenler r0-r15 (load r3 / store r3); 'push' değere göre 1, 2 veya
+4 byte'lık biçimi seçer.
+"""
+
+import argparse
+import struct
+import sys
+
+# (kod, işlenenler): işlenen tipleri b = byte, w = u16 adres, i = push
+KOMUTLAR = {
+    'nop':    (0x00, ''),
+    'end':    (0x01, ''),
+    'push':   (None, 'i'),
+    'load':   (0x05, 'r'),
+    'store':  (0x06, 'r'),
+    'dup':    (0x07, ''),
+    'drop':   (0x08, ''),
+    'swap':   (0x09, ''),
+    'add':    (0x10, ''),
+    'sub':    (0x11, ''),
+    'mul':    (0x12, ''),
+    'div':    (0x13, ''),
+    'mod':    (0x14, ''),
+    'and':    (0x15, ''),
+    'or':     (0x16, ''),
+    'xor':    (0x17, ''),
+    'not':    (0x18, ''),
+    'neg':    (0x19, ''),
+    'shl':    (0x1A, ''),
+    'shr':    (0x1B, ''),
+    'eq':     (0x20, ''),
+    'ne':     (0x21, ''),
+    'lt':     (0x22, ''),
+    'le':     (0x23, ''),
+    'gt':     (0x24, ''),
+    'ge':     (0x25, ''),
+    'jmp':    (0x30, 'w'),
+    'jz':     (0x31, 'w'),
+    'jnz':    (0x32, 'w'),
+    'yield':  (0x33, ''),
+    'wait':   (0x34, ''),
+    'time':   (0x35, ''),
+    'din':    (0x40, 'bb'),
+    'dout':   (0x41, 'bb'),
+    'ain':    (0x42, 'bb'),
+    'mrd':    (0x44, 'bbb'),
+    'mwr':    (0x45, 'bbb'),
+    'mpos':   (0x46, 'bb'),
+    'mgoto':  (0x47, 'bb'),
+    'mspeed': (0x48, 'bb'),
+    'mstop':  (0x49, 'bb'),
+    'event':  (0x50, 'b'),
+}
+
+BETIK_BOYUT_MAX = 1024
+
+# Sık kullanılan FPGA register'ları (kanal içi adres, mrd / mwr)
+SABITLER = {
+    'control': 0x00, 'status': 0x01, 'error': 0x02, 'event_flags': 0x03,
+    'speed': 0x0C, 'direction': 0x0D,
+    'fwd': 1, 'rev': 2,
+    'busy': 0x80, 'reached': 0x40, 'homed': 0x20, 'fault': 0x08,
+}
+
+
+def _push_boyu(deger):
+    if -128 <= deger <= 127:
+        return 2
+    if -32768 <= deger <= 32767:
+        return 3
+    return 5
+
+
+def _ayristir(text):
+    """Satırlar -> [(satır no, komut, işlenenler)], .equ sabitleri"""
+    satirlar = []
+    sabitler = dict(SABITLER)
+    for no, satir in enumerate(text.splitlines(), 1):
+        satir = satir.split(';', 1)[0].split('#', 1)[0].strip()
+        while satir:
+            # Aynı satırda etiket ve komut olabilir
+            bas, ayrac, kalan = satir.partition(':')
+            if ayrac and bas.strip().isidentifier() and ' ' not in bas.strip():
+                satirlar.append((no, bas.strip() + ':', []))
+                satir = kalan.strip()
+                continue
+            break
+        if not satir:
+            continue
+        parcalar = satir.replace(',', ' ').split()
+        komut = parcalar[0].lower()
+        if komut == '.equ':
+            if len(parcalar) != 3:
+                raise ValueError(f"satır {no}: .equ AD DEGER")
+            sabitler[parcalar[1]] = _sayi(parcalar[2], sabitler, no)
+            continue
+        satirlar.append((no, komut, parcalar[1:]))
+    return satirlar, sabitler
+
+
+def _sayi(x, sabitler, no):
+    if x in sabitler:
+        return sabitler[x]
+    try:
+        return int(x, 0)
+    except ValueError:
+        raise ValueError(f"satır {no}: sayı veya sabit değil: {x}")
+
+
+def assemble(text):
+    """Betik metni -> bytecode (bytes)"""
+    satirlar, sabitler = _ayristir(text)
+
+    # 1. geçiş: etiket adresleri (push boyu değere göre, etiket push edilemez)
+    etiketler = {}
+    adres = 0
+    for no, komut, islenenler in satirlar:
+        if komut.endswith(':'):
+            ad = komut[:-1]
+            if ad in etiketler:
+                raise ValueError(f"satır {no}: etiket iki kez tanımlı: {ad}")
+            etiketler[ad] = adres
+            continue
+        if komut not in KOMUTLAR:
+            raise ValueError(f"satır {no}: bilinmeyen komut: {komut}")
+        kod, tipler = KOMUTLAR[komut]
+        if len(islenenler) != len(tipler):
+            raise ValueError(f"satır {no}: {komut} {len(tipler)} işlenen alır")
+        if komut == 'push':
+            adres += _push_boyu(_sayi(islenenler[0], sabitler, no))
+        else:
+            adres += 1 + sum({'b': 1, 'r': 1, 'w': 2}[t] for t in tipler)
+
+    # 2. geçiş: kodlama
+    cikti = bytearray()
+    for no, komut, islenenler in satirlar:
+        if komut.endswith(':'):
+            continue
+        kod, tipler = KOMUTLAR[komut]
+        if komut == 'push':
+            deger = _sayi(islenenler[0], sabitler, no)
+            if not -2**31 <= deger < 2**32:
+                raise ValueError(f"satır {no}: 32 bit dışında: {deger}")
+            boy = _push_boyu(deger)
+            if boy == 2:
+                cikti += struct.pack('<Bb', 0x02, deger)
+            elif boy == 3:
+                cikti += struct.pack('<Bh', 0x03, deger)
+            else:
+                cikti += struct.pack('<BI', 0x04, deger & 0xFFFFFFFF)
+            continue
+
+        cikti.append(kod)
+        for tip, x in zip(tipler, islenenler):
+            if tip == 'w':
+                if x not in etiketler:
+                    raise ValueError(f"satır {no}: tanımsız etiket: {x}")
+                cikti += struct.pack('<H', etiketler[x])
+            elif tip == 'r':
+                r = x[1:] if x.lower().startswith('r') and x[1:].isdigit() else x
+                deger = _sayi(r, sabitler, no)
+                if not 0 <= deger <= 15:
+                    raise ValueError(f"satır {no}: değişken r0-r15: {x}")
+                cikti.append(deger)
+            else:
+                deger = _sayi(x, sabitler, no)
+                if not 0 <= deger <= 255:
+                    raise ValueError(f"satır {no}: byte dışında: {x}")
+                cikti.append(deger)
+
+    if not cikti:
+        raise ValueError("boş program")
+    if len(cikti) > BETIK_BOYUT_MAX:
+        raise ValueError(f"program {len(cikti)} byte, en fazla {BETIK_BOYUT_MAX}")
+    return bytes(cikti)
+
+
+def listing(code):
+    """Bytecode -> okunur liste satırları (adres, hex, komut)"""
+    adlar = {kod: ad for ad, (kod, _) in KOMUTLAR.items() if kod is not None}
+    boylar = {0x02: ('<b', 1), 0x03: ('<h', 2), 0x04: ('<i', 4)}
+    satirlar = []
+    a = 0
+    while a < len(code):
+        op = code[a]
+        if op in boylar:
+            fmt, n = boylar[op]
+            metin = f"push {struct.unpack_from(fmt, code, a + 1)[0]}"
+        elif op in adlar:
+            tipler = KOMUTLAR[adlar[op]][1]
+            n = sum({'b': 1, 'r': 1, 'w': 2}[t] for t in tipler)
+            if tipler == 'w':
+                metin = f"{adlar[op]} {struct.unpack_from('<H', code, a + 1)[0]:04X}"
+            elif tipler == 'r':
+                metin = f"{adlar[op]} r{code[a + 1]}"
+            else:
+                metin = ' '.join([adlar[op]] + [str(b) for b in code[a + 1:a + 1 + n]])
+        else:
+            n = 0
+            metin = f"?? {op:02X}"
+        satirlar.append(f"{a:04X}  {code[a:a + 1 + n].hex():<12} {metin}")
+        a += 1 + n
+    return satirlar
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Burjuva betik assembler")
+    parser.add_argument('kaynak', help="betik metni")
+    parser.add_argument('-o', '--output', help="bytecode dosyası (varsayılan: kaynak.bin)")
+    parser.add_argument('-l', '--list', action='store_true', help="listeyi yazdır")
+    args = parser.parse_args()
+
+    try:
+        with open(args.kaynak) as f:
+            code = assemble(f.read())
+    except (OSError, ValueError) as e:
+        print(f"{args.kaynak}: {e}", file=sys.stderr)
+        return 1
+
+    output = args.output or args.kaynak.rsplit('.', 1)[0] + '.bin'
+    with open(output, 'wb') as f:
+        f.write(code)
+    if args.list:
+        print('\n'.join(listing(code)))
+    print(f"{output}: {len(code)} byte")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
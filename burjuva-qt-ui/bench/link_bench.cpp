@@ -0,0 +1,285 @@
+// Round-trip benchmark of the command link: fixed workloads are sent one
+// line at a time (next line after the previous reply) to a real port or
+// to the firmware simulator (stm32-firmware-beta/sim) and reported as
+// latency percentiles, commands per second and bytes on the wire.
+//
+//   toggle          io16 set, pins 0-15 high/low in turn
+//   readall         io16 readall
+//   adc-sweep       aio20 read, ports 0-19 in turn
+//   motor-snapshot  status of motor channels 0-7 in one ';' batch
+//   mixed           io16 set + io16 readall + aio20 read + motor status batch
+//
+// burjuva-link-bench [-p PORT] [-b BAUD] [-n OPS] [--json FILE] [-w LIST]
+// Latency is measured on the caller's thread, from queuing a line to its
+// reply callback. Workloads of a module with slot -1 are skipped.
+
+#include "serialcontroller.h"
+#include "burjuvaclient.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+
+static const int MotorChannels = 8;
+
+struct Workload {
+    QString name;
+    int commandsPerLine;
+    QStringList setup;                      // Sent once, not measured
+    std::function<QString(int i)> line;     // i-th measured line
+};
+
+struct Result {
+    QString name;
+    int operations;
+    int commands;
+    int errors;
+    qint64 elapsedNs;
+    QVector<qint64> latencies;              // Sorted, ns
+    quint64 bytesWritten;
+    quint64 bytesRead;
+};
+
+static QVector<Workload> buildWorkloads(int io16, int aio20, int fpga)
+{
+    QVector<Workload> workloads;
+    
+    auto pinSet = [io16](int i) {
+        return QString("io16:%1:set:%2:%3").arg(io16).arg((i / 2) % 16).arg(i % 2 ? "low" : "high");
+    };
+    auto adcRead = [aio20](int i) {
+        return QString("aio20:%1:read:%2").arg(aio20).arg(i % 20);
+    };
+    auto motorSnapshot = [fpga]() {
+        QStringList commands;
+        for (int ch = 0; ch < MotorChannels; ++ch)
+            commands.append(QString("fpga:%1:motor:%2:status").arg(fpga).arg(ch));
+        return commands.join(QLatin1Char(';'));
+    };
+    
+    QStringList outputs;
+    for (int group = 0; group < 4; ++group)
+        outputs.append(QString("io16:%1:dirgroup:%2:out").arg(io16).arg(group));
+    
+    if (io16 >= 0) {
+        workloads.append({"toggle", 1, outputs, pinSet});
+        workloads.append({"readall", 1, {}, [io16](int) {
+            return QString("io16:%1:readall").arg(io16);
+        }});
+    }
+    if (aio20 >= 0)
+        workloads.append({"adc-sweep", 1, {}, adcRead});
+    if (fpga >= 0) {
+        const QString snapshot = motorSnapshot();
+        workloads.append({"motor-snapshot", MotorChannels, {}, [snapshot](int) { return snapshot; }});
+    }
+    if (io16 >= 0 && aio20 >= 0 && fpga >= 0) {
+        workloads.append({"mixed", 4, outputs, [=](int i) {
+            return QStringList{pinSet(i),
+                               QString("io16:%1:readall").arg(io16),
+                               adcRead(i),
+                               QString("fpga:%1:motor:%2:status").arg(fpga).arg(i % MotorChannels)}
+                .join(QLatin1Char(';'));
+        }});
+    }
+    return workloads;
+}
+
+static Result runWorkload(SerialController &serial, BurjuvaClient &client,
+                          const Workload &workload, int operations, int warmup)
+{
+    Result result{workload.name, 0, 0, 0, 0, {}, 0, 0};
+    result.latencies.reserve(operations);
+    
+    QEventLoop loop;
+    QElapsedTimer timer;
+    quint64 written = 0;
+    quint64 read = 0;
+    int index = -workload.setup.size() - warmup;
+    
+    // Lines go out with priority: the queue would add up to a cycle time
+    std::function<void()> next = [&]() {
+        QString line;
+        if (index < -warmup)
+            line = workload.setup.at(index + warmup + workload.setup.size());
+        else
+            line = workload.line(index + warmup);
+        
+        if (index == 0) {
+            written = serial.bytesWritten();
+            read = serial.bytesRead();
+            timer.start();
+        }
+        
+        const qint64 start = timer.isValid() ? timer.nsecsElapsed() : 0;
+        // A ';' line reports its first failing command
+        client.command(line, [&, start](int status, const QString &) {
+            if (index >= 0) {
+                result.latencies.append(timer.nsecsElapsed() - start);
+                if (status != SerialController::StatusOk)
+                    result.errors++;
+            }
+            
+            if (status == SerialController::StatusNoReply && !serial.isConnected()) {
+                loop.quit();
+                return;
+            }
+            if (++index >= operations) {
+                loop.quit();
+                return;
+            }
+            next();
+        }, true);
+    };
+    
+    next();
+    loop.exec();
+    
+    result.elapsedNs = timer.isValid() ? timer.nsecsElapsed() : 0;
+    result.operations = result.latencies.size();
+    result.commands = result.operations * workload.commandsPerLine;
+    result.bytesWritten = serial.bytesWritten() - written;
+    result.bytesRead = serial.bytesRead() - read;
+    std::sort(result.latencies.begin(), result.latencies.end());
+    return result;
+}
+
+// Nearest-rank percentile of sorted samples, µs
+static double percentileUs(const QVector<qint64> &sorted, double p)
+{
+    if (sorted.isEmpty())
+        return 0.0;
+    int rank = int(std::ceil(p / 100.0 * sorted.size())) - 1;
+    return sorted.at(qBound(0, rank, sorted.size() - 1)) / 1000.0;
+}
+
+static QJsonObject toJson(const Result &r)
+{
+    const double seconds = r.elapsedNs / 1e9;
+    const double ops = qMax(1, r.operations);
+    
+    QJsonObject latency;
+    latency["p50"] = percentileUs(r.latencies, 50);
+    latency["p99"] = percentileUs(r.latencies, 99);
+    latency["max"] = r.latencies.isEmpty() ? 0.0 : r.latencies.last() / 1000.0;
+    
+    QJsonObject object;
+    object["name"] = r.name;
+    object["operations"] = r.operations;
+    object["commands"] = r.commands;
+    object["errors"] = r.errors;
+    object["seconds"] = seconds;
+    object["ops_per_s"] = seconds > 0 ? r.operations / seconds : 0.0;
+    object["commands_per_s"] = seconds > 0 ? r.commands / seconds : 0.0;
+    object["latency_us"] = latency;
+    object["tx_bytes_per_op"] = r.bytesWritten / ops;
+    object["rx_bytes_per_op"] = r.bytesRead / ops;
+    return object;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("burjuva-link-bench");
+    
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Burjuva-Atacama komut hattı gecikme/verim ölçümü");
+    parser.addHelpOption();
+    QCommandLineOption portOption({"p", "port"}, "Seri port veya simülatör pty (BURJUVA_PORT)", "port",
+                                  qEnvironmentVariable("BURJUVA_PORT", "/dev/ttyAMA0"));
+    QCommandLineOption baudOption({"b", "baud"}, "Baud hızı", "baud", "115200");
+    QCommandLineOption opsOption({"n", "ops"}, "İş yükü başına ölçülen satır", "n", "1000");
+    QCommandLineOption warmupOption("warmup", "Ölçülmeyen ısınma satırı", "n", "20");
+    QCommandLineOption workloadOption({"w", "workloads"}, "Virgülle ayrılmış iş yükleri", "list",
+                                      "toggle,readall,adc-sweep,motor-snapshot,mixed");
+    QCommandLineOption io16Option("io16", "IO16 slotu (-1: yok)", "slot", "0");
+    QCommandLineOption aio20Option("aio20", "AIO20 slotu (-1: yok)", "slot", "1");
+    QCommandLineOption fpgaOption("fpga", "FPGA slotu (-1: yok)", "slot", "2");
+    QCommandLineOption jsonOption("json", "Sonuçları JSON olarak yaz (- = stdout)", "file");
+    parser.addOptions({portOption, baudOption, opsOption, warmupOption, workloadOption,
+                       io16Option, aio20Option, fpgaOption, jsonOption});
+    parser.process(app);
+    
+    const int operations = qMax(1, parser.value(opsOption).toInt());
+    const int warmup = qMax(0, parser.value(warmupOption).toInt());
+    const QStringList selected = parser.value(workloadOption).split(QLatin1Char(','));
+    const bool jsonToStdout = parser.value(jsonOption) == "-";
+    
+    SerialController serial;
+    serial.setUpdatesEnabled(false);     // No ResponseRouter here
+    BurjuvaClient client(&serial);
+    
+    if (!serial.connectToPort(parser.value(portOption), parser.value(baudOption).toInt())) {
+        std::fprintf(stderr, "%s açılamadı\n", qPrintable(parser.value(portOption)));
+        return 1;
+    }
+    
+    // Human summary goes to stderr when stdout carries the JSON
+    FILE *text = jsonToStdout ? stderr : stdout;
+    std::fprintf(text, "%-15s %7s %5s %10s %9s %9s %9s %7s %7s\n",
+                 "workload", "ops", "err", "cmd/s", "p50 us", "p99 us", "max us", "tx/op", "rx/op");
+    
+    QJsonArray results;
+    int failed = 0;
+    const QVector<Workload> workloads = buildWorkloads(parser.value(io16Option).toInt(),
+                                                       parser.value(aio20Option).toInt(),
+                                                       parser.value(fpgaOption).toInt());
+    for (const Workload &workload : workloads) {
+        if (!selected.contains(workload.name))
+            continue;
+        
+        const Result r = runWorkload(serial, client, workload, operations, warmup);
+        const QJsonObject object = toJson(r);
+        results.append(object);
+        failed += r.errors;
+        
+        std::fprintf(text, "%-15s %7d %5d %10.0f %9.0f %9.0f %9.0f %7.1f %7.1f\n",
+                     qPrintable(r.name), r.operations, r.errors,
+                     object["commands_per_s"].toDouble(),
+                     object["latency_us"].toObject()["p50"].toDouble(),
+                     object["latency_us"].toObject()["p99"].toDouble(),
+                     object["latency_us"].toObject()["max"].toDouble(),
+                     object["tx_bytes_per_op"].toDouble(),
+                     object["rx_bytes_per_op"].toDouble());
+        
+        if (!serial.isConnected()) {
+            std::fprintf(stderr, "Bağlantı koptu\n");
+            return 1;
+        }
+    }
+    
+    if (parser.isSet(jsonOption)) {
+        QJsonObject report;
+        report["port"] = parser.value(portOption);
+        report["baud"] = parser.value(baudOption).toInt();
+        report["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+        report["ops"] = operations;
+        report["warmup"] = warmup;
+        report["workloads"] = results;
+        const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+        
+        if (jsonToStdout) {
+            std::fwrite(json.constData(), 1, json.size(), stdout);
+        } else {
+            QFile file(parser.value(jsonOption));
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                std::fprintf(stderr, "%s yazılamadı\n", qPrintable(file.fileName()));
+                return 1;
+            }
+            file.write(json);
+        }
+    }
+    
+    serial.disconnectFromPort();
+    return failed ? 3 : 0;
+}
@@ -0,0 +1,240 @@
+// Replays a recorded serial byte stream through the reply pipeline and
+// reports decoded lines per second:
+//   decoder   SerialWorker driven inline, updates popped and discarded
+//   headless  worker thread + update queue, consumer without widgets
+//   ui        worker thread + ResponseRouter + module widgets on screen
+//
+// burjuva-replay-bench [recording] [--repeat N]
+// Recordings come from burjuva-ui run with BURJUVA_SERIAL_RECORD=<file>;
+// without one a synthetic IO16/AIO20 polling stream is used.
+
+#include "serialcontroller.h"
+#include "serialworker.h"
+#include "burjuvaclient.h"
+#include "responserouter.h"
+#include "io16widget.h"
+#include "aio20widget.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSet>
+#include <QThread>
+#include <atomic>
+#include <cstdio>
+
+struct ReplayEntry {
+    bool command;           // true: written line, false: read chunk
+    QByteArray data;
+};
+
+static bool loadRecording(const QString &fileName, QVector<ReplayEntry> &entries)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    
+    const QByteArray all = file.readAll();
+    int pos = 0;
+    while (pos < all.size()) {
+        int eol = all.indexOf('\n', pos);
+        if (eol < 0 || eol - pos < 2)
+            return false;
+        
+        const QByteArray header = all.mid(pos, eol - pos);
+        pos = eol + 1;
+        
+        ReplayEntry entry;
+        if (header.startsWith("> ")) {
+            entry.command = true;
+            entry.data = header.mid(2);
+        } else if (header.startsWith("< ")) {
+            int length = header.mid(2).toInt();
+            if (length < 0 || pos + length > all.size())
+                return false;
+            entry.command = false;
+            entry.data = all.mid(pos, length);
+            pos += length;
+        } else {
+            return false;
+        }
+        entries.append(entry);
+    }
+    return true;
+}
+
+static void synthesize(QVector<ReplayEntry> &entries)
+{
+    // One polling cycle of the UI: AIO20 readall, IO16 status, a ';' batch
+    QByteArray block = "=0 ";
+    for (int ch = 0; ch < 20; ++ch) {
+        if (ch)
+            block += ',';
+        block += QByteArray::number((ch * 211) % 4096);
+    }
+    block += "\r\n";
+    
+    entries.append({true, "aio20:1:readall"});
+    entries.append({false, block});
+    entries.append({true, "io16:0:status"});
+    entries.append({false, "=0 0F00 0A00 00F3\r\n"});
+    entries.append({true, "io16:0:set:12:high;io16:0:get:3;aio20:1:read:4"});
+    entries.append({false, "=0;0 1;0 2048\r\n"});
+}
+
+// Module widgets the stream talks to
+static QSet<QPair<int, int>> modulesInStream(const QVector<ReplayEntry> &entries)
+{
+    QSet<QPair<int, int>> modules;
+    for (const ReplayEntry &entry : entries) {
+        if (!entry.command)
+            continue;
+        for (const QByteArray &command : entry.data.split(';')) {
+            RoutedUpdate update;
+            if (ResponseRouter::decodeReply(QString::fromUtf8(command), 1, QString(), update))
+                modules.insert(qMakePair(update.module, update.slot));
+        }
+    }
+    return modules;
+}
+
+static void replay(SerialWorker *worker, const QVector<ReplayEntry> &entries, int repeat)
+{
+    for (int r = 0; r < repeat; ++r) {
+        for (const ReplayEntry &entry : entries) {
+            if (entry.command)
+                worker->replayCommand(QString::fromUtf8(entry.data));
+            else
+                worker->feed(entry.data);
+        }
+    }
+}
+
+static void report(const char *mode, quint64 lines, qint64 ns, quint64 dropped)
+{
+    double seconds = ns / 1e9;
+    std::printf("%-9s %10llu lines %8.3f s %12.0f lines/s  dropped %llu\n",
+                mode, static_cast<unsigned long long>(lines), seconds,
+                seconds > 0 ? lines / seconds : 0.0,
+                static_cast<unsigned long long>(dropped));
+}
+
+static void runDecoder(const QVector<ReplayEntry> &entries, int repeat)
+{
+    SpscQueue<RoutedUpdate> updates(SerialController::UpdateQueueSize);
+    SerialWorker worker(&updates);
+    RoutedUpdate update;
+    
+    QElapsedTimer timer;
+    timer.start();
+    for (int r = 0; r < repeat; ++r) {
+        for (const ReplayEntry &entry : entries) {
+            if (entry.command) {
+                worker.replayCommand(QString::fromUtf8(entry.data));
+            } else {
+                worker.feed(entry.data);
+                while (updates.pop(update)) {}
+            }
+        }
+    }
+    report("decoder", worker.linesProcessed(), timer.nsecsElapsed(), worker.updatesDropped());
+}
+
+static void runThreaded(const QVector<ReplayEntry> &entries, int repeat, bool attachUi)
+{
+    SerialController serial;
+    BurjuvaClient client(&serial);
+    ResponseRouter *router = nullptr;
+    QList<QWidget *> widgets;
+    
+    if (attachUi) {
+        router = new ResponseRouter(&serial);
+        for (const QPair<int, int> &module : modulesInStream(entries)) {
+            QWidget *widget = nullptr;
+            if (module.first == ResponseRouter::KindIO16)
+                widget = new IO16Widget(module.second, &client, router);
+            else if (module.first == ResponseRouter::KindAIO20)
+                widget = new AIO20Widget(module.second, &client, router);
+            if (widget) {
+                widget->show();
+                widgets.append(widget);
+            }
+        }
+        QApplication::processEvents();
+    }
+    
+    SerialWorker *worker = serial.worker();
+    std::atomic<bool> done(false);
+    
+    QElapsedTimer timer;
+    timer.start();
+    
+    QMetaObject::invokeMethod(worker, [&]() {
+        worker->setBackpressure(true);
+        replay(worker, entries, repeat);
+        done.store(true);
+    }, Qt::QueuedConnection);
+    
+    RoutedUpdate update;
+    while (true) {
+        // Sampled before draining: once set, nothing is left after the drain
+        const bool finished = done.load();
+        
+        if (attachUi) {
+            QApplication::processEvents(QEventLoop::AllEvents, 5);
+            router->drainUpdates();
+        } else {
+            while (serial.takeUpdate(update)) {}
+            if (!finished)
+                QThread::yieldCurrentThread();
+        }
+        
+        if (finished)
+            break;
+    }
+    
+    report(attachUi ? "ui" : "headless", worker->linesProcessed(), timer.nsecsElapsed(),
+           serial.updatesDropped());
+    
+    qDeleteAll(widgets);
+    delete router;
+}
+
+int main(int argc, char *argv[])
+{
+    // Widgets are painted, just not to a screen, unless a platform is chosen
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    
+    // Replay must not overwrite the recording it reads
+    qunsetenv("BURJUVA_SERIAL_RECORD");
+    
+    QApplication app(argc, argv);
+    
+    QString recording;
+    int repeat = 0;
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args.at(i) == "--repeat" && i + 1 < args.size())
+            repeat = args.at(++i).toInt();
+        else
+            recording = args.at(i);
+    }
+    
+    QVector<ReplayEntry> entries;
+    if (recording.isEmpty()) {
+        synthesize(entries);
+        if (repeat <= 0)
+            repeat = 50000;
+    } else if (!loadRecording(recording, entries)) {
+        std::fprintf(stderr, "Cannot read recording %s\n", qPrintable(recording));
+        return 1;
+    }
+    if (repeat <= 0)
+        repeat = 1;
+    
+    std::printf("%d entries x %d\n", entries.size(), repeat);
+    runDecoder(entries, repeat);
+    runThreaded(entries, repeat, false);
+    runThreaded(entries, repeat, true);
+    return 0;
+}
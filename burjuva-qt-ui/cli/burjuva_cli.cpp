@@ -0,0 +1,223 @@
+// Command line client on the headless library (QtCore + QtSerialPort).
+//
+// burjuva-cli [-p PORT] [-b BAUD] [-n REPEAT] <module> <verb> [args...]
+// With -n the command is repeated back to back and round-trip latency
+// is reported.
+
+#include "serialcontroller.h"
+#include "burjuvaclient.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+
+using Done = std::function<void(int status, const QString &text)>;
+using Runner = std::function<void(BurjuvaClient &client, const Done &done)>;
+
+static const char *Usage =
+    "io16 set S PIN high|low    io16 get S PIN          io16 dir S GROUP in|out\n"
+    "io16 status S              io16 readall S\n"
+    "aio20 read S PORT          aio20 readall S         aio20 setvolt S PORT MV\n"
+    "motor goto S CH POS SPEED  motor speed S CH SPEED DIR(0-2)\n"
+    "motor stop S CH            motor home S CH         motor status S CH\n"
+    "detect                     raw \"<komut>\"";
+
+static QString hex16(quint16 word)
+{
+    return QString("%1").arg(word, 4, 16, QLatin1Char('0')).toUpper();
+}
+
+// Parse the positional arguments into a runnable request, null if invalid
+static Runner buildRunner(const QStringList &args)
+{
+    bool valid = true;
+    auto num = [&](int i) {
+        bool ok = false;
+        int value = (i < args.size()) ? args.at(i).toInt(&ok) : 0;
+        valid = valid && ok;
+        return value;
+    };
+    auto word = [&](int i) {
+        if (i >= args.size())
+            valid = false;
+        return (i < args.size()) ? args.at(i).toLower() : QString();
+    };
+    auto status = [](const Done &done) {
+        return [done](int st) { done(st, QString()); };
+    };
+    
+    const QString module = word(0);
+    const QString verb = word(1);
+    Runner run;
+    
+    if (module == "io16") {
+        const int slot = num(2);
+        if (verb == "set") {
+            const int pin = num(3);
+            const bool high = word(4) == "high" || word(4) == "1";
+            run = [=](BurjuvaClient &c, const Done &d) { c.setPin(slot, pin, high, status(d)); };
+        } else if (verb == "get") {
+            const int pin = num(3);
+            run = [=](BurjuvaClient &c, const Done &d) {
+                c.readPin(slot, pin, [d](int st, bool high) { d(st, high ? "1" : "0"); });
+            };
+        } else if (verb == "dir") {
+            const int group = num(3);
+            const bool output = word(4) == "out";
+            run = [=](BurjuvaClient &c, const Done &d) { c.setGroupDirection(slot, group, output, status(d)); };
+        } else if (verb == "status") {
+            run = [=](BurjuvaClient &c, const Done &d) {
+                c.readPortState(slot, [d](int st, quint16 dir, quint16 out, quint16 in) {
+                    d(st, QString("dir=%1 out=%2 in=%3").arg(hex16(dir), hex16(out), hex16(in)));
+                });
+            };
+        } else if (verb == "readall") {
+            run = [=](BurjuvaClient &c, const Done &d) {
+                c.readInputs(slot, [d](int st, quint16 in) { d(st, hex16(in)); });
+            };
+        }
+    } else if (module == "aio20") {
+        const int slot = num(2);
+        if (verb == "read") {
+            const int port = num(3);
+            run = [=](BurjuvaClient &c, const Done &d) {
+                c.readAdc(slot, port, [d](int st, int raw) { d(st, QString::number(raw)); });
+            };
+        } else if (verb == "readall") {
+            run = [=](BurjuvaClient &c, const Done &d) {
+                c.readAdcBlock(slot, [d](int st, const QVector<int> &raw) {
+                    QStringList values;
+                    for (int value : raw) {
+                        values.append(QString::number(value));
+                    }
+                    d(st, values.join(','));
+                });
+            };
+        } else if (verb == "setvolt") {
+            const int port = num(3);
+            const int mv = num(4);
+            run = [=](BurjuvaClient &c, const Done &d) { c.setVoltage(slot, port, mv, status(d)); };
+        }
+    } else if (module == "motor") {
+        const int slot = num(2);
+        const int channel = num(3);
+        if (verb == "goto") {
+            const int position = num(4);
+            const int speed = num(5);
+            run = [=](BurjuvaClient &c, const Done &d) { c.motorGoTo(slot, channel, position, speed, status(d)); };
+        } else if (verb == "speed") {
+            const int speed = num(4);
+            const auto direction = BurjuvaClient::MotorDirection(num(5));
+            run = [=](BurjuvaClient &c, const Done &d) { c.motorSpeed(slot, channel, speed, direction, status(d)); };
+        } else if (verb == "stop") {
+            run = [=](BurjuvaClient &c, const Done &d) { c.motorStop(slot, channel, status(d)); };
+        } else if (verb == "home") {
+            run = [=](BurjuvaClient &c, const Done &d) { c.motorHome(slot, channel, status(d)); };
+        } else if (verb == "status") {
+            run = [=](BurjuvaClient &c, const Done &d) {
+                c.motorStatus(slot, channel, [d](int st, const BurjuvaClient::MotorState &m) {
+                    d(st, QString("status=%1 error=%2 position=%3")
+                              .arg(m.status, 2, 16, QLatin1Char('0'))
+                              .arg(m.error, 2, 16, QLatin1Char('0'))
+                              .arg(m.position));
+                });
+            };
+        }
+    } else if (module == "detect") {
+        valid = true;
+        run = [](BurjuvaClient &c, const Done &d) {
+            // One "<slot> <type> <uid> <hid> <fid> <init> <init_us>" record per slot
+            c.command("modul-algila:rapor", [d](int st, const QString &payload) {
+                d(st, payload.split(QLatin1Char('|')).join(QLatin1Char('\n')));
+            });
+        };
+    } else if (module == "raw" && args.size() >= 2) {
+        valid = true;
+        const QString command = args.mid(1).join(QLatin1Char(' '));
+        run = [=](BurjuvaClient &c, const Done &d) {
+            c.command(command, [d](int st, const QString &payload) { d(st, payload); });
+        };
+    }
+    
+    return valid ? run : Runner();
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("burjuva-cli");
+    
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QString("Burjuva-Atacama komut satırı istemcisi\n\n") + Usage);
+    parser.addHelpOption();
+    QCommandLineOption portOption({"p", "port"}, "Seri port (BURJUVA_PORT)", "port",
+                                  qEnvironmentVariable("BURJUVA_PORT", "/dev/ttyAMA0"));
+    QCommandLineOption baudOption({"b", "baud"}, "Baud hızı", "baud", "115200");
+    QCommandLineOption repeatOption({"n", "repeat"}, "Komutu N kez arka arkaya çalıştır", "n", "1");
+    parser.addOption(portOption);
+    parser.addOption(baudOption);
+    parser.addOption(repeatOption);
+    parser.addPositionalArgument("komut", "Modül, komut ve parametreler");
+    parser.process(app);
+    
+    Runner run = buildRunner(parser.positionalArguments());
+    if (!run) {
+        std::fprintf(stderr, "Geçersiz komut.\n%s\n", Usage);
+        return 2;
+    }
+    const int repeat = qMax(1, parser.value(repeatOption).toInt());
+    
+    SerialController serial;
+    serial.setUpdatesEnabled(false);     // No ResponseRouter here
+    BurjuvaClient client(&serial);
+    
+    if (!serial.connectToPort(parser.value(portOption), parser.value(baudOption).toInt())) {
+        std::fprintf(stderr, "%s açılamadı\n", qPrintable(parser.value(portOption)));
+        return 1;
+    }
+    
+    QVector<qint64> latencies;
+    latencies.reserve(repeat);
+    QElapsedTimer timer;
+    int exitCode = 0;
+    
+    std::function<void()> next = [&]() {
+        const qint64 start = timer.nsecsElapsed();
+        run(client, [&, start](int status, const QString &text) {
+            latencies.append(timer.nsecsElapsed() - start);
+            
+            if (status != SerialController::StatusOk) {
+                std::fprintf(stderr, "Hata (kod %d) %s\n", status, qPrintable(text));
+                exitCode = (status > 0) ? status : 1;
+                app.exit(exitCode);
+                return;
+            }
+            if (latencies.size() == 1)
+                std::printf("%s\n", text.isEmpty() ? "OK" : qPrintable(text));
+            
+            if (latencies.size() < repeat)
+                next();
+            else
+                app.exit(0);
+        });
+    };
+    
+    timer.start();
+    next();
+    app.exec();
+    
+    if (repeat > 1 && !latencies.isEmpty()) {
+        const double totalMs = timer.nsecsElapsed() / 1e6;
+        std::sort(latencies.begin(), latencies.end());
+        std::printf("%d istek, %.1f ms, %.1f istek/s, gecikme us min %lld med %lld max %lld\n",
+                    latencies.size(), totalMs, latencies.size() * 1000.0 / totalMs,
+                    latencies.first() / 1000, latencies.at(latencies.size() / 2) / 1000,
+                    latencies.last() / 1000);
+    }
+    
+    serial.disconnectFromPort();
+    return exitCode;
+}
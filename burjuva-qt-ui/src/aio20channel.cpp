@@ -4,6 +4,13 @@
 #include <QGroupBox>
 #include <QFont>
 
+// Same sheet again still costs a full re-polish; skip it
+static void setStyleIfChanged(QWidget *widget, const QString &style)
+{
+    if (widget->styleSheet() != style)
+        widget->setStyleSheet(style);
+}
+
 AIO20Channel::AIO20Channel(int channel, bool isOutput, QWidget *parent)
     : QWidget(parent)
     , m_channel(channel)
@@ -110,11 +117,11 @@ void AIO20Channel::setAck(const QString &ack)
     
     // Color code ACK
     if (ack.contains("OK", Qt::CaseInsensitive)) {
-        m_ackLabel->setStyleSheet("QLabel { color: green; font-size: 8pt; font-style: italic; }");
+        setStyleIfChanged(m_ackLabel, "QLabel { color: green; font-size: 8pt; font-style: italic; }");
     } else if (ack.contains("ERROR", Qt::CaseInsensitive)) {
-        m_ackLabel->setStyleSheet("QLabel { color: red; font-size: 8pt; font-style: italic; }");
+        setStyleIfChanged(m_ackLabel, "QLabel { color: red; font-size: 8pt; font-style: italic; }");
     } else {
-        m_ackLabel->setStyleSheet("QLabel { color: #666; font-size: 8pt; font-style: italic; }");
+        setStyleIfChanged(m_ackLabel, "QLabel { color: #666; font-size: 8pt; font-style: italic; }");
     }
 }
 
@@ -138,13 +145,13 @@ void AIO20Channel::updateDisplay()
     
     // Color coding for value display
     if (m_isOutput) {
-        m_valueLabel->setStyleSheet("QLabel { background-color: #FFE4B5; padding: 5px; border: 1px solid #FFA500; border-radius: 3px; }");
+        setStyleIfChanged(m_valueLabel, "QLabel { background-color: #FFE4B5; padding: 5px; border: 1px solid #FFA500; border-radius: 3px; }");
     } else {
         // Input channel - color based on value
         if (m_value > 0.1) {
-            m_valueLabel->setStyleSheet("QLabel { background-color: #90EE90; padding: 5px; border: 1px solid #008000; border-radius: 3px; }");
+            setStyleIfChanged(m_valueLabel, "QLabel { background-color: #90EE90; padding: 5px; border: 1px solid #008000; border-radius: 3px; }");
         } else {
-            m_valueLabel->setStyleSheet("QLabel { background-color: #F0F0F0; padding: 5px; border: 1px solid #CCC; border-radius: 3px; }");
+            setStyleIfChanged(m_valueLabel, "QLabel { background-color: #F0F0F0; padding: 5px; border: 1px solid #CCC; border-radius: 3px; }");
         }
     }
 }
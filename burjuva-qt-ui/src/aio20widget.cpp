@@ -1,27 +1,55 @@
 #include "aio20widget.h"
 #include "aio20channel.h"
-#include "serialcontroller.h"
+#include "trendview.h"
+#include "burjuvaclient.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QScrollArea>
-#include <QRegularExpression>
+#include <QTabWidget>
+#include <QTimer>
+#include <QDateTime>
 
-AIO20Widget::AIO20Widget(int slot, SerialController *serial, QWidget *parent)
+AIO20Widget::AIO20Widget(int slot, BurjuvaClient *client, ResponseRouter *router,
+                         QWidget *parent)
     : QWidget(parent)
     , m_slot(slot)
-    , m_serial(serial)
+    , m_client(client)
+    , m_router(router)
+    , m_refreshTimer(new QTimer(this))
+    , m_trendTimer(new QTimer(this))
+    , m_trendRequestMs(0)
+    , m_trend(12, TrendCapacity)
 {
+    m_state.slot = slot;
+    for (int channel = 0; channel < 20; channel++) {
+        AIO20ChannelState *state = m_state.channel(channel);
+        state->channel = channel;
+        state->isOutput = channel >= 12;
+    }
+    
     setupUI();
     
-    connect(m_serial, &SerialController::dataReceived,
-            this, &AIO20Widget::handleDataReceived);
+    // At most one widget refresh per period, however fast samples arrive
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setInterval(WidgetRefreshMs);
+    connect(m_refreshTimer, &QTimer::timeout, this, &AIO20Widget::refreshWidgets);
+    
+    connect(m_trendTimer, &QTimer::timeout, this, &AIO20Widget::pollTrend);
+    m_trendTimer->start(TrendSampleMs);
+    
+    m_router->registerTarget(ResponseRouter::KindAIO20, m_slot, this);
     
     // Request initial states
     requestAllStates();
 }
 
+AIO20Widget::~AIO20Widget()
+{
+    m_router->unregisterTarget(ResponseRouter::KindAIO20, m_slot, this);
+}
+
 void AIO20Widget::setupUI()
 {
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
@@ -85,112 +113,152 @@ void AIO20Widget::setupUI()
     scrollLayout->addStretch();
     
     scrollArea->setWidget(scrollContent);
-    mainLayout->addWidget(scrollArea);
+    
+    // Channels / input trend
+    QTabWidget *tabs = new QTabWidget(this);
+    tabs->addTab(scrollArea, "Kanallar");
+    tabs->addTab(new TrendView(&m_trend, "V", this), "Trend");
+    mainLayout->addWidget(tabs);
 }
 
 void AIO20Widget::updateState(const AIO20State &state)
 {
     m_state = state;
-    
-    // Update input channels
-    for (int i = 0; i < 12; i++) {
-        AIO20ChannelState channelState = state.inputChannels[i];
-        m_inputChannels[i]->setValue(channelState.value);
-        m_inputChannels[i]->setMode(channelState.mode);
-        m_inputChannels[i]->setAck(channelState.lastAck);
-    }
-    
-    // Update output channels
-    for (int i = 0; i < 8; i++) {
-        AIO20ChannelState channelState = state.outputChannels[i];
-        m_outputChannels[i]->setValue(channelState.value);
-        m_outputChannels[i]->setMode(channelState.mode);
-        m_outputChannels[i]->setAck(channelState.lastAck);
-    }
+    m_state.slot = m_slot;
+    m_state.dirtyChannels = 0xFFFFF;
+    scheduleRefresh();
 }
 
 void AIO20Widget::onChannelValueChanged(int channel, float value)
 {
-    QString cmd = QString("aio20:slot%1:kanal%2:set:%3")
-                      .arg(m_slot)
-                      .arg(channel)
-                      .arg(value, 0, 'f', 2);
-    
-    m_serial->sendCommand(cmd);
+    // Firmware takes millivolts (0-10000)
+    m_client->setVoltage(m_slot, channel, qRound(value * 1000.0f));
     m_statusLabel->setText(QString("Kanal %1 = %2V").arg(channel).arg(value, 0, 'f', 2));
 }
 
-void AIO20Widget::handleDataReceived(const QString &data)
+void AIO20Widget::routedUpdate(const RoutedUpdate &update)
 {
-    // Parse AIO20 responses
-    // Example: "[ACK] AIO20 Slot 1 Kanal 5 = 3.25V"
-    // Example: "[ACK] AIO20 Slot 1 Kanal 15 Output = 5.00V"
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
     
-    if (!data.contains(QString("Slot %1").arg(m_slot)))
-        return;
+    // 12-bit raw, 4095 = 10V (firmware AIO20_ToVoltage)
+    switch (update.kind) {
+        case RoutedUpdate::ChannelRaw: {
+            float volts = update.value * 10.0f / 4095.0f;
+            if (update.channel >= 0 && update.channel < 12)
+                m_trend.append(update.channel, now, volts);
+            setChannelVoltage(update.channel, volts, update.command);
+            break;
+        }
+        case RoutedUpdate::ChannelBlock:
+            for (int channel = 0; channel < update.values.size() && channel < 20; channel++) {
+                float volts = update.values.at(channel) * 10.0f / 4095.0f;
+                if (channel < 12)
+                    m_trend.append(channel, now, volts);
+                setChannelVoltage(channel, volts, QString());
+            }
+            m_trendRequestMs = 0;
+            m_pendingStatus = QStringLiteral("Tüm kanallar güncellendi");
+            break;
+        case RoutedUpdate::ChannelVoltage:
+            setChannelVoltage(update.channel, update.value / 1000.0f, update.command);
+            break;
+        case RoutedUpdate::Error:
+            m_trendRequestMs = 0;
+            m_pendingStatus = QString("Hata (kod %1): %2").arg(update.status).arg(update.command);
+            break;
+        default:
+            return;
+    }
     
-    // Parse channel value
-    QRegularExpression channelRegex(R"(Kanal\s+(\d+)\s+(?:Output\s+)?=\s+([\d.]+)\s*([VmA]+))");
-    QRegularExpressionMatch match = channelRegex.match(data);
+    scheduleRefresh();
+}
+
+void AIO20Widget::setChannelVoltage(int channel, float volts, const QString &ack)
+{
+    AIO20ChannelState *state = m_state.channel(channel);
+    if (!state)
+        return;
     
-    if (match.hasMatch()) {
-        int channel = match.captured(1).toInt();
-        float value = match.captured(2).toFloat();
-        QString unit = match.captured(3);
-        
-        // Convert mA to voltage for display (4-20mA range)
-        if (unit.contains("mA", Qt::CaseInsensitive)) {
-            // Keep as mA value
-        }
-        
-        // Update appropriate channel
-        if (channel >= 0 && channel < 12) {
-            m_inputChannels[channel]->setValue(value);
-            m_inputChannels[channel]->setAck(data);
-            m_statusLabel->setText(QString("Kanal %1 güncellendi: %2%3")
-                                       .arg(channel).arg(value, 0, 'f', 2).arg(unit));
-        } else if (channel >= 12 && channel < 20) {
-            int idx = channel - 12;
-            m_outputChannels[idx]->setValue(value);
-            m_outputChannels[idx]->setAck(data);
-            m_statusLabel->setText(QString("Kanal %1 güncellendi: %2%3")
-                                       .arg(channel).arg(value, 0, 'f', 2).arg(unit));
-        }
+    // Unchanged samples cost nothing downstream
+    if (state->value == volts && ack.isEmpty())
         return;
-    }
     
-    // Parse mode configuration
-    QRegularExpression modeRegex(R"(Kanal\s+(\d+)\s+Mode:\s+(\w+))");
-    QRegularExpressionMatch modeMatch = modeRegex.match(data);
+    state->value = volts;
+    state->rawValue = qRound(volts * 4095.0f / 10.0f);
+    state->lastUpdateTime = QDateTime::currentMSecsSinceEpoch();
+    m_state.dirtyChannels |= 1u << channel;
     
-    if (modeMatch.hasMatch()) {
-        int channel = modeMatch.captured(1).toInt();
-        QString mode = modeMatch.captured(2);
-        
-        if (channel >= 0 && channel < 12) {
-            m_inputChannels[channel]->setMode(mode);
-        } else if (channel >= 12 && channel < 20) {
-            int idx = channel - 12;
-            m_outputChannels[idx]->setMode(mode);
-        }
+    if (!ack.isEmpty()) {
+        state->lastAck = ack;
+        m_pendingStatus = QString("Kanal %1 güncellendi: %2V")
+                              .arg(channel).arg(volts, 0, 'f', 2);
     }
 }
 
-void AIO20Widget::requestChannelState(int channel)
+AIO20Channel *AIO20Widget::channelWidget(int channel) const
 {
-    QString cmd = QString("aio20:slot%1:kanal%2:oku").arg(m_slot).arg(channel);
-    m_serial->sendCommand(cmd);
+    if (channel >= 0 && channel < 12)
+        return m_inputChannels[channel];
+    if (channel >= 12 && channel < 20)
+        return m_outputChannels[channel - 12];
+    return nullptr;
 }
 
-void AIO20Widget::requestAllStates()
+void AIO20Widget::scheduleRefresh()
 {
-    // Request all input channels
-    for (int i = 0; i < 12; i++) {
-        requestChannelState(i);
+    if (!m_refreshTimer->isActive())
+        m_refreshTimer->start();
+}
+
+void AIO20Widget::refreshWidgets()
+{
+    // Hidden (other slot on screen): stay dirty until shown
+    if (!isVisible())
+        return;
+    
+    for (int channel = 0; channel < 20; channel++) {
+        if (!(m_state.dirtyChannels & (1u << channel)))
+            continue;
+        
+        const AIO20ChannelState *state = m_state.channel(channel);
+        AIO20Channel *widget = channelWidget(channel);
+        widget->setValue(state->value);
+        if (!state->mode.isEmpty())
+            widget->setMode(state->mode);
+        if (!state->lastAck.isEmpty())
+            widget->setAck(state->lastAck);
     }
+    m_state.dirtyChannels = 0;
     
-    // Request all output channels
-    for (int i = 12; i < 20; i++) {
-        requestChannelState(i);
+    if (!m_pendingStatus.isNull()) {
+        m_statusLabel->setText(m_pendingStatus);
+        m_pendingStatus.clear();
     }
 }
+
+void AIO20Widget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    refreshWidgets();
+}
+
+void AIO20Widget::pollTrend()
+{
+    if (!m_client->isConnected())
+        return;
+    
+    // One outstanding sample at most, so a stalled link cannot fill the
+    // command queue; a reply lost to a timeout is given up after 5 s
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (m_trendRequestMs != 0 && now - m_trendRequestMs < 5000)
+        return;
+    
+    m_trendRequestMs = now;
+    requestAllStates();
+}
+
+void AIO20Widget::requestAllStates()
+{
+    // All 20 ports in one reply
+    m_client->readAdcBlock(m_slot);
+}
@@ -4,30 +4,50 @@
 #include <QWidget>
 #include <QLabel>
 #include "moduletypes.h"
+#include "responserouter.h"
+#include "trendbuffer.h"
 
-class SerialController;
+class BurjuvaClient;
 class AIO20Channel;
+class QTimer;
 
-class AIO20Widget : public QWidget
+class AIO20Widget : public QWidget, public RouteTarget
 {
     Q_OBJECT
-    
+
 public:
-    explicit AIO20Widget(int slot, SerialController *serial, QWidget *parent = nullptr);
+    explicit AIO20Widget(int slot, BurjuvaClient *client, ResponseRouter *router,
+                         QWidget *parent = nullptr);
+    ~AIO20Widget();
     
     void updateState(const AIO20State &state);
     
+    // Input history for the trend view: one readall per TrendSampleMs,
+    // TrendCapacity samples per channel (~9 h)
+    static constexpr int TrendSampleMs = 1000;
+    static constexpr int TrendCapacity = 32768;
+    
+    // Decoded replies for this slot (ResponseRouter); updates the model only
+    void routedUpdate(const RoutedUpdate &update) override;
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
 private slots:
     void onChannelValueChanged(int channel, float value);
-    void handleDataReceived(const QString &data);
-    
+    void refreshWidgets();
+    void pollTrend();
+
 private:
     void setupUI();
-    void requestChannelState(int channel);
     void requestAllStates();
+    void setChannelVoltage(int channel, float volts, const QString &ack);
+    void scheduleRefresh();
+    AIO20Channel *channelWidget(int channel) const;
     
     int m_slot;
-    SerialController *m_serial;
+    BurjuvaClient *m_client;
+    ResponseRouter *m_router;
     
     // 12 input channels (0-11)
     AIO20Channel *m_inputChannels[12];
@@ -36,8 +56,13 @@ private:
     AIO20Channel *m_outputChannels[8];
     
     QLabel *m_statusLabel;
+    QTimer *m_refreshTimer;
+    QString m_pendingStatus;    // Shown at the next refresh
+    QTimer *m_trendTimer;
+    qint64 m_trendRequestMs;    // Last unanswered readall, 0 = none
+    TrendBuffer m_trend;        // Inputs 0-11
     
-    AIO20State m_state;
+    AIO20State m_state;         // Model; widgets follow it at WidgetRefreshMs
 };
 
 #endif // AIO20WIDGET_H
@@ -0,0 +1,188 @@
+#include "burjuvaclient.h"
+#include "serialcontroller.h"
+#include "responserouter.h"
+
+BurjuvaClient::BurjuvaClient(SerialController *serial, QObject *parent)
+    : QObject(parent)
+    , m_serial(serial)
+    , m_nextId(1)
+{
+    connect(m_serial, &SerialController::requestCompleted,
+            this, &BurjuvaClient::handleRequestCompleted);
+}
+
+bool BurjuvaClient::isConnected() const
+{
+    return m_serial->isConnected();
+}
+
+void BurjuvaClient::command(const QString &command, ReplyCallback done, bool priority)
+{
+    quint32 id = 0;
+    if (done) {
+        id = m_nextId++;
+        if (m_nextId == 0)
+            m_nextId = 1;
+        // Registered before sending; the id may complete on the next event loop pass
+        m_pending.insert(id, std::move(done));
+    }
+    
+    if (priority)
+        m_serial->sendCommandWithPriority(command, id);
+    else
+        m_serial->sendCommand(command, id);
+}
+
+void BurjuvaClient::handleRequestCompleted(quint32 requestId, int status, const QString &payload)
+{
+    ReplyCallback done = m_pending.take(requestId);
+    if (done)
+        done(status, payload);
+}
+
+template <typename Fn>
+void BurjuvaClient::decoded(const QString &cmd, Fn &&onUpdate)
+{
+    command(cmd, [cmd, onUpdate](int status, const QString &payload) {
+        RoutedUpdate update;
+        if (status == SerialController::StatusOk &&
+            !ResponseRouter::decodeReply(cmd, status, payload, update))
+            status = SerialController::StatusSyntax;  // Reply not understood
+        onUpdate(status, update);
+    });
+}
+
+static BurjuvaClient::ReplyCallback statusOnly(BurjuvaClient::StatusCallback done)
+{
+    if (!done)
+        return nullptr;
+    return [done](int status, const QString &) { done(status); };
+}
+
+void BurjuvaClient::setPin(int slot, int pin, bool high, StatusCallback done)
+{
+    command(QString("io16:%1:set:%2:%3").arg(slot).arg(pin).arg(high ? "high" : "low"),
+            statusOnly(done));
+}
+
+void BurjuvaClient::readPin(int slot, int pin, std::function<void(int, bool)> done)
+{
+    QString cmd = QString("io16:%1:get:%2").arg(slot).arg(pin);
+    if (!done) {
+        command(cmd);
+        return;
+    }
+    decoded(cmd, [done](int status, const RoutedUpdate &update) {
+        done(status, update.value != 0);
+    });
+}
+
+void BurjuvaClient::setGroupDirection(int slot, int group, bool output, StatusCallback done)
+{
+    command(QString("io16:%1:dirgroup:%2:%3").arg(slot).arg(group).arg(output ? "out" : "in"),
+            statusOnly(done));
+}
+
+void BurjuvaClient::readPortState(int slot, std::function<void(int, quint16, quint16, quint16)> done)
+{
+    QString cmd = QString("io16:%1:status").arg(slot);
+    if (!done) {
+        command(cmd);
+        return;
+    }
+    decoded(cmd, [done](int status, const RoutedUpdate &update) {
+        done(status, update.direction, update.output, update.input);
+    });
+}
+
+void BurjuvaClient::readInputs(int slot, std::function<void(int, quint16)> done)
+{
+    QString cmd = QString("io16:%1:readall").arg(slot);
+    if (!done) {
+        command(cmd);
+        return;
+    }
+    decoded(cmd, [done](int status, const RoutedUpdate &update) {
+        done(status, update.input);
+    });
+}
+
+void BurjuvaClient::readAdc(int slot, int port, std::function<void(int, int)> done)
+{
+    QString cmd = QString("aio20:%1:read:%2").arg(slot).arg(port);
+    if (!done) {
+        command(cmd);
+        return;
+    }
+    decoded(cmd, [done](int status, const RoutedUpdate &update) {
+        done(status, update.value);
+    });
+}
+
+void BurjuvaClient::readAdcBlock(int slot, std::function<void(int, const QVector<int> &)> done)
+{
+    QString cmd = QString("aio20:%1:readall").arg(slot);
+    if (!done) {
+        command(cmd);
+        return;
+    }
+    decoded(cmd, [done](int status, const RoutedUpdate &update) {
+        done(status, update.values);
+    });
+}
+
+void BurjuvaClient::setVoltage(int slot, int port, int millivolts, StatusCallback done)
+{
+    // Firmware takes millivolts (0-10000)
+    command(QString("aio20:%1:setvolt:%2:%3").arg(slot).arg(port).arg(qBound(0, millivolts, 10000)),
+            statusOnly(done));
+}
+
+void BurjuvaClient::motorGoTo(int slot, int channel, qint32 position, int speed, StatusCallback done)
+{
+    command(QString("fpga:%1:motor:%2:goto:%3:%4").arg(slot).arg(channel).arg(position).arg(speed),
+            statusOnly(done));
+}
+
+void BurjuvaClient::motorSpeed(int slot, int channel, int speed, MotorDirection direction,
+                               StatusCallback done)
+{
+    command(QString("fpga:%1:motor:%2:speed:%3:%4").arg(slot).arg(channel).arg(speed).arg(int(direction)),
+            statusOnly(done));
+}
+
+void BurjuvaClient::motorStop(int slot, int channel, StatusCallback done)
+{
+    command(QString("fpga:%1:motor:%2:stop").arg(slot).arg(channel), statusOnly(done));
+}
+
+void BurjuvaClient::motorHome(int slot, int channel, StatusCallback done)
+{
+    command(QString("fpga:%1:motor:%2:home").arg(slot).arg(channel), statusOnly(done));
+}
+
+void BurjuvaClient::motorStatus(int slot, int channel,
+                                std::function<void(int, const MotorState &)> done)
+{
+    QString cmd = QString("fpga:%1:motor:%2:status").arg(slot).arg(channel);
+    if (!done) {
+        command(cmd);
+        return;
+    }
+    
+    // "<status hex> <error hex> <position>"
+    command(cmd, [done](int status, const QString &payload) {
+        MotorState state = {0, 0, 0};
+        const QVector<QStringRef> words = payload.splitRef(QLatin1Char(' '));
+        if (status == SerialController::StatusOk) {
+            if (words.size() == 3) {
+                state.status = quint8(words.at(0).toUInt(nullptr, 16));
+                state.error = quint8(words.at(1).toUInt(nullptr, 16));
+                state.position = words.at(2).toInt();
+            } else {
+                status = SerialController::StatusSyntax;
+            }
+        }
+        done(status, state);
+    });
+}
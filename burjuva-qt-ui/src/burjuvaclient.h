@@ -0,0 +1,80 @@
+#ifndef BURJUVACLIENT_H
+#define BURJUVACLIENT_H
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <functional>
+
+class SerialController;
+
+// Typed, asynchronous command API on top of SerialController. Each call
+// queues one firmware command; the optional callback runs on the caller's
+// thread with the command's own status (SerialController::ReplyStatus,
+// StatusNoReply on timeout/disconnect) and the decoded result.
+// Replies to IO16/AIO20 commands also reach a ResponseRouter as usual.
+class BurjuvaClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    using StatusCallback = std::function<void(int status)>;
+    using ReplyCallback = std::function<void(int status, const QString &payload)>;
+    
+    enum MotorDirection {
+        MotorStop = 0,
+        MotorForward = 1,
+        MotorReverse = 2
+    };
+    
+    struct MotorState {
+        quint8 status;
+        quint8 error;
+        qint32 position;
+    };
+    
+    explicit BurjuvaClient(SerialController *serial, QObject *parent = nullptr);
+    
+    SerialController *serial() const { return m_serial; }
+    bool isConnected() const;
+    
+    // IO16
+    void setPin(int slot, int pin, bool high, StatusCallback done = nullptr);
+    void readPin(int slot, int pin, std::function<void(int status, bool high)> done);
+    void setGroupDirection(int slot, int group, bool output, StatusCallback done = nullptr);
+    void readPortState(int slot, std::function<void(int status, quint16 direction,
+                                                    quint16 output, quint16 input)> done = nullptr);
+    void readInputs(int slot, std::function<void(int status, quint16 input)> done = nullptr);
+    
+    // AIO20
+    void readAdc(int slot, int port, std::function<void(int status, int raw)> done = nullptr);
+    void readAdcBlock(int slot, std::function<void(int status, const QVector<int> &raw)> done = nullptr);
+    void setVoltage(int slot, int port, int millivolts, StatusCallback done = nullptr);
+    
+    // FPGA motors
+    void motorGoTo(int slot, int channel, qint32 position, int speed, StatusCallback done = nullptr);
+    void motorSpeed(int slot, int channel, int speed, MotorDirection direction,
+                    StatusCallback done = nullptr);
+    void motorStop(int slot, int channel, StatusCallback done = nullptr);
+    void motorHome(int slot, int channel, StatusCallback done = nullptr);
+    void motorStatus(int slot, int channel,
+                     std::function<void(int status, const MotorState &state)> done);
+    
+    // Any shell command; priority commands skip the queue. A ';' line is
+    // answered with its first failing status and the raw results.
+    void command(const QString &command, ReplyCallback done = nullptr, bool priority = false);
+
+private slots:
+    void handleRequestCompleted(quint32 requestId, int status, const QString &payload);
+
+private:
+    // Decoded payload of command via the ResponseRouter decoder
+    template <typename Fn>
+    void decoded(const QString &command, Fn &&onUpdate);
+    
+    SerialController *m_serial;
+    QHash<quint32, ReplyCallback> m_pending;
+    quint32 m_nextId;
+};
+
+#endif // BURJUVACLIENT_H
@@ -4,6 +4,13 @@
 #include <QGroupBox>
 #include <QFont>
 
+// setStyleSheet re-polishes the widget even for an identical sheet
+static void setStyleIfChanged(QWidget *widget, const QString &style)
+{
+    if (widget->styleSheet() != style)
+        widget->setStyleSheet(style);
+}
+
 IO16Group::IO16Group(int group, QWidget *parent)
     : QWidget(parent)
     , m_group(group)
@@ -94,7 +101,7 @@ void IO16Group::setDirection(bool isOutput)
     
     m_directionBtn->setChecked(isOutput);
     m_directionBtn->setText(isOutput ? "Output" : "Input");
-    m_directionBtn->setStyleSheet(isOutput ? "background-color: #FFD700;" : "");
+    setStyleIfChanged(m_directionBtn, isOutput ? "background-color: #FFD700;" : "");
     
     updatePinWidgets();
 }
@@ -109,10 +116,10 @@ void IO16Group::setPinValue(int pin, bool value)
     if (m_isOutput) {
         m_pins[pin].toggleBtn->setChecked(value);
         m_pins[pin].toggleBtn->setText(value ? "ON" : "OFF");
-        m_pins[pin].toggleBtn->setStyleSheet(value ? "background-color: #90EE90;" : "");
+        setStyleIfChanged(m_pins[pin].toggleBtn, value ? "background-color: #90EE90;" : "");
     } else {
         m_pins[pin].valueLabel->setText(value ? "1" : "0");
-        m_pins[pin].valueLabel->setStyleSheet(value ?
+        setStyleIfChanged(m_pins[pin].valueLabel, value ?
             "QLabel { background-color: #90EE90; padding: 5px; border: 1px solid #008000; border-radius: 3px; font-weight: bold; }" :
             "QLabel { background-color: #F0F0F0; padding: 5px; border: 1px solid #CCC; border-radius: 3px; }");
     }
@@ -127,11 +134,11 @@ void IO16Group::setPinAck(int pin, const QString &ack)
     
     // Color code ACK
     if (ack.contains("OK", Qt::CaseInsensitive)) {
-        m_pins[pin].ackLabel->setStyleSheet("QLabel { color: green; font-size: 9pt; }");
+        setStyleIfChanged(m_pins[pin].ackLabel, "QLabel { color: green; font-size: 9pt; }");
     } else if (ack.contains("ERROR", Qt::CaseInsensitive)) {
-        m_pins[pin].ackLabel->setStyleSheet("QLabel { color: red; font-size: 9pt; }");
+        setStyleIfChanged(m_pins[pin].ackLabel, "QLabel { color: red; font-size: 9pt; }");
     } else {
-        m_pins[pin].ackLabel->setStyleSheet("QLabel { color: #666; font-size: 9pt; }");
+        setStyleIfChanged(m_pins[pin].ackLabel, "QLabel { color: #666; font-size: 9pt; }");
     }
 }
 
@@ -1,25 +1,46 @@
 #include "io16widget.h"
 #include "io16group.h"
-#include "serialcontroller.h"
+#include "burjuvaclient.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGroupBox>
-#include <QRegularExpression>
+#include <QTimer>
+#include <QDateTime>
 
-IO16Widget::IO16Widget(int slot, SerialController *serial, QWidget *parent)
+IO16Widget::IO16Widget(int slot, BurjuvaClient *client, ResponseRouter *router,
+                       QWidget *parent)
     : QWidget(parent)
     , m_slot(slot)
-    , m_serial(serial)
+    , m_client(client)
+    , m_router(router)
+    , m_refreshTimer(new QTimer(this))
 {
+    m_state.slot = slot;
+    for (int group = 0; group < 4; group++) {
+        m_state.groups[group].group = group;
+        for (int pin = 0; pin < 4; pin++) {
+            m_state.groups[group].pins[pin].pin = group * 4 + pin;
+        }
+    }
+    
     setupUI();
     
-    connect(m_serial, &SerialController::dataReceived,
-            this, &IO16Widget::handleDataReceived);
+    // At most one widget refresh per period, however fast replies arrive
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setInterval(WidgetRefreshMs);
+    connect(m_refreshTimer, &QTimer::timeout, this, &IO16Widget::refreshWidgets);
+    
+    m_router->registerTarget(ResponseRouter::KindIO16, m_slot, this);
     
     // Request initial states
     requestAllStates();
 }
 
+IO16Widget::~IO16Widget()
+{
+    m_router->unregisterTarget(ResponseRouter::KindIO16, m_slot, this);
+}
+
 void IO16Widget::setupUI()
 {
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
@@ -66,27 +87,15 @@ void IO16Widget::setupUI()
 void IO16Widget::updateState(const IO16State &state)
 {
     m_state = state;
-    
-    for (int group = 0; group < 4; group++) {
-        IO16GroupState groupState = state.groups[group];
-        
-        m_groups[group]->setDirection(groupState.isOutput);
-        
-        for (int pin = 0; pin < 4; pin++) {
-            m_groups[group]->setPinValue(pin, groupState.pins[pin].value);
-            m_groups[group]->setPinAck(pin, groupState.pins[pin].lastAck);
-        }
-    }
+    m_state.slot = m_slot;
+    m_state.dirtyPins = 0xFFFF;
+    m_state.dirtyGroups = 0x0F;
+    scheduleRefresh();
 }
 
 void IO16Widget::onDirectionChanged(int group, bool isOutput)
 {
-    QString cmd = QString("io16:slot%1:grup%2:direction:%3")
-                      .arg(m_slot)
-                      .arg(group)
-                      .arg(isOutput ? "output" : "input");
-    
-    m_serial->sendCommand(cmd);
+    m_client->setGroupDirection(m_slot, group, isOutput);
     m_statusLabel->setText(QString("Grup %1 yönü değiştiriliyor...").arg(group));
 }
 
@@ -94,69 +103,139 @@ void IO16Widget::onPinToggled(int group, int pin, bool value)
 {
     int pinNum = group * 4 + pin;
     
-    QString cmd = QString("io16:slot%1:pin%2:%3")
-                      .arg(m_slot)
-                      .arg(pinNum)
-                      .arg(value ? "1" : "0");
-    
-    m_serial->sendCommand(cmd);
+    m_client->setPin(m_slot, pinNum, value);
     m_statusLabel->setText(QString("Pin %1 = %2").arg(pinNum).arg(value));
 }
 
-void IO16Widget::handleDataReceived(const QString &data)
+void IO16Widget::routedUpdate(const RoutedUpdate &update)
+{
+    switch (update.kind) {
+        case RoutedUpdate::PinValue:
+            if (update.channel >= 0 && update.channel < 16) {
+                setPin(update.channel, update.value != 0);
+                
+                IO16PinState &pin = m_state.groups[update.channel / 4].pins[update.channel % 4];
+                pin.lastAck = update.command;
+                pin.lastUpdateTime = QDateTime::currentMSecsSinceEpoch();
+                m_state.dirtyPins |= 1 << update.channel;
+                m_pendingStatus = QString("Pin %1 güncellendi").arg(update.channel);
+            }
+            break;
+        case RoutedUpdate::GroupDirection:
+            if (update.channel >= 0 && update.channel < 4) {
+                setGroupDirection(update.channel, update.value != 0);
+                m_pendingStatus = QString("Grup %1 yönü: %2")
+                                      .arg(update.channel)
+                                      .arg(update.value ? "Output" : "Input");
+            }
+            break;
+        case RoutedUpdate::PortState:
+            applyPortState(update.direction, update.output, update.input);
+            break;
+        case RoutedUpdate::InputWord:
+            // Only the input word is known; keep output pins as they are
+            for (int pinNum = 0; pinNum < 16; pinNum++) {
+                if (!m_state.groups[pinNum / 4].isOutput)
+                    setPin(pinNum, (update.input >> pinNum) & 1);
+            }
+            break;
+        case RoutedUpdate::Error:
+            m_pendingStatus = QString("Hata (kod %1): %2").arg(update.status).arg(update.command);
+            break;
+        default:
+            return;
+    }
+    
+    scheduleRefresh();
+}
+
+void IO16Widget::setPin(int pinNum, bool value)
 {
-    // Parse IO16 responses
-    // Example: "[ACK] IO16 Slot 0 Pin 5 = 1"
-    // Example: "[ACK] IO16 Slot 0 Grup 1 Direction = Output"
+    IO16PinState &pin = m_state.groups[pinNum / 4].pins[pinNum % 4];
+    if (pin.value == value)
+        return;
     
-    if (!data.contains(QString("Slot %1").arg(m_slot)))
+    pin.value = value;
+    pin.lastUpdateTime = QDateTime::currentMSecsSinceEpoch();
+    m_state.dirtyPins |= 1 << pinNum;
+}
+
+void IO16Widget::setGroupDirection(int group, bool isOutput)
+{
+    IO16GroupState &state = m_state.groups[group];
+    if (state.isOutput == isOutput)
         return;
     
-    // Parse pin value
-    QRegularExpression pinRegex(R"(Pin\s+(\d+)\s+=\s+(\d+))");
-    QRegularExpressionMatch pinMatch = pinRegex.match(data);
+    state.isOutput = isOutput;
+    for (int pin = 0; pin < 4; pin++) {
+        state.pins[pin].isOutput = isOutput;
+    }
     
-    if (pinMatch.hasMatch()) {
-        int pinNum = pinMatch.captured(1).toInt();
-        bool value = pinMatch.captured(2).toInt() == 1;
+    // Switching direction swaps the pin widgets; their values must follow
+    m_state.dirtyGroups |= 1 << group;
+    m_state.dirtyPins |= 0xF << (group * 4);
+}
+
+void IO16Widget::applyPortState(quint16 direction, quint16 output, quint16 input)
+{
+    // One "status" reply refreshes all four groups
+    for (int group = 0; group < 4; group++) {
+        bool isOutput = (direction >> (group * 4)) & 1;
+        quint16 word = isOutput ? output : input;
         
-        int group = pinNum / 4;
-        int pin = pinNum % 4;
+        setGroupDirection(group, isOutput);
         
-        if (group >= 0 && group < 4) {
-            m_groups[group]->setPinValue(pin, value);
-            m_groups[group]->setPinAck(pin, data);
-            m_statusLabel->setText(QString("Pin %1 güncellendi").arg(pinNum));
+        for (int pin = 0; pin < 4; pin++) {
+            setPin(group * 4 + pin, (word >> (group * 4 + pin)) & 1);
         }
-        return;
     }
+    m_pendingStatus = QStringLiteral("Durum güncellendi");
+}
+
+void IO16Widget::scheduleRefresh()
+{
+    if (!m_refreshTimer->isActive())
+        m_refreshTimer->start();
+}
+
+void IO16Widget::refreshWidgets()
+{
+    // Hidden (other slot on screen): stay dirty until shown
+    if (!isVisible())
+        return;
     
-    // Parse direction
-    QRegularExpression dirRegex(R"(Grup\s+(\d+)\s+Direction\s+=\s+(\w+))");
-    QRegularExpressionMatch dirMatch = dirRegex.match(data);
+    for (int group = 0; group < 4; group++) {
+        if (m_state.dirtyGroups & (1 << group))
+            m_groups[group]->setDirection(m_state.groups[group].isOutput);
+    }
     
-    if (dirMatch.hasMatch()) {
-        int group = dirMatch.captured(1).toInt();
-        QString direction = dirMatch.captured(2);
-        bool isOutput = direction.contains("output", Qt::CaseInsensitive);
+    for (int pinNum = 0; pinNum < 16; pinNum++) {
+        if (!(m_state.dirtyPins & (1 << pinNum)))
+            continue;
         
-        if (group >= 0 && group < 4) {
-            m_groups[group]->setDirection(isOutput);
-            m_statusLabel->setText(QString("Grup %1 yönü: %2").arg(group).arg(direction));
-        }
-        return;
+        const IO16PinState &pin = m_state.groups[pinNum / 4].pins[pinNum % 4];
+        m_groups[pinNum / 4]->setPinValue(pinNum % 4, pin.value);
+        if (!pin.lastAck.isEmpty())
+            m_groups[pinNum / 4]->setPinAck(pinNum % 4, pin.lastAck);
+    }
+    
+    m_state.dirtyPins = 0;
+    m_state.dirtyGroups = 0;
+    
+    if (!m_pendingStatus.isNull()) {
+        m_statusLabel->setText(m_pendingStatus);
+        m_pendingStatus.clear();
     }
 }
 
-void IO16Widget::requestGroupState(int group)
+void IO16Widget::showEvent(QShowEvent *event)
 {
-    QString cmd = QString("io16:slot%1:grup%2:oku").arg(m_slot).arg(group);
-    m_serial->sendCommand(cmd);
+    QWidget::showEvent(event);
+    refreshWidgets();
 }
 
 void IO16Widget::requestAllStates()
 {
-    for (int group = 0; group < 4; group++) {
-        requestGroupState(group);
-    }
+    // Direction, output and input words in one reply
+    m_client->readPortState(m_slot);
 }
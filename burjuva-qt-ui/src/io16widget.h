@@ -5,36 +5,52 @@
 #include <QLabel>
 #include <QGroupBox>
 #include "moduletypes.h"
+#include "responserouter.h"
 
-class SerialController;
+class BurjuvaClient;
 class IO16Group;
+class QTimer;
 
-class IO16Widget : public QWidget
+class IO16Widget : public QWidget, public RouteTarget
 {
     Q_OBJECT
-    
+
 public:
-    explicit IO16Widget(int slot, SerialController *serial, QWidget *parent = nullptr);
+    explicit IO16Widget(int slot, BurjuvaClient *client, ResponseRouter *router,
+                        QWidget *parent = nullptr);
+    ~IO16Widget();
     
     void updateState(const IO16State &state);
     
+    // Decoded replies for this slot (ResponseRouter); updates the model only
+    void routedUpdate(const RoutedUpdate &update) override;
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
 private slots:
     void onDirectionChanged(int group, bool isOutput);
     void onPinToggled(int group, int pin, bool value);
-    void handleDataReceived(const QString &data);
-    
+    void refreshWidgets();
+
 private:
     void setupUI();
-    void requestGroupState(int group);
     void requestAllStates();
+    void applyPortState(quint16 direction, quint16 output, quint16 input);
+    void setPin(int pinNum, bool value);
+    void setGroupDirection(int group, bool isOutput);
+    void scheduleRefresh();
     
     int m_slot;
-    SerialController *m_serial;
+    BurjuvaClient *m_client;
+    ResponseRouter *m_router;
     
     IO16Group *m_groups[4];
     QLabel *m_statusLabel;
+    QTimer *m_refreshTimer;
+    QString m_pendingStatus;    // Shown at the next refresh
     
-    IO16State m_state;
+    IO16State m_state;          // Model; widgets follow it at WidgetRefreshMs
 };
 
 #endif // IO16WIDGET_H
@@ -1,5 +1,7 @@
 #include "mainwindow.h"
 #include "serialcontroller.h"
+#include "burjuvaclient.h"
+#include "responserouter.h"
 #include "moduledetector.h"
 #include "io16widget.h"
 #include "aio20widget.h"
@@ -15,7 +17,9 @@
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , m_serial(new SerialController(this))
-    , m_detector(new ModuleDetector(m_serial, this))
+    , m_client(new BurjuvaClient(m_serial, this))
+    , m_router(new ResponseRouter(m_serial, this))
+    , m_detector(new ModuleDetector(m_serial, m_router, this))
     , m_currentSlot(-1)
 {
     setupUI();
@@ -26,6 +30,8 @@ MainWindow::MainWindow(QWidget *parent)
     // Connect signals
     connect(m_detector, &ModuleDetector::detectionCompleted,
             this, &MainWindow::onDetectionCompleted);
+    connect(m_detector, &ModuleDetector::moduleChanged,
+            this, &MainWindow::onModuleChanged);
     
     connect(m_serial, &SerialController::connected, this, [this]() {
         m_statusLabel->setText("Bağlantı başarılı");
@@ -216,6 +222,32 @@ void MainWindow::onDetectionCompleted(const QList<ModuleInfo> &modules)
     m_statusLabel->setText(QString("Algılama tamamlandı: %1 modül bulundu").arg(modules.size()));
 }
 
+void MainWindow::onModuleChanged(const ModuleInfo &module)
+{
+    m_modules = m_detector->getDetectedModules();
+    
+    // Drop the widget of a module that left the slot, it would poll an empty slot
+    if (module.type != ModuleType::IO16 && m_io16Widgets.contains(module.slot)) {
+        IO16Widget *widget = m_io16Widgets.take(module.slot);
+        m_stackedWidget->removeWidget(widget);
+        widget->deleteLater();
+    }
+    if (module.type != ModuleType::AIO20 && m_aio20Widgets.contains(module.slot)) {
+        AIO20Widget *widget = m_aio20Widgets.take(module.slot);
+        m_stackedWidget->removeWidget(widget);
+        widget->deleteLater();
+    }
+    
+    updateSlotDisplay();
+    
+    if (module.slot == m_currentSlot) {
+        m_currentSlot = -1;
+        switchToModule(module.slot);
+    }
+    
+    m_statusLabel->setText(QString("Slot %1: %2").arg(module.slot).arg(module.name));
+}
+
 void MainWindow::onCycleTimeChanged(int value)
 {
     m_serial->setCycleTime(value);
@@ -260,14 +292,14 @@ void MainWindow::switchToModule(int slot)
     // Create widget if not exists
     if (module.type == ModuleType::IO16) {
         if (!m_io16Widgets.contains(slot)) {
-            IO16Widget *widget = new IO16Widget(slot, m_serial, this);
+            IO16Widget *widget = new IO16Widget(slot, m_client, m_router, this);
             m_io16Widgets[slot] = widget;
             m_stackedWidget->addWidget(widget);
         }
         m_stackedWidget->setCurrentWidget(m_io16Widgets[slot]);
     } else if (module.type == ModuleType::AIO20) {
         if (!m_aio20Widgets.contains(slot)) {
-            AIO20Widget *widget = new AIO20Widget(slot, m_serial, this);
+            AIO20Widget *widget = new AIO20Widget(slot, m_client, m_router, this);
             m_aio20Widgets[slot] = widget;
             m_stackedWidget->addWidget(widget);
         }
@@ -10,6 +10,8 @@
 #include "moduletypes.h"
 
 class SerialController;
+class BurjuvaClient;
+class ResponseRouter;
 class ModuleDetector;
 class IO16Widget;
 class AIO20Widget;
@@ -26,6 +28,7 @@ private slots:
     void onConnectClicked();
     void onDisconnectClicked();
     void onDetectionCompleted(const QList<ModuleInfo> &modules);
+    void onModuleChanged(const ModuleInfo &module);
     void onCycleTimeChanged(int value);
     void onSlotClicked(int slot);
     
@@ -39,6 +42,8 @@ private:
     
     // Serial communication
     SerialController *m_serial;
+    BurjuvaClient *m_client;        // Typed commands for the module widgets
+    ResponseRouter *m_router;       // Decodes replies once, routes by module/slot
     ModuleDetector *m_detector;
     
     // UI components
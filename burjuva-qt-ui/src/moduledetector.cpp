@@ -1,17 +1,23 @@
 #include "moduledetector.h"
 #include "serialcontroller.h"
+#include "responserouter.h"
 #include <QDebug>
-#include <QRegularExpression>
 
-ModuleDetector::ModuleDetector(SerialController *serial, QObject *parent)
+ModuleDetector::ModuleDetector(SerialController *serial, ResponseRouter *router, QObject *parent)
     : QObject(parent)
     , m_serial(serial)
     , m_detectionComplete(false)
 {
-    connect(m_serial, &SerialController::dataReceived,
-            this, &ModuleDetector::handleDataReceived);
     connect(m_serial, &SerialController::commandCompleted,
             this, &ModuleDetector::handleCommandCompleted);
+    
+    // Detection replies, frames and hot-plug events arrive pre-decoded
+    connect(router, &ResponseRouter::detectionReply,
+            this, &ModuleDetector::handleReply);
+    connect(router, &ResponseRouter::detectionFrame,
+            this, &ModuleDetector::handleFrame);
+    connect(router, &ResponseRouter::slotEvent,
+            this, &ModuleDetector::handleSlotEvent);
 }
 
 void ModuleDetector::startDetection()
@@ -24,13 +30,12 @@ void ModuleDetector::startDetection()
     qDebug() << "Starting module detection...";
     
     m_modules.clear();
-    m_currentData.clear();
     m_detectionComplete = false;
     
     emit detectionStarted();
     
-    // Send detection command
-    m_serial->sendCommandWithPriority("modul-algila");
+    // One binary frame with UID/HID/FID/type/init status for all slots
+    m_serial->sendCommandWithPriority("modul-algila:bin");
 }
 
 ModuleInfo ModuleDetector::getModuleAtSlot(int slot) const
@@ -50,20 +55,126 @@ ModuleInfo ModuleDetector::getModuleAtSlot(int slot) const
     return empty;
 }
 
-void ModuleDetector::handleDataReceived(const QString &data)
+void ModuleDetector::handleCommandCompleted(const QString &command)
 {
-    if (!data.startsWith("Slot "))
+    // Machine mode detection is finished by the reply/frame handlers
+    if (m_serial->machineMode())
+        return;
+    
+    if (!command.startsWith(QLatin1String("modul-algila")) || m_detectionComplete)
         return;
     
-    // Parse module line: "Slot X: MODUL_TIPI (UID: XXXXXXXX)"
-    parseModuleData(data);
+    finishDetection();
 }
 
-void ModuleDetector::handleCommandCompleted(const QString &command)
+void ModuleDetector::handleReply(const QString &command, int status, const QString &payload)
 {
-    if (command != "modul-algila")
+    if (!command.startsWith(QLatin1String("modul-algila")) || m_detectionComplete)
         return;
     
+    if (status != SerialController::StatusOk) {
+        // Firmware without the binary report: fall back to the type summary
+        if (command == QLatin1String("modul-algila:bin")) {
+            m_serial->sendCommandWithPriority("modul-algila");
+            return;
+        }
+        m_detectionComplete = true;
+        emit detectionFailed(QString("Modul algilama hatasi (kod %1)").arg(status));
+        return;
+    }
+    
+    if (command == QLatin1String("modul-algila:bin"))
+        return;  // Frame follows, see handleFrame
+    
+    if (command == QLatin1String("modul-algila:rapor"))
+        parseReport(payload);
+    else
+        parseMachineReply(payload);
+    finishDetection();
+}
+
+void ModuleDetector::handleFrame(const QString &command, const QByteArray &frame)
+{
+    if (command != QLatin1String("modul-algila:bin") || m_detectionComplete)
+        return;
+    
+    if (!parseReportFrame(frame)) {
+        m_detectionComplete = true;
+        emit detectionFailed("Modul algilama cercevesi bozuk");
+        return;
+    }
+    finishDetection();
+}
+
+void ModuleDetector::handleSlotEvent(int slot, const QString &kind)
+{
+    // Hot-plug event from the firmware monitor, kind "-" = removed
+    ModuleInfo module = moduleFromKind(slot, kind);
+    
+    // Replace only this slot, the rest of the list stays valid
+    for (int i = 0; i < m_modules.size(); ++i) {
+        if (m_modules.at(i).slot == slot) {
+            m_modules.removeAt(i);
+            break;
+        }
+    }
+    m_modules.append(module);
+    std::sort(m_modules.begin(), m_modules.end(),
+              [](const ModuleInfo &a, const ModuleInfo &b) {
+                  return a.slot < b.slot;
+              });
+    
+    qDebug() << "Slot" << slot << "changed:" << module.name;
+    emit moduleChanged(module);
+}
+
+void ModuleDetector::parseMachineReply(const QString &payload)
+{
+    // Machine mode reply: slot 0-3 types, e.g. "io16,aio20,-,fpga"
+    const QStringList kinds = payload.split(QLatin1Char(','));
+    
+    for (int slot = 0; slot < kinds.size() && slot < 4; ++slot) {
+        const QString &kind = kinds.at(slot);
+        if (kind == QLatin1String("-"))
+            continue;
+        
+        ModuleInfo module = moduleFromKind(slot, kind);
+        m_modules.append(module);
+        emit moduleDetected(module);
+    }
+}
+
+ModuleInfo ModuleDetector::moduleFromKind(int slot, const QString &kind)
+{
+    ModuleInfo module;
+    module.slot = slot;
+    
+    if (kind == QLatin1String("-")) {
+        module.type = ModuleType::None;
+        module.name = "Empty";
+        module.initialized = false;
+        return module;
+    }
+    
+    module.type = parseModuleType(kind);
+    module.initialized = true;
+    
+    switch (module.type) {
+        case ModuleType::IO16:
+            module.name = "IO16 Digital";
+            break;
+        case ModuleType::AIO20:
+            module.name = "AIO20 Analog";
+            break;
+        default:
+            module.name = kind;
+            break;
+    }
+    return module;
+}
+
+void ModuleDetector::finishDetection()
+{
     // Detection completed
     m_detectionComplete = true;
     
@@ -98,52 +209,95 @@ void ModuleDetector::handleCommandCompleted(const QString &command)
     emit detectionCompleted(m_modules);
 }
 
-void ModuleDetector::parseModuleData(const QString &data)
+void ModuleDetector::parseReport(const QString &payload)
 {
-    // Example: "Slot 0: IO16_DIJITAL (UID: 5A3B1C9D)"
-    // Example: "Slot 1: AIO20_ANALOG (UID: 8F2E4A6C)"
-    // Example: "Slot 2: BOS"
-    
-    QRegularExpression slotRegex(R"(Slot\s+(\d+):\s+(\w+)(?:\s+\(UID:\s+([0-9A-F]+)\))?)");
-    QRegularExpressionMatch match = slotRegex.match(data);
+    // "modul-algila:rapor": one record per slot, records separated by '|'
+    // "<slot> <type> <uid> <hid> <fid> <init> <init_us>", empty slot "<slot> 0"
+    const QVector<QStringRef> records = payload.splitRef(QLatin1Char('|'));
     
-    if (!match.hasMatch()) {
-        qWarning() << "Failed to parse module data:" << data;
-        return;
+    for (const QStringRef &record : records) {
+        const QVector<QStringRef> fields = record.split(QLatin1Char(' '));
+        if (fields.size() < 2)
+            continue;
+        
+        ModuleInfo module = moduleFromTypeCode(fields.at(0).toInt(), fields.at(1).toInt());
+        if (module.type == ModuleType::None || fields.size() < 7)
+            continue;
+        
+        module.uid = fields.at(2).toString();
+        module.hid = fields.at(3).toString();
+        module.fid = fields.at(4).toString();
+        module.initStatus = fields.at(5).toInt();
+        module.initTimeUs = fields.at(6).toUInt();
+        module.initialized = (module.initStatus == 0);
+        
+        m_modules.append(module);
+        emit moduleDetected(module);
     }
+}
+
+// Dallas/Maxim CRC8, same as the firmware's 1-Wire ROM check
+static quint8 crc8(const uchar *data, int len)
+{
+    quint8 crc = 0;
+    for (int i = 0; i < len; i++) {
+        quint8 inbyte = data[i];
+        for (int j = 0; j < 8; j++) {
+            quint8 mix = (crc ^ inbyte) & 0x01;
+            crc >>= 1;
+            if (mix)
+                crc ^= 0x8C;
+            inbyte >>= 1;
+        }
+    }
+    return crc;
+}
+
+bool ModuleDetector::parseReportFrame(const QByteArray &frame)
+{
+    // [B5][version][count] + count x 32 byte records + CRC8
+    // Record: slot, type, init_status, init_tries, uid[8], hid[8], fid[8], init_us (LE)
+    static const int RecordSize = 32;
+    const uchar *data = reinterpret_cast<const uchar *>(frame.constData());
     
-    int slot = match.captured(1).toInt();
-    QString typeStr = match.captured(2);
-    QString uid = match.captured(3);
-    
-    ModuleInfo module;
-    module.slot = slot;
-    module.type = parseModuleType(typeStr);
-    module.uid = uid;
-    module.initialized = true;
+    if (frame.size() < 4 || data[0] != 0xB5 || data[1] != 1)
+        return false;
     
-    // Set module name
-    switch (module.type) {
-        case ModuleType::IO16:
-            module.name = "IO16 Digital";
-            break;
-        case ModuleType::AIO20:
-            module.name = "AIO20 Analog";
-            break;
-        case ModuleType::None:
-            module.name = "Empty";
-            break;
-        default:
-            module.name = "Unknown";
-            break;
-    }
+    int count = data[2];
+    if (frame.size() != 3 + count * RecordSize + 1)
+        return false;
+    if (crc8(data, frame.size() - 1) != data[frame.size() - 1])
+        return false;
     
-    // Only add non-empty modules during parsing
-    if (module.type != ModuleType::None) {
+    for (int i = 0; i < count; ++i) {
+        const uchar *r = data + 3 + i * RecordSize;
+        
+        ModuleInfo module = moduleFromTypeCode(r[0], r[1]);
+        if (module.type == ModuleType::None)
+            continue;
+        
+        module.initStatus = static_cast<qint8>(r[2]);
+        module.uid = QByteArray(reinterpret_cast<const char *>(r + 4), 8).toHex().toUpper();
+        module.hid = QByteArray(reinterpret_cast<const char *>(r + 12), 8).toHex().toUpper();
+        module.fid = QByteArray(reinterpret_cast<const char *>(r + 20), 8).toHex().toUpper();
+        module.initTimeUs = quint32(r[28]) | (quint32(r[29]) << 8) |
+                            (quint32(r[30]) << 16) | (quint32(r[31]) << 24);
+        module.initialized = (module.initStatus == 0);
+        
         m_modules.append(module);
-        qDebug() << "Detected module at slot" << slot << ":" << module.name << "UID:" << uid;
         emit moduleDetected(module);
     }
+    return true;
+}
+
+ModuleInfo ModuleDetector::moduleFromTypeCode(int slot, int typeCode)
+{
+    // Firmware Modul_Tip: 0 empty, 1 io16, 2 aio20, 3 fpga, 4 unrecognized
+    static const char *const kinds[] = { "-", "io16", "aio20", "fpga", "?" };
+    
+    ModuleInfo module = moduleFromKind(slot, kinds[(typeCode >= 0 && typeCode <= 4) ? typeCode : 4]);
+    module.typeCode = typeCode;
+    return module;
 }
 
 ModuleType ModuleDetector::parseModuleType(const QString &typeStr)
@@ -6,13 +6,15 @@
 #include "moduletypes.h"
 
 class SerialController;
+class ResponseRouter;
 
 class ModuleDetector : public QObject
 {
     Q_OBJECT
     
 public:
-    explicit ModuleDetector(SerialController *serial, QObject *parent = nullptr);
+    explicit ModuleDetector(SerialController *serial, ResponseRouter *router,
+                            QObject *parent = nullptr);
     
     void startDetection();
     QList<ModuleInfo> getDetectedModules() const { return m_modules; }
@@ -24,19 +26,27 @@ signals:
     void moduleDetected(const ModuleInfo &module);
     void detectionCompleted(const QList<ModuleInfo> &modules);
     void detectionFailed(const QString &error);
+    // Hot-plug: a slot's module was inserted, removed or swapped
+    void moduleChanged(const ModuleInfo &module);
     
 private slots:
-    void handleDataReceived(const QString &data);
     void handleCommandCompleted(const QString &command);
+    void handleReply(const QString &command, int status, const QString &payload);
+    void handleSlotEvent(int slot, const QString &kind);
+    void handleFrame(const QString &command, const QByteArray &frame);
     
 private:
-    void parseModuleData(const QString &data);
+    void parseMachineReply(const QString &payload);
+    void parseReport(const QString &payload);
+    bool parseReportFrame(const QByteArray &frame);
+    ModuleInfo moduleFromKind(int slot, const QString &kind);
+    ModuleInfo moduleFromTypeCode(int slot, int typeCode);
+    void finishDetection();
     ModuleType parseModuleType(const QString &typeStr);
     
     SerialController *m_serial;
     QList<ModuleInfo> m_modules;
     bool m_detectionComplete;
-    QString m_currentData;
 };
 
 #endif // MODULEDETECTOR_H
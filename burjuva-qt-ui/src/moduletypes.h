@@ -18,11 +18,19 @@ struct ModuleInfo {
     ModuleType type;
     QString name;               // "io16", "aio20", etc.
     QString uid;                // 1-Wire UID
+    QString hid;                // EEPROM 0x00-0x07 (hex)
+    QString fid;                // EEPROM 0x08-0x0F (hex)
+    int typeCode;               // Firmware Modul_Tip (0=empty, 1=io16, 2=aio20, 3=fpga, 4=unknown)
+    int initStatus;             // Chip init result, 0 = OK
+    quint32 initTimeUs;         // Chip init duration
     bool initialized;
     
     ModuleInfo() 
         : slot(-1)
         , type(ModuleType::None)
+        , typeCode(0)
+        , initStatus(0)
+        , initTimeUs(0)
         , initialized(false)
     {}
 };
@@ -74,20 +82,44 @@ struct AIO20ChannelState {
     {}
 };
 
+// Model -> widget refresh period (~30 Hz). Module states absorb replies at
+// any rate; only what changed since the last refresh is pushed to widgets.
+constexpr int WidgetRefreshMs = 33;
+
 // Module state container
 struct IO16State {
     int slot;
     IO16GroupState groups[4];   // 4 groups
+    quint16 dirtyPins;          // Pin value/ack changed (bit = pin 0-15)
+    quint8 dirtyGroups;         // Group direction changed (bit = group 0-3)
     
-    IO16State() : slot(-1) {}
+    IO16State()
+        : slot(-1)
+        , dirtyPins(0)
+        , dirtyGroups(0)
+    {}
 };
 
 struct AIO20State {
     int slot;
     AIO20ChannelState inputs[12];   // AI0-AI11
     AIO20ChannelState outputs[8];   // AO0-AO7
+    quint32 dirtyChannels;          // Value/ack/mode changed (bit = channel 0-19)
     
-    AIO20State() : slot(-1) {}
+    AIO20State()
+        : slot(-1)
+        , dirtyChannels(0)
+    {}
+    
+    // Channel 0-19 across inputs and outputs, nullptr if out of range
+    AIO20ChannelState *channel(int ch)
+    {
+        if (ch >= 0 && ch < 12)
+            return &inputs[ch];
+        if (ch >= 12 && ch < 20)
+            return &outputs[ch - 12];
+        return nullptr;
+    }
 };
 
 // Utility functions
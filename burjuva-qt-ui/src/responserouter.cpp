@@ -0,0 +1,235 @@
+#include "responserouter.h"
+#include "serialcontroller.h"
+#include <QDebug>
+#include <QTimer>
+#include <QSet>
+
+ResponseRouter::ResponseRouter(SerialController *serial, QObject *parent)
+    : QObject(parent)
+    , m_serial(serial)
+    , m_displayTimer(new QTimer(this))
+{
+    for (int kind = 0; kind < KindCount; ++kind) {
+        for (int slot = 0; slot < SlotCount; ++slot) {
+            m_routes[kind][slot] = nullptr;
+        }
+    }
+    
+    connect(serial, &SerialController::replyReceived,
+            this, &ResponseRouter::handleReply);
+    connect(serial, &SerialController::eventReceived,
+            this, &ResponseRouter::handleEvent);
+    connect(serial, &SerialController::frameReceived,
+            this, &ResponseRouter::handleFrame);
+    
+    connect(m_displayTimer, &QTimer::timeout,
+            this, &ResponseRouter::handleDisplayTick);
+    m_displayTimer->start(DisplayIntervalMs);
+}
+
+void ResponseRouter::registerTarget(ModuleKind kind, int slot, RouteTarget *target)
+{
+    if (slot < 0 || slot >= SlotCount)
+        return;
+    
+    m_routes[kind][slot] = target;
+}
+
+void ResponseRouter::unregisterTarget(ModuleKind kind, int slot, RouteTarget *target)
+{
+    if (slot < 0 || slot >= SlotCount)
+        return;
+    
+    // A newer widget may already own the slot
+    if (m_routes[kind][slot] == target)
+        m_routes[kind][slot] = nullptr;
+}
+
+void ResponseRouter::handleReply(const QString &command, int status, const QString &payload)
+{
+    // Module replies never get here, they come through the update queue
+    if (command.startsWith(QLatin1String("modul-algila")))
+        emit detectionReply(command, status, payload);
+}
+
+bool ResponseRouter::decodeReply(const QString &command, int status, const QString &payload,
+                                 RoutedUpdate &update)
+{
+    // "<module>:<slot>:<verb>[:<args>...]"
+    const QVector<QStringRef> parts = command.splitRef(QLatin1Char(':'));
+    if (parts.size() < 3)
+        return false;
+    
+    const QStringRef module = parts.at(0);
+    if (module == QLatin1String("io16"))
+        update.module = KindIO16;
+    else if (module == QLatin1String("aio20"))
+        update.module = KindAIO20;
+    else if (module == QLatin1String("fpga"))
+        update.module = KindFPGA;
+    else
+        return false;
+    
+    bool ok = false;
+    update.slot = parts.at(1).toInt(&ok);
+    if (!ok || update.slot < 0 || update.slot >= SlotCount)
+        return false;
+    
+    update.status = status;
+    update.command = command;
+    
+    if (status != SerialController::StatusOk) {
+        update.kind = RoutedUpdate::Error;
+        return true;
+    }
+    
+    if (update.module == KindIO16)
+        return decodeIO16(update, parts, payload);
+    if (update.module == KindAIO20)
+        return decodeAIO20(update, parts, payload);
+    return false;
+}
+
+bool ResponseRouter::decodeIO16(RoutedUpdate &update, const QVector<QStringRef> &parts,
+                                const QString &payload)
+{
+    const QStringRef verb = parts.at(2);
+    
+    if (verb == QLatin1String("set") && parts.size() >= 5) {
+        // io16:S:set:PIN:high|low -> OK
+        update.kind = RoutedUpdate::PinValue;
+        update.channel = parts.at(3).toInt();
+        update.value = parts.at(4).startsWith(QLatin1String("high")) ? 1 : 0;
+    } else if (verb == QLatin1String("get") && parts.size() >= 4) {
+        // io16:S:get:PIN -> "0" / "1"
+        update.kind = RoutedUpdate::PinValue;
+        update.channel = parts.at(3).toInt();
+        update.value = (payload == QLatin1String("1")) ? 1 : 0;
+    } else if (verb == QLatin1String("dirgroup") && parts.size() >= 5) {
+        // io16:S:dirgroup:GROUP:in|out -> OK
+        update.kind = RoutedUpdate::GroupDirection;
+        update.channel = parts.at(3).toInt();
+        update.value = parts.at(4).startsWith(QLatin1String("out")) ? 1 : 0;
+    } else if (verb == QLatin1String("status")) {
+        // "<dir> <out> <in>" hex words
+        const QVector<QStringRef> words = payload.splitRef(QLatin1Char(' '));
+        if (words.size() < 3)
+            return false;
+        update.kind = RoutedUpdate::PortState;
+        update.direction = words.at(0).toUShort(nullptr, 16);
+        update.output = words.at(1).toUShort(nullptr, 16);
+        update.input = words.at(2).toUShort(nullptr, 16);
+    } else if (verb == QLatin1String("readall")) {
+        update.kind = RoutedUpdate::InputWord;
+        update.input = payload.toUShort(nullptr, 16);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool ResponseRouter::decodeAIO20(RoutedUpdate &update, const QVector<QStringRef> &parts,
+                                 const QString &payload)
+{
+    const QStringRef verb = parts.at(2);
+    
+    if (verb == QLatin1String("read") && parts.size() >= 4) {
+        // aio20:S:read:PORT -> raw
+        update.kind = RoutedUpdate::ChannelRaw;
+        update.channel = parts.at(3).toInt();
+        update.value = payload.toInt();
+    } else if (verb == QLatin1String("readall")) {
+        // "v0,v1,...,v19"
+        const QVector<QStringRef> raw = payload.splitRef(QLatin1Char(','));
+        update.kind = RoutedUpdate::ChannelBlock;
+        update.values.reserve(raw.size());
+        for (const QStringRef &value : raw) {
+            update.values.append(value.toInt());
+        }
+    } else if (verb == QLatin1String("setvolt") && parts.size() >= 5) {
+        // aio20:S:setvolt:PORT:MV -> OK
+        update.kind = RoutedUpdate::ChannelVoltage;
+        update.channel = parts.at(3).toInt();
+        update.value = parts.at(4).toInt();
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool ResponseRouter::isSnapshot(const RoutedUpdate &update)
+{
+    // Kinds that carry a slot's whole state; a newer one supersedes an older
+    return update.kind == RoutedUpdate::PortState ||
+           update.kind == RoutedUpdate::InputWord ||
+           update.kind == RoutedUpdate::ChannelBlock;
+}
+
+void ResponseRouter::handleDisplayTick()
+{
+    drainUpdates();
+}
+
+int ResponseRouter::drainUpdates()
+{
+    RoutedUpdate update;
+    while (m_serial->takeUpdate(update)) {
+        m_batch.append(update);
+    }
+    
+    const int count = m_batch.size();
+    if (count == 0)
+        return 0;
+    
+    // Coalesce: of several snapshots of one kind for one slot in this frame
+    // only the last is delivered; single-channel updates all go through
+    QVector<bool> superseded(count, false);
+    QSet<int> seen;
+    for (int i = count - 1; i >= 0; --i) {
+        const RoutedUpdate &u = m_batch.at(i);
+        if (!isSnapshot(u))
+            continue;
+        int key = (u.kind * KindCount + u.module) * SlotCount + u.slot;
+        if (seen.contains(key))
+            superseded[i] = true;
+        else
+            seen.insert(key);
+    }
+    
+    for (int i = 0; i < count; ++i) {
+        if (!superseded.at(i))
+            dispatch(m_batch.at(i));
+    }
+    
+    m_batch.clear();
+    return count;
+}
+
+void ResponseRouter::dispatch(const RoutedUpdate &update)
+{
+    // No widget for this slot: dropped
+    RouteTarget *target = m_routes[update.module][update.slot];
+    if (target)
+        target->routedUpdate(update);
+}
+
+void ResponseRouter::handleEvent(const QString &event)
+{
+    // "slot:<n>:<kind>"
+    const QVector<QStringRef> parts = event.splitRef(QLatin1Char(':'));
+    if (parts.size() != 3 || parts.at(0) != QLatin1String("slot"))
+        return;
+    
+    bool ok = false;
+    int slot = parts.at(1).toInt(&ok);
+    if (!ok || slot < 0 || slot >= SlotCount)
+        return;
+    
+    emit slotEvent(slot, parts.at(2).toString());
+}
+
+void ResponseRouter::handleFrame(const QString &command, const QByteArray &frame)
+{
+    if (command.startsWith(QLatin1String("modul-algila")))
+        emit detectionFrame(command, frame);
+}
@@ -0,0 +1,118 @@
+#ifndef RESPONSEROUTER_H
+#define RESPONSEROUTER_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+class SerialController;
+class QTimer;
+
+// Decoded firmware reply, addressed to one module slot
+struct RoutedUpdate {
+    enum Kind {
+        PinValue,           // IO16: channel = pin, value = 0/1
+        GroupDirection,     // IO16: channel = group, value = 1 output / 0 input
+        PortState,          // IO16: direction/output/input words (status)
+        InputWord,          // IO16: input word only (readall)
+        ChannelRaw,         // AIO20: channel = port, value = 12-bit raw
+        ChannelBlock,       // AIO20: values = raw of ports 0..n-1 (readall)
+        ChannelVoltage,     // AIO20: channel = port, value = written mV (setvolt)
+        Error               // Any module: status != OK, command = failed command
+    };
+    
+    Kind kind;
+    int module;             // ResponseRouter::ModuleKind
+    int slot;
+    int channel;
+    int value;
+    quint16 direction;
+    quint16 output;
+    quint16 input;
+    int status;
+    QVector<int> values;
+    QString command;
+    
+    RoutedUpdate()
+        : kind(Error)
+        , module(-1)
+        , slot(-1)
+        , channel(-1)
+        , value(0)
+        , direction(0)
+        , output(0)
+        , input(0)
+        , status(0)
+    {}
+};
+
+// Receiver of routed updates (module widgets)
+class RouteTarget
+{
+public:
+    virtual ~RouteTarget() {}
+    virtual void routedUpdate(const RoutedUpdate &update) = 0;
+};
+
+// Single protocol decoder: every machine reply is parsed once, on the
+// serial worker thread (decodeReply), and handed on the GUI thread to the
+// one target registered for its module kind and slot. Updates are drained
+// from SerialController's queue once per display frame, not per line.
+class ResponseRouter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum ModuleKind {
+        KindIO16 = 0,
+        KindAIO20,
+        KindFPGA,
+        KindCount
+    };
+    
+    static constexpr int SlotCount = 4;
+    
+    // Update delivery rate; faster than the screen is wasted work
+    static constexpr int DisplayIntervalMs = 16;
+    
+    explicit ResponseRouter(SerialController *serial, QObject *parent = nullptr);
+    
+    void registerTarget(ModuleKind kind, int slot, RouteTarget *target);
+    void unregisterTarget(ModuleKind kind, int slot, RouteTarget *target);
+    
+    // Decode a module reply (io16/aio20/fpga) into update; false for other
+    // commands and for replies that carry no state. Thread-safe.
+    static bool decodeReply(const QString &command, int status, const QString &payload,
+                            RoutedUpdate &update);
+    
+    // Deliver every queued update now; returns the number taken
+    int drainUpdates();
+
+signals:
+    // Module detection traffic (modul-algila*, hot-plug events)
+    void detectionReply(const QString &command, int status, const QString &payload);
+    void detectionFrame(const QString &command, const QByteArray &frame);
+    void slotEvent(int slot, const QString &kind);
+
+private slots:
+    void handleReply(const QString &command, int status, const QString &payload);
+    void handleDisplayTick();
+    void handleEvent(const QString &event);
+    void handleFrame(const QString &command, const QByteArray &frame);
+
+private:
+    // Fill update from command + payload, false if the reply carries no state
+    static bool decodeIO16(RoutedUpdate &update, const QVector<QStringRef> &parts,
+                           const QString &payload);
+    static bool decodeAIO20(RoutedUpdate &update, const QVector<QStringRef> &parts,
+                            const QString &payload);
+    static bool isSnapshot(const RoutedUpdate &update);
+    void dispatch(const RoutedUpdate &update);
+    
+    SerialController *m_serial;
+    QTimer *m_displayTimer;
+    QVector<RoutedUpdate> m_batch;
+    RouteTarget *m_routes[KindCount][SlotCount];
+};
+
+#endif // RESPONSEROUTER_H
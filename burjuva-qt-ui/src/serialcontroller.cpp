@@ -1,100 +1,119 @@
 #include "serialcontroller.h"
+#include "serialworker.h"
+#include "transport.h"
 #include <QDebug>
-#include <QDateTime>
 
 SerialController::SerialController(QObject *parent)
     : QObject(parent)
-    , m_serial(new QSerialPort(this))
-    , m_queueTimer(new QTimer(this))
+    , m_updates(UpdateQueueSize)
+    , m_worker(new SerialWorker(&m_updates))
+    , m_connected(false)
     , m_cycleTime(100)  // Default 100ms cycle time
-    , m_waitingForResponse(false)
+    , m_batchingEnabled(true)
+    , m_machineMode(false)
 {
-    connect(m_serial, &QSerialPort::readyRead,
-            this, &SerialController::handleReadyRead);
-    connect(m_serial, &QSerialPort::errorOccurred,
-            this, &SerialController::handleError);
-    
-    connect(m_queueTimer, &QTimer::timeout,
-            this, &SerialController::processCommandQueue);
+    // Port, timers and parsing run on the worker thread; painting can no
+    // longer stall the serial link
+    m_thread.setObjectName("burjuva-serial");
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    
+    // Worker signals arrive queued on the GUI thread
+    connect(m_worker, &SerialWorker::connected, this, &SerialController::connected);
+    connect(m_worker, &SerialWorker::disconnected, this, [this]() {
+        m_connected = false;
+        m_machineMode = false;
+        emit disconnected();
+    });
+    connect(m_worker, &SerialWorker::dataReceived, this, &SerialController::dataReceived);
+    connect(m_worker, &SerialWorker::ackReceived, this, &SerialController::ackReceived);
+    connect(m_worker, &SerialWorker::errorOccurred, this, &SerialController::errorOccurred);
+    connect(m_worker, &SerialWorker::commandCompleted, this, &SerialController::commandCompleted);
+    connect(m_worker, &SerialWorker::replyReceived, this, &SerialController::replyReceived);
+    connect(m_worker, &SerialWorker::eventReceived, this, &SerialController::eventReceived);
+    connect(m_worker, &SerialWorker::frameReceived, this, &SerialController::frameReceived);
+    connect(m_worker, &SerialWorker::requestCompleted, this, &SerialController::requestCompleted);
+    
+    m_thread.start();
 }
 
 SerialController::~SerialController()
 {
     disconnectFromPort();
+    m_thread.quit();
+    m_thread.wait();
 }
 
 bool SerialController::connectToPort(const QString &portName, qint32 baudRate)
 {
-    if (m_serial->isOpen())
-        disconnectFromPort();
-    
-    m_serial->setPortName(portName);
-    m_serial->setBaudRate(baudRate);
-    m_serial->setDataBits(QSerialPort::Data8);
-    m_serial->setParity(QSerialPort::NoParity);
-    m_serial->setStopBits(QSerialPort::OneStop);
-    m_serial->setFlowControl(QSerialPort::NoFlowControl);
-    
-    if (m_serial->open(QIODevice::ReadWrite)) {
-        qDebug() << "Connected to" << portName << "at" << baudRate << "baud";
-        
-        // Start command queue processing
-        m_queueTimer->start(m_cycleTime);
-        
-        emit connected();
-        return true;
+    return connectToTransport(new SerialTransport(portName, baudRate));
+}
+
+bool SerialController::connectToTransport(Transport *transport)
+{
+    const QString name = transport->name();
+    transport->moveToThread(&m_thread);
+    
+    bool ok = false;
+    QMetaObject::invokeMethod(m_worker, [&]() {
+        ok = m_worker->openTransport(transport);
+    }, Qt::BlockingQueuedConnection);
+    
+    m_connected = ok;
+    if (ok) {
+        m_portName = name;
+        m_machineMode = true;
     }
-    
-    QString error = m_serial->errorString();
-    qWarning() << "Failed to connect:" << error;
-    emit errorOccurred(error);
-    return false;
+    return ok;
 }
 
 void SerialController::disconnectFromPort()
 {
-    if (m_serial->isOpen()) {
-        m_queueTimer->stop();
-        m_commandQueue.clear();
-        m_serial->close();
-        qDebug() << "Disconnected from serial port";
-        emit disconnected();
-    }
+    if (!m_connected)
+        return;
+    
+    QMetaObject::invokeMethod(m_worker, [this]() {
+        m_worker->closePort();
+    }, Qt::BlockingQueuedConnection);
+    
+    m_connected = false;
+    m_machineMode = false;
 }
 
 bool SerialController::isConnected() const
 {
-    return m_serial->isOpen();
+    return m_connected;
 }
 
 QString SerialController::portName() const
 {
-    return m_serial->portName();
+    return m_portName;
 }
 
-void SerialController::sendCommand(const QString &command)
+void SerialController::sendCommand(const QString &command, quint32 requestId)
 {
-    if (!m_serial->isOpen())
+    if (!m_connected) {
+        if (requestId)
+            emit requestCompleted(requestId, StatusNoReply, QString());
         return;
+    }
     
-    // Add to queue
-    m_commandQueue.enqueue(command);
+    QMetaObject::invokeMethod(m_worker, [this, command, requestId]() {
+        m_worker->sendCommand(command, requestId);
+    }, Qt::QueuedConnection);
 }
 
-void SerialController::sendCommandWithPriority(const QString &command)
+void SerialController::sendCommandWithPriority(const QString &command, quint32 requestId)
 {
-    if (!m_serial->isOpen())
+    if (!m_connected) {
+        if (requestId)
+            emit requestCompleted(requestId, StatusNoReply, QString());
         return;
+    }
     
-    // Send immediately (bypass queue)
-    QString cmd = command + "\r\n";
-    m_serial->write(cmd.toUtf8());
-    m_serial->flush();
-    
-    m_lastCommand = command;
-    m_waitingForResponse = true;
-    
-    qDebug() << "TX [PRIORITY]:" << command;
+    QMetaObject::invokeMethod(m_worker, [this, command, requestId]() {
+        m_worker->sendCommandWithPriority(command, requestId);
+    }, Qt::QueuedConnection);
 }
 
 void SerialController::setCycleTime(int milliseconds)
@@ -104,83 +123,38 @@ void SerialController::setCycleTime(int milliseconds)
     
     m_cycleTime = milliseconds;
     
-    if (m_queueTimer->isActive()) {
-        m_queueTimer->setInterval(milliseconds);
-    }
-    
-    qDebug() << "Cycle time set to" << milliseconds << "ms";
+    QMetaObject::invokeMethod(m_worker, [this, milliseconds]() {
+        m_worker->setCycleTime(milliseconds);
+    }, Qt::QueuedConnection);
 }
 
-void SerialController::processCommandQueue()
+void SerialController::setBatchingEnabled(bool enabled)
 {
-    // Don't process if waiting for response
-    if (m_waitingForResponse)
-        return;
-    
-    // Check if queue has commands
-    if (m_commandQueue.isEmpty())
-        return;
-    
-    // Get next command
-    QString command = m_commandQueue.dequeue();
-    
-    // Send command
-    QString cmd = command + "\r\n";
-    m_serial->write(cmd.toUtf8());
-    m_serial->flush();
+    m_batchingEnabled = enabled;
     
-    m_lastCommand = command;
-    m_waitingForResponse = true;
-    
-    qDebug() << "TX:" << command;
+    QMetaObject::invokeMethod(m_worker, [this, enabled]() {
+        m_worker->setBatchingEnabled(enabled);
+    }, Qt::QueuedConnection);
 }
 
-void SerialController::handleReadyRead()
+void SerialController::setUpdatesEnabled(bool enabled)
 {
-    m_buffer.append(m_serial->readAll());
-    
-    // Process complete lines
-    while (m_buffer.contains('\n')) {
-        int idx = m_buffer.indexOf('\n');
-        QByteArray line = m_buffer.left(idx);
-        m_buffer.remove(0, idx + 1);
-        
-        QString data = QString::fromUtf8(line).trimmed();
-        
-        if (data.isEmpty())
-            continue;
-        
-        qDebug() << "RX:" << data;
-        
-        // Check for ACK
-        if (data.startsWith("[ACK]")) {
-            emit ackReceived(data);
-        }
-        
-        // Check for command completion
-        if (data.contains("Komut tamamlandi:")) {
-            m_waitingForResponse = false;
-            emit commandCompleted(m_lastCommand);
-        }
-        
-        // Emit all received data
-        emit dataReceived(data);
-    }
+    QMetaObject::invokeMethod(m_worker, [this, enabled]() {
+        m_worker->setUpdatesEnabled(enabled);
+    }, Qt::QueuedConnection);
 }
 
-void SerialController::handleError(QSerialPort::SerialPortError error)
+quint64 SerialController::updatesDropped() const
 {
-    if (error == QSerialPort::NoError)
-        return;
-    
-    QString errorString = m_serial->errorString();
-    qWarning() << "Serial error:" << errorString;
-    
-    emit errorOccurred(errorString);
-    
-    // Disconnect on critical errors
-    if (error == QSerialPort::ResourceError ||
-        error == QSerialPort::PermissionError) {
-        disconnectFromPort();
-    }
+    return m_worker->updatesDropped();
+}
+
+quint64 SerialController::bytesWritten() const
+{
+    return m_worker->bytesWritten();
+}
+
+quint64 SerialController::bytesRead() const
+{
+    return m_worker->bytesRead();
 }
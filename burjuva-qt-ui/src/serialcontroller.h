@@ -2,10 +2,18 @@
 #define SERIALCONTROLLER_H
 
 #include <QObject>
-#include <QSerialPort>
-#include <QTimer>
-#include <QQueue>
+#include <QThread>
+#include "responserouter.h"
+#include "spscqueue.h"
 
+class SerialWorker;
+class Transport;
+
+// GUI-thread handle of the serial link. Port I/O, line framing, reply
+// decoding and the command queue run in a SerialWorker on a dedicated
+// thread; decoded module replies come back through a lock-free
+// single-producer/single-consumer queue (takeUpdate), everything else
+// through queued signals.
 class SerialController : public QObject
 {
     Q_OBJECT
@@ -16,39 +24,92 @@ public:
     
     // Connection
     bool connectToPort(const QString &portName, qint32 baudRate = 115200);
+    // Any other link (pty, socket, pipe); takes ownership, transport must
+    // have no parent
+    bool connectToTransport(Transport *transport);
     void disconnectFromPort();
     bool isConnected() const;
     QString portName() const;
     
-    // Command sending
-    void sendCommand(const QString &command);
-    void sendCommandWithPriority(const QString &command); // Skip queue
+    // Command sending. A non-zero requestId is answered with
+    // requestCompleted once the command's own result is known.
+    void sendCommand(const QString &command, quint32 requestId = 0);
+    void sendCommandWithPriority(const QString &command, quint32 requestId = 0); // Skip queue
     
     // Cycle time control
     void setCycleTime(int milliseconds);
     int cycleTime() const { return m_cycleTime; }
     
+    // Batching: queued commands are joined with ';' into one line
+    void setBatchingEnabled(bool enabled);
+    bool batchingEnabled() const { return m_batchingEnabled; }
+    
+    // Firmware command buffer is 256 bytes; keep a margin for CR/LF
+    static constexpr int MaxBatchLength = 240;
+    
+    // Machine mode: no echo/prose, one "=<status> <payload>" line per command
+    // Enabled automatically on connect
+    bool machineMode() const { return m_machineMode; }
+    
+    // Headless use without a ResponseRouter: don't fill the update queue
+    void setUpdatesEnabled(bool enabled);
+    
+    // Consumer side of the update queue (GUI thread, ResponseRouter)
+    bool takeUpdate(RoutedUpdate &update) { return m_updates.pop(update); }
+    
+    // Updates lost because the consumer fell behind
+    quint64 updatesDropped() const;
+    
+    // Link traffic since construction, any thread
+    quint64 bytesWritten() const;
+    quint64 bytesRead() const;
+    
+    // Worker object, for tools that replay recorded traffic into it
+    SerialWorker *worker() const { return m_worker; }
+    
+    // Decoded updates the GUI may fall behind by before they are dropped
+    static constexpr int UpdateQueueSize = 4096;
+    
+    // Status codes of machine mode replies (firmware uart_helper.h)
+    enum ReplyStatus {
+        StatusOk = 0,
+        StatusSyntax = 1,
+        StatusBadArgument = 2,
+        StatusNoModule = 3,
+        StatusHardware = 4,
+        StatusOverflow = 5,
+        StatusNoReply = -1      // Host side: timeout or link closed
+    };
+    
 signals:
     void connected();
     void disconnected();
+    // Human mode lines and events; machine replies are not repeated here
     void dataReceived(const QString &data);
     void ackReceived(const QString &ack);
     void errorOccurred(const QString &error);
     void commandCompleted(const QString &command);
-    
-private slots:
-    void handleReadyRead();
-    void handleError(QSerialPort::SerialPortError error);
-    void processCommandQueue();
+    // One per command of a ';' batch whose reply is not a module update
+    // (detection, mode switches, ...); module replies go to takeUpdate
+    void replyReceived(const QString &command, int status, const QString &payload);
+    // Unsolicited firmware event ("!<event>" line), e.g. "slot:2:io16"
+    void eventReceived(const QString &event);
+    // Binary payload announced by a "=0 bin <n>" reply (e.g. modul-algila:bin)
+    void frameReceived(const QString &command, const QByteArray &frame);
+    // Result of a command sent with a request id
+    void requestCompleted(quint32 requestId, int status, const QString &payload);
     
 private:
-    QSerialPort *m_serial;
-    QByteArray m_buffer;
-    QTimer *m_queueTimer;
-    QQueue<QString> m_commandQueue;
-    QString m_lastCommand;
+    QThread m_thread;
+    SpscQueue<RoutedUpdate> m_updates;
+    SerialWorker *m_worker;
+    
+    // GUI-side copies of worker state
+    bool m_connected;
+    QString m_portName;
     int m_cycleTime;
-    bool m_waitingForResponse;
+    bool m_batchingEnabled;
+    bool m_machineMode;
 };
 
 #endif // SERIALCONTROLLER_H
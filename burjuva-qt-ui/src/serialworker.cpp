@@ -0,0 +1,440 @@
+#include "serialworker.h"
+#include "serialcontroller.h"
+#include "transport.h"
+#include <QDebug>
+#include <QLoggingCategory>
+#include <QThread>
+#include <cstring>
+
+// Per-line RX/TX trace, off by default:
+// QT_LOGGING_RULES="burjuva.serial.debug=true"
+Q_LOGGING_CATEGORY(lcSerial, "burjuva.serial", QtInfoMsg)
+
+// Drop a command that never completes (e.g. firmware without machine mode)
+static const int ResponseTimeoutMs = 3000;
+
+SerialWorker::SerialWorker(SpscQueue<RoutedUpdate> *updates, QObject *parent)
+    : QObject(parent)
+    , m_updates(updates)
+    , m_transport(nullptr)
+    , m_queueTimer(new QTimer(this))
+    , m_responseTimer(new QTimer(this))
+    , m_cycleTime(100)  // Default 100ms cycle time
+    , m_waitingForResponse(false)
+    , m_batchingEnabled(true)
+    , m_machineMode(false)
+    , m_backpressure(false)
+    , m_updatesEnabled(true)
+    , m_frameRemaining(0)
+    , m_linesProcessed(0)
+    , m_updatesDropped(0)
+    , m_bytesWritten(0)
+    , m_bytesRead(0)
+{
+    connect(m_queueTimer, &QTimer::timeout,
+            this, &SerialWorker::processCommandQueue);
+    
+    m_responseTimer->setSingleShot(true);
+    m_responseTimer->setInterval(ResponseTimeoutMs);
+    connect(m_responseTimer, &QTimer::timeout,
+            this, &SerialWorker::handleResponseTimeout);
+    
+    QString recordFile = qEnvironmentVariable("BURJUVA_SERIAL_RECORD");
+    if (!recordFile.isEmpty())
+        startRecording(recordFile);
+}
+
+SerialWorker::~SerialWorker()
+{
+    closePort();
+}
+
+bool SerialWorker::openTransport(Transport *transport)
+{
+    if (m_transport)
+        closePort();
+    
+    transport->setParent(this);
+    if (!transport->open()) {
+        QString error = transport->errorString();
+        qWarning() << "Failed to connect:" << error;
+        delete transport;
+        emit errorOccurred(error);
+        return false;
+    }
+    
+    m_transport = transport;
+    connect(m_transport, &Transport::readyRead,
+            this, &SerialWorker::handleReadyRead);
+    connect(m_transport, &Transport::errorOccurred,
+            this, &SerialWorker::handleError);
+    
+    qDebug() << "Connected to" << m_transport->name();
+    
+    // Switch firmware to machine mode: no echo, no prose, terse replies
+    m_machineMode = true;
+    sendCommandWithPriority("mode:machine");
+    
+    // Start command queue processing
+    m_queueTimer->start(m_cycleTime);
+    
+    emit connected();
+    return true;
+}
+
+void SerialWorker::closePort()
+{
+    if (!m_transport)
+        return;
+    
+    m_queueTimer->stop();
+    m_responseTimer->stop();
+    failRequests(true);
+    
+    // Leave the shell usable for a terminal
+    if (m_machineMode) {
+        m_transport->write("mode:human\r\n");
+        m_transport->waitForWritten(100);
+    }
+    
+    // May be running inside one of the transport's own signals
+    m_transport->disconnect(this);
+    m_transport->close();
+    m_transport->deleteLater();
+    m_transport = nullptr;
+    
+    m_buffer.clear();
+    m_frameRemaining = 0;
+    m_waitingForResponse = false;
+    m_machineMode = false;
+    qDebug() << "Disconnected from serial port";
+    emit disconnected();
+}
+
+void SerialWorker::sendCommand(const QString &command, quint32 requestId)
+{
+    if (!m_transport) {
+        if (requestId)
+            emit requestCompleted(requestId, SerialController::StatusNoReply, QString());
+        return;
+    }
+    
+    // Add to queue
+    m_commandQueue.enqueue({command, requestId});
+}
+
+void SerialWorker::sendCommandWithPriority(const QString &command, quint32 requestId)
+{
+    if (!m_transport) {
+        if (requestId)
+            emit requestCompleted(requestId, SerialController::StatusNoReply, QString());
+        return;
+    }
+    
+    // The firmware has no RX FIFO: never write while it is still answering,
+    // put the command at the head of the queue instead
+    if (m_waitingForResponse) {
+        m_commandQueue.prepend({command, requestId});
+        return;
+    }
+    
+    // Send immediately (bypass queue)
+    m_lastIds = {requestId};
+    writeLine(command);
+    
+    qCDebug(lcSerial) << "TX [PRIORITY]:" << command;
+}
+
+void SerialWorker::setCycleTime(int milliseconds)
+{
+    m_cycleTime = milliseconds;
+    
+    if (m_queueTimer->isActive()) {
+        m_queueTimer->setInterval(milliseconds);
+    }
+    
+    qDebug() << "Cycle time set to" << milliseconds << "ms";
+}
+
+void SerialWorker::processCommandQueue()
+{
+    // Don't process if waiting for response
+    if (m_waitingForResponse)
+        return;
+    
+    // Check if queue has commands
+    if (m_commandQueue.isEmpty())
+        return;
+    
+    // Get next command
+    PendingCommand next = m_commandQueue.dequeue();
+    QString command = next.command;
+    m_lastIds = {next.requestId};
+    
+    // Join following commands into one ';' separated line so the
+    // firmware answers the whole batch with a single ACK/completion.
+    // Commands with a binary reply must go alone.
+    if (m_batchingEnabled && !isBinaryCommand(command)) {
+        while (!m_commandQueue.isEmpty() && !isBinaryCommand(m_commandQueue.head().command) &&
+               command.size() + 1 + m_commandQueue.head().command.size() <= SerialController::MaxBatchLength) {
+            next = m_commandQueue.dequeue();
+            command += QLatin1Char(';');
+            command += next.command;
+            m_lastIds.append(next.requestId);
+        }
+    }
+    
+    // Send command
+    writeLine(command);
+    
+    qCDebug(lcSerial) << "TX:" << command;
+}
+
+bool SerialWorker::isBinaryCommand(const QString &command)
+{
+    return command.endsWith(QLatin1String(":bin"));
+}
+
+void SerialWorker::writeLine(const QString &command)
+{
+    QByteArray line = command.toUtf8();
+    if (m_record.isOpen())
+        m_record.write("> " + line + '\n');
+    
+    line += "\r\n";
+    m_transport->write(line);
+    m_bytesWritten.fetch_add(line.size(), std::memory_order_relaxed);
+    
+    m_lastCommand = command;
+    m_waitingForResponse = true;
+    m_responseTimer->start();
+}
+
+bool SerialWorker::startRecording(const QString &fileName)
+{
+    m_record.close();
+    m_record.setFileName(fileName);
+    if (!m_record.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Cannot record serial traffic to" << fileName;
+        return false;
+    }
+    
+    qDebug() << "Recording serial traffic to" << fileName;
+    return true;
+}
+
+void SerialWorker::replayCommand(const QString &command)
+{
+    m_lastCommand = command;
+    m_lastIds.clear();
+    m_waitingForResponse = true;
+}
+
+void SerialWorker::handleResponseTimeout()
+{
+    if (!m_waitingForResponse)
+        return;
+    
+    qWarning() << "No response for" << m_lastCommand;
+    m_waitingForResponse = false;
+    m_frameRemaining = 0;
+    failRequests(false);
+    emit errorOccurred(QString("Yanıt zaman aşımı: %1").arg(m_lastCommand));
+}
+
+void SerialWorker::completeCommand()
+{
+    m_waitingForResponse = false;
+    m_responseTimer->stop();
+    m_lastIds.clear();
+    emit commandCompleted(m_lastCommand);
+}
+
+void SerialWorker::failRequests(bool includeQueued)
+{
+    // Callers waiting on a reply that will never come
+    for (quint32 id : qAsConst(m_lastIds)) {
+        if (id)
+            emit requestCompleted(id, SerialController::StatusNoReply, QString());
+    }
+    m_lastIds.clear();
+    
+    if (!includeQueued)
+        return;
+    
+    for (const PendingCommand &pending : qAsConst(m_commandQueue)) {
+        if (pending.requestId)
+            emit requestCompleted(pending.requestId, SerialController::StatusNoReply, QString());
+    }
+    m_commandQueue.clear();
+}
+
+void SerialWorker::handleReadyRead()
+{
+    QByteArray bytes = m_transport->readAll();
+    m_bytesRead.fetch_add(bytes.size(), std::memory_order_relaxed);
+    
+    if (m_record.isOpen()) {
+        m_record.write("< " + QByteArray::number(bytes.size()) + '\n');
+        m_record.write(bytes);
+    }
+    
+    feed(bytes);
+}
+
+void SerialWorker::feed(const QByteArray &bytes)
+{
+    m_buffer.append(bytes);
+    
+    // Walk the buffer by offset; consumed bytes are dropped once per chunk
+    // instead of shifting the buffer after every line
+    const char *data = m_buffer.constData();
+    const int size = m_buffer.size();
+    int pos = 0;
+    
+    while (pos < size) {
+        // Binary frame following a "=0 bin <n>" reply line
+        if (m_frameRemaining > 0) {
+            if (size - pos < m_frameRemaining)
+                break;
+            
+            QByteArray frame(data + pos, m_frameRemaining);
+            pos += m_frameRemaining;
+            m_frameRemaining = 0;
+            
+            emit frameReceived(m_lastCommand, frame);
+            completeCommand();
+            continue;
+        }
+        
+        const char *end = static_cast<const char *>(memchr(data + pos, '\n', size - pos));
+        if (!end)
+            break;
+        
+        int length = int(end - (data + pos));
+        processLine(data + pos, length);
+        pos += length + 1;
+    }
+    
+    if (pos >= size)
+        m_buffer.clear();
+    else if (pos > 0)
+        m_buffer.remove(0, pos);
+}
+
+void SerialWorker::processLine(const char *line, int length)
+{
+    QString data = QString::fromUtf8(line, length).trimmed();
+    
+    if (data.isEmpty())
+        return;
+    
+    m_linesProcessed.fetch_add(1, std::memory_order_relaxed);
+    qCDebug(lcSerial) << "RX:" << data;
+    
+    // Machine mode reply: "=<status>[ <payload>]"
+    if (data.size() >= 2 && data[0] == QLatin1Char('=') && data[1].isDigit()) {
+        handleMachineReply(data);
+        return;
+    }
+    
+    // Asynchronous event: "!<event>", never completes a command
+    if (data.startsWith(QLatin1Char('!'))) {
+        emit eventReceived(data.mid(1));
+        emit dataReceived(data);
+        return;
+    }
+    
+    // Check for ACK
+    if (data.startsWith("[ACK]")) {
+        emit ackReceived(data);
+    }
+    
+    // Check for command completion; human mode has no per-command status
+    if (data.contains("Komut tamamlandi:")) {
+        for (quint32 id : qAsConst(m_lastIds)) {
+            if (id)
+                emit requestCompleted(id, SerialController::StatusOk, QString());
+        }
+        completeCommand();
+    }
+    
+    // Human mode prose goes out as is
+    emit dataReceived(data);
+}
+
+void SerialWorker::handleMachineReply(const QString &line)
+{
+    // A ';' batch is answered with one line, results in command order
+    QString commandLine = m_lastCommand;
+    if (commandLine.startsWith("atomic:"))
+        commandLine.remove(0, 7);
+    
+    const QStringList commands = commandLine.split(QLatin1Char(';'));
+    const QStringList results = line.mid(1).split(QLatin1Char(';'));
+    
+    // A caller's own ';' line under one request id gets its first failing
+    // status and the raw results instead of the first command's result
+    const bool callerBatch = m_lastIds.size() == 1 && results.size() > 1;
+    int batchStatus = SerialController::StatusOk;
+    
+    for (int i = 0; i < results.size(); ++i) {
+        const QString &result = results.at(i);
+        int status = result.isEmpty() ? SerialController::StatusSyntax : result.at(0).digitValue();
+        QString payload = result.mid(2);
+        QString command = (i < commands.size()) ? commands.at(i) : m_lastCommand;
+        publish(command, status, payload);
+        
+        if (callerBatch) {
+            if (batchStatus == SerialController::StatusOk)
+                batchStatus = status;
+            continue;
+        }
+        
+        quint32 id = (i < m_lastIds.size()) ? m_lastIds.at(i) : 0;
+        if (id)
+            emit requestCompleted(id, status, payload);
+    }
+    if (callerBatch && m_lastIds.first())
+        emit requestCompleted(m_lastIds.first(), batchStatus, line.mid(1));
+    m_lastIds.clear();
+    
+    // Binary reply: the command completes once the frame has been read
+    if (results.size() == 1 && results.at(0).startsWith(QLatin1String("0 bin "))) {
+        m_frameRemaining = results.at(0).mid(6).toInt();
+        if (m_frameRemaining > 0)
+            return;
+    }
+    
+    completeCommand();
+}
+
+void SerialWorker::publish(const QString &command, int status, const QString &payload)
+{
+    RoutedUpdate update;
+    if (!m_updatesEnabled || !ResponseRouter::decodeReply(command, status, payload, update)) {
+        // Detection, mode switches, ...: rare, sent as a queued signal
+        emit replyReceived(command, status, payload);
+        return;
+    }
+    
+    while (!m_updates->push(update)) {
+        if (!m_backpressure) {
+            if (m_updatesDropped.fetch_add(1, std::memory_order_relaxed) == 0)
+                qWarning() << "Update queue full, GUI is not draining";
+            return;
+        }
+        QThread::yieldCurrentThread();
+    }
+}
+
+void SerialWorker::handleError(const QString &error, bool fatal)
+{
+    qWarning() << "Serial error:" << error;
+    
+    emit errorOccurred(error);
+    
+    // Disconnect on critical errors
+    if (fatal)
+        closePort();
+}
@@ -0,0 +1,113 @@
+#ifndef SERIALWORKER_H
+#define SERIALWORKER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QQueue>
+#include <QVector>
+#include <QFile>
+#include <atomic>
+#include "responserouter.h"
+#include "spscqueue.h"
+
+class Transport;
+
+// Transport, framing, decoding and command pipeline of SerialController.
+// Lives on SerialController's worker thread; all slots run there.
+// Decoded module replies are pushed into the update queue, the only
+// per-line traffic towards the GUI thread. Commands sent with a request
+// id are answered individually through requestCompleted.
+class SerialWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SerialWorker(SpscQueue<RoutedUpdate> *updates, QObject *parent = nullptr);
+    ~SerialWorker();
+    
+    // Takes ownership of transport (already moved to this thread)
+    bool openTransport(Transport *transport);
+    void closePort();
+    
+    void sendCommand(const QString &command, quint32 requestId = 0);
+    void sendCommandWithPriority(const QString &command, quint32 requestId = 0);
+    void setCycleTime(int milliseconds);
+    void setBatchingEnabled(bool enabled) { m_batchingEnabled = enabled; }
+    
+    // Off: module replies are not decoded into the update queue
+    // (headless clients without a ResponseRouter draining it)
+    void setUpdatesEnabled(bool enabled) { m_updatesEnabled = enabled; }
+    
+    // Traffic recording (BURJUVA_SERIAL_RECORD=<file>), replayed by
+    // burjuva-replay-bench: "> <command>\n" for each written line,
+    // "< <n>\n" followed by n raw bytes for each read chunk
+    bool startRecording(const QString &fileName);
+    
+    // Replay: behave as if command had been written / bytes had been read
+    void replayCommand(const QString &command);
+    void feed(const QByteArray &bytes);
+    
+    // Replay must not lose updates: wait for the consumer instead of dropping
+    void setBackpressure(bool enabled) { m_backpressure = enabled; }
+    
+    // Counters, readable from any thread
+    quint64 linesProcessed() const { return m_linesProcessed.load(std::memory_order_relaxed); }
+    quint64 updatesDropped() const { return m_updatesDropped.load(std::memory_order_relaxed); }
+    quint64 bytesWritten() const { return m_bytesWritten.load(std::memory_order_relaxed); }
+    quint64 bytesRead() const { return m_bytesRead.load(std::memory_order_relaxed); }
+
+signals:
+    void connected();
+    void disconnected();
+    void dataReceived(const QString &data);
+    void ackReceived(const QString &ack);
+    void errorOccurred(const QString &error);
+    void commandCompleted(const QString &command);
+    void replyReceived(const QString &command, int status, const QString &payload);
+    void eventReceived(const QString &event);
+    void frameReceived(const QString &command, const QByteArray &frame);
+    void requestCompleted(quint32 requestId, int status, const QString &payload);
+
+private slots:
+    void handleReadyRead();
+    void handleError(const QString &error, bool fatal);
+    void processCommandQueue();
+    void handleResponseTimeout();
+
+private:
+    void writeLine(const QString &command);
+    void processLine(const char *data, int length);
+    void handleMachineReply(const QString &line);
+    void publish(const QString &command, int status, const QString &payload);
+    void completeCommand();
+    void failRequests(bool includeQueued);
+    static bool isBinaryCommand(const QString &command);
+    
+    struct PendingCommand {
+        QString command;
+        quint32 requestId;      // 0: nobody waits for this reply
+    };
+    
+    SpscQueue<RoutedUpdate> *m_updates;
+    Transport *m_transport;     // nullptr while closed
+    QByteArray m_buffer;
+    QTimer *m_queueTimer;
+    QTimer *m_responseTimer;
+    QQueue<PendingCommand> m_commandQueue;
+    QString m_lastCommand;
+    QVector<quint32> m_lastIds; // Request ids of m_lastCommand, in batch order
+    int m_cycleTime;
+    bool m_waitingForResponse;
+    bool m_batchingEnabled;
+    bool m_machineMode;
+    bool m_backpressure;
+    bool m_updatesEnabled;
+    int m_frameRemaining;       // Raw bytes still expected after "=0 bin <n>"
+    QFile m_record;
+    std::atomic<quint64> m_linesProcessed;
+    std::atomic<quint64> m_updatesDropped;
+    std::atomic<quint64> m_bytesWritten;  // On the wire, CR/LF included
+    std::atomic<quint64> m_bytesRead;
+};
+
+#endif // SERIALWORKER_H
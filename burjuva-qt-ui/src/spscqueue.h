@@ -0,0 +1,72 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Capacity is rounded up to a power of two; one slot stays empty.
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(size_t capacity)
+        : m_head(0)
+        , m_tail(0)
+    {
+        size_t size = 2;
+        while (size < capacity + 1)
+            size <<= 1;
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+    
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+    
+    // Producer side; false if the queue is full (item not taken)
+    bool push(T item)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t next = (tail + 1) & m_mask;
+        if (next == m_head.load(std::memory_order_acquire))
+            return false;
+        
+        m_slots[tail] = std::move(item);
+        m_tail.store(next, std::memory_order_release);
+        return true;
+    }
+    
+    // Consumer side; false if the queue is empty
+    bool pop(T &item)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+        
+        item = std::move(m_slots[head]);
+        m_head.store((head + 1) & m_mask, std::memory_order_release);
+        return true;
+    }
+    
+    // Either side; exact only while the other side is idle
+    bool isEmpty() const
+    {
+        return m_head.load(std::memory_order_acquire) ==
+               m_tail.load(std::memory_order_acquire);
+    }
+    
+    size_t capacity() const { return m_mask; }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_mask;
+    
+    // Separate cache lines: producer and consumer never share a written line
+    alignas(64) std::atomic<size_t> m_head;     // Written by the consumer
+    alignas(64) std::atomic<size_t> m_tail;     // Written by the producer
+};
+
+#endif // SPSCQUEUE_H
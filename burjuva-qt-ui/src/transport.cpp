@@ -0,0 +1,120 @@
+#include "transport.h"
+#include <QSerialPort>
+
+SerialTransport::SerialTransport(const QString &portName, qint32 baudRate, QObject *parent)
+    : Transport(parent)
+    , m_port(new QSerialPort(this))
+{
+    m_port->setPortName(portName);
+    m_port->setBaudRate(baudRate);
+    m_port->setDataBits(QSerialPort::Data8);
+    m_port->setParity(QSerialPort::NoParity);
+    m_port->setStopBits(QSerialPort::OneStop);
+    m_port->setFlowControl(QSerialPort::NoFlowControl);
+    
+    connect(m_port, &QSerialPort::readyRead, this, &Transport::readyRead);
+    connect(m_port, &QSerialPort::errorOccurred, this, [this](QSerialPort::SerialPortError error) {
+        if (error == QSerialPort::NoError)
+            return;
+        
+        // Unplugged adapter / lost permission: nothing left to talk to
+        bool fatal = error == QSerialPort::ResourceError ||
+                     error == QSerialPort::PermissionError;
+        emit errorOccurred(m_port->errorString(), fatal);
+    });
+}
+
+bool SerialTransport::open()
+{
+    return m_port->open(QIODevice::ReadWrite);
+}
+
+void SerialTransport::close()
+{
+    m_port->close();
+}
+
+bool SerialTransport::isOpen() const
+{
+    return m_port->isOpen();
+}
+
+QString SerialTransport::name() const
+{
+    return m_port->portName();
+}
+
+QString SerialTransport::errorString() const
+{
+    return m_port->errorString();
+}
+
+void SerialTransport::write(const QByteArray &data)
+{
+    m_port->write(data);
+    m_port->flush();
+}
+
+QByteArray SerialTransport::readAll()
+{
+    return m_port->readAll();
+}
+
+void SerialTransport::waitForWritten(int msecs)
+{
+    m_port->waitForBytesWritten(msecs);
+}
+
+DeviceTransport::DeviceTransport(QIODevice *device, const QString &name, QObject *parent)
+    : Transport(parent)
+    , m_device(device)
+    , m_name(name)
+{
+    m_device->setParent(this);
+    connect(m_device, &QIODevice::readyRead, this, &Transport::readyRead);
+    connect(m_device, &QIODevice::readChannelFinished, this, [this]() {
+        emit errorOccurred(QString("%1: bağlantı kapandı").arg(m_name), true);
+    });
+}
+
+bool DeviceTransport::open()
+{
+    if (m_device->isOpen())
+        return true;
+    return m_device->open(QIODevice::ReadWrite);
+}
+
+void DeviceTransport::close()
+{
+    m_device->close();
+}
+
+bool DeviceTransport::isOpen() const
+{
+    return m_device->isOpen();
+}
+
+QString DeviceTransport::name() const
+{
+    return m_name;
+}
+
+QString DeviceTransport::errorString() const
+{
+    return m_device->errorString();
+}
+
+void DeviceTransport::write(const QByteArray &data)
+{
+    m_device->write(data);
+}
+
+QByteArray DeviceTransport::readAll()
+{
+    return m_device->readAll();
+}
+
+void DeviceTransport::waitForWritten(int msecs)
+{
+    m_device->waitForBytesWritten(msecs);
+}
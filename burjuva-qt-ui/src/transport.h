@@ -0,0 +1,85 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+
+class QSerialPort;
+class QIODevice;
+
+// Byte link to the firmware shell. SerialWorker only talks to this
+// interface, so the same pipeline runs over a UART, a pty, a socket or a
+// pipe. Used from the worker thread only.
+class Transport : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit Transport(QObject *parent = nullptr) : QObject(parent) {}
+    
+    virtual bool open() = 0;
+    virtual void close() = 0;
+    virtual bool isOpen() const = 0;
+    virtual QString name() const = 0;
+    virtual QString errorString() const = 0;
+    
+    virtual void write(const QByteArray &data) = 0;
+    virtual QByteArray readAll() = 0;
+    
+    // Wait until written bytes have left (last line before close)
+    virtual void waitForWritten(int msecs) { Q_UNUSED(msecs); }
+
+signals:
+    void readyRead();
+    // fatal: the link is gone and the worker closes it
+    void errorOccurred(const QString &error, bool fatal);
+};
+
+// UART via QSerialPort, 8N1 without flow control
+class SerialTransport : public Transport
+{
+    Q_OBJECT
+
+public:
+    SerialTransport(const QString &portName, qint32 baudRate, QObject *parent = nullptr);
+    
+    bool open() override;
+    void close() override;
+    bool isOpen() const override;
+    QString name() const override;
+    QString errorString() const override;
+    
+    void write(const QByteArray &data) override;
+    QByteArray readAll() override;
+    void waitForWritten(int msecs) override;
+
+private:
+    QSerialPort *m_port;
+};
+
+// Any QIODevice (QTcpSocket, QProcess, QLocalSocket, ...); takes ownership.
+// open() opens the device read/write unless it already is.
+class DeviceTransport : public Transport
+{
+    Q_OBJECT
+
+public:
+    DeviceTransport(QIODevice *device, const QString &name, QObject *parent = nullptr);
+    
+    bool open() override;
+    void close() override;
+    bool isOpen() const override;
+    QString name() const override;
+    QString errorString() const override;
+    
+    void write(const QByteArray &data) override;
+    QByteArray readAll() override;
+    void waitForWritten(int msecs) override;
+
+private:
+    QIODevice *m_device;
+    QString m_name;
+};
+
+#endif // TRANSPORT_H
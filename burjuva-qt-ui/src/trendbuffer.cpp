@@ -0,0 +1,133 @@
+#include "trendbuffer.h"
+#include <limits>
+
+static qint32 clampOffset(qint64 offset)
+{
+    if (offset > std::numeric_limits<qint32>::max())
+        return std::numeric_limits<qint32>::max();
+    if (offset < std::numeric_limits<qint32>::min())
+        return std::numeric_limits<qint32>::min();
+    return qint32(offset);
+}
+
+TrendBuffer::TrendBuffer(int channels, int capacity)
+    : m_rings(channels)
+    , m_capacity(capacity)
+    , m_epochMs(-1)
+{
+    // All memory up front: a shift of samples never reallocates
+    for (Ring &ring : m_rings) {
+        ring.time.resize(capacity);
+        ring.value.resize(capacity);
+        ring.head = 0;
+        ring.count = 0;
+    }
+}
+
+void TrendBuffer::append(int channel, qint64 timeMs, float value)
+{
+    if (channel < 0 || channel >= m_rings.size())
+        return;
+    
+    if (m_epochMs < 0)
+        m_epochMs = timeMs;
+    
+    Ring &ring = m_rings[channel];
+    ring.time[ring.head] = clampOffset(timeMs - m_epochMs);
+    ring.value[ring.head] = value;
+    
+    ring.head = (ring.head + 1) % m_capacity;
+    if (ring.count < m_capacity)
+        ring.count++;
+}
+
+void TrendBuffer::clear()
+{
+    for (Ring &ring : m_rings) {
+        ring.head = 0;
+        ring.count = 0;
+    }
+    m_epochMs = -1;
+}
+
+int TrendBuffer::count(int channel) const
+{
+    if (channel < 0 || channel >= m_rings.size())
+        return 0;
+    return m_rings.at(channel).count;
+}
+
+int TrendBuffer::lowerBound(const Ring &ring, qint32 time) const
+{
+    // Logical index 0 is the oldest sample
+    const int oldest = (ring.head - ring.count + m_capacity) % m_capacity;
+    int low = 0;
+    int high = ring.count;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (ring.time.at((oldest + mid) % m_capacity) < time)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+void TrendBuffer::decimate(int channel, qint64 fromMs, qint64 toMs, int columns,
+                           QVector<QPointF> &out) const
+{
+    out.clear();
+    if (channel < 0 || channel >= m_rings.size() || columns <= 0 ||
+        toMs <= fromMs || m_epochMs < 0)
+        return;
+    
+    const Ring &ring = m_rings.at(channel);
+    const qint32 from = clampOffset(fromMs - m_epochMs);
+    const qint32 to = clampOffset(toMs - m_epochMs);
+    const double columnsPerMs = double(columns) / double(qint64(to) - from);
+    const int oldest = (ring.head - ring.count + m_capacity) % m_capacity;
+    
+    out.reserve(2 * columns);
+    
+    int column = -1;
+    int minPos = 0;
+    int maxPos = 0;
+    
+    // Emit the current column's extremes in time order
+    auto flush = [&]() {
+        if (column < 0)
+            return;
+        int first = minPos;
+        int second = maxPos;
+        if (ring.time.at(second) < ring.time.at(first))
+            qSwap(first, second);
+        out.append(QPointF(double(m_epochMs + ring.time.at(first)), ring.value.at(first)));
+        if (second != first)
+            out.append(QPointF(double(m_epochMs + ring.time.at(second)), ring.value.at(second)));
+    };
+    
+    for (int i = lowerBound(ring, from); i < ring.count; ++i) {
+        const int pos = (oldest + i) % m_capacity;
+        const qint32 time = ring.time.at(pos);
+        if (time >= to)
+            break;
+        
+        int c = int((qint64(time) - from) * columnsPerMs);
+        if (c >= columns)
+            c = columns - 1;
+        
+        if (c != column) {
+            flush();
+            column = c;
+            minPos = pos;
+            maxPos = pos;
+        } else {
+            const float value = ring.value.at(pos);
+            if (value < ring.value.at(minPos))
+                minPos = pos;
+            if (value > ring.value.at(maxPos))
+                maxPos = pos;
+        }
+    }
+    flush();
+}
@@ -0,0 +1,43 @@
+#ifndef TRENDBUFFER_H
+#define TRENDBUFFER_H
+
+#include <QVector>
+#include <QPointF>
+
+// Fixed-capacity sample history for a set of analog channels.
+// Each channel is a ring of parallel time/value arrays allocated once;
+// when full the oldest samples are overwritten. Times must be
+// non-decreasing per channel.
+class TrendBuffer
+{
+public:
+    TrendBuffer(int channels, int capacity);
+    
+    void append(int channel, qint64 timeMs, float value);
+    void clear();
+    
+    int channelCount() const { return m_rings.size(); }
+    int capacity() const { return m_capacity; }
+    int count(int channel) const;
+    
+    // Samples of [fromMs, toMs) reduced to at most 2 points per column:
+    // each column's min and max in time order. Point x is msecs since epoch.
+    void decimate(int channel, qint64 fromMs, qint64 toMs, int columns,
+                  QVector<QPointF> &out) const;
+
+private:
+    struct Ring {
+        QVector<qint32> time;   // ms relative to m_epochMs
+        QVector<float> value;
+        int head;               // Next write position
+        int count;
+    };
+    
+    int lowerBound(const Ring &ring, qint32 time) const;
+    
+    QVector<Ring> m_rings;
+    int m_capacity;
+    qint64 m_epochMs;           // Set by the first sample; int32 offsets last 24 days
+};
+
+#endif // TRENDBUFFER_H
@@ -0,0 +1,128 @@
+#include "trendview.h"
+#include "trendbuffer.h"
+#include <QtCharts/QChart>
+#include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QDateTimeAxis>
+#include <QtCharts/QValueAxis>
+#include <QtCharts/QLegendMarker>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QComboBox>
+#include <QLabel>
+#include <QTimer>
+#include <QDateTime>
+
+QT_CHARTS_USE_NAMESPACE
+
+TrendView::TrendView(const TrendBuffer *buffer, const QString &unit, QWidget *parent)
+    : QWidget(parent)
+    , m_buffer(buffer)
+    , m_redrawTimer(new QTimer(this))
+    , m_windowMs(10 * 60 * 1000)
+{
+    setupUI(unit);
+    
+    connect(m_redrawTimer, &QTimer::timeout, this, &TrendView::redraw);
+    m_redrawTimer->start(RedrawIntervalMs);
+}
+
+void TrendView::setupUI(const QString &unit)
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+    
+    // Time window
+    QHBoxLayout *controlLayout = new QHBoxLayout();
+    m_windowCombo = new QComboBox(this);
+    m_windowCombo->addItem("1 dakika", 60 * 1000);
+    m_windowCombo->addItem("10 dakika", 10 * 60 * 1000);
+    m_windowCombo->addItem("1 saat", 60 * 60 * 1000);
+    m_windowCombo->addItem("8 saat", 8 * 60 * 60 * 1000);
+    m_windowCombo->setCurrentIndex(1);
+    connect(m_windowCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &TrendView::onWindowChanged);
+    
+    controlLayout->addWidget(new QLabel("Zaman aralığı:", this));
+    controlLayout->addWidget(m_windowCombo);
+    controlLayout->addStretch();
+    mainLayout->addLayout(controlLayout);
+    
+    // Chart
+    m_chart = new QChart();
+    m_chart->legend()->setAlignment(Qt::AlignRight);
+    
+    m_axisX = new QDateTimeAxis();
+    m_axisX->setFormat("HH:mm:ss");
+    m_axisX->setTickCount(6);
+    m_chart->addAxis(m_axisX, Qt::AlignBottom);
+    
+    m_axisY = new QValueAxis();
+    m_axisY->setRange(0.0, 10.0);
+    m_axisY->setTitleText(unit);
+    m_chart->addAxis(m_axisY, Qt::AlignLeft);
+    
+    for (int channel = 0; channel < m_buffer->channelCount(); channel++) {
+        QLineSeries *series = new QLineSeries();
+        series->setName(QString("CH%1").arg(channel));
+        m_chart->addSeries(series);
+        series->attachAxis(m_axisX);
+        series->attachAxis(m_axisY);
+        m_series.append(series);
+    }
+    
+    // Clicking a legend entry hides/shows its channel; hidden ones cost nothing
+    for (QLegendMarker *marker : m_chart->legend()->markers()) {
+        connect(marker, &QLegendMarker::clicked, this, [this, marker]() {
+            QAbstractSeries *series = marker->series();
+            series->setVisible(!series->isVisible());
+            marker->setVisible(true);
+            marker->setLabelBrush(series->isVisible() ? QBrush(Qt::black) : QBrush(Qt::gray));
+            redraw();
+        });
+    }
+    
+    m_chartView = new QChartView(m_chart, this);
+    m_chartView->setRenderHint(QPainter::Antialiasing, false);
+    mainLayout->addWidget(m_chartView, 1);
+}
+
+void TrendView::onWindowChanged(int index)
+{
+    m_windowMs = m_windowCombo->itemData(index).toLongLong();
+    m_axisX->setFormat(m_windowMs > 60 * 60 * 1000 ? "HH:mm" : "HH:mm:ss");
+    redraw();
+}
+
+void TrendView::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    redraw();
+}
+
+void TrendView::redraw()
+{
+    // Off-screen tab: nothing to draw, the buffer keeps recording
+    if (!isVisible())
+        return;
+    
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 from = now - m_windowMs;
+    
+    int columns = int(m_chart->plotArea().width());
+    if (columns <= 0)
+        columns = width();
+    
+    for (int channel = 0; channel < m_series.size(); channel++) {
+        QLineSeries *series = m_series.at(channel);
+        if (!series->isVisible())
+            continue;
+        
+        // One bulk replace per series instead of per-point appends
+        m_buffer->decimate(channel, from, now + 1, columns, m_points);
+        series->replace(m_points);
+    }
+    
+    m_axisX->setRange(QDateTime::fromMSecsSinceEpoch(from),
+                      QDateTime::fromMSecsSinceEpoch(now));
+}
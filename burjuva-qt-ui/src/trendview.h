@@ -0,0 +1,58 @@
+#ifndef TRENDVIEW_H
+#define TRENDVIEW_H
+
+#include <QWidget>
+#include <QVector>
+#include <QPointF>
+#include <QtCharts/QChartGlobal>
+
+QT_CHARTS_BEGIN_NAMESPACE
+class QChart;
+class QChartView;
+class QLineSeries;
+class QDateTimeAxis;
+class QValueAxis;
+QT_CHARTS_END_NAMESPACE
+
+class QComboBox;
+class QTimer;
+class TrendBuffer;
+
+// Trend chart of the channels in a TrendBuffer. Redrawn periodically with
+// one min/max point pair per pixel column, so the point count depends on
+// the chart width, not on how much history is shown.
+class TrendView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit TrendView(const TrendBuffer *buffer, const QString &unit,
+                       QWidget *parent = nullptr);
+    
+    static constexpr int RedrawIntervalMs = 500;
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
+private slots:
+    void redraw();
+    void onWindowChanged(int index);
+
+private:
+    void setupUI(const QString &unit);
+    
+    const TrendBuffer *m_buffer;
+    
+    QtCharts::QChart *m_chart;
+    QtCharts::QChartView *m_chartView;
+    QtCharts::QDateTimeAxis *m_axisX;
+    QtCharts::QValueAxis *m_axisY;
+    QVector<QtCharts::QLineSeries *> m_series;
+    
+    QComboBox *m_windowCombo;
+    QTimer *m_redrawTimer;
+    qint64 m_windowMs;          // Visible history
+    QVector<QPointF> m_points;  // Reused decimation output
+};
+
+#endif // TRENDVIEW_H
@@ -12,6 +12,9 @@ import subprocess
 import sys
 import os
 import time
+import struct
+import zlib
+import betik_asm
 from datetime import datetime
 
 # UART testi için
@@ -1408,8 +1411,102 @@ def setup_system():
     
     return True
 
-def send_uart_command(ser, command, wait_response=True, timeout=2, show_timing=True):
-    """UART komutu gönder, ACK bekle, gecikmeyi ölç ve yanıt al"""
+# Machine mode durum kodları (firmware uart_helper.h ile aynı)
+UART_STATUS_TEXT = {
+    0: "OK",
+    1: "Sözdizimi hatası",
+    2: "Geçersiz parametre",
+    3: "Modül yok",
+    4: "Donanım hatası",
+    5: "Yanıt taşması",
+}
+
+def set_uart_mode(ser, machine):
+    """STM32 shell modunu değiştir (machine: echo/ACK/açıklama yok, tek satır yanıt)"""
+    command = "mode:machine" if machine else "mode:human"
+    ser.reset_input_buffer()
+    ser.write(f"{command}\r\n".encode())
+    ser.flush()
+    
+    # Yanıtı bekle: machine -> "=0 machine", human -> "OK: mode human"
+    deadline = time.time() + 1.0
+    response = ""
+    while time.time() < deadline:
+        if ser.in_waiting:
+            response += ser.read(ser.in_waiting).decode('utf-8', errors='ignore')
+            if "=0 machine" in response or "OK: mode human" in response:
+                break
+        time.sleep(0.001)
+    ser.burjuva_machine_mode = machine
+    return response
+
+def is_machine_mode(ser):
+    return getattr(ser, 'burjuva_machine_mode', False)
+
+def machine_command(ser, command, timeout=2):
+    """Machine mode komutu gönder, [(durum, değer), ...] döndür (batch için birden fazla)"""
+    ser.reset_input_buffer()
+    ser.write(f"{command}\r\n".encode())
+    ser.flush()
+    
+    buffer = ""
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        if ser.in_waiting:
+            buffer += ser.read(ser.in_waiting).decode('utf-8', errors='ignore')
+            for line in buffer.split('\n'):
+                line = line.strip()
+                if len(line) >= 2 and line[0] == '=' and line[1].isdigit():
+                    results = []
+                    for item in line[1:].split(';'):
+                        status = int(item[0]) if item[:1].isdigit() else 1
+                        results.append((status, item[2:]))
+                    return results
+        time.sleep(0.001)
+    return None
+
+def format_machine_reply(results):
+    """Machine mode yanıtını menülerin beklediği 'OK:' / 'Hata:' satırlarına çevir"""
+    lines = []
+    for status, payload in results:
+        if status == 0:
+            lines.append(f"OK: {payload}".rstrip())
+        else:
+            text = UART_STATUS_TEXT.get(status, f"kod {status}")
+            lines.append(f"Hata: {text} {payload}".rstrip())
+    return "\n".join(lines)
+
+def send_uart_command(ser, command, wait_response=True, timeout=2, show_timing=True, verbose=False):
+    """UART komutu gönder, ACK bekle, gecikmeyi ölç ve yanıt al
+    
+    Machine mode'da tek satırlık kısa yanıt beklenir. verbose=True ise komut
+    geçici olarak human mode'da çalıştırılır (tanı çıktısı için).
+    """
+    if is_machine_mode(ser):
+        if verbose:
+            set_uart_mode(ser, False)
+            try:
+                return send_uart_command(ser, command, wait_response, timeout, show_timing)
+            finally:
+                set_uart_mode(ser, True)
+        
+        if not wait_response:
+            ser.write(f"{command}\r\n".encode())
+            ser.flush()
+            return None
+        
+        start_time_ns = time.perf_counter_ns()
+        results = machine_command(ser, command, timeout)
+        if results is None:
+            if show_timing:
+                print(f"⚠️  [Yanıt alınamadı! {timeout}s timeout]")
+            return None
+        
+        if show_timing:
+            latency_us = (time.perf_counter_ns() - start_time_ns) / 1000
+            print(f"⏱️  [Yanıt: {latency_us:.0f} µs ({latency_us / 1000:.2f} ms)]")
+        return format_machine_reply(results)
+    
     try:
         # Buffer'ı temizle
         ser.reset_input_buffer()
@@ -1462,73 +1559,63 @@ def send_uart_command(ser, command, wait_response=True, timeout=2, show_timing=T
         print(f"❌ UART hatası: {e}")
         return None
 
+# Firmware Modul_Tip kodları (modul-algila:rapor kayıtlarındaki 2. alan)
+MODULE_TYPE_CODES = {1: 'IO16', 2: 'AIO20', 3: 'FPGA', 4: 'UNKNOWN'}
+
+def parse_module_record(record):
+    """'<slot> <tip> <uid> <hid> <fid> <init> <init_us>' kaydını sözlüğe çevir (boş slot: None)"""
+    fields = record.split()
+    if len(fields) < 2 or fields[1] == '0':
+        return None
+    try:
+        slot = int(fields[0])
+        mod_type = MODULE_TYPE_CODES.get(int(fields[1]), 'UNKNOWN')
+    except ValueError:
+        return None
+    
+    module = {'slot': slot, 'type': mod_type, 'description': mod_type}
+    if len(fields) >= 7:
+        module['uid'] = fields[2]
+        module['hid'] = fields[3]
+        module['fid'] = fields[4]
+        module['init_status'] = int(fields[5])
+        module['init_us'] = int(fields[6])
+        try:
+            name = bytes.fromhex(fields[4]).split(b'\0')[0].decode('ascii', errors='replace').strip()
+            if name:
+                module['description'] = f"{mod_type} ({name})"
+        except ValueError:
+            pass
+    return module
+
 def detect_modules(ser):
-    """Modülleri algıla ve sonuçları parse et"""
+    """Modülleri algıla: 'modul-algila:rapor' ile slot başına tek kayıt"""
     print("\n🔍 Modüller algılanıyor...")
     
-    response = send_uart_command(ser, "modul-algila", timeout=3)
-    
-    if not response:
-        print("❌ Modül algılama yanıtı alınamadı!")
-        return []
-    
-    # Yanıtı göster
-    print("\n" + "="*60)
-    print(response)
-    print("="*60)
-    
-    # Modülleri parse et
-    # STM32 çıktısı şu formatta:
-    # Slot 0 (PC2): -> FOUND!
-    #   TYPE: IO16 - 16 Channel Digital I/O
-    #   NAME: io16
+    if is_machine_mode(ser):
+        # Kayıtlar '|' ile tek satırda: "=0 0 1 ...|1 0|2 2 ...|3 0"
+        results = machine_command(ser, "modul-algila:rapor", timeout=3)
+        if not results or results[0][0] != 0:
+            print("❌ Modül algılama yanıtı alınamadı!")
+            return []
+        records = results[0][1].split('|')
+    else:
+        # Human mode: her kayıt "MODUL " ile başlayan bir satır
+        response = send_uart_command(ser, "modul-algila:rapor", timeout=3)
+        if not response:
+            print("❌ Modül algılama yanıtı alınamadı!")
+            return []
+        records = [line.strip()[6:] for line in response.split('\n')
+                   if line.strip().startswith("MODUL ")]
     
     modules = []
-    lines = response.split('\n')
-    current_slot = None
-    
-    for line in lines:
-        # Slot satırını bul: "Slot 0 (PC2): -> FOUND!"
-        if "Slot" in line and "FOUND" in line:
-            try:
-                # "Slot 0 (PC2): -> FOUND!" -> slot=0
-                parts = line.split()
-                if len(parts) >= 2 and parts[0] == "Slot":
-                    current_slot = int(parts[1])
-            except (IndexError, ValueError):
-                continue
-        
-        # TYPE satırını bul: "  TYPE: IO16 - 16 Channel Digital I/O"
-        elif "TYPE:" in line and current_slot is not None:
-            try:
-                # "  TYPE: IO16 - 16 Channel Digital I/O"
-                type_part = line.split("TYPE:")[1].strip()
-                
-                # İlk kelimeyi al (IO16, AIO20, FPGA, etc.)
-                # "IO16 - 16 Channel Digital I/O" -> "IO16"
-                if " - " in type_part:
-                    module_type = type_part.split(" - ")[0].strip()
-                elif " " in type_part:
-                    module_type = type_part.split()[0].strip()
-                else:
-                    module_type = type_part.strip()
-                
-                module_desc = type_part  # Tam açıklama
-                
-                print(f"  [DEBUG] Parsed: Slot={current_slot}, Type='{module_type}', Desc='{module_desc}'")
-                
-                modules.append({
-                    'slot': current_slot,
-                    'type': module_type,
-                    'description': module_desc
-                })
-                
-                current_slot = None  # Reset for next module
-                
-            except (IndexError, ValueError) as e:
-                print(f"  [DEBUG] Parse error on TYPE line '{line}': {e}")
-                continue
-    
+    for record in records:
+        module = parse_module_record(record)
+        if module is None:
+            continue
+        if module.get('init_status', 0) != 0:
+            print(f"  ⚠️  Slot {module['slot']}: {module['type']} chip init başarısız")
+        modules.append(module)
     return modules
 
 def io16_control_interface(ser, slot):
@@ -1832,7 +1919,7 @@ def io16_control_interface(ser, slot):
                 # UART üzerinden STM32'ye gönder
                 cmd = f"io16:{slot}:status"
                 print(f"\n📤 Komut gönderiliyor: {cmd}")
-                response = send_uart_command(ser, cmd)
+                response = send_uart_command(ser, cmd, verbose=True)
                 if response:
                     print("\n📨 STM32 Yanıtı:")
                     print("─" * 60)
@@ -1912,7 +1999,7 @@ def io16_control_interface(ser, slot):
                 cmd = f"io16:{slot}:info"
                 print(f"\n📤 UART Komutu: {cmd}")
                 print(f"   STM32 → SPI2 → iC-JX (Slot {slot}) → INFO Register (0x1D)")
-                response = send_uart_command(ser, cmd)
+                response = send_uart_command(ser, cmd, verbose=True)
                 if response:
                     print("\n📨 STM32 Yanıtı:")
                     print("─" * 70)
@@ -1958,7 +2045,7 @@ def io16_control_interface(ser, slot):
                 cmd = f"io16:{slot}:overcurrent"
                 print(f"\n📤 iC-JX Overcurrent Kontrol: {cmd}")
                 print(f"   STM32 → SPI1 → iC-JX (Slot {slot}) → Overcurrent Registers")
-                response = send_uart_command(ser, cmd)
+                response = send_uart_command(ser, cmd, verbose=True)
                 if response:
                     print("\n📨 STM32 Yanıtı:")
                     print("─" * 60)
@@ -1981,7 +2068,7 @@ def io16_control_interface(ser, slot):
                 print(f"\n📤 iC-JX Register Dump: {cmd}")
                 print(f"   STM32 → SPI1 → iC-JX (Slot {slot}) → Tüm Register'ları Oku")
                 print("\n⏳ Lütfen bekleyin, tüm register'lar okunuyor...")
-                response = send_uart_command(ser, cmd, timeout=5)  # Longer timeout
+                response = send_uart_command(ser, cmd, timeout=5, verbose=True)  # Longer timeout
                 if response:
                     print("\n📨 STM32 Yanıtı:")
                     print("═" * 60)
@@ -2036,7 +2123,7 @@ def io16_control_interface(ser, slot):
                         cmd = f"io16:{test_slot}:info"
                         print(f"   Komut: {cmd}")
                         
-                        response = send_uart_command(ser, cmd, timeout=2, show_timing=False)
+                        response = send_uart_command(ser, cmd, timeout=2, show_timing=False, verbose=True)
                         
                         if response:
                             # Yanıtı analiz et
@@ -2150,7 +2237,7 @@ def io16_control_interface(ser, slot):
                             # Format: io16:testcs:gpio:pin
                             cmd = f"io16:testcs:{gpio}:{pin_num}"
                             
-                            response = send_uart_command(ser, cmd, timeout=2, show_timing=False)
+                            response = send_uart_command(ser, cmd, timeout=2, show_timing=False, verbose=True)
                             
                             if response:
                                 print("\n📨 SONUÇ:")
@@ -2261,7 +2348,7 @@ def aio20_control_interface(ser, slot):
             print("   AFE kartları ve kanal değerleri gösterilecek")
             cmd = f"aio20:{slot}:status"
             print(f"\n📤 Komut gönderiliyor: {cmd}")
-            response = send_uart_command(ser, cmd, timeout=5)
+            response = send_uart_command(ser, cmd, timeout=5, verbose=True)
             if response:
                 print("\n" + "="*70)
                 print("� AIO20 DURUM RAPORU")
@@ -2272,7 +2359,7 @@ def aio20_control_interface(ser, slot):
         elif choice == '5':
             cmd = f"aio20:{slot}:info"
             print(f"\n📤 Komut gönderiliyor: {cmd}")
-            response = send_uart_command(ser, cmd, timeout=3)
+            response = send_uart_command(ser, cmd, timeout=3, verbose=True)
             if response:
                 print("\n📨 STM32 Yanıtı:")
                 print("─" * 60)
@@ -2292,7 +2379,7 @@ def aio20_control_interface(ser, slot):
             if confirm == 'e':
                 cmd = f"aio20:{slot}:init"
                 print(f"\n📤 Komut gönderiliyor: {cmd}")
-                response = send_uart_command(ser, cmd, timeout=5)
+                response = send_uart_command(ser, cmd, timeout=5, verbose=True)
                 if response:
                     print("\n📨 STM32 Yanıtı:")
                     print("─" * 60)
@@ -2309,7 +2396,7 @@ def aio20_control_interface(ser, slot):
             
             cmd = f"aio20:{slot}:detectafe"
             print(f"📤 Komut gönderiliyor: {cmd}")
-            response = send_uart_command(ser, cmd, timeout=5)
+            response = send_uart_command(ser, cmd, timeout=5, verbose=True)
             if response:
                 print("\n📨 STM32 Yanıtı:")
                 print("─" * 60)
@@ -2462,7 +2549,7 @@ def fpga_motor_control_menu(ser, slot):
                 
                 cmd = f"fpga:{slot}:motor:{motor_ch}:status"
                 print(f"\n📤 Komut: {cmd}")
-                response = send_uart_command(ser, cmd)
+                response = send_uart_command(ser, cmd, verbose=True)
                 if response:
                     print("\n📨 STM32 Yanıtı:")
                     print("─" * 60)
@@ -2590,9 +2677,12 @@ def fpga_motor_control_menu(ser, slot):
                     response = send_uart_command(ser, cmd, timeout=1)
                     
                     # Parse position from response
-                    if "pozisyon:" in response:
+                    if response and "pozisyon:" in response:
                         pos_str = response.split("pozisyon:")[-1].strip().split()[0]
                         print(f"\rPozisyon: {pos_str:>8}    ", end='', flush=True)
+                    elif response and response.startswith("OK: "):
+                        pos_str = response[4:].strip()
+                        print(f"\rPozisyon: {pos_str:>8}    ", end='', flush=True)
                     
                     time.sleep(0.2)  # 5 Hz update
                 
@@ -2656,7 +2746,14 @@ def fpga_motor_control_menu(ser, slot):
                             cmd_info = f"fpga:{slot}:motor:{motor_ch}:timerinfo"
                             response_info = send_uart_command(ser, cmd_info, timeout=1)
                             
-                            if "DURDU" in response_info:
+                            if response_info and response_info.startswith("OK: ") and "Kalan=" not in response_info:
+                                # Machine mode: "OK: <kalan ms>", 0 = durdu
+                                remaining = int(response_info[4:].strip() or 0)
+                                if remaining == 0:
+                                    print("\r✅ Timer tamamlandı, motor durdu           ")
+                                    break
+                                print(f"\r⏱️  Kalan süre: {remaining / 1000.0:.1f}s    ", end='', flush=True)
+                            elif "DURDU" in response_info:
                                 print("\r✅ Timer tamamlandı, motor durdu           ")
                                 break
                             elif "Kalan=" in response_info:
@@ -2705,6 +2802,188 @@ def fpga_motor_control_menu(ser, slot):
         if choice != '0':
             input("\nDevam etmek için Enter'a basın...")
 
+def upload_fpga_bitstream_stm32(ser, slot, path=FPGA_BITSTREAM):
+    """Bitstream'i STM32 flash'ına yükle (fpga:2:bit:*), CRC32 ile doğrula"""
+    if not os.path.exists(path):
+        print(f"❌ Bitstream bulunamadı: {path}")
+        return False
+    
+    with open(path, 'rb') as f:
+        bitstream = f.read()
+    crc = zlib.crc32(bitstream) & 0xFFFFFFFF
+    print(f"📁 {path}: {len(bitstream)} byte, CRC32 {crc:08X}")
+    
+    was_machine = is_machine_mode(ser)
+    if not was_machine:
+        set_uart_mode(ser, True)
+    
+    try:
+        start = time.time()
+        reply = machine_command(ser, f"fpga:{slot}:bit:begin:{len(bitstream)}:{crc}", timeout=3)
+        if not reply or reply[0][0] != 0:
+            print(f"❌ Yükleme başlatılamadı: {format_machine_reply(reply) if reply else 'yanıt yok'}")
+            return False
+        
+        # 96 byte'lık parçalar: komut satırı 256 karakter
+        for offset in range(0, len(bitstream), 96):
+            chunk = bitstream[offset:offset + 96]
+            reply = machine_command(ser, f"fpga:{slot}:bit:data:{offset}:{chunk.hex()}")
+            if not reply or reply[0][0] != 0:
+                print(f"\n❌ Parça {offset} yazılamadı: {format_machine_reply(reply) if reply else 'yanıt yok'}")
+                return False
+            if offset % 4800 == 0:
+                print(f"\r   {offset + len(chunk)}/{len(bitstream)} byte", end="", flush=True)
+        print(f"\r   {len(bitstream)}/{len(bitstream)} byte")
+        
+        reply = machine_command(ser, f"fpga:{slot}:bit:end", timeout=3)
+        if not reply or reply[0][0] != 0:
+            print(f"❌ Doğrulama başarısız: {format_machine_reply(reply) if reply else 'yanıt yok'}")
+            return False
+        print(f"✓ Flash'a yazıldı ({time.time() - start:.1f} s)")
+        
+        reply = machine_command(ser, f"fpga:{slot}:config", timeout=3)
+        if not reply or reply[0][0] != 0:
+            print(f"❌ FPGA yapılandırılamadı: {format_machine_reply(reply) if reply else 'yanıt yok'}")
+            return False
+        print(f"✓ FPGA yapılandırıldı: CRESET -> CDONE {reply[0][1]} µs")
+        return True
+    finally:
+        if not was_machine:
+            set_uart_mode(ser, False)
+
+# Kilitleme/refleks kural tablosu (stm32-firmware-beta/src/kural.h): kural başına
+# 16 byte, çok byte'lı alanlar little endian
+KURAL_BOYU = 16
+KURAL_SAYISI = 32
+
+def encode_rule(line):
+    """'TETIK -> EYLEM [event]' satırını 16 byte'a çevir
+
+    Tetik:  io16:S:PIN:high|low          aio20:S:PORT:>|<:ESIK[:HIST]
+            fpga:S:CH:MASK (STATUS bit maskesi, örn. 0x08 = FAULT)
+    Eylem:  io16:S:PIN:high|low          stop:S:CH   estop:S:CH
+            speed:S:CH:HIZ:YON (1 ileri / 2 geri)
+    """
+    if '->' not in line:
+        raise ValueError("'->' yok")
+    tetik, eylem = [x.strip() for x in line.split('->', 1)]
+    bayrak = 0
+    if eylem.endswith(' event'):
+        eylem = eylem[:-6].strip()
+        bayrak = 0x01
+    
+    def sayi(x):
+        return int(x, 0)
+    
+    t = tetik.split(':')
+    if t[0] == 'io16' and len(t) == 4 and t[3] in ('high', 'low'):
+        tetik_alan = (1, sayi(t[1]), sayi(t[2]), 1 if t[3] == 'high' else 0, 0, 0)
+    elif t[0] == 'aio20' and len(t) in (5, 6) and t[3] in ('>', '<'):
+        hist = sayi(t[5]) if len(t) == 6 else 0
+        tetik_alan = (2 if t[3] == '>' else 3, sayi(t[1]), sayi(t[2]), 0, sayi(t[4]), hist)
+    elif t[0] == 'fpga' and len(t) == 4:
+        tetik_alan = (4, sayi(t[1]), sayi(t[2]), sayi(t[3]), 0, 0)
+    else:
+        raise ValueError(f"geçersiz tetik: {tetik}")
+    
+    e = eylem.split(':')
+    if e[0] == 'io16' and len(e) == 4 and e[3] in ('high', 'low'):
+        eylem_alan = (1, sayi(e[1]), sayi(e[2]), 1 if e[3] == 'high' else 0, 0)
+    elif e[0] in ('stop', 'estop') and len(e) == 3:
+        eylem_alan = (3 if e[0] == 'stop' else 4, sayi(e[1]), sayi(e[2]), 0, 0)
+    elif e[0] == 'speed' and len(e) == 5:
+        eylem_alan = (5, sayi(e[1]), sayi(e[2]), sayi(e[4]), sayi(e[3]))
+    else:
+        raise ValueError(f"geçersiz eylem: {eylem}")
+    
+    return struct.pack('<BBBBHHBBBBHBB', *tetik_alan, *eylem_alan, bayrak, 0)
+
+def encode_rule_table(text):
+    """Kural dosyası metni ('#' yorum) -> ikili tablo"""
+    table = b''
+    for no, line in enumerate(text.splitlines(), 1):
+        line = line.split('#', 1)[0].strip()
+        if not line:
+            continue
+        try:
+            table += encode_rule(line)
+        except (ValueError, IndexError, struct.error) as e:
+            raise ValueError(f"satır {no}: {e}")
+    if len(table) > KURAL_SAYISI * KURAL_BOYU:
+        raise ValueError(f"en fazla {KURAL_SAYISI} kural")
+    return table
+
+def upload_rule_table(ser, table, enable=True):
+    """Kural tablosunu yükle (kural:begin/data/end), CRC32 ile doğrula"""
+    crc = zlib.crc32(table) & 0xFFFFFFFF
+    
+    was_machine = is_machine_mode(ser)
+    if not was_machine:
+        set_uart_mode(ser, True)
+    
+    try:
+        reply = machine_command(ser, f"kural:begin:{len(table)}:{crc}")
+        if not reply or reply[0][0] != 0:
+            print(f"❌ Yükleme başlatılamadı: {format_machine_reply(reply) if reply else 'yanıt yok'}")
+            return False
+        for offset in range(0, len(table), 96):
+            chunk = table[offset:offset + 96]
+            reply = machine_command(ser, f"kural:data:{offset}:{chunk.hex()}")
+            if not reply or reply[0][0] != 0:
+                print(f"❌ Parça {offset} yazılamadı: {format_machine_reply(reply) if reply else 'yanıt yok'}")
+                return False
+        reply = machine_command(ser, "kural:end")
+        if not reply or reply[0][0] != 0:
+            print(f"❌ Tablo reddedildi: {format_machine_reply(reply) if reply else 'yanıt yok'}")
+            return False
+        print(f"✓ {len(table) // KURAL_BOYU} kural yüklendi")
+        if enable:
+            reply = machine_command(ser, "kural:on")
+            if not reply or reply[0][0] != 0:
+                print("❌ Kurallar açılamadı")
+                return False
+        return True
+    finally:
+        if not was_machine:
+            set_uart_mode(ser, False)
+
+def upload_program(ser, code, run=True):
+    """Betik bytecode'unu yükle (betik:begin/data/end), CRC32 ile doğrula
+
+    Bytecode betik_asm.assemble() çıktısıdır
+    """
+    crc = zlib.crc32(code) & 0xFFFFFFFF
+    
+    was_machine = is_machine_mode(ser)
+    if not was_machine:
+        set_uart_mode(ser, True)
+    
+    try:
+        reply = machine_command(ser, f"betik:begin:{len(code)}:{crc}")
+        if not reply or reply[0][0] != 0:
+            print(f"❌ Yükleme başlatılamadı: {format_machine_reply(reply) if reply else 'yanıt yok'}")
+            return False
+        for offset in range(0, len(code), 96):
+            chunk = code[offset:offset + 96]
+            reply = machine_command(ser, f"betik:data:{offset}:{chunk.hex()}")
+            if not reply or reply[0][0] != 0:
+                print(f"❌ Parça {offset} yazılamadı: {format_machine_reply(reply) if reply else 'yanıt yok'}")
+                return False
+        reply = machine_command(ser, "betik:end")
+        if not reply or reply[0][0] != 0:
+            print(f"❌ Betik reddedildi: {format_machine_reply(reply) if reply else 'yanıt yok'}")
+            return False
+        print(f"✓ {len(code)} byte betik yüklendi")
+        if run:
+            reply = machine_command(ser, "betik:run")
+            if not reply or reply[0][0] != 0:
+                print("❌ Betik başlatılamadı")
+                return False
+        return True
+    finally:
+        if not was_machine:
+            set_uart_mode(ser, False)
+
 def fpga_control_interface(ser, slot):
     """FPGA kontrol arayüzü"""
     while True:
@@ -2717,6 +2996,8 @@ def fpga_control_interface(ser, slot):
         print("4. Durum Göster (Status)")
         print("5. 🎮 Motor Kontrolü (Motor Control)")
         print("6. Yardım (Help)")
+        print("7. 💾 Bitstream Yükle (STM32 flash + yapılandır)")
+        print("8. FPGA Yapılandır (flash'taki bitstream)")
         print("0. Geri Dön")
         print("="*60)
         
@@ -2758,7 +3039,7 @@ def fpga_control_interface(ser, slot):
         elif choice == '4':
             cmd = f"fpga:{slot}:status"
             print(f"\n📤 Komut gönderiliyor: {cmd}")
-            response = send_uart_command(ser, cmd)
+            response = send_uart_command(ser, cmd, verbose=True)
             if response:
                 print("\n📨 STM32 Yanıtı:")
                 print("─" * 60)
@@ -2777,9 +3058,25 @@ def fpga_control_interface(ser, slot):
             print(f"  • fpga:{slot}:motor:0:goto:1000:128 - Motor 0 pozisyon 1000'e git")
             print(f"  • fpga:{slot}:motor:0:speed:200:1 - Motor 0 hız 200 ileri")
             print(f"  • fpga:{slot}:motor:0:home    - Motor 0 home (pozisyon=0)")
+            print(f"  • fpga:{slot}:bit             - Flash'taki bitstream ve CDONE")
+            print(f"  • fpga:{slot}:config          - FPGA'yı flash'taki bitstream ile yapılandır")
             print("\n  Not: Register adresleri 0x00-0xFF arasında")
             print("       Motor channels: 0-15")
         
+        elif choice == '7':
+            path = input(f"Bitstream dosyası [{FPGA_BITSTREAM}]: ").strip() or FPGA_BITSTREAM
+            upload_fpga_bitstream_stm32(ser, slot, path)
+        
+        elif choice == '8':
+            cmd = f"fpga:{slot}:config"
+            print(f"\n📤 Komut gönderiliyor: {cmd}")
+            response = send_uart_command(ser, cmd)
+            if response:
+                print("\n📨 STM32 Yanıtı:")
+                print("─" * 60)
+                print(response.strip())
+                print("─" * 60)
+        
         elif choice == '0':
             break
         else:
@@ -2950,11 +3247,15 @@ def module_control_menu():
         time.sleep(0.5)
         print(f"✓ {UART_PORT} bağlantısı başarılı\n")
         
+        # Host yazılımı machine mode kullanır (echo/ACK/açıklama yok)
+        set_uart_mode(ser, True)
+        
         # Modülleri algıla
         modules = detect_modules(ser)
         
         if not modules:
             print("\n⚠️  Hiç modül algılanamadı!")
+            set_uart_mode(ser, False)
             ser.close()
             return False
         
@@ -2965,11 +3266,35 @@ def module_control_menu():
         # Modül seç
         while True:
             print("\n" + "="*60)
-            choice = input("Kontrol etmek istediğiniz modülü seçin (0-{}) veya 'q' (çıkış): ".format(len(modules)-1)).strip()
+            choice = input("Kontrol etmek istediğiniz modülü seçin (0-{}), 'k' (kural tablosu), 'b' (betik) veya 'q' (çıkış): ".format(len(modules)-1)).strip()
             
             if choice.lower() == 'q':
                 break
             
+            if choice.lower() == 'k':
+                path = input("Kural dosyası: ").strip()
+                try:
+                    with open(path) as f:
+                        table = encode_rule_table(f.read())
+                    upload_rule_table(ser, table)
+                except (OSError, ValueError) as e:
+                    print(f"❌ {e}")
+                continue
+            
+            if choice.lower() == 'b':
+                path = input("Betik dosyası (.s metin veya .bin): ").strip()
+                try:
+                    if path.endswith('.bin'):
+                        with open(path, 'rb') as f:
+                            code = f.read()
+                    else:
+                        with open(path) as f:
+                            code = betik_asm.assemble(f.read())
+                    upload_program(ser, code)
+                except (OSError, ValueError) as e:
+                    print(f"❌ {e}")
+                continue
+            
             try:
                 idx = int(choice)
                 if idx < 0 or idx >= len(modules):
@@ -2999,6 +3324,8 @@ def module_control_menu():
             except ValueError:
                 print("❌ Geçerli bir sayı girin!")
         
+        # Terminal kullanımı için human mode'a dön
+        set_uart_mode(ser, False)
         ser.close()
         print("\n✓ Bağlantı kapatıldı")
         return True
@@ -55,6 +55,66 @@ echo [6/13] uart_helper.c
 arm-none-eabi-gcc -c %CFLAGS% src/uart_helper.c -o build/uart_helper.o
 if %ERRORLEVEL% NEQ 0 exit /b 1
 
+echo [7/14] tick.c
+arm-none-eabi-gcc -c %CFLAGS% src/tick.c -o build/tick.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [8/15] komut.c
+arm-none-eabi-gcc -c %CFLAGS% src/komut.c -o build/komut.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [9/16] istatistik.c
+arm-none-eabi-gcc -c %CFLAGS% src/istatistik.c -o build/istatistik.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [10/17] darbe.c
+arm-none-eabi-gcc -c %CFLAGS% src/darbe.c -o build/darbe.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [11/18] servo.c
+arm-none-eabi-gcc -c %CFLAGS% src/servo.c -o build/servo.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [12/19] hareket.c
+arm-none-eabi-gcc -c %CFLAGS% src/hareket.c -o build/hareket.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [13/20] pid.c
+arm-none-eabi-gcc -c %CFLAGS% src/pid.c -o build/pid.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [14/21] kuyruk.c
+arm-none-eabi-gcc -c %CFLAGS% src/kuyruk.c -o build/kuyruk.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [15/22] olay.c
+arm-none-eabi-gcc -c %CFLAGS% src/olay.c -o build/olay.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [16/23] yukleme.c
+arm-none-eabi-gcc -c %CFLAGS% src/yukleme.c -o build/yukleme.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [17/24] konum.c
+arm-none-eabi-gcc -c %CFLAGS% src/konum.c -o build/konum.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [18/25] disli.c
+arm-none-eabi-gcc -c %CFLAGS% src/disli.c -o build/disli.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [19/26] referans.c
+arm-none-eabi-gcc -c %CFLAGS% src/referans.c -o build/referans.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [20/27] kural.c
+arm-none-eabi-gcc -c %CFLAGS% src/kural.c -o build/kural.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
+echo [21/28] betik.c
+arm-none-eabi-gcc -c %CFLAGS% src/betik.c -o build/betik.o
+if %ERRORLEVEL% NEQ 0 exit /b 1
+
 echo [7/10] spisurucu.c
 arm-none-eabi-gcc -c %CFLAGS% src/spisurucu.c -o build/spisurucu.o
 if %ERRORLEVEL% NEQ 0 exit /b 1
@@ -91,11 +151,26 @@ echo.
 echo Linking...
 arm-none-eabi-gcc %LDFLAGS% ^
     build/main.o ^
+    build/komut.o ^
     build/modul_algilama.o ^
     build/16kanaldijital.o ^
     build/20kanalanalogio.o ^
     build/fpga.o ^
     build/uart_helper.o ^
+    build/tick.o ^
+    build/istatistik.o ^
+    build/darbe.o ^
+    build/servo.o ^
+    build/hareket.o ^
+    build/pid.o ^
+    build/kuyruk.o ^
+    build/olay.o ^
+    build/yukleme.o ^
+    build/konum.o ^
+    build/disli.o ^
+    build/referans.o ^
+    build/kural.o ^
+    build/betik.o ^
     build/spisurucu.o ^
     build/stm32f10x_gpio.o ^
     build/stm32f10x_rcc.o ^
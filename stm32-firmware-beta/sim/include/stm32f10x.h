@@ -0,0 +1,118 @@
+/**
+ * Burjuva Simülatör - stm32f10x.h yerine geçen host başlığı
+ * 
+ * Komut katmanı ve modül sürücülerinin derlenmesi için gereken
+ * SPL tiplerinin asgari alt kümesi. Çevre birimleri sim_spl.c'de
+ * bellekte tutulur.
+ */
+
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+#include <stdint.h>
+
+#define __IO    volatile
+
+typedef enum {RESET = 0, SET = !RESET} FlagStatus, ITStatus;
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+typedef enum {ERROR = 0, SUCCESS = !ERROR} ErrorStatus;
+
+typedef struct {
+    __IO uint32_t CRL;
+    __IO uint32_t CRH;
+    __IO uint32_t IDR;
+    __IO uint32_t ODR;
+    __IO uint32_t BSRR;
+    __IO uint32_t BRR;
+    __IO uint32_t LCKR;
+} GPIO_TypeDef;
+
+typedef struct {
+    __IO uint16_t SR;
+    __IO uint16_t DR;
+} USART_TypeDef;
+
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    __IO uint16_t CR1;
+    __IO uint16_t DIER;
+    __IO uint16_t SR;
+    __IO uint16_t EGR;
+    __IO uint16_t CNT;
+    __IO uint16_t PSC;
+    __IO uint16_t ARR;
+} TIM_TypeDef;
+
+typedef struct {
+    __IO uint32_t IMR;
+    __IO uint32_t EMR;
+    __IO uint32_t RTSR;
+    __IO uint32_t FTSR;
+    __IO uint32_t SWIER;
+    __IO uint32_t PR;
+} EXTI_TypeDef;
+
+typedef struct {
+    __IO uint32_t EVCR;
+    __IO uint32_t MAPR;
+    __IO uint32_t EXTICR[4];
+} AFIO_TypeDef;
+
+typedef struct {
+    __IO uint32_t DHCSR;
+    __IO uint32_t DCRSR;
+    __IO uint32_t DCRDR;
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+#define TIM_CR1_CEN                 ((uint16_t)0x0001)
+#define TIM_DIER_UIE                ((uint16_t)0x0001)
+#define TIM_SR_UIF                  ((uint16_t)0x0001)
+#define TIM_EGR_UG                  ((uint8_t)0x01)
+#define AFIO_EXTICR1_EXTI0_PB       ((uint16_t)0x0001)
+
+typedef enum {
+    EXTI0_IRQn = 6,
+    TIM2_IRQn = 28
+} IRQn_Type;
+
+extern GPIO_TypeDef sim_gpio[4];
+extern USART_TypeDef sim_usart1;
+extern CoreDebug_Type sim_coredebug;
+extern TIM_TypeDef sim_tim2;
+extern EXTI_TypeDef sim_exti;
+extern AFIO_TypeDef sim_afio;
+
+/* Her erişimde CYCCNT host saatinden (72 MHz karşılığı) güncellenir */
+DWT_Type* sim_dwt(void);
+
+#define GPIOA   (&sim_gpio[0])
+#define GPIOB   (&sim_gpio[1])
+#define GPIOC   (&sim_gpio[2])
+#define GPIOD   (&sim_gpio[3])
+#define USART1  (&sim_usart1)
+#define TIM2    (&sim_tim2)
+#define EXTI    (&sim_exti)
+#define AFIO    (&sim_afio)
+#define DWT         (sim_dwt())
+#define CoreDebug   (&sim_coredebug)
+
+/* SysTick host'ta sim_main.c'nin saat döngüsünden sürülür */
+static inline uint32_t SysTick_Config(uint32_t ticks) { (void)ticks; return 0; }
+
+/* TIM2 servo ve EXTI0 FPGA INT kesmeleri de aynı döngüden sürülür; NVIC yok */
+static inline void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) { (void)irq; (void)priority; }
+static inline void NVIC_EnableIRQ(IRQn_Type irq) { (void)irq; }
+static inline void NVIC_DisableIRQ(IRQn_Type irq) { (void)irq; }
+
+/* SPL'deki stm32f10x_conf.h gibi çevre birimi başlıklarını da getir */
+#include "stm32f10x_gpio.h"
+#include "stm32f10x_usart.h"
+
+#endif // __STM32F10x_H
@@ -0,0 +1,39 @@
+/**
+ * Burjuva Simülatör - stm32f10x_flash.h yerine geçen host başlığı
+ *
+ * 256 KB flash bellekte tutulur (sim_spl.c); --flash verilirse dosyadan
+ * yüklenir ve her FLASH_Lock'ta geri yazılır. Silinmemiş yarım kelimeye
+ * yazma, donanımdaki gibi FLASH_ERROR_PG döner.
+ */
+
+#ifndef __STM32F10x_FLASH_H
+#define __STM32F10x_FLASH_H
+
+#include "stm32f10x.h"
+
+#define SIM_FLASH_BASE      0x08000000UL
+#define SIM_FLASH_SIZE      (256UL * 1024)
+
+typedef enum {
+    FLASH_BUSY = 1,
+    FLASH_ERROR_PG,
+    FLASH_ERROR_WRP,
+    FLASH_COMPLETE,
+    FLASH_TIMEOUT
+} FLASH_Status;
+
+extern uint8_t sim_flash[SIM_FLASH_SIZE];
+
+/* Firmware flash'ı adresle okur; host'ta bellek dizisine eşlenir */
+#define FLASH_ISARET(adres)     ((const uint8_t*)&sim_flash[(adres) - SIM_FLASH_BASE])
+
+void FLASH_Unlock(void);
+void FLASH_Lock(void);
+FLASH_Status FLASH_ErasePage(uint32_t Page_Address);
+FLASH_Status FLASH_ProgramWord(uint32_t Address, uint32_t Data);
+FLASH_Status FLASH_ProgramHalfWord(uint32_t Address, uint16_t Data);
+
+// Flash dosyası (NULL: yalnızca bellekte, açılışta silinmiş)
+int Sim_FlashDosya(const char* path);
+
+#endif // __STM32F10x_FLASH_H
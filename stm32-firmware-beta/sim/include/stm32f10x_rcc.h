@@ -0,0 +1,24 @@
+/**
+ * Burjuva Simülatör - stm32f10x_rcc.h yerine geçen host başlığı
+ */
+
+#ifndef __STM32F10x_RCC_H
+#define __STM32F10x_RCC_H
+
+#include "stm32f10x.h"
+
+#define RCC_APB1Periph_TIM2     ((uint32_t)0x00000001)
+#define RCC_APB2Periph_AFIO     ((uint32_t)0x00000001)
+#define RCC_APB2Periph_GPIOB    ((uint32_t)0x00000008)
+
+static inline void RCC_APB1PeriphClockCmd(uint32_t periph, FunctionalState state) {
+    (void)periph;
+    (void)state;
+}
+
+static inline void RCC_APB2PeriphClockCmd(uint32_t periph, FunctionalState state) {
+    (void)periph;
+    (void)state;
+}
+
+#endif // __STM32F10x_RCC_H
@@ -0,0 +1,19 @@
+/**
+ * Burjuva Simülatör - stm32f10x_usart.h yerine geçen host başlığı
+ * 
+ * USART_SendData çıkış tamponuna yazar (sim_main.c pty'ye aktarır).
+ */
+
+#ifndef __STM32F10x_USART_H
+#define __STM32F10x_USART_H
+
+#include "stm32f10x.h"
+
+#define USART_FLAG_TXE      ((uint16_t)0x0080)
+#define USART_FLAG_RXNE     ((uint16_t)0x0020)
+
+FlagStatus USART_GetFlagStatus(USART_TypeDef* USARTx, uint16_t USART_FLAG);
+void USART_SendData(USART_TypeDef* USARTx, uint16_t Data);
+uint16_t USART_ReceiveData(USART_TypeDef* USARTx);
+
+#endif // __STM32F10x_USART_H
@@ -0,0 +1,389 @@
+/**
+ * Burjuva Simülatör - Hareket profili / tesis modeli
+ *
+ * hareket.c'yi basit bir FPGA pozisyon döngüsü modeline karşı çalıştırır;
+ * trapez ve S-eğrisi için hareket süresi, izleme hatası, aşım ve servo
+ * tick başına maliyeti raporlar. FPGA register dosyası burada tutulur:
+ * profil REG_TARGET_POS / REG_SPEED yazar, model REG_CURRENT_POS'u günceller.
+ *
+ * Model: FPGA hız komutu kp * (hedef - konum), |komut| <= REG_SPEED *
+ * pwm-hiz; motor hızı komutu tau zaman sabitiyle izler. --pid verilirse
+ * eksenlerde PID döngüsü (pid.c) çalışır, FPGA hız/yön modundadır:
+ * komut = ±REG_SPEED * pwm-hiz (REG_DIRECTION'a göre).
+ *
+ * Kullanım:
+ *   burjuva-profil [--mesafe 10000] [--vmax 20000] [--amax 200000]
+ *                  [--jmax 10000000] [--pwm 255] [--pwm-min 32]
+ *                  [--kp 100] [--tau 15] [--pwm-hiz 100] [--eksen 1]
+ *                  [--pid KP:KI:KD[:KVFF[:KAFF]]] [--csv <dosya>]
+ *
+ * Tick maliyeti host'un cycle sayacıyla (x86 TSC, yoksa ns) ölçülür;
+ * 72 MHz Cortex-M3 üzerindeki değer için "servo" komutuna bakın.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "hareket.h"
+#include "pid.h"
+#include "servo.h"
+#include "fpga.h"
+#include "olay.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define OLCU_BIRIM  "cyc"
+static uint64_t olcu(void) {
+    return __rdtsc();
+}
+#else
+#define OLCU_BIRIM  "ns"
+static uint64_t olcu(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+#define SLOT                2
+#define ALT_ADIM            10          // Model: tick başına entegrasyon adımı
+#define YERLESME_COUNT      2.0         // |hedef - konum| bu değerin altında kalmalı
+#define SURE_MAX_MS         60000
+
+typedef struct {
+    double pos;                 // count
+    double vel;                 // count/s
+} Motor;
+
+typedef struct {
+    double kp;                  // 1/s
+    double tau;                 // s
+    double pwm_hiz;             // count/s, PWM birimi başına
+} Model;
+
+typedef struct {
+    uint32_t sure_ms;           // Profil BITTI
+    uint32_t yerlesme_ms;       // Konum hedef bandına girip kaldı
+    double max_hata;            // |setpoint - konum|, hareket boyunca
+    double rms_hata;
+    double asim;                // Hedefin ötesine en uzak konum
+    double son_hata;
+    uint64_t tick_toplam;
+    uint64_t tick_max;
+    uint32_t tick_sayisi;
+} Sonuc;
+
+static uint8_t registers[256];
+static Motor motorlar[16];
+
+// ========== FPGA / servo karşılıkları ==========
+
+int FPGA_ReadRegister(uint8_t slot, uint8_t address, uint8_t* value) {
+    if (slot != SLOT || !value) {
+        return -1;
+    }
+    *value = registers[address];
+    return 0;
+}
+
+int FPGA_WriteRegister(uint8_t slot, uint8_t address, uint8_t value) {
+    if (slot != SLOT) {
+        return -1;
+    }
+    registers[address] = value;
+    return 0;
+}
+
+int FPGA_ReadBlock(uint8_t slot, uint8_t address, uint8_t* buffer, uint16_t length) {
+    if (slot != SLOT || !buffer || address + length > 256) {
+        return -1;
+    }
+    memcpy(buffer, &registers[address], length);
+    return 0;
+}
+
+int FPGA_WriteBlock(uint8_t slot, uint8_t address, const uint8_t* buffer, uint16_t length) {
+    if (slot != SLOT || !buffer || address + length > 256) {
+        return -1;
+    }
+    memcpy(&registers[address], buffer, length);
+    return 0;
+}
+
+int FPGA_Motor_Enable(FPGA_Motor_t *motor, uint8_t ctrl) {
+    return FPGA_WriteRegister(motor->slot, FPGA_MOTOR_REG_BASE(motor->channel) + REG_CONTROL_FLAGS,
+                              ctrl);
+}
+
+uint8_t Olay_Durduruldu(uint8_t slot, uint8_t ch) {
+    (void)slot;
+    (void)ch;
+    return 0;
+}
+
+void Servo_Kilit(void) {
+}
+
+void Servo_Birak(void) {
+}
+
+int Disli_Setpoint(uint8_t slot, uint8_t ch, int32_t* pos_q8, int32_t* hiz_q8) {
+    (void)slot;
+    (void)ch;
+    (void)pos_q8;
+    (void)hiz_q8;
+    return -1;
+}
+
+// ========== Model ==========
+
+static int32_t reg24(uint8_t base) {
+    int32_t v = ((int32_t)registers[base] << 16) | ((int32_t)registers[base + 1] << 8) |
+                registers[base + 2];
+    return (v & 0x800000) ? v - 0x1000000 : v;
+}
+
+static void konum_yaz(uint8_t ch, int32_t pos) {
+    uint8_t base = FPGA_MOTOR_REG_BASE(ch);
+    registers[base + REG_CURRENT_POS_HIGH] = (pos >> 16) & 0xFF;
+    registers[base + REG_CURRENT_POS_MID] = (pos >> 8) & 0xFF;
+    registers[base + REG_CURRENT_POS_LOW] = pos & 0xFF;
+}
+
+static void model_adim(const Model* m, uint8_t ch) {
+    uint8_t base = FPGA_MOTOR_REG_BASE(ch);
+    Motor* mt = &motorlar[ch];
+    double hedef = reg24(base + REG_TARGET_POS_HIGH);
+    double limit = registers[base + REG_SPEED] * m->pwm_hiz;
+    double dt = 1.0 / SERVO_HZ / ALT_ADIM;
+    
+    uint8_t flags = registers[base + REG_CONTROL_FLAGS];
+    uint8_t yon = registers[base + REG_DIRECTION];
+    
+    if (!(flags & CTRL_FLAG_ENABLE)) {
+        limit = 0;
+    }
+    
+    for (int i = 0; i < ALT_ADIM; i++) {
+        double komut = m->kp * (hedef - mt->pos);
+        if (flags & CTRL_FLAG_CONTROL_MODE) {
+            // Hız/yön modu: FPGA pozisyon döngüsü devre dışı
+            komut = (yon == DIRECTION_FORWARD) ? limit : (yon == DIRECTION_REVERSE) ? -limit : 0;
+        } else if (komut > limit) {
+            komut = limit;
+        } else if (komut < -limit) {
+            komut = -limit;
+        }
+        mt->vel += (komut - mt->vel) * dt / m->tau;
+        mt->pos += mt->vel * dt;
+    }
+    konum_yaz(ch, (int32_t)lround(mt->pos));
+}
+
+// ========== Koşu ==========
+
+static int kos(const char* ad, const Hareket_Param* param, const PID_Kazanc* pid,
+               int32_t mesafe, uint8_t eksen, const Model* m, FILE* csv, Sonuc* s) {
+    double kare_toplam = 0;
+    uint32_t hareket_tick = 0;
+    uint32_t bant_ms = 0;
+    uint32_t t;
+    
+    memset(s, 0, sizeof(*s));
+    memset(registers, 0, sizeof(registers));
+    memset(motorlar, 0, sizeof(motorlar));
+    
+    PID_Kapat(SLOT, PID_TUM_KANALLAR);
+    
+    for (uint8_t ch = 0; ch < eksen; ch++) {
+        if (pid && (PID_Ayarla(SLOT, ch, pid) != 0 || PID_Ac(SLOT, ch) != 0)) {
+            fprintf(stderr, "%s: gecersiz PID kazanci\n", ad);
+            return -1;
+        }
+        if (Hareket_Ayarla(SLOT, ch, param) != 0 || Hareket_Git(SLOT, ch, mesafe) != 0) {
+            fprintf(stderr, "%s: gecersiz profil parametresi\n", ad);
+            return -1;
+        }
+    }
+    
+    for (t = 1; t <= SURE_MAX_MS; t++) {
+        Hareket_Bilgi bilgi;
+        uint64_t start = olcu();
+        uint64_t sure;
+        double hata, ileri;
+        
+        Hareket_Tick();
+        PID_Tick();
+        sure = olcu() - start;
+        
+        for (uint8_t ch = 0; ch < eksen; ch++) {
+            model_adim(m, ch);
+        }
+        
+        Hareket_Oku(SLOT, 0, &bilgi);
+        hata = bilgi.setpoint - motorlar[0].pos;
+        ileri = (mesafe >= 0) ? motorlar[0].pos - mesafe : mesafe - motorlar[0].pos;
+        
+        if (bilgi.durum == HAREKET_SURUYOR) {
+            s->tick_toplam += sure;
+            s->tick_sayisi++;
+            if (sure > s->tick_max) {
+                s->tick_max = sure;
+            }
+            if (fabs(hata) > s->max_hata) {
+                s->max_hata = fabs(hata);
+            }
+            kare_toplam += hata * hata;
+            hareket_tick++;
+        } else if (s->sure_ms == 0) {
+            s->sure_ms = t;
+        }
+        if (ileri > s->asim) {
+            s->asim = ileri;
+        }
+        
+        if (fabs(motorlar[0].pos - mesafe) < YERLESME_COUNT) {
+            if (bant_ms == 0) {
+                bant_ms = t;
+            }
+        } else {
+            bant_ms = 0;
+        }
+        
+        if (csv) {
+            fprintf(csv, "%s,%u,%ld,%ld,%.2f,%.1f\n", ad, t, (long)bilgi.setpoint,
+                    (long)bilgi.hiz, motorlar[0].pos, motorlar[0].vel);
+        }
+        
+        // Profil bitti ve konum 100 ms boyunca bantta
+        if (s->sure_ms && bant_ms && t - bant_ms >= 100) {
+            break;
+        }
+    }
+    
+    s->yerlesme_ms = bant_ms ? bant_ms : t;
+    s->rms_hata = hareket_tick ? sqrt(kare_toplam / hareket_tick) : 0;
+    s->son_hata = fabs(motorlar[0].pos - mesafe);
+    return 0;
+}
+
+static void usage(const char* prog) {
+    fprintf(stderr,
+            "Kullanim: %s [--mesafe <count>] [--vmax <count/s>] [--amax <count/s2>]\n"
+            "          [--jmax <count/s3>] [--pwm <0-255>] [--pwm-min <0-255>]\n"
+            "          [--kp <1/s>] [--tau <ms>] [--pwm-hiz <count/s>] [--eksen <1-%d>]\n"
+            "          [--pid KP:KI:KD[:KVFF[:KAFF]]] [--csv <dosya>]\n"
+            "          (PID kazanclari micro birim, pid.h)\n",
+            prog, HAREKET_EKSEN_SAYISI);
+}
+
+int main(int argc, char* argv[]) {
+    Hareket_Param param = { 20000, 200000, 10000000, 255, 32 };
+    Model model = { 100.0, 0.015, 100.0 };
+    int32_t mesafe = 10000;
+    unsigned long eksen = 1;
+    PID_Kazanc pid = { 0, 0, 0, 0, 0, 255 };
+    uint8_t pid_var = 0;
+    const char* csv_path = NULL;
+    FILE* csv = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 2;
+        }
+        if (strcmp(argv[i], "--mesafe") == 0) {
+            mesafe = (int32_t)strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--vmax") == 0) {
+            param.vmax = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--amax") == 0) {
+            param.amax = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--jmax") == 0) {
+            param.jmax = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--pwm") == 0) {
+            param.pwm_max = (uint8_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--pwm-min") == 0) {
+            param.pwm_min = (uint8_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--kp") == 0) {
+            model.kp = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--tau") == 0) {
+            model.tau = strtod(argv[++i], NULL) / 1000.0;
+        } else if (strcmp(argv[i], "--pwm-hiz") == 0) {
+            model.pwm_hiz = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--eksen") == 0) {
+            eksen = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--pid") == 0) {
+            char* p = argv[++i];
+            int32_t* alanlar[5] = { &pid.kp, &pid.ki, &pid.kd, &pid.kvff, &pid.kaff };
+            for (int n = 0; n < 5 && *p; n++) {
+                *alanlar[n] = (int32_t)strtol(p, &p, 10);
+                if (*p == ':') {
+                    p++;
+                }
+            }
+            pid_var = 1;
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            csv_path = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    
+    if (eksen < 1 || eksen > HAREKET_EKSEN_SAYISI || model.kp <= 0 || model.tau <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (csv_path) {
+        csv = fopen(csv_path, "w");
+        if (!csv) {
+            perror(csv_path);
+            return 1;
+        }
+        fprintf(csv, "profil,ms,setpoint,hiz,konum,motor_hiz\n");
+    }
+    
+    printf("mesafe %ld count, vmax %lu, amax %lu, jmax %lu, %lu eksen; "
+           "model kp %.0f/s, tau %.0f ms, %.0f count/s/pwm\n",
+           (long)mesafe, (unsigned long)param.vmax, (unsigned long)param.amax,
+           (unsigned long)param.jmax, eksen, model.kp, model.tau * 1000, model.pwm_hiz);
+    if (pid_var) {
+        printf("PID (micro) kp %ld, ki %ld, kd %ld, kvff %ld, kaff %ld; FPGA hiz/yon modu\n",
+               (long)pid.kp, (long)pid.ki, (long)pid.kd, (long)pid.kvff, (long)pid.kaff);
+    }
+    printf("%-8s %7s %8s %11s %9s %9s %7s %9s %10s %10s\n", "profil", "pencere", "sure ms",
+           "yerlesme ms", "max hata", "rms hata", "asim", "son hata",
+           "ort " OLCU_BIRIM "/tick", "max " OLCU_BIRIM "/tick");
+    
+    for (int run = 0; run < 2; run++) {
+        const char* ad = run ? "s-egri" : "trapez";
+        Hareket_Param p = param;
+        Hareket_Bilgi bilgi;
+        Sonuc s;
+        
+        if (run == 0) {
+            p.jmax = 0;
+        } else if (param.jmax == 0) {
+            break;
+        }
+        if (kos(ad, &p, pid_var ? &pid : NULL, mesafe, (uint8_t)eksen, &model, csv, &s) != 0) {
+            return 1;
+        }
+        Hareket_Oku(SLOT, 0, &bilgi);
+        
+        printf("%-8s %7u %8lu %11lu %9.1f %9.1f %7.1f %9.2f %10.0f %10llu\n", ad, bilgi.pencere,
+               (unsigned long)s.sure_ms, (unsigned long)s.yerlesme_ms, s.max_hata, s.rms_hata,
+               s.asim, s.son_hata,
+               s.tick_sayisi ? (double)s.tick_toplam / s.tick_sayisi : 0.0,
+               (unsigned long long)s.tick_max);
+    }
+    
+    if (csv) {
+        fclose(csv);
+    }
+    return 0;
+}
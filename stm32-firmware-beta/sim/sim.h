@@ -0,0 +1,47 @@
+/**
+ * Burjuva Simülatör - Host tarafı slot cihaz modelleri
+ * 
+ * Firmware komut katmanı (komut.c) ve modül sürücüleri host'ta
+ * derlenir; SPI sürücüsü (spisurucu.c) yerine sim_spi.c, 1-Wire modül
+ * algılama (modul_algilama.c) yerine sim_modul.c bağlanır. UART bir
+ * pseudo-terminal'dir (sim_main.c).
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include "stm32f10x.h"
+#include "modul_algilama.h"
+
+// SPI slot cihazı: CS LOW ile çerçeve başlar, CS HIGH ile biter
+typedef struct {
+    void (*select)(uint8_t slot);
+    uint8_t (*exchange)(uint8_t slot, uint8_t mosi);
+    void (*deselect)(uint8_t slot);
+} Sim_SpiCihaz;
+
+extern const Sim_SpiCihaz sim_icjx;        // IO16: iC-JX echo protokolü
+extern const Sim_SpiCihaz sim_max11300;    // AIO20: MAX11300 register dosyası
+extern const Sim_SpiCihaz sim_ice40;       // FPGA: iCE40 SPI slave yapılandırma
+
+// Slot tablosu (modül algılama ve SPI yönlendirmesi)
+void Sim_SlotAyarla(uint8_t slot, Modul_Tip type);
+Modul_Tip Sim_SlotTipi(uint8_t slot);
+
+// SPI hattında gerçek donanımda geçecek süre (CS gecikmeleri + byte'lar)
+// Son Sim_SpiSureSifirla'dan beri, µs
+uint32_t Sim_SpiSure(void);
+void Sim_SpiSureSifirla(void);
+
+// Cihaz durumunu sıfırla (açılış)
+void Sim_IcjxReset(uint8_t slot);
+void Sim_Max11300Reset(uint8_t slot);
+
+// GPIO çıkışı değişti: slot 2 CRESET (PB1) kenarları, CDONE (PB10)
+void Sim_Ice40Pinler(GPIO_TypeDef* port);
+
+// iC-JX çerçevelerinin binde permil'ini boz (0 = kapalı)
+void Sim_IcjxHataOrani(uint16_t permil);
+
+#endif // SIM_H
@@ -0,0 +1,110 @@
+/**
+ * Burjuva Simülatör - iCE40 (FPGA) SPI slave yapılandırma modeli
+ *
+ * Slot 2 FPGA'sı CRESET = PB1, CDONE = PB10 (sim GPIO'da IDR = ODR,
+ * CDONE biti model tarafından sürülür).
+ *
+ *   CRESET LOW             -> yapılandırma silinir, CDONE LOW
+ *   CRESET HIGH, CS LOW    -> SPI slave yapılandırma: 7E AA 99 7E
+ *                             preamble'ı aranır, ardından gelen akışta
+ *                             wakeup komutu (01 06) ve en az bir boş
+ *                             byte saat -> CDONE HIGH
+ *   CRESET HIGH, CS HIGH   -> SPI master (harici flash) yok: yapılandırmasız
+ *
+ * Komut akışı çözülmez: veri içinde 01 06 geçip ardından sıfır olmayan
+ * byte gelirse wakeup sayılmaz. MISO her zaman 0xFF (register erişimi
+ * fpga.c'de bellekte).
+ */
+
+#include "sim.h"
+#include "stm32f10x_gpio.h"
+
+#define ICE40_SLOT          2
+#define CRESET_PIN          GPIO_Pin_1
+#define CDONE_PIN           GPIO_Pin_10
+#define PREAMBLE            0x7EAA997EUL
+
+typedef enum {
+    ICE40_BOS = 0,          // Yapılandırmasız
+    ICE40_PREAMBLE,         // CRESET sonrası, preamble bekleniyor
+    ICE40_VERI,             // Bitstream alınıyor
+    ICE40_CALISIYOR         // CDONE HIGH
+} Ice40_Durum;
+
+static uint8_t durum = ICE40_BOS;
+static uint8_t creset = 1;
+static uint8_t secili = 0;
+static uint32_t kaydirma = 0;
+static uint8_t onceki = 0;
+static uint8_t wakeup = 0;
+
+static void cdone_yaz(uint8_t high) {
+    if (high) {
+        GPIOB->ODR |= CDONE_PIN;
+    } else {
+        GPIOB->ODR &= ~(uint32_t)CDONE_PIN;
+    }
+}
+
+void Sim_Ice40Pinler(GPIO_TypeDef* port) {
+    uint8_t yeni;
+
+    if (port != GPIOB || Sim_SlotTipi(ICE40_SLOT) != MODUL_FPGA) {
+        return;
+    }
+    yeni = (GPIOB->ODR & CRESET_PIN) ? 1 : 0;
+    if (yeni == creset) {
+        return;
+    }
+    creset = yeni;
+
+    if (!creset) {
+        durum = ICE40_BOS;
+        cdone_yaz(0);
+    } else if (secili) {
+        durum = ICE40_PREAMBLE;
+        kaydirma = 0;
+        wakeup = 0;
+    }
+}
+
+static void ice40_select(uint8_t slot) {
+    if (slot == ICE40_SLOT) {
+        secili = 1;
+    }
+}
+
+static uint8_t ice40_exchange(uint8_t slot, uint8_t mosi) {
+    if (slot != ICE40_SLOT || !creset) {
+        return 0xFF;
+    }
+
+    if (durum == ICE40_PREAMBLE) {
+        kaydirma = (kaydirma << 8) | mosi;
+        if (kaydirma == PREAMBLE) {
+            durum = ICE40_VERI;
+            onceki = 0;
+        }
+    } else if (durum == ICE40_VERI) {
+        if (wakeup && mosi == 0x00) {
+            durum = ICE40_CALISIYOR;
+            cdone_yaz(1);
+        } else {
+            wakeup = (onceki == 0x01 && mosi == 0x06);
+        }
+        onceki = mosi;
+    }
+    return 0xFF;
+}
+
+static void ice40_deselect(uint8_t slot) {
+    if (slot == ICE40_SLOT) {
+        secili = 0;
+    }
+}
+
+const Sim_SpiCihaz sim_ice40 = {
+    ice40_select,
+    ice40_exchange,
+    ice40_deselect
+};
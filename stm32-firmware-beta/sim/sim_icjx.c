@@ -0,0 +1,127 @@
+/**
+ * Burjuva Simülatör - iC-JX (IO16) SPI modeli
+ * 
+ * 16kanaldijital.c'nin beklediği echo protokolü:
+ * 
+ *   Yazma: MOSI  ADDR  COUNT  D0 .. Dn-1  END_ADDR  CTRL
+ *          MISO  --    ADDR   COUNT .. Dn-2  Dn-1   CTRL
+ *   Okuma: MOSI  ADDR  NOP    COUNT  echo(D0) .. echo(Dn-1)  CTRL
+ *          MISO  --    ADDR   D0     D1 ..      --           CTRL
+ * 
+ * Yazılan değerler çerçeve CTRL byte'ı ile tamamlanınca register
+ * dosyasına uygulanır. Giriş register'ları çıkış register'larını
+ * geri okur (çıkışlar girişlere bağlı test kablosu gibi).
+ * 
+ * Sim_IcjxHataOrani ile çerçevelerin bir kısmı bozulur: CTRL echo'su
+ * yanlış döner ve yazma uygulanmaz (hat gürültüsü gibi).
+ */
+
+#include "sim.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ICJX_REG_INPUT_A        0x00
+#define ICJX_REG_INPUT_B        0x01
+#define ICJX_REG_OUTPUT_A       0x0C
+#define ICJX_REG_OUTPUT_B       0x0D
+#define ICJX_REG_INFO           0x1D
+
+#define ICJX_CTRL_BYTE          0x59
+#define ICJX_INFO_VALUE         0x21    // 0x00 / 0xFF dışında: chip cevap veriyor
+
+typedef struct {
+    uint8_t reg[32];
+    uint8_t pending[16];    // Yazma çerçevesinin verisi (CTRL'de uygulanır)
+    uint8_t addr;           // Çerçevenin ilk byte'ı
+    uint8_t count;
+    uint8_t index;          // Çerçevedeki byte sırası
+    uint8_t last;           // Önceki MOSI byte'ı (echo)
+    uint8_t corrupt;        // Bu çerçeve bozuk (hata enjeksiyonu)
+} Icjx;
+
+static Icjx chips[4];
+static uint16_t hata_permil = 0;
+
+void Sim_IcjxHataOrani(uint16_t permil) {
+    hata_permil = permil;
+}
+
+static uint8_t icjx_read(const Icjx* chip, uint8_t ra) {
+    ra &= 0x1F;
+    if (ra == ICJX_REG_INPUT_A) {
+        return chip->reg[ICJX_REG_OUTPUT_A];
+    }
+    if (ra == ICJX_REG_INPUT_B) {
+        return chip->reg[ICJX_REG_OUTPUT_B];
+    }
+    return chip->reg[ra];
+}
+
+void Sim_IcjxReset(uint8_t slot) {
+    Icjx* chip = &chips[slot & 3];
+    memset(chip, 0, sizeof(*chip));
+    chip->reg[ICJX_REG_INFO] = ICJX_INFO_VALUE;
+}
+
+static void icjx_select(uint8_t slot) {
+    chips[slot & 3].index = 0;
+    chips[slot & 3].corrupt = hata_permil > 0 && (uint16_t)(rand() % 1000) < hata_permil;
+}
+
+static uint8_t icjx_exchange(uint8_t slot, uint8_t mosi) {
+    Icjx* chip = &chips[slot & 3];
+    uint8_t k = chip->index;
+    uint8_t ra = (chip->addr >> 1) & 0x1F;
+    uint8_t miso = chip->last;
+    
+    if (chip->index < 255) {
+        chip->index++;
+    }
+    
+    if (k == 0) {
+        chip->addr = mosi;
+        chip->count = 0;
+    } else if (!(chip->addr & 0x01)) {
+        // Yazma
+        if (k == 1) {
+            chip->count = (mosi >> 4) + 1;
+            miso = chip->addr;
+        } else if (k >= 2 && k < 2 + chip->count) {
+            chip->pending[k - 2] = mosi;
+        } else if (k == 3 + chip->count) {
+            miso = chip->corrupt ? (uint8_t)~ICJX_CTRL_BYTE : ICJX_CTRL_BYTE;
+            if (mosi == ICJX_CTRL_BYTE && !chip->corrupt) {
+                for (uint8_t i = 0; i < chip->count; i++) {
+                    if (ra + i < 32) {
+                        chip->reg[ra + i] = chip->pending[i];
+                    }
+                }
+            }
+        }
+    } else {
+        // Okuma
+        if (k == 1) {
+            miso = chip->addr;
+        } else if (k == 2) {
+            chip->count = (mosi >> 4) + 1;
+            miso = icjx_read(chip, ra);
+        } else if (k < 2 + chip->count) {
+            miso = icjx_read(chip, ra + (k - 2));
+        } else if (k == 3 + chip->count) {
+            miso = chip->corrupt ? (uint8_t)~ICJX_CTRL_BYTE : ICJX_CTRL_BYTE;
+        }
+    }
+    
+    chip->last = mosi;
+    return miso;
+}
+
+static void icjx_deselect(uint8_t slot) {
+    chips[slot & 3].index = 0;
+}
+
+const Sim_SpiCihaz sim_icjx = {
+    icjx_select,
+    icjx_exchange,
+    icjx_deselect
+};
@@ -0,0 +1,425 @@
+/**
+ * Burjuva Simülatör - Ana döngü
+ *
+ * Firmware'in komut katmanını bir pseudo-terminal üzerinden sunar:
+ * main.c'deki açılış ve ana döngü aynen çalışır, USART1 yerine pty
+ * master ucu, SysTick yerine CLOCK_MONOTONIC kullanılır.
+ *
+ * Kullanım:
+ *   burjuva-sim [--slots io16,aio20,fpga,io16] [--link /tmp/burjuva]
+ *               [--baud 115200] [--spi-sure] [--icjx-hata 50]
+ *               [--flash flash.bin] [--betik program.bin]
+ *
+ * --slots     Slot 0-3 modül tipleri (io16, aio20, fpga, -)
+ * --link      Slave pty yoluna sembolik bağlantı (istemcide sabit -p)
+ * --baud      Çıkışı UART byte süresine göre yavaşlat (0 = sınırsız)
+ * --spi-sure  Her komuttan ve arka plan turundan sonra gerçek SPI hattında
+ *             geçecek süre kadar bekle; arka plan turu bir RX byte süresini
+ *             aşar ve bu sürede iki byte birikirse stats rx_tasma sayar
+ * --icjx-hata IO16 SPI çerçevelerinin binde kaçı bozulsun (tekrar katmanı testi)
+ * --flash     256 KB flash dosyası: FPGA bitstream imajı yeniden açılışta kalır
+ * --betik     Açılışta yüklenip başlatılan bytecode (betik_asm.py çıktısı)
+ */
+
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+
+#include "stm32f10x.h"
+#include "spisurucu.h"
+#include "modul_algilama.h"
+#include "uart_helper.h"
+#include "komut.h"
+#include "istatistik.h"
+#include "darbe.h"
+#include "servo.h"
+#include "kuyruk.h"
+#include "olay.h"
+#include "referans.h"
+#include "kural.h"
+#include "betik.h"
+#include "yukleme.h"
+#include "fpga.h"
+#include "tick.h"
+#include "sim.h"
+#include "stm32f10x_flash.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+void SysTick_Handler(void);
+
+#define TX_BUFFER_SIZE      8192
+
+static int pty_fd = -1;
+static uint8_t tx_buffer[TX_BUFFER_SIZE];
+static size_t tx_len = 0;
+static uint32_t baud = 0;
+static const char* link_path = NULL;
+static volatile sig_atomic_t running = 1;
+
+// ========== USART1 (pty) ==========
+
+static void sleep_us(uint64_t us) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)(us / 1000000);
+    ts.tv_nsec = (long)(us % 1000000) * 1000;
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR && running);
+}
+
+static void tx_flush(void) {
+    size_t done = 0;
+    
+    while (done < tx_len) {
+        ssize_t n = write(pty_fd, tx_buffer + done, tx_len - done);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;  // İstemci yok: çıkış düşer (gerçek UART gibi)
+        }
+        done += (size_t)n;
+    }
+    
+    // 8N1: byte başına 10 bit
+    if (baud > 0 && tx_len > 0) {
+        sleep_us((uint64_t)tx_len * 10 * 1000000 / baud);
+    }
+    tx_len = 0;
+}
+
+FlagStatus USART_GetFlagStatus(USART_TypeDef* USARTx, uint16_t USART_FLAG) {
+    int bekleyen = 0;
+    
+    (void)USARTx;
+    if (USART_FLAG == USART_FLAG_RXNE) {
+        // Host'un yazıp ana döngünün henüz okumadığı byte
+        return (ioctl(pty_fd, FIONREAD, &bekleyen) == 0 && bekleyen > 0) ? SET : RESET;
+    }
+    return SET;     // TX her zaman boş
+}
+
+void USART_SendData(USART_TypeDef* USARTx, uint16_t Data) {
+    USARTx->DR = Data;
+    if (tx_len == TX_BUFFER_SIZE) {
+        tx_flush();
+    }
+    tx_buffer[tx_len++] = (uint8_t)Data;
+}
+
+uint16_t USART_ReceiveData(USART_TypeDef* USARTx) {
+    return USARTx->DR;
+}
+
+// ========== SysTick ==========
+
+static uint64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static void tick_update(uint64_t* last) {
+    uint64_t now = now_ms();
+    while (*last < now) {
+        SysTick_Handler();
+        Servo_Tick();       // SERVO_HZ == TICK_HZ
+        (*last)++;
+    }
+}
+
+// ========== USART1 RX taşması ==========
+
+/* Donanımda arka plan görevleri süresince RX yoklanmaz: RXNE tek byte
+ * tutar, ikinci byte gelirse ORE. Görevlerin SPI süresi beklenir, pty'de
+ * iki byte birikmişse taşma sayılır (host satırı tek seferde yazar, byte
+ * aralığı UART byte süresi kabul edilir). */
+static void rx_tasma_yokla(uint32_t sure_us) {
+    uint32_t bayt_us = 10 * 1000000 / (baud ? baud : 115200);
+    int bekleyen = 0;
+    
+    sleep_us(sure_us);
+    if (sure_us > bayt_us && ioctl(pty_fd, FIONREAD, &bekleyen) == 0 && bekleyen >= 2) {
+        Istatistik_RxTasma();
+    }
+}
+
+// ========== FPGA INT ==========
+
+// INT hattı PB0 (aktif LOW); GPIO_ReadInputDataBit ODR'yi okur
+static void int_pin(uint8_t low) {
+    if (low) {
+        GPIOB->ODR &= ~1UL;
+    } else {
+        GPIOB->ODR |= 1UL;
+    }
+}
+
+/* Slot 2 INT hattı: bekleyen olay özeti boş değilken LOW (açık-drain).
+ * EXTI0 düşen kenarı yalnızca hat HIGH'dan LOW'a inerken kesme üretir;
+ * EXTI->SWIER yazılımla bekleyen kesmeyi ayrıca tetikler. */
+static void fpga_int_update(void) {
+    static uint8_t int_low = 0;
+    uint8_t lo = 0, hi = 0;
+    uint8_t low;
+    
+    FPGA_ReadRegister(OLAY_SLOT, FPGA_REG_EVENT_PENDING_LOW, &lo);
+    FPGA_ReadRegister(OLAY_SLOT, FPGA_REG_EVENT_PENDING_HIGH, &hi);
+    low = (lo | hi) != 0;
+    int_pin(low);
+    
+    // Düşen kenar veya yazılım tetiği (EXTI->SWIER)
+    if (((low && !int_low && (EXTI->FTSR & 1)) || (EXTI->SWIER & 1)) && (EXTI->IMR & 1)) {
+        EXTI->SWIER &= ~1UL;
+        EXTI0_IRQHandler();
+        FPGA_ReadRegister(OLAY_SLOT, FPGA_REG_EVENT_PENDING_LOW, &lo);
+        FPGA_ReadRegister(OLAY_SLOT, FPGA_REG_EVENT_PENDING_HIGH, &hi);
+        low = (lo | hi) != 0;
+        int_pin(low);
+    }
+    int_low = low;
+}
+
+// ========== Kurulum ==========
+
+static int parse_slots(const char* list) {
+    char copy[64];
+    char* save = NULL;
+    uint8_t slot = 0;
+    
+    if (strlen(list) >= sizeof(copy)) {
+        return -1;
+    }
+    strcpy(copy, list);
+    
+    for (char* name = strtok_r(copy, ",", &save); name; name = strtok_r(NULL, ",", &save)) {
+        Modul_Tip type;
+        
+        if (slot >= MODUL_SLOT_SAYISI) {
+            return -1;
+        }
+        if (strcmp(name, "io16") == 0) {
+            type = MODUL_IO16;
+        } else if (strcmp(name, "aio20") == 0) {
+            type = MODUL_AIO20;
+        } else if (strcmp(name, "fpga") == 0) {
+            type = MODUL_FPGA;
+        } else if (strcmp(name, "-") == 0) {
+            type = MODUL_YOK;
+        } else {
+            return -1;
+        }
+        Sim_SlotAyarla(slot++, type);
+    }
+    
+    while (slot < MODUL_SLOT_SAYISI) {
+        Sim_SlotAyarla(slot++, MODUL_YOK);
+    }
+    return 0;
+}
+
+/**
+ * Bytecode dosyasını oku (firmware yüklemesiyle aynı doğrulama açılışta)
+ * @return byte sayısı, -1: okunamadı / çok büyük
+ */
+static int read_betik(const char* path, uint8_t* buf) {
+    FILE* f = fopen(path, "rb");
+    size_t n;
+    
+    if (!f) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    n = fread(buf, 1, BETIK_BOYUT_MAX + 1, f);
+    fclose(f);
+    if (n == 0 || n > BETIK_BOYUT_MAX) {
+        fprintf(stderr, "%s: betik 1-%d byte olmali\n", path, BETIK_BOYUT_MAX);
+        return -1;
+    }
+    return (int)n;
+}
+
+static int open_pty(int* slave_fd) {
+    struct termios tio;
+    const char* slave_name;
+    
+    pty_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (pty_fd < 0 || grantpt(pty_fd) != 0 || unlockpt(pty_fd) != 0) {
+        perror("pty");
+        return -1;
+    }
+    slave_name = ptsname(pty_fd);
+    
+    // Slave ucu açık tutulur: istemci bağlanıp ayrılınca master EIO vermez
+    *slave_fd = open(slave_name, O_RDWR | O_NOCTTY);
+    if (*slave_fd < 0 || tcgetattr(*slave_fd, &tio) != 0) {
+        perror(slave_name);
+        return -1;
+    }
+    cfmakeraw(&tio);
+    tcsetattr(*slave_fd, TCSANOW, &tio);
+    
+    if (link_path) {
+        unlink(link_path);
+        if (symlink(slave_name, link_path) != 0) {
+            perror(link_path);
+            return -1;
+        }
+    }
+    
+    printf("%s\n", link_path ? link_path : slave_name);
+    fflush(stdout);
+    return 0;
+}
+
+static void handle_signal(int sig) {
+    (void)sig;
+    running = 0;
+}
+
+static void usage(const char* prog) {
+    fprintf(stderr,
+            "Kullanim: %s [--slots io16,aio20,fpga,io16] [--link <yol>] [--baud <n>] [--spi-sure]\n"
+            "          [--icjx-hata <binde>] [--flash <dosya>] [--betik <dosya>]\n",
+            prog);
+}
+
+int main(int argc, char* argv[]) {
+    const char* slots = "io16,aio20,fpga,io16";
+    const char* flash_path = NULL;
+    const char* betik_path = NULL;
+    uint8_t spi_timing = 0;
+    uint8_t betik[BETIK_BOYUT_MAX + 1];
+    int betik_boyut = 0;
+    int cikis = 0;
+    int slave_fd = -1;
+    uint64_t last_tick;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--slots") == 0 && i + 1 < argc) {
+            slots = argv[++i];
+        } else if (strcmp(argv[i], "--link") == 0 && i + 1 < argc) {
+            link_path = argv[++i];
+        } else if (strcmp(argv[i], "--baud") == 0 && i + 1 < argc) {
+            baud = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--spi-sure") == 0) {
+            spi_timing = 1;
+        } else if (strcmp(argv[i], "--icjx-hata") == 0 && i + 1 < argc) {
+            Sim_IcjxHataOrani((uint16_t)strtoul(argv[++i], NULL, 10));
+        } else if (strcmp(argv[i], "--flash") == 0 && i + 1 < argc) {
+            flash_path = argv[++i];
+        } else if (strcmp(argv[i], "--betik") == 0 && i + 1 < argc) {
+            betik_path = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    
+    if (parse_slots(slots) != 0) {
+        fprintf(stderr, "Gecersiz slot listesi: %s\n", slots);
+        return 2;
+    }
+    if (betik_path && (betik_boyut = read_betik(betik_path, betik)) < 0) {
+        return 2;
+    }
+    Sim_FlashDosya(flash_path);
+    if (open_pty(&slave_fd) != 0) {
+        return 1;
+    }
+    
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+    
+    // main.c açılış sırası
+    SPI_Module_Init();
+    Tick_Init();
+    Istatistik_Init();
+    Yukleme_Init();
+    Darbe_Init();
+    Servo_Init();
+    Olay_Init();
+    int_pin(0);             // Çekme direnci: olay yokken HIGH
+    last_tick = now_ms();
+    Modul_Init();
+    UART_SendString("\r\n========================================\r\n"
+                    "  BURJUVA MOTOR CONTROLLER v1.0\r\n"
+                    "  Host Simulator - UART Command System\r\n"
+                    "========================================\r\n\r\n");
+    tx_flush();
+    
+    // Modüller kayıtlı olmalı: DOUT pinleri yüklemede çıkış yapılır
+    if (betik_path) {
+        if (Betik_Yukle(betik, (uint16_t)betik_boyut) != BETIK_OK) {
+            Betik_Bilgi b;
+            Betik_Oku(&b);
+            fprintf(stderr, "%s: adres %u'da gecersiz komut\n", betik_path, b.hatali_adres);
+            running = 0;
+            cikis = 2;
+        } else {
+            Betik_Calistir();
+        }
+    }
+    
+    while (running) {
+        struct pollfd pfd = { pty_fd, POLLIN, 0 };
+        uint8_t rx[256];
+        ssize_t n;
+        
+        Istatistik_Dongu();
+        
+        // Tick'ler en geç 1 ms gecikmeyle işlenir
+        if (poll(&pfd, 1, 1) > 0 && (pfd.revents & POLLIN)) {
+            n = read(pty_fd, rx, sizeof(rx));
+            if (n < 0 && errno != EINTR && errno != EAGAIN) {
+                break;
+            }
+            
+            for (ssize_t i = 0; i < n; i++) {
+                tick_update(&last_tick);
+                Sim_SpiSureSifirla();
+                
+                sim_usart1.DR = rx[i];
+                Komut_RxByte((uint8_t)USART_ReceiveData(USART1));
+                fpga_int_update();
+                
+                // Komut sonu: donanımda SPI hattının alacağı süre
+                if (spi_timing && Sim_SpiSure() > 0) {
+                    sleep_us(Sim_SpiSure());
+                }
+            }
+            tx_flush();
+        }
+        
+        tick_update(&last_tick);
+        fpga_int_update();
+        Sim_SpiSureSifirla();
+        Darbe_Isle();
+        Kuyruk_Isle();
+        Olay_Isle();
+        Referans_Isle();
+        Kural_Isle();
+        Betik_Isle();
+        if (Komut_SatirBos()) {
+            Modul_Izle();
+            tx_flush();
+        }
+        if (spi_timing && Sim_SpiSure() > 0) {
+            rx_tasma_yokla(Sim_SpiSure());
+        }
+    }
+    
+    if (link_path) {
+        unlink(link_path);
+    }
+    close(slave_fd);
+    close(pty_fd);
+    return cikis;
+}
@@ -0,0 +1,111 @@
+/**
+ * Burjuva Simülatör - MAX11300 (AIO20) SPI modeli
+ * 
+ * Çerçeve: [ADDR<<1 | RNW] ardından 16-bit register'lar MSB önce;
+ * çok kelimeli çerçevede adres her kelimede bir artar (burst).
+ * 
+ * ADC_DATA register'ları zamanla değişen sentetik sinyal döndürür:
+ * port başına farklı periyotlu üçgen dalga. AFE algılama portları
+ * (4, 7, 12, 17) 0-10V kartı değerinde sabittir. DAC moduna alınmış
+ * portun ADC'si DAC değerini geri okur.
+ */
+
+#include "sim.h"
+#include "max11300_regs.h"
+#include "tick.h"
+#include <string.h>
+
+#define MAX11300_REG_SAYISI     0x80
+#define AFE_0_10V_DEGERI        1080    // aio20_afe.h: 980-1180 → 0-10V kartı
+
+typedef struct {
+    uint16_t reg[MAX11300_REG_SAYISI];
+    uint8_t addr;
+    uint8_t rnw;
+    uint8_t index;
+    uint8_t msb;            // Yazılan kelimenin ilk byte'ı
+    uint16_t word;          // Okunan kelime
+} Max11300;
+
+static Max11300 chips[4];
+
+static uint16_t adc_sinyal(uint8_t slot, uint8_t port) {
+    const Max11300* chip = &chips[slot & 3];
+    uint16_t mode = chip->reg[MAX11300_REG_PORT_CFG_00 + port] & 0xF000;
+    
+    if (port == 4 || port == 7 || port == 12 || port == 17) {
+        return AFE_0_10V_DEGERI;
+    }
+    if (mode == MAX11300_MODE_5_AOUT || mode == MAX11300_MODE_6_AOUT_PD) {
+        return chip->reg[MAX11300_REG_DAC_DATA_PORT_00 + port] & 0x0FFF;
+    }
+    
+    // 0..4095..0, periyot (2 + port) saniye, slotlar faz kaydırmalı
+    uint32_t period = (2 + port) * 1000;
+    uint32_t t = (Tick_Ms() + slot * 250) % period;
+    uint32_t half = period / 2;
+    uint32_t up = (t < half) ? t : period - t;
+    return (uint16_t)(up * 4095 / half);
+}
+
+static uint16_t max11300_read(uint8_t slot, uint8_t addr) {
+    if (addr >= MAX11300_REG_ADC_DATA_PORT_00 && addr <= MAX11300_REG_ADC_DATA_PORT_19) {
+        return adc_sinyal(slot, addr - MAX11300_REG_ADC_DATA_PORT_00);
+    }
+    return (addr < MAX11300_REG_SAYISI) ? chips[slot & 3].reg[addr] : 0;
+}
+
+void Sim_Max11300Reset(uint8_t slot) {
+    Max11300* chip = &chips[slot & 3];
+    memset(chip, 0, sizeof(*chip));
+    chip->reg[MAX11300_REG_DEV_ID] = MAX11300_DEVICE_ID;
+}
+
+static void max11300_select(uint8_t slot) {
+    chips[slot & 3].index = 0;
+}
+
+static uint8_t max11300_exchange(uint8_t slot, uint8_t mosi) {
+    Max11300* chip = &chips[slot & 3];
+    uint8_t k = chip->index;
+    
+    if (chip->index < 255) {
+        chip->index++;
+    }
+    
+    if (k == 0) {
+        chip->addr = mosi >> 1;
+        chip->rnw = mosi & 0x01;
+        return 0x00;
+    }
+    
+    if (chip->rnw) {
+        if (k & 1) {
+            chip->word = max11300_read(slot, chip->addr);
+            return (uint8_t)(chip->word >> 8);
+        }
+        chip->addr++;
+        return (uint8_t)chip->word;
+    }
+    
+    if (k & 1) {
+        chip->msb = mosi;
+    } else {
+        // DEV_ID salt okunur
+        if (chip->addr != MAX11300_REG_DEV_ID && chip->addr < MAX11300_REG_SAYISI) {
+            chip->reg[chip->addr] = ((uint16_t)chip->msb << 8) | mosi;
+        }
+        chip->addr++;
+    }
+    return 0x00;
+}
+
+static void max11300_deselect(uint8_t slot) {
+    chips[slot & 3].index = 0;
+}
+
+const Sim_SpiCihaz sim_max11300 = {
+    max11300_select,
+    max11300_exchange,
+    max11300_deselect
+};
@@ -0,0 +1,257 @@
+/**
+ * Burjuva Simülatör - Modül algılama (modul_algilama.c yerine)
+ * 
+ * 1-Wire taraması yerine slot tablosu (sim_main.c --slots) kullanılır.
+ * Modüller açılışta kaydedilir, IO16 chip init'i gerçek sürücüyle
+ * simüle edilen iC-JX üzerinde çalışır. modul-algila[:rapor|:bin]
+ * ve modul-izle komutlarının yanıt formatları firmware ile aynıdır;
+ * hot-plug olayı üretilmez.
+ */
+
+#include "modul_algilama.h"
+#include "16kanaldijital.h"
+#include "20kanalanalogio.h"
+#include "fpga.h"
+#include "uart_helper.h"
+#include "sim.h"
+#include <string.h>
+#include <stdio.h>
+
+#define RAPOR_MAGIC         0xB5
+#define RAPOR_VERSIYON      1
+#define RAPOR_KAYIT_BOYUTU  32
+#define RAPOR_CERCEVE_BOYUTU (3 + MODUL_SLOT_SAYISI * RAPOR_KAYIT_BOYUTU + 1)
+
+static Modul_Slot slots[MODUL_SLOT_SAYISI];
+static uint8_t izle_aktif = 1;
+
+// 1-Wire CRC8 (modul_algilama.c ile aynı)
+static uint8_t crc8(const uint8_t* data, int len) {
+    uint8_t crc = 0;
+    for (int i = 0; i < len; i++) {
+        uint8_t inbyte = data[i];
+        for (int j = 0; j < 8; j++) {
+            uint8_t mix = (crc ^ inbyte) & 0x01;
+            crc >>= 1;
+            if (mix) crc ^= 0x8C;
+            inbyte >>= 1;
+        }
+    }
+    return crc;
+}
+
+static const char* module_kind_name(Modul_Tip type) {
+    switch (type) {
+        case MODUL_IO16:  return "io16";
+        case MODUL_AIO20: return "aio20";
+        case MODUL_FPGA:  return "fpga";
+        case MODUL_BILINMEYEN: return "?";
+        default: return "-";
+    }
+}
+
+/**
+ * Slot kimliği: UID family 0x2D + slot, HID "burjsimN", FID "<tip>" (8 byte, boşluk dolgulu)
+ */
+static void fill_identity(uint8_t slot, Modul_Slot* s) {
+    char text[9];
+    
+    s->uid[0] = 0x2D;
+    for (int i = 1; i < 7; i++) {
+        s->uid[i] = (i == 1) ? slot : 0x00;
+    }
+    s->uid[7] = crc8(s->uid, 7);
+    
+    sprintf(text, "burjsim%u", (unsigned)slot);
+    memcpy(s->hid, text, 8);
+    memset(s->fid, ' ', 8);
+    memcpy(s->fid, module_kind_name(s->type), strlen(module_kind_name(s->type)));
+}
+
+void Modul_Init(void) {
+    char line[48];
+    uint8_t found = 0;
+    
+    memset(slots, 0, sizeof(slots));
+    
+    for (uint8_t slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+        Modul_Slot* s = &slots[slot];
+        
+        s->type = Sim_SlotTipi(slot);
+        if (s->type == MODUL_YOK) {
+            continue;
+        }
+        s->present = 1;
+        fill_identity(slot, s);
+        found++;
+        
+        UART_QuietBegin();
+        if (s->type == MODUL_IO16) {
+            IO16_Register(slot);
+            Sim_SpiSureSifirla();
+            s->init_status = (IO16_ChipInit(slot) == 0) ? 0 : -1;
+            s->init_tries = 1;
+            s->init_us = Sim_SpiSure();
+        } else if (s->type == MODUL_AIO20) {
+            AIO20_Register(slot);
+        } else if (s->type == MODUL_FPGA) {
+            FPGA_Register(slot);
+        }
+        UART_QuietEnd();
+        s->registered = s->type;
+    }
+    
+    sprintf(line, "[INIT] %u module(s) ready (simulator)\r\n", (unsigned)found);
+    UART_SendString(line);
+}
+
+uint8_t Modul_Tara(uint8_t verbose) {
+    uint8_t found = 0;
+    char line[48];
+    
+    for (uint8_t slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+        if (slots[slot].present) {
+            found++;
+        }
+        if (verbose) {
+            sprintf(line, "Slot %02X: %s\r\n", (unsigned)slot,
+                    slots[slot].present ? module_kind_name(slots[slot].type) : "EMPTY");
+            UART_SendString(line);
+        }
+    }
+    return found;
+}
+
+const Modul_Slot* Modul_GetSlot(uint8_t slot) {
+    if (slot >= MODUL_SLOT_SAYISI) {
+        return NULL;
+    }
+    return &slots[slot];
+}
+
+void Modul_Izle(void) {
+    // Slot tablosu çalışma sırasında değişmez
+}
+
+void Modul_Izle_Komut(const char* arg) {
+    if (strcmp(arg, "on") == 0) {
+        izle_aktif = 1;
+    } else if (strcmp(arg, "off") == 0) {
+        izle_aktif = 0;
+    } else if (*arg) {
+        UART_SendError(UART_ST_ARG, "Hata: modul-izle:on veya modul-izle:off\r\n");
+        return;
+    }
+    
+    UART_SendString(izle_aktif ? "Hot-plug izleme: acik\r\n" : "Hot-plug izleme: kapali\r\n");
+    UART_Reply(UART_ST_OK, izle_aktif ? "on" : "off");
+    UART_SendComplete("modul-izle");
+}
+
+static void hex8_append(char* out, const uint8_t* data) {
+    static const char hex[] = "0123456789ABCDEF";
+    for (int i = 0; i < 8; i++) {
+        *out++ = hex[data[i] >> 4];
+        *out++ = hex[data[i] & 0x0F];
+    }
+    *out = '\0';
+}
+
+static void format_record(uint8_t slot, char* out) {
+    const Modul_Slot* s = &slots[slot];
+    char uid[17], hid[17], fid[17];
+    
+    if (!s->present) {
+        sprintf(out, "%u 0", (unsigned)slot);
+        return;
+    }
+    hex8_append(uid, s->uid);
+    hex8_append(hid, s->hid);
+    hex8_append(fid, s->fid);
+    sprintf(out, "%u %u %s %s %s %d %lu", (unsigned)slot, (unsigned)s->type,
+            uid, hid, fid, (int)s->init_status, (unsigned long)s->init_us);
+}
+
+static uint16_t build_frame(uint8_t* frame) {
+    uint16_t n = 0;
+    
+    frame[n++] = RAPOR_MAGIC;
+    frame[n++] = RAPOR_VERSIYON;
+    frame[n++] = MODUL_SLOT_SAYISI;
+    
+    for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+        const Modul_Slot* s = &slots[slot];
+        uint8_t* r = &frame[n];
+        
+        memset(r, 0, RAPOR_KAYIT_BOYUTU);
+        r[0] = slot;
+        if (s->present) {
+            r[1] = (uint8_t)s->type;
+            r[2] = (uint8_t)s->init_status;
+            r[3] = s->init_tries;
+            memcpy(&r[4], s->uid, 8);
+            memcpy(&r[12], s->hid, 8);
+            memcpy(&r[20], s->fid, 8);
+            r[28] = (uint8_t)(s->init_us);
+            r[29] = (uint8_t)(s->init_us >> 8);
+            r[30] = (uint8_t)(s->init_us >> 16);
+            r[31] = (uint8_t)(s->init_us >> 24);
+        }
+        n += RAPOR_KAYIT_BOYUTU;
+    }
+    
+    frame[n] = crc8(frame, n);
+    return n + 1;
+}
+
+void Modul_Komut_Isle(const char* arg) {
+    if (*arg == '\0') {
+        char summary[32];
+        
+        Modul_Tara(1);
+        
+        summary[0] = '\0';
+        for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+            if (slot > 0) {
+                strcat(summary, ",");
+            }
+            strcat(summary, slots[slot].present ? module_kind_name(slots[slot].type) : "-");
+        }
+        UART_Reply(UART_ST_OK, summary);
+    }
+    else if (strcmp(arg, "rapor") == 0) {
+        char report[MODUL_SLOT_SAYISI * 72];
+        char* p = report;
+        
+        for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+            if (slot > 0) {
+                *p++ = '|';
+            }
+            format_record(slot, p);
+            UART_SendString("MODUL ");
+            UART_SendString(p);
+            UART_SendString("\r\n");
+            p += strlen(p);
+        }
+        UART_Reply(UART_ST_OK, report);
+    }
+    else if (strcmp(arg, "bin") == 0) {
+        uint8_t frame[RAPOR_CERCEVE_BOYUTU];
+        char header[12];
+        
+        if (UART_GetMode() != UART_MODE_MACHINE || UART_InBatch()) {
+            UART_SendError(UART_ST_ARG, "Hata: modul-algila:bin sadece machine mode'da, tek komut olarak\r\n");
+            return;
+        }
+        
+        uint16_t len = build_frame(frame);
+        sprintf(header, "bin %u", (unsigned)len);
+        UART_Reply(UART_ST_OK, header);
+        UART_SendBytes(frame, len);
+    }
+    else {
+        UART_SendError(UART_ST_ARG, "Hata: modul-algila[:rapor|:bin]\r\n");
+        return;
+    }
+    UART_SendComplete("modul-algila");
+}
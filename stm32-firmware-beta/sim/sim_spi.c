@@ -0,0 +1,154 @@
+/**
+ * Burjuva Simülatör - SPI sürücüsü (spisurucu.c yerine)
+ * 
+ * spisurucu.h arayüzü aynen korunur; CS seçimi ve byte alışverişi
+ * slot tablosundaki cihaz modeline yönlendirilir. Gerçek sürücünün
+ * CS gecikmeleri ve SPI saat hızları süre sayacına eklenir, böylece
+ * simülatör istenirse donanım hızında cevap verebilir.
+ */
+
+#include "spisurucu.h"
+#include "sim.h"
+#include "istatistik.h"
+#include <stddef.h>
+
+// spisurucu.c'deki delay_us değerleri
+#define CS_ENABLE_US        160     // 10 + 50 + 100
+#define CS_DISABLE_US       60      // 50 + 10
+#define BYTE_GAP_US         20
+
+// Slot başına SPI saati (kHz): APB1 36 MHz / prescaler
+static const uint16_t slot_khz[5] = { 4500, 9000, 2250, 4500, 4500 };
+
+static Modul_Tip slot_types[4];
+static int current_cs_slot = -1;
+static uint32_t bus_ns = 0;
+
+static const Sim_SpiCihaz* slot_device(int slot) {
+    if (slot < 0 || slot > 3) {
+        return NULL;
+    }
+    switch (slot_types[slot]) {
+        case MODUL_IO16:  return &sim_icjx;
+        case MODUL_AIO20: return &sim_max11300;
+        case MODUL_FPGA:  return &sim_ice40;
+        default:          return NULL;    // Boş slot: MISO 0xFF
+    }
+}
+
+void Sim_SlotAyarla(uint8_t slot, Modul_Tip type) {
+    if (slot > 3) {
+        return;
+    }
+    slot_types[slot] = type;
+    if (type == MODUL_IO16) {
+        Sim_IcjxReset(slot);
+    } else if (type == MODUL_AIO20) {
+        Sim_Max11300Reset(slot);
+    }
+}
+
+Modul_Tip Sim_SlotTipi(uint8_t slot) {
+    return (slot < 4) ? slot_types[slot] : MODUL_YOK;
+}
+
+uint32_t Sim_SpiSure(void) {
+    return bus_ns / 1000;
+}
+
+void Sim_SpiSureSifirla(void) {
+    bus_ns = 0;
+}
+
+void SPI_Module_Init(void) {
+    current_cs_slot = -1;
+}
+
+int SPI_SetCS(spi_slot_t slot, chip_select_t cs) {
+    const Sim_SpiCihaz* device;
+    
+    if (slot < 0 || slot > 4) {
+        return -1;
+    }
+    
+    if (cs == CS_ENABLE) {
+        if (current_cs_slot == -1) {
+            bus_ns += CS_ENABLE_US * 1000;
+            current_cs_slot = slot;
+            Istatistik_SpiIslem(slot);
+            device = slot_device(slot);
+            if (device) {
+                device->select(slot);
+            }
+            return 0;
+        }
+        return (current_cs_slot == slot) ? 0 : -1;
+    }
+    
+    bus_ns += CS_DISABLE_US * 1000;
+    if (current_cs_slot == slot) {
+        device = slot_device(slot);
+        if (device) {
+            device->deselect(slot);
+        }
+        current_cs_slot = -1;
+        return 0;
+    }
+    return (current_cs_slot == -1) ? 0 : -1;
+}
+
+void SPI_Send(spi_slot_t slot, uint8_t data) {
+    SPI_DataExchange(slot, data);
+}
+
+uint8_t SPI_DataExchange(spi_slot_t slot, uint8_t mosi) {
+    const Sim_SpiCihaz* device;
+    int khz = (slot >= 0 && slot <= 4) ? slot_khz[slot] : 4500;
+    
+    bus_ns += BYTE_GAP_US * 1000 + 8 * 1000000 / khz;
+    Istatistik_SpiByte(slot);
+    
+    // MISO sadece seçili slottan gelir (CPLD multiplexer)
+    if (current_cs_slot != slot) {
+        return 0x00;
+    }
+    device = slot_device(slot);
+    return device ? device->exchange(slot, mosi) : 0xFF;
+}
+
+int SPI_Transfer(spi_slot_t slot, const uint8_t* tx_data, uint8_t* rx_data, uint16_t length) {
+    if (slot < 0 || slot > 4 || !tx_data || length == 0) {
+        return -1;
+    }
+    
+    for (uint16_t i = 0; i < length; i++) {
+        uint8_t received = SPI_DataExchange(slot, tx_data[i]);
+        
+        if (rx_data) {
+            rx_data[i] = received;
+        }
+    }
+    
+    return 0;
+}
+
+int SPI_BlokGonder(spi_slot_t slot, const uint8_t* tx_data, uint32_t length) {
+    const Sim_SpiCihaz* device;
+    int khz;
+    
+    if (slot < 0 || slot > 4 || !tx_data || length == 0) {
+        return -1;
+    }
+    
+    // Bayt arası bekleme yok: yalnızca SPI saati
+    khz = slot_khz[slot];
+    bus_ns += (uint32_t)((uint64_t)length * 8 * 1000000 / khz);
+    device = (current_cs_slot == slot) ? slot_device(slot) : NULL;
+    for (uint32_t i = 0; i < length; i++) {
+        Istatistik_SpiByte(slot);
+        if (device) {
+            device->exchange(slot, tx_data[i]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * Burjuva Simülatör - SPL GPIO karşılıkları
+ * 
+ * GPIO portları bellekte tutulur; ODR yazılır, IDR ODR'yi yansıtır.
+ * Çıkış değişimleri pin modellerine (sim_ice40.c CRESET) bildirilir.
+ * DWT cycle sayacı CLOCK_MONOTONIC'ten türetilir. USART fonksiyonları
+ * pseudo-terminal'e bağlı olduğu için sim_main.c'de. Flash bellek
+ * dizisidir, istenirse dosyaya yansıtılır.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "stm32f10x.h"
+#include "stm32f10x_flash.h"
+#include "sim.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+GPIO_TypeDef sim_gpio[4];
+USART_TypeDef sim_usart1;
+CoreDebug_Type sim_coredebug;
+TIM_TypeDef sim_tim2;
+EXTI_TypeDef sim_exti;
+AFIO_TypeDef sim_afio;
+uint8_t sim_flash[SIM_FLASH_SIZE];
+
+static const char* flash_path = NULL;
+static uint8_t flash_locked = 1;
+
+static DWT_Type dwt;
+
+DWT_Type* sim_dwt(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    dwt.CYCCNT = (uint32_t)(((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec) * 72 / 1000);
+    return &dwt;
+}
+
+void GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_InitStruct) {
+    (void)GPIOx;
+    (void)GPIO_InitStruct;
+}
+
+void GPIO_StructInit(GPIO_InitTypeDef* GPIO_InitStruct) {
+    GPIO_InitStruct->GPIO_Pin = GPIO_Pin_All;
+    GPIO_InitStruct->GPIO_Speed = GPIO_Speed_2MHz;
+    GPIO_InitStruct->GPIO_Mode = GPIO_Mode_IN_FLOATING;
+}
+
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin) {
+    return (GPIOx->ODR & GPIO_Pin) ? 1 : 0;
+}
+
+uint8_t GPIO_ReadOutputDataBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin) {
+    return (GPIOx->ODR & GPIO_Pin) ? 1 : 0;
+}
+
+void GPIO_SetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin) {
+    GPIOx->ODR |= GPIO_Pin;
+    Sim_Ice40Pinler(GPIOx);
+}
+
+void GPIO_ResetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin) {
+    GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+    Sim_Ice40Pinler(GPIOx);
+}
+
+void GPIO_WriteBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, BitAction BitVal) {
+    if (BitVal != Bit_RESET) {
+        GPIO_SetBits(GPIOx, GPIO_Pin);
+    } else {
+        GPIO_ResetBits(GPIOx, GPIO_Pin);
+    }
+}
+
+// ========== Flash ==========
+
+int Sim_FlashDosya(const char* path) {
+    FILE* f;
+    
+    memset(sim_flash, 0xFF, sizeof(sim_flash));
+    flash_path = path;
+    if (!path) {
+        return 0;
+    }
+    
+    // Dosya yoksa silinmiş flash ile başlanır, ilk yazmada oluşur
+    f = fopen(path, "rb");
+    if (f) {
+        size_t n = fread(sim_flash, 1, sizeof(sim_flash), f);
+        (void)n;
+        fclose(f);
+    }
+    return 0;
+}
+
+static void flash_kaydet(void) {
+    FILE* f;
+    
+    if (!flash_path) {
+        return;
+    }
+    f = fopen(flash_path, "wb");
+    if (f) {
+        fwrite(sim_flash, 1, sizeof(sim_flash), f);
+        fclose(f);
+    }
+}
+
+static int flash_adres_gecerli(uint32_t address, uint32_t size) {
+    return address >= SIM_FLASH_BASE && address + size <= SIM_FLASH_BASE + SIM_FLASH_SIZE;
+}
+
+void FLASH_Unlock(void) {
+    flash_locked = 0;
+}
+
+void FLASH_Lock(void) {
+    if (!flash_locked) {
+        flash_kaydet();
+    }
+    flash_locked = 1;
+}
+
+FLASH_Status FLASH_ErasePage(uint32_t Page_Address) {
+    uint32_t page = (Page_Address - SIM_FLASH_BASE) & ~(uint32_t)2047;
+    
+    if (flash_locked || !flash_adres_gecerli(Page_Address, 1)) {
+        return FLASH_ERROR_WRP;
+    }
+    memset(&sim_flash[page], 0xFF, 2048);
+    return FLASH_COMPLETE;
+}
+
+FLASH_Status FLASH_ProgramHalfWord(uint32_t Address, uint16_t Data) {
+    uint8_t* p = &sim_flash[Address - SIM_FLASH_BASE];
+    
+    if (flash_locked || (Address & 1) || !flash_adres_gecerli(Address, 2)) {
+        return FLASH_ERROR_WRP;
+    }
+    if (p[0] != 0xFF || p[1] != 0xFF) {
+        return FLASH_ERROR_PG;
+    }
+    p[0] = (uint8_t)Data;
+    p[1] = (uint8_t)(Data >> 8);
+    return FLASH_COMPLETE;
+}
+
+FLASH_Status FLASH_ProgramWord(uint32_t Address, uint32_t Data) {
+    FLASH_Status status = FLASH_ProgramHalfWord(Address, (uint16_t)Data);
+    
+    if (status == FLASH_COMPLETE) {
+        status = FLASH_ProgramHalfWord(Address + 2, (uint16_t)(Data >> 16));
+    }
+    return status;
+}
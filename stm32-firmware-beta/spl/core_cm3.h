@@ -125,6 +125,8 @@
 #define __DSB() __asm__ volatile ("dsb" ::: "memory")
 #define __ISB() __asm__ volatile ("isb" ::: "memory")
 #define __DMB() __asm__ volatile ("dmb" ::: "memory")
+#define __disable_irq() __asm__ volatile ("cpsid i" ::: "memory")
+#define __enable_irq()  __asm__ volatile ("cpsie i" ::: "memory")
 
 #endif /* __CORE_CM3_H_GENERIC */
 
@@ -7,16 +7,155 @@ void Default_Handler(void);
 
 void SystemInit(void) __attribute__((weak));
 
-// Vector table
+// Handlers not defined elsewhere fall back to Default_Handler
+#define WEAK_HANDLER(name) void name(void) __attribute__((weak, alias("Default_Handler")))
+
+WEAK_HANDLER(NMI_Handler);
+WEAK_HANDLER(HardFault_Handler);
+WEAK_HANDLER(MemManage_Handler);
+WEAK_HANDLER(BusFault_Handler);
+WEAK_HANDLER(UsageFault_Handler);
+WEAK_HANDLER(SVC_Handler);
+WEAK_HANDLER(DebugMon_Handler);
+WEAK_HANDLER(PendSV_Handler);
+WEAK_HANDLER(SysTick_Handler);
+WEAK_HANDLER(WWDG_IRQHandler);
+WEAK_HANDLER(PVD_IRQHandler);
+WEAK_HANDLER(TAMPER_IRQHandler);
+WEAK_HANDLER(RTC_IRQHandler);
+WEAK_HANDLER(FLASH_IRQHandler);
+WEAK_HANDLER(RCC_IRQHandler);
+WEAK_HANDLER(EXTI0_IRQHandler);
+WEAK_HANDLER(EXTI1_IRQHandler);
+WEAK_HANDLER(EXTI2_IRQHandler);
+WEAK_HANDLER(EXTI3_IRQHandler);
+WEAK_HANDLER(EXTI4_IRQHandler);
+WEAK_HANDLER(DMA1_Channel1_IRQHandler);
+WEAK_HANDLER(DMA1_Channel2_IRQHandler);
+WEAK_HANDLER(DMA1_Channel3_IRQHandler);
+WEAK_HANDLER(DMA1_Channel4_IRQHandler);
+WEAK_HANDLER(DMA1_Channel5_IRQHandler);
+WEAK_HANDLER(DMA1_Channel6_IRQHandler);
+WEAK_HANDLER(DMA1_Channel7_IRQHandler);
+WEAK_HANDLER(ADC1_2_IRQHandler);
+WEAK_HANDLER(USB_HP_CAN1_TX_IRQHandler);
+WEAK_HANDLER(USB_LP_CAN1_RX0_IRQHandler);
+WEAK_HANDLER(CAN1_RX1_IRQHandler);
+WEAK_HANDLER(CAN1_SCE_IRQHandler);
+WEAK_HANDLER(EXTI9_5_IRQHandler);
+WEAK_HANDLER(TIM1_BRK_IRQHandler);
+WEAK_HANDLER(TIM1_UP_IRQHandler);
+WEAK_HANDLER(TIM1_TRG_COM_IRQHandler);
+WEAK_HANDLER(TIM1_CC_IRQHandler);
+WEAK_HANDLER(TIM2_IRQHandler);
+WEAK_HANDLER(TIM3_IRQHandler);
+WEAK_HANDLER(TIM4_IRQHandler);
+WEAK_HANDLER(I2C1_EV_IRQHandler);
+WEAK_HANDLER(I2C1_ER_IRQHandler);
+WEAK_HANDLER(I2C2_EV_IRQHandler);
+WEAK_HANDLER(I2C2_ER_IRQHandler);
+WEAK_HANDLER(SPI1_IRQHandler);
+WEAK_HANDLER(SPI2_IRQHandler);
+WEAK_HANDLER(USART1_IRQHandler);
+WEAK_HANDLER(USART2_IRQHandler);
+WEAK_HANDLER(USART3_IRQHandler);
+WEAK_HANDLER(EXTI15_10_IRQHandler);
+WEAK_HANDLER(RTCAlarm_IRQHandler);
+WEAK_HANDLER(USBWakeUp_IRQHandler);
+WEAK_HANDLER(TIM8_BRK_IRQHandler);
+WEAK_HANDLER(TIM8_UP_IRQHandler);
+WEAK_HANDLER(TIM8_TRG_COM_IRQHandler);
+WEAK_HANDLER(TIM8_CC_IRQHandler);
+WEAK_HANDLER(ADC3_IRQHandler);
+WEAK_HANDLER(FSMC_IRQHandler);
+WEAK_HANDLER(SDIO_IRQHandler);
+WEAK_HANDLER(TIM5_IRQHandler);
+WEAK_HANDLER(SPI3_IRQHandler);
+WEAK_HANDLER(UART4_IRQHandler);
+WEAK_HANDLER(UART5_IRQHandler);
+WEAK_HANDLER(TIM6_IRQHandler);
+WEAK_HANDLER(TIM7_IRQHandler);
+WEAK_HANDLER(DMA2_Channel1_IRQHandler);
+WEAK_HANDLER(DMA2_Channel2_IRQHandler);
+WEAK_HANDLER(DMA2_Channel3_IRQHandler);
+WEAK_HANDLER(DMA2_Channel4_5_IRQHandler);
+
+// Vector table (STM32F10x high density)
 __attribute__((section(".isr_vector")))
 void (* const vectors[])(void) = {
     (void (*)(void))&_estack,
     Reset_Handler,
-    Default_Handler,  // NMI
-    Default_Handler,  // HardFault
-    Default_Handler,  // MemManage
-    Default_Handler,  // BusFault
-    Default_Handler,  // UsageFault
+    NMI_Handler,
+    HardFault_Handler,
+    MemManage_Handler,
+    BusFault_Handler,
+    UsageFault_Handler,
+    0, 0, 0, 0,                      // Reserved
+    SVC_Handler,
+    DebugMon_Handler,
+    0,                               // Reserved
+    PendSV_Handler,
+    SysTick_Handler,
+    WWDG_IRQHandler,                 // 0
+    PVD_IRQHandler,                  // 1
+    TAMPER_IRQHandler,               // 2
+    RTC_IRQHandler,                  // 3
+    FLASH_IRQHandler,                // 4
+    RCC_IRQHandler,                  // 5
+    EXTI0_IRQHandler,                // 6
+    EXTI1_IRQHandler,                // 7
+    EXTI2_IRQHandler,                // 8
+    EXTI3_IRQHandler,                // 9
+    EXTI4_IRQHandler,                // 10
+    DMA1_Channel1_IRQHandler,        // 11
+    DMA1_Channel2_IRQHandler,        // 12
+    DMA1_Channel3_IRQHandler,        // 13
+    DMA1_Channel4_IRQHandler,        // 14
+    DMA1_Channel5_IRQHandler,        // 15
+    DMA1_Channel6_IRQHandler,        // 16
+    DMA1_Channel7_IRQHandler,        // 17
+    ADC1_2_IRQHandler,               // 18
+    USB_HP_CAN1_TX_IRQHandler,       // 19
+    USB_LP_CAN1_RX0_IRQHandler,      // 20
+    CAN1_RX1_IRQHandler,             // 21
+    CAN1_SCE_IRQHandler,             // 22
+    EXTI9_5_IRQHandler,              // 23
+    TIM1_BRK_IRQHandler,             // 24
+    TIM1_UP_IRQHandler,              // 25
+    TIM1_TRG_COM_IRQHandler,         // 26
+    TIM1_CC_IRQHandler,              // 27
+    TIM2_IRQHandler,                 // 28
+    TIM3_IRQHandler,                 // 29
+    TIM4_IRQHandler,                 // 30
+    I2C1_EV_IRQHandler,              // 31
+    I2C1_ER_IRQHandler,              // 32
+    I2C2_EV_IRQHandler,              // 33
+    I2C2_ER_IRQHandler,              // 34
+    SPI1_IRQHandler,                 // 35
+    SPI2_IRQHandler,                 // 36
+    USART1_IRQHandler,               // 37
+    USART2_IRQHandler,               // 38
+    USART3_IRQHandler,               // 39
+    EXTI15_10_IRQHandler,            // 40
+    RTCAlarm_IRQHandler,             // 41
+    USBWakeUp_IRQHandler,            // 42
+    TIM8_BRK_IRQHandler,             // 43
+    TIM8_UP_IRQHandler,              // 44
+    TIM8_TRG_COM_IRQHandler,         // 45
+    TIM8_CC_IRQHandler,              // 46
+    ADC3_IRQHandler,                 // 47
+    FSMC_IRQHandler,                 // 48
+    SDIO_IRQHandler,                 // 49
+    TIM5_IRQHandler,                 // 50
+    SPI3_IRQHandler,                 // 51
+    UART4_IRQHandler,                // 52
+    UART5_IRQHandler,                // 53
+    TIM6_IRQHandler,                 // 54
+    TIM7_IRQHandler,                 // 55
+    DMA2_Channel1_IRQHandler,        // 56
+    DMA2_Channel2_IRQHandler,        // 57
+    DMA2_Channel3_IRQHandler,        // 58
+    DMA2_Channel4_5_IRQHandler,      // 59
 };
 
 void Reset_Handler(void) {
@@ -10,6 +10,8 @@
 #include "stm32f10x_usart.h"
 #include "uart_helper.h"
 #include "spisurucu.h"
+#include "istatistik.h"
+#include "darbe.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -70,12 +72,43 @@ typedef struct {
     uint16_t input_state;       // Giriş durumları (16 bit)
     uint16_t output_state;      // Çıkış durumları (16 bit)
     uint16_t direction_mask;    // Yön: 1=çıkış, 0=giriş
+    uint16_t pending_output;    // Ertelenmiş çıkış değeri (atomic batch)
+    uint16_t saved_output;      // Batch başındaki output_state (IO16_DiscardDeferred)
+    uint8_t pending;            // 1: pending_output commit bekliyor
 } IO16_Module;
 
 // Maksimum 4 slot
 static IO16_Module io16_modules[4];
 static uint8_t io16_module_count = 0;
 
+// Ertelenmiş çıkış modu (atomic batch): 1 iken çıkış yazımları commit'e kadar bekler
+static uint8_t io16_deferred = 0;
+
+// İşlem katmanı: echo hatası veren çerçeve IO16_FRAME_TRIES kez gönderilir,
+// denemeler arası bekleme IO16_BACKOFF_US'den başlayıp ikiye katlanır.
+// Art arda IO16_REINIT_ESIK işlem tüm denemelerde başarısız olursa chip
+// yeniden init edilir (IO16_InitChip) ve çerçeve bir kez daha denenir.
+#define IO16_FRAME_TRIES        3
+#define IO16_BACKOFF_US         20      // 20 + 40 µs
+#define IO16_REINIT_ESIK        2
+#define IO16_CYCLES_PER_US      72
+
+// Slot başına işlem hata sayaçları ("io16:S:errors")
+typedef struct {
+    uint32_t transactions;      // Register okuma/yazma işlemi
+    uint32_t frame_errors;      // Echo/CS hatası veren çerçeve
+    uint32_t retries;           // Tekrar gönderilen çerçeve
+    uint32_t recovered;         // Tekrar veya re-init ile kurtarılan işlem
+    uint32_t failed;            // Tüm denemeleri başarısız işlem
+    uint32_t reinits;           // Kalıcı hata sonrası chip re-init
+    uint8_t consecutive;        // Art arda başarısız işlem
+} IO16_Errors;
+
+static IO16_Errors io16_errors[4];
+
+// Chip init sürerken başarısız işlemler re-init'e yükseltilmez
+static uint8_t io16_init_active = 0;
+
 // Forward declarations
 static int IO16_SetDirection(uint8_t slot, uint8_t pin, uint8_t direction);
 static int IO16_WriteRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t* value);
@@ -259,6 +292,8 @@ int IO16_ChipInit(uint8_t slot) {
     uint8_t value;
     int ret = 0;
     
+    io16_init_active = 1;
+    
     UART_SendString("\r\n");
     UART_SendString("====================================\r\n");
     UART_SendString("[iC-JX-INIT] Slot ");
@@ -290,6 +325,7 @@ int IO16_ChipInit(uint8_t slot) {
     ret = IO16_WriteRegister(slot, IO16_REG_CONTROLWORD_3B, 1, &value);
     if (ret != 0) {
         UART_SendString("[iC-JX-INIT] ERROR: Clock enable FAILED!\r\n");
+        io16_init_active = 0;
         return ret;
     }
     UART_SendString("[iC-JX-INIT] Clock enabled - OK!\r\n");
@@ -363,6 +399,10 @@ int IO16_ChipInit(uint8_t slot) {
     UART_SendString("[iC-JX-INIT] Chip ready for operation!\r\n");
     UART_SendString("====================================\r\n\r\n");
     
+    io16_init_active = 0;
+    if (slot < 4) {
+        io16_errors[slot].consecutive = 0;
+    }
     return 0;
 }
 
@@ -375,10 +415,30 @@ void IO16_Register(uint8_t slot) {
         io16_modules[io16_module_count].input_state = 0;
         io16_modules[io16_module_count].output_state = 0;
         io16_modules[io16_module_count].direction_mask = 0x0000;  // Tümü giriş
+        io16_modules[io16_module_count].pending_output = 0;
+        io16_modules[io16_module_count].pending = 0;
         io16_module_count++;
     }
 }
 
+/**
+ * Slot'taki IO16 modülünü kayıttan çıkar (modül çıkarıldığında)
+ */
+void IO16_Unregister(uint8_t slot) {
+    Darbe_Iptal(slot, 0xFFFF);
+    
+    for (uint8_t i = 0; i < io16_module_count; i++) {
+        if (io16_modules[i].slot == slot) {
+            // Kalan modülleri bir sola kaydır
+            for (uint8_t j = i; j + 1 < io16_module_count; j++) {
+                io16_modules[j] = io16_modules[j + 1];
+            }
+            io16_module_count--;
+            return;
+        }
+    }
+}
+
 /**
  * Slot'a göre modül bul
  */
@@ -481,14 +541,14 @@ static int IO16_InitChip(uint8_t slot) {
 }
 
 /**
- * IO16 Register Yaz (SPI)
+ * IO16 Register Yaz - tek SPI çerçevesi, tekrar yok
  * @param slot: Slot numarası (0-3)
  * @param reg: Register adresi
  * @param count: Yazılacak byte sayısı
  * @param value: Yazılacak değerler
  * @return 0: başarılı, -1: hata
  */
-static int IO16_WriteRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t* value) {
+static int IO16_WriteFrame(uint8_t slot, uint8_t reg, uint8_t count, uint8_t* value) {
     uint8_t address_byte = get_address_byte(reg, 0);  // Write
     uint8_t count_byte = get_count_byte(count);
     uint8_t miso;
@@ -526,6 +586,7 @@ static int IO16_WriteRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t*
     // Adres echo kontrolü
     if (miso != address_byte) {
         UART_SendString(" ADDR_ECHO_FAIL!\r\n");
+        Istatistik_EchoHata(slot, IST_ECHO_ADDR);
         SPI_SetCS(slot, CS_DISABLE);
         return -1;
     }
@@ -545,6 +606,7 @@ static int IO16_WriteRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t*
             // İlk byte'ta count echo olmalı
             if (miso != count_byte) {
                 UART_SendString(" COUNT_ECHO_FAIL!\r\n");
+                Istatistik_EchoHata(slot, IST_ECHO_COUNT);
                 SPI_SetCS(slot, CS_DISABLE);
                 return -1;
             }
@@ -563,6 +625,7 @@ static int IO16_WriteRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t*
     // Son veri echo kontrolü
     if (miso != value[count - 1]) {
         UART_SendString(" DATA_ECHO_FAIL!\r\n");
+        Istatistik_EchoHata(slot, IST_ECHO_DATA);
         SPI_SetCS(slot, CS_DISABLE);
         return -1;
     }
@@ -576,6 +639,7 @@ static int IO16_WriteRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t*
     // CTRL echo kontrolü
     if (miso != CTRL_BYTE) {
         UART_SendString(" CTRL_ECHO_FAIL!\r\n");
+        Istatistik_EchoHata(slot, IST_ECHO_CTRL);
         SPI_SetCS(slot, CS_DISABLE);
         return -1;
     }
@@ -588,14 +652,14 @@ static int IO16_WriteRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t*
 }
 
 /**
- * IO16 Register Oku (SPI)
+ * IO16 Register Oku - tek SPI çerçevesi, tekrar yok
  * @param slot: Slot numarası (0-3)
  * @param reg: Register adresi
  * @param count: Okunacak byte sayısı
  * @param value: Okunan değerler (output)
  * @return 0: başarılı, -1: hata
  */
-static int IO16_ReadRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t* value) {
+static int IO16_ReadFrame(uint8_t slot, uint8_t reg, uint8_t count, uint8_t* value) {
     uint8_t address_byte = get_address_byte(reg, 1);  // Read
     uint8_t count_byte = get_count_byte(count);
     uint8_t miso;
@@ -631,6 +695,7 @@ static int IO16_ReadRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t*
     // Adres echo kontrolü
     if (miso != address_byte) {
         UART_SendString(" ADDR_ECHO_FAIL!\r\n");
+        Istatistik_EchoHata(slot, IST_ECHO_ADDR);
         SPI_SetCS(slot, CS_DISABLE);
         return -1;
     }
@@ -668,6 +733,7 @@ static int IO16_ReadRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t*
     // CTRL echo kontrolü
     if (miso != CTRL_BYTE) {
         UART_SendString(" CTRL_ECHO_FAIL!\r\n");
+        Istatistik_EchoHata(slot, IST_ECHO_CTRL);
         SPI_SetCS(slot, CS_DISABLE);
         return -1;
     }
@@ -679,6 +745,246 @@ static int IO16_ReadRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t*
     return 0;
 }
 
+/**
+ * Tekrar denemeleri arası bekleme (attempt: 1, 2, ...)
+ */
+static void IO16_Backoff(uint8_t attempt) {
+    uint32_t start = Istatistik_Cycle();
+    uint32_t cycles = ((uint32_t)IO16_BACKOFF_US << (attempt - 1)) * IO16_CYCLES_PER_US;
+    while ((Istatistik_Cycle() - start) < cycles);
+}
+
+/**
+ * Register işlemi: çerçeveyi sınırlı sayıda tekrarla, kalıcı hatada chip'i
+ * yeniden init et. Register yazımları mutlak değer olduğundan tekrar güvenli.
+ * @param write: 1=yazma, 0=okuma
+ * @return 0: başarılı, -1: hata
+ */
+static int IO16_Transfer(uint8_t slot, uint8_t write, uint8_t reg, uint8_t count, uint8_t* value) {
+    if (slot >= 4) {
+        return -1;
+    }
+    IO16_Errors* err = &io16_errors[slot];
+    err->transactions++;
+    
+    for (uint8_t attempt = 0; attempt < IO16_FRAME_TRIES; attempt++) {
+        if (attempt > 0) {
+            err->retries++;
+            IO16_Backoff(attempt);
+        }
+        
+        int ret = write ? IO16_WriteFrame(slot, reg, count, value)
+                        : IO16_ReadFrame(slot, reg, count, value);
+        if (ret == 0) {
+            if (attempt > 0) {
+                err->recovered++;
+            }
+            err->consecutive = 0;
+            return 0;
+        }
+        err->frame_errors++;
+    }
+    
+    if (err->consecutive < 255) {
+        err->consecutive++;
+    }
+    
+    // Kalıcı hata: chip clock/filtre ayarını kaybetmiş olabilir (brown-out, hot-plug)
+    if (err->consecutive >= IO16_REINIT_ESIK && !io16_init_active) {
+        int ret;
+        
+        err->reinits++;
+        err->consecutive = 0;
+        io16_init_active = 1;
+        UART_QuietBegin();
+        ret = IO16_InitChip(slot);
+        UART_QuietEnd();
+        io16_init_active = 0;
+        
+        if (ret == 0) {
+            ret = write ? IO16_WriteFrame(slot, reg, count, value)
+                        : IO16_ReadFrame(slot, reg, count, value);
+            if (ret == 0) {
+                err->recovered++;
+                return 0;
+            }
+            err->frame_errors++;
+        }
+    }
+    
+    err->failed++;
+    return -1;
+}
+
+static int IO16_WriteRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t* value) {
+    return IO16_Transfer(slot, 1, reg, count, value);
+}
+
+static int IO16_ReadRegister(uint8_t slot, uint8_t reg, uint8_t count, uint8_t* value) {
+    return IO16_Transfer(slot, 0, reg, count, value);
+}
+
+/**
+ * İşlem hata sayaçlarını yazdır
+ * Machine mode: "<işlem> <çerçeve hatası> <tekrar> <kurtarılan> <başarısız> <re-init>"
+ */
+static void IO16_PrintErrors(uint8_t slot) {
+    const IO16_Errors* err = &io16_errors[slot];
+    char buf[80];
+    
+    sprintf(buf, "%lu %lu %lu %lu %lu %lu",
+            (unsigned long)err->transactions, (unsigned long)err->frame_errors,
+            (unsigned long)err->retries, (unsigned long)err->recovered,
+            (unsigned long)err->failed, (unsigned long)err->reinits);
+    
+    if (UART_GetMode() == UART_MODE_MACHINE) {
+        UART_Reply(UART_ST_OK, buf);
+        return;
+    }
+    
+    UART_SendString("IO16 Slot ");
+    UART_SendHex8(slot);
+    UART_SendString(" SPI islem hatalari\r\n");
+    sprintf(buf, "  Islem:          %lu\r\n", (unsigned long)err->transactions);
+    UART_SendString(buf);
+    sprintf(buf, "  Cerceve hatasi: %lu\r\n", (unsigned long)err->frame_errors);
+    UART_SendString(buf);
+    sprintf(buf, "  Tekrar:         %lu\r\n", (unsigned long)err->retries);
+    UART_SendString(buf);
+    sprintf(buf, "  Kurtarilan:     %lu\r\n", (unsigned long)err->recovered);
+    UART_SendString(buf);
+    sprintf(buf, "  Basarisiz:      %lu\r\n", (unsigned long)err->failed);
+    UART_SendString(buf);
+    sprintf(buf, "  Chip re-init:   %lu\r\n", (unsigned long)err->reinits);
+    UART_SendString(buf);
+    UART_Reply(UART_ST_OK, NULL);
+}
+
+/**
+ * Gölge çıkış register'ını güncelle (atomic batch)
+ * İlk dokunuşta OUTPUT_A/B tek 2-byte okuma ile gölgeye alınır,
+ * böylece batch dışındaki bitler korunur.
+ */
+static int IO16_DeferOutput(IO16_Module* module, uint16_t mask, uint16_t value) {
+    if (!module->pending) {
+        uint8_t out[2];
+        if (IO16_ReadRegister(module->slot, IO16_REG_OUTPUT_A, 2, out) != 0) {
+            return -1;
+        }
+        module->pending_output = ((uint16_t)out[1] << 8) | out[0];
+        module->pending = 1;
+    }
+    module->pending_output = (module->pending_output & ~mask) | (value & mask);
+    return 0;
+}
+
+/**
+ * Ertelenmiş çıkış modunu başlat (atomic batch)
+ * Bu noktadan sonra IO16_SetPin / IO16_WriteAll çıkışları SPI'a yazmaz,
+ * IO16_CommitDeferred() ile hepsi aynı taramada uygulanır.
+ * Yön (CONTROLWORD_2) değişiklikleri ertelenmez.
+ */
+void IO16_BeginDeferred(void) {
+    for (uint8_t i = 0; i < io16_module_count; i++) {
+        io16_modules[i].pending = 0;
+        io16_modules[i].saved_output = io16_modules[i].output_state;
+    }
+    io16_deferred = 1;
+}
+
+/**
+ * Bekleyen çıkışları at (atomic batch'te komut hatası)
+ * SPI yazımı yok, gölge çıkış durumu batch başına döner.
+ */
+void IO16_DiscardDeferred(void) {
+    io16_deferred = 0;
+    for (uint8_t i = 0; i < io16_module_count; i++) {
+        if (io16_modules[i].pending) {
+            io16_modules[i].output_state = io16_modules[i].saved_output;
+            io16_modules[i].pending = 0;
+        }
+    }
+}
+
+/**
+ * Bekleyen çıkışları uygula
+ * Her modül için tek bir 2-byte OUTPUT_A/OUTPUT_B yazımı yapılır.
+ * @return 0: başarılı, -1: en az bir modülde yazma hatası
+ */
+int IO16_CommitDeferred(void) {
+    int result = 0;
+    
+    io16_deferred = 0;
+    for (uint8_t i = 0; i < io16_module_count; i++) {
+        IO16_Module* module = &io16_modules[i];
+        if (!module->pending) {
+            continue;
+        }
+        uint8_t out[2];
+        out[0] = module->pending_output & 0xFF;
+        out[1] = (module->pending_output >> 8) & 0xFF;
+        if (IO16_WriteRegister(module->slot, IO16_REG_OUTPUT_A, 2, out) != 0) {
+            result = -1;
+        }
+        module->pending = 0;
+    }
+    return result;
+}
+
+/**
+ * Maskedeki çıkış bitlerini gölge register üzerinden yaz
+ * Okuma ve yön kontrolü yok: OUTPUT_A/B tek 2-byte çerçeve (zamanlı çıkışlar)
+ */
+int IO16_ApplyOutputs(uint8_t slot, uint16_t mask, uint16_t value) {
+    IO16_Module* module = IO16_GetModule(slot);
+    if (!module) {
+        return -1;
+    }
+    
+    uint16_t state = (module->output_state & ~mask) | (value & mask);
+    
+    if (io16_deferred) {
+        if (IO16_DeferOutput(module, mask, value) != 0) {
+            return -1;
+        }
+        module->output_state = state;
+        return 0;
+    }
+    
+    uint8_t out[2];
+    out[0] = state & 0xFF;
+    out[1] = (state >> 8) & 0xFF;
+    if (IO16_WriteRegister(slot, IO16_REG_OUTPUT_A, 2, out) != 0) {
+        return -1;
+    }
+    module->output_state = state;
+    return 0;
+}
+
+/**
+ * INPUT_A/B tek 2-byte çerçevede (ana döngü taraması, referans.c)
+ * SPI debug çıktısı bastırılır: her döngü turunda çağrılabilir
+ */
+int IO16_ReadInputs(uint8_t slot, uint16_t* inputs) {
+    IO16_Module* module = IO16_GetModule(slot);
+    if (!module) {
+        return -1;
+    }
+    
+    uint8_t in[2];
+    int ret;
+    UART_QuietBegin();
+    ret = IO16_ReadRegister(slot, IO16_REG_INPUT_A, 2, in);
+    UART_QuietEnd();
+    if (ret != 0) {
+        return -1;
+    }
+    
+    module->input_state = ((uint16_t)in[1] << 8) | in[0];
+    *inputs = module->input_state;
+    return 0;
+}
+
 /**
  * Tek bir pin'i ayarla (0-15)
  * state: 0=LOW, 1=HIGH
@@ -712,6 +1018,20 @@ int IO16_SetPin(uint8_t slot, uint8_t pin, uint8_t state) {
         UART_SendString(" is already OUTPUT\r\n");
     }
     
+    // Atomic batch: SPI yazımı yok, sadece gölge register güncellenir
+    if (io16_deferred) {
+        uint16_t mask = (uint16_t)(1 << pin);
+        if (IO16_DeferOutput(module, mask, state ? mask : 0) != 0) {
+            return -1;
+        }
+        if (state) {
+            module->output_state |= mask;
+        } else {
+            module->output_state &= ~mask;
+        }
+        return 0;
+    }
+    
     // ⚠️  MEVCUT-SİSTEM YÖNTEM: Single-byte read/write (OUTPUT_A or OUTPUT_B)
     // Reference: pilot_io16_set_value() reads/writes 1 byte at a time
     // NOT: PilotConfig 2-byte kullanıyor ama set_value() 1-byte kullanıyor!
@@ -982,6 +1302,15 @@ int IO16_WriteAll(uint8_t slot, uint16_t state) {
         return -1;
     }
     
+    // Atomic batch: commit'e kadar beklet
+    if (io16_deferred) {
+        if (IO16_DeferOutput(module, 0xFFFF, state) != 0) {
+            return -1;
+        }
+        module->output_state = state & module->direction_mask;
+        return 0;
+    }
+    
     // Lower byte (pins 0-7) - OUTPUT_A
     uint8_t output_a = state & 0xFF;
     if (IO16_WriteRegister(slot, IO16_REG_OUTPUT_A, 1, &output_a) != 0) {
@@ -1130,6 +1459,166 @@ void IO16_PrintStatus(uint8_t slot) {
     UART_SendString("====================================\r\n");
 }
 
+/**
+ * Ondalık sayı oku (en fazla max), *p sayıdan sonrasını gösterir
+ */
+static int IO16_ParseNumber(const char** p, uint32_t max, uint32_t* out) {
+    const char* s = *p;
+    uint32_t value = 0;
+    
+    if (*s < '0' || *s > '9') {
+        return -1;
+    }
+    while (*s >= '0' && *s <= '9') {
+        value = value * 10 + (uint32_t)(*s - '0');
+        if (value > max) {
+            return -1;
+        }
+        s++;
+    }
+    *p = s;
+    *out = value;
+    return 0;
+}
+
+/**
+ * Zamanlı çıkış pin'ini çıkış yap (IO16_SetPin gibi otomatik yön)
+ */
+int IO16_EnsureOutput(uint8_t slot, uint8_t pin) {
+    IO16_Module* module = IO16_GetModule(slot);
+    if (!module) {
+        return -1;
+    }
+    if (module->direction_mask & (1 << pin)) {
+        return 0;
+    }
+    return IO16_SetDirection(slot, pin, 1);
+}
+
+/**
+ * Zamanlı çıkış komutları (darbe.c)
+ *   pulse:PIN:MS[:low]              PIN'i MS ms aktif tut
+ *   train:PIN:ON:OFF:COUNT[:low]    COUNT darbe (0 = iptale kadar)
+ *   after:MS:PIN:high|low           MS ms sonra yaz
+ *   cancel[:PIN]                    İptal, darbe pinleri pasif seviyeye
+ *   timers                          "<olay> <pin maskesi>"
+ */
+static void IO16_TimedCommand(uint8_t slot, const char* cmd) {
+    uint32_t pin, on_ms, off_ms = 0, count = 1, delay_ms = 0;
+    uint8_t level = 1;
+    uint8_t after = 0;
+    int ret;
+    
+    if (strcmp(cmd, "timers") == 0) {
+        char buf[16];
+        uint8_t n;
+        uint16_t mask = Darbe_Bekleyen(slot, &n);
+        sprintf(buf, "%u %04X", (unsigned)n, mask);
+        UART_SendString("Bekleyen olay: ");
+        UART_SendString(buf);
+        UART_SendString("\r\n");
+        UART_Reply(UART_ST_OK, buf);
+        return;
+    }
+    
+    if (strncmp(cmd, "cancel", 6) == 0) {
+        uint16_t mask = 0xFFFF;
+        char buf[8];
+        cmd += 6;
+        if (*cmd == ':') {
+            cmd++;
+            if (IO16_ParseNumber(&cmd, 15, &pin) != 0 || *cmd) {
+                UART_SendError(UART_ST_ARG, "Hata: Geçersiz pin (0-15)\r\n");
+                return;
+            }
+            mask = (uint16_t)(1 << pin);
+        } else if (*cmd) {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası\r\n");
+            return;
+        }
+        sprintf(buf, "%u", (unsigned)Darbe_Iptal(slot, mask));
+        UART_SendString("OK: İptal edilen olay: ");
+        UART_SendString(buf);
+        UART_SendString("\r\n");
+        UART_Reply(UART_ST_OK, buf);
+        return;
+    }
+    
+    if (strncmp(cmd, "pulse:", 6) == 0) {
+        cmd += 6;
+        if (IO16_ParseNumber(&cmd, 15, &pin) != 0 || *cmd++ != ':' ||
+            IO16_ParseNumber(&cmd, DARBE_SURE_MAX, &on_ms) != 0 || on_ms == 0) {
+            UART_SendError(UART_ST_ARG, "Hata: pulse:PIN:MS[:low] (MS 1-60000)\r\n");
+            return;
+        }
+    } else if (strncmp(cmd, "train:", 6) == 0) {
+        cmd += 6;
+        if (IO16_ParseNumber(&cmd, 15, &pin) != 0 || *cmd++ != ':' ||
+            IO16_ParseNumber(&cmd, DARBE_SURE_MAX, &on_ms) != 0 || on_ms == 0 || *cmd++ != ':' ||
+            IO16_ParseNumber(&cmd, DARBE_SURE_MAX, &off_ms) != 0 || off_ms == 0 || *cmd++ != ':' ||
+            IO16_ParseNumber(&cmd, 0xFFFF, &count) != 0) {
+            UART_SendError(UART_ST_ARG, "Hata: train:PIN:ON:OFF:COUNT[:low] (ms 1-60000)\r\n");
+            return;
+        }
+    } else if (strncmp(cmd, "after:", 6) == 0) {
+        cmd += 6;
+        if (IO16_ParseNumber(&cmd, DARBE_SURE_MAX, &delay_ms) != 0 || *cmd++ != ':' ||
+            IO16_ParseNumber(&cmd, 15, &pin) != 0 || *cmd++ != ':' ||
+            (strcmp(cmd, "high") != 0 && strcmp(cmd, "low") != 0)) {
+            UART_SendError(UART_ST_ARG, "Hata: after:MS:PIN:high|low (MS 0-60000)\r\n");
+            return;
+        }
+        level = (strcmp(cmd, "high") == 0) ? 1 : 0;
+        after = 1;
+    } else {
+        UART_SendError(UART_ST_SYNTAX, "Hata: Bilinmeyen komut\r\n");
+        return;
+    }
+    
+    // Darbe seviyesi: varsayılan aktif HIGH
+    if (!after) {
+        if (strcmp(cmd, ":low") == 0) {
+            level = 0;
+        } else if (*cmd && strcmp(cmd, ":high") != 0) {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası\r\n");
+            return;
+        }
+    }
+    
+    if (!IO16_GetModule(slot)) {
+        UART_SendError(UART_ST_NOMODULE, "Hata: Modül bulunamadı\r\n");
+        return;
+    }
+    if (IO16_EnsureOutput(slot, (uint8_t)pin) != 0) {
+        UART_SendError(UART_ST_HW, "Hata: Pin çıkış yapılamadı\r\n");
+        return;
+    }
+    
+    if (after) {
+        ret = Darbe_Ertele(slot, (uint8_t)pin, level, (uint16_t)delay_ms);
+    } else {
+        ret = Darbe_Baslat(slot, (uint8_t)pin, level, (uint16_t)on_ms,
+                           (uint16_t)off_ms, (uint16_t)count);
+    }
+    if (ret == -2) {
+        UART_SendError(UART_ST_OVERFLOW, "Hata: Zamanlayıcı havuzu dolu\r\n");
+        return;
+    }
+    if (ret != 0) {
+        UART_SendError(UART_ST_HW, "Hata: Çıkış yazılamadı\r\n");
+        return;
+    }
+    UART_SendString("OK: Zamanlayıcı kuruldu\r\n");
+    UART_Reply(UART_ST_OK, NULL);
+}
+
+/**
+ * Machine mode hata kodu: slotta modül yoksa NOMODULE, varsa HW
+ */
+static uint8_t IO16_ErrorStatus(uint8_t slot) {
+    return IO16_GetModule(slot) ? UART_ST_HW : UART_ST_NOMODULE;
+}
+
 /**
  * Modül komutunu işle
  * Format: io16:SLOT:KOMUT
@@ -1139,6 +1628,9 @@ void IO16_PrintStatus(uint8_t slot) {
  *   io16:0:dir:3:out
  *   io16:0:status
  *   io16:0:readall
+ *   io16:0:errors[:reset]
+ *   io16:0:pulse:5:50
+ *   io16:0:train:5:10:90:20
  */
 void IO16_HandleCommand(const char* cmd) {
     // ACK gönder (komut alındı onayı)
@@ -1148,14 +1640,14 @@ void IO16_HandleCommand(const char* cmd) {
     
     // Slot'u parse et
     if (cmd[0] < '0' || cmd[0] > '3') {
-        UART_SendString("Hata: Geçersiz slot (0-3)\r\n");
+        UART_SendError(UART_ST_ARG, "Hata: Geçersiz slot (0-3)\r\n");
         return;
     }
     uint8_t slot = cmd[0] - '0';
     
     // Slot atla (':' geç)
     if (cmd[1] != ':') {
-        UART_SendString("Hata: Format hatası\r\n");
+        UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası\r\n");
         return;
     }
     cmd += 2;
@@ -1173,7 +1665,7 @@ void IO16_HandleCommand(const char* cmd) {
         }
         
         if (cmd[0] != ':') {
-            UART_SendString("Hata: Format hatası\r\n");
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası\r\n");
             return;
         }
         cmd += 1;
@@ -1186,8 +1678,9 @@ void IO16_HandleCommand(const char* cmd) {
             UART_SendString(" = ");
             UART_SendString(state ? "HIGH" : "LOW");
             UART_SendString("\r\n");
+            UART_Reply(UART_ST_OK, NULL);
         } else {
-            UART_SendString("Hata: Pin ayarlanamadı\r\n");
+            UART_SendError(IO16_ErrorStatus(slot), "Hata: Pin ayarlanamadı\r\n");
         }
     }
     else if (strncmp(cmd, "get:", 4) == 0) {
@@ -1205,8 +1698,9 @@ void IO16_HandleCommand(const char* cmd) {
             UART_SendString(" = ");
             UART_SendString(state ? "HIGH" : "LOW");
             UART_SendString("\r\n");
+            UART_Reply(UART_ST_OK, state ? "1" : "0");
         } else {
-            UART_SendString("Hata: Pin okunamadı\r\n");
+            UART_SendError(IO16_ErrorStatus(slot), "Hata: Pin okunamadı\r\n");
         }
     }
     else if (strncmp(cmd, "dirgroup:", 9) == 0) {
@@ -1216,7 +1710,7 @@ void IO16_HandleCommand(const char* cmd) {
         
         uint8_t group = cmd[0] - '0';
         if (group > 3) {
-            UART_SendString("Hata: Geçersiz grup (0-3)\r\n");
+            UART_SendError(UART_ST_ARG, "Hata: Geçersiz grup (0-3)\r\n");
             UART_SendString("  Grup 0: Pins 0-3\r\n");
             UART_SendString("  Grup 1: Pins 4-7\r\n");
             UART_SendString("  Grup 2: Pins 8-11\r\n");
@@ -1225,7 +1719,7 @@ void IO16_HandleCommand(const char* cmd) {
         }
         
         if (cmd[1] != ':') {
-            UART_SendString("Hata: Format hatası\r\n");
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası\r\n");
             return;
         }
         cmd += 2;
@@ -1239,7 +1733,7 @@ void IO16_HandleCommand(const char* cmd) {
         // Mevcut değeri oku
         uint8_t reg_value;
         if (IO16_ReadRegister(slot, reg, 1, &reg_value) != 0) {
-            UART_SendString("Hata: Register okunamadı\r\n");
+            UART_SendError(IO16_ErrorStatus(slot), "Hata: Register okunamadı\r\n");
             return;
         }
         
@@ -1252,7 +1746,7 @@ void IO16_HandleCommand(const char* cmd) {
         
         // Yaz
         if (IO16_WriteRegister(slot, reg, 1, &reg_value) != 0) {
-            UART_SendString("Hata: Register yazılamadı\r\n");
+            UART_SendError(IO16_ErrorStatus(slot), "Hata: Register yazılamadı\r\n");
             return;
         }
         
@@ -1265,15 +1759,48 @@ void IO16_HandleCommand(const char* cmd) {
         UART_SendString(") = ");
         UART_SendString(direction ? "OUTPUT" : "INPUT");
         UART_SendString("\r\n");
+        UART_Reply(UART_ST_OK, NULL);
     }
     else if (strcmp(cmd, "status") == 0) {
-        IO16_PrintStatus(slot);
+        IO16_Module* module = IO16_GetModule(slot);
+        if (UART_GetMode() == UART_MODE_MACHINE && module) {
+            // Kısa durum: "<yön> <çıkış> <giriş>" (hex)
+            char buf[16];
+            IO16_ReadAll(slot);
+            sprintf(buf, "%04X %04X %04X", module->direction_mask,
+                    module->output_state, module->input_state);
+            UART_Reply(UART_ST_OK, buf);
+        } else if (!module) {
+            UART_SendError(UART_ST_NOMODULE, "Hata: Modül bulunamadı\r\n");
+        } else {
+            IO16_PrintStatus(slot);
+        }
+    }
+    else if (strncmp(cmd, "pulse:", 6) == 0 || strncmp(cmd, "train:", 6) == 0 ||
+             strncmp(cmd, "after:", 6) == 0 || strncmp(cmd, "cancel", 6) == 0 ||
+             strcmp(cmd, "timers") == 0) {
+        IO16_TimedCommand(slot, cmd);
+    }
+    else if (strcmp(cmd, "errors") == 0) {
+        IO16_PrintErrors(slot);
+    }
+    else if (strcmp(cmd, "errors:reset") == 0) {
+        memset(&io16_errors[slot], 0, sizeof(io16_errors[slot]));
+        UART_SendString("OK: Hata sayaclari sifirlandi\r\n");
+        UART_Reply(UART_ST_OK, NULL);
     }
     else if (strcmp(cmd, "readall") == 0) {
-        uint16_t state = IO16_ReadAll(slot);
-        UART_SendString("Tüm pinler: 0x");
-        UART_SendHex16(state);
-        UART_SendString("\r\n");
+        if (!IO16_GetModule(slot)) {
+            UART_SendError(UART_ST_NOMODULE, "Hata: Modül bulunamadı\r\n");
+        } else {
+            char buf[8];
+            uint16_t state = IO16_ReadAll(slot);
+            UART_SendString("Tüm pinler: 0x");
+            UART_SendHex16(state);
+            UART_SendString("\r\n");
+            sprintf(buf, "%04X", state);
+            UART_Reply(UART_ST_OK, buf);
+        }
     }
     else if (strncmp(cmd, "writeall:", 9) == 0) {
         // writeall:VALUE (hex format: 0x00FF veya decimal)
@@ -1308,16 +1835,19 @@ void IO16_HandleCommand(const char* cmd) {
             UART_SendString("OK: Tüm pinler yazıldı = 0x");
             UART_SendHex16(value);
             UART_SendString("\r\n");
+            UART_Reply(UART_ST_OK, NULL);
         } else {
-            UART_SendString("Hata: Yazma başarısız\r\n");
+            UART_SendError(IO16_ErrorStatus(slot), "Hata: Yazma başarısız\r\n");
         }
     }
     else if (strcmp(cmd, "info") == 0) {
         // Read chip INFO register
         uint8_t info = IO16_GetChipInfo(slot);
+        char buf[4];
         UART_SendString("iC-JX Chip INFO: 0x");
         UART_SendHex8(info);
         UART_SendString("\r\n");
+        sprintf(buf, "%02X", info);
         
         // Chip detected ve başarılı? → AUTO-INITIALIZE!
         if (info != 0x00 && info != 0xFF) {
@@ -1325,17 +1855,24 @@ void IO16_HandleCommand(const char* cmd) {
             if (IO16_InitChip(slot) == 0) {
                 UART_SendString("✅ Chip initialization SUCCESS!\r\n");
                 UART_SendString("📝 TIP: Now run 'io16:0:status' to verify settings\r\n\r\n");
+                UART_Reply(UART_ST_OK, buf);
             } else {
                 UART_SendString("❌ Chip initialization FAILED!\r\n\r\n");
+                UART_Reply(UART_ST_HW, buf);
             }
+        } else {
+            UART_Reply(UART_ST_HW, buf);
         }
     }
     else if (strcmp(cmd, "overcurrent") == 0) {
         // Check overcurrent status
         uint16_t over = IO16_CheckOvercurrent(slot);
+        char buf[8];
         if (over == 0) {
             UART_SendString("No overcurrent detected\r\n");
         }
+        sprintf(buf, "%04X", over);
+        UART_Reply(UART_ST_OK, buf);
     }
     else if (strcmp(cmd, "regdump") == 0) {
         // Dump all important registers
@@ -1349,7 +1886,7 @@ void IO16_HandleCommand(const char* cmd) {
         // Parse GPIO number
         uint8_t gpio = cmd[0] - '0';
         if (cmd[1] != ':') {
-            UART_SendString("Hata: Format hatası (beklenen: testcs:GPIO:PIN)\r\n");
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (beklenen: testcs:GPIO:PIN)\r\n");
             return;
         }
         cmd += 2;
@@ -1362,13 +1899,13 @@ void IO16_HandleCommand(const char* cmd) {
         
         // Validate GPIO range
         if (gpio > 3) {  // GPIOA=0, GPIOB=1, GPIOC=2, GPIOD=3
-            UART_SendString("Hata: GPIO geçersiz (0-3)\r\n");
+            UART_SendError(UART_ST_ARG, "Hata: GPIO geçersiz (0-3)\r\n");
             return;
         }
         
         // Validate pin range
         if (pin > 15) {
-            UART_SendString("Hata: Pin geçersiz (0-15)\r\n");
+            UART_SendError(UART_ST_ARG, "Hata: Pin geçersiz (0-15)\r\n");
             return;
         }
         
@@ -1389,7 +1926,7 @@ void IO16_HandleCommand(const char* cmd) {
             case 2: gpio_port = GPIOC; UART_SendString("[TEST-CS] GPIO = GPIOC\r\n"); break;
             case 3: gpio_port = GPIOD; UART_SendString("[TEST-CS] GPIO = GPIOD\r\n"); break;
             default: 
-                UART_SendString("Hata: GPIO dönüşüm hatası\r\n");
+                UART_SendError(UART_ST_HW, "Hata: GPIO dönüşüm hatası\r\n");
                 return;
         }
         
@@ -1428,6 +1965,7 @@ void IO16_HandleCommand(const char* cmd) {
         UART_SendString("\r\n");
         
         if (info != 0x00 && info != 0xFF) {
+            UART_Reply(UART_ST_OK, NULL);
             UART_SendString("[CHIP-INFO] ✓ iC-JX chip detected and responding!\r\n");
             UART_SendString("[SUCCESS] This pin is the correct CS: GPIO");
             UART_SendHex8(gpio);
@@ -1437,6 +1975,7 @@ void IO16_HandleCommand(const char* cmd) {
         } else {
             UART_SendString("[CHIP-INFO] ✗ No valid chip response (0x00 or 0xFF)\r\n");
             UART_SendString("[FAIL] This pin is NOT the CS pin\r\n");
+            UART_Reply(UART_ST_HW, NULL);
         }
         
         // Set CS HIGH (inactive) again
@@ -1444,7 +1983,7 @@ void IO16_HandleCommand(const char* cmd) {
         UART_SendString("[TEST-CS] CS set HIGH (inactive) - Test complete\r\n");
     }
     else {
-        UART_SendString("Hata: Bilinmeyen komut\r\n");
+        UART_SendError(UART_ST_SYNTAX, "Hata: Bilinmeyen komut\r\n");
         UART_SendString("Kullanım:\r\n");
         UART_SendString("  io16:SLOT:set:PIN:high/low\r\n");
         UART_SendString("  io16:SLOT:get:PIN\r\n");
@@ -1455,9 +1994,14 @@ void IO16_HandleCommand(const char* cmd) {
         UART_SendString("  io16:SLOT:overcurrent  - Check overcurrent status\r\n");
         UART_SendString("  io16:SLOT:regdump      - Dump all registers\r\n");
         UART_SendString("  io16:SLOT:writeall:VAL - Write all 16 pins (hex or decimal)\r\n");
+        UART_SendString("  io16:SLOT:errors[:reset] - SPI retry counters\r\n");
+        UART_SendString("  io16:SLOT:pulse:PIN:MS[:low]           - Timed pulse\r\n");
+        UART_SendString("  io16:SLOT:train:PIN:ON:OFF:COUNT[:low] - Pulse train (COUNT 0 = endless)\r\n");
+        UART_SendString("  io16:SLOT:after:MS:PIN:high/low        - Delayed write\r\n");
+        UART_SendString("  io16:SLOT:cancel[:PIN] / timers        - Cancel / pending timers\r\n");
         UART_SendString("  io16:testcs:GPIO:PIN   - Test pin as CS (SAFE - READ ONLY!)\r\n");
     }
     
     // Komut tamamlandı mesajı (burjuva_manager için)
-    UART_SendString("\r\nKomut tamamlandi: io16\r\n");
+    UART_SendComplete("io16");
 }
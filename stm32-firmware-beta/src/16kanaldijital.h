@@ -10,6 +10,7 @@
 
 // Modül kaydetme ve initialization
 void IO16_Register(uint8_t slot);
+void IO16_Unregister(uint8_t slot);
 int IO16_ChipInit(uint8_t slot);  // CRITICAL: Initialize IO678 chip (internal clock)
 
 // Pin kontrolü
@@ -21,6 +22,18 @@ int IO16_SetDirection(uint8_t slot, uint8_t pin, uint8_t direction);
 uint16_t IO16_ReadAll(uint8_t slot);
 int IO16_WriteAll(uint8_t slot, uint16_t state);
 
+// Gölge register üzerinden maskeli çıkış yazımı (zamanlı çıkışlar, darbe.c)
+int IO16_ApplyOutputs(uint8_t slot, uint16_t mask, uint16_t value);
+int IO16_EnsureOutput(uint8_t slot, uint8_t pin);
+
+// Girişlerin sessiz tek çerçeve okuması (referans arama taraması)
+int IO16_ReadInputs(uint8_t slot, uint16_t* inputs);
+
+// Atomic batch: çıkışları biriktir, tek taramada uygula
+void IO16_BeginDeferred(void);
+int IO16_CommitDeferred(void);
+void IO16_DiscardDeferred(void);
+
 // Durum ve komut
 void IO16_PrintStatus(uint8_t slot);
 void IO16_HandleCommand(const char* cmd);
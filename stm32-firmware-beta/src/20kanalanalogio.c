@@ -118,6 +118,22 @@ void AIO20_Register(uint8_t slot) {
     }
 }
 
+/**
+ * Slot'taki AIO20 modülünü kayıttan çıkar (modül çıkarıldığında)
+ */
+void AIO20_Unregister(uint8_t slot) {
+    for (uint8_t i = 0; i < aio20_module_count; i++) {
+        if (aio20_modules[i].slot == slot) {
+            // Kalan modülleri bir sola kaydır
+            for (uint8_t j = i; j + 1 < aio20_module_count; j++) {
+                aio20_modules[j] = aio20_modules[j + 1];
+            }
+            aio20_module_count--;
+            return;
+        }
+    }
+}
+
 /**
  * Slot'a göre modül bul
  */
@@ -491,6 +507,13 @@ void AIO20_PrintInfo(uint8_t slot) {
     UART_SendString("====================================\r\n");
 }
 
+/**
+ * Machine mode hata kodu: slotta modül yoksa NOMODULE, varsa HW
+ */
+static uint8_t AIO20_ErrorStatus(uint8_t slot) {
+    return AIO20_GetModule(slot) ? UART_ST_HW : UART_ST_NOMODULE;
+}
+
 /**
  * Modül komutunu işle
  * Format: aio20:SLOT:KOMUT
@@ -510,13 +533,13 @@ void AIO20_HandleCommand(const char* cmd) {
     
     // Slot parse
     if (cmd[0] < '0' || cmd[0] > '3') {
-        UART_SendString("Hata: Geçersiz slot (0-3)\r\n");
+        UART_SendError(UART_ST_ARG, "Hata: Geçersiz slot (0-3)\r\n");
         return;
     }
     uint8_t slot = cmd[0] - '0';
     
     if (cmd[1] != ':') {
-        UART_SendString("Hata: Format hatası\r\n");
+        UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası\r\n");
         return;
     }
     cmd += 2;
@@ -534,7 +557,7 @@ void AIO20_HandleCommand(const char* cmd) {
         }
         
         if (port >= 20) {
-            UART_SendString("Hata: Geçersiz port (0-19)\r\n");
+            UART_SendError(UART_ST_ARG, "Hata: Geçersiz port (0-19)\r\n");
             return;
         }
         
@@ -546,8 +569,10 @@ void AIO20_HandleCommand(const char* cmd) {
             sprintf(buf, "Port %d: Raw=%d, Voltage=%d.%03dV\r\n",
                     port, value, voltage / 1000, voltage % 1000);
             UART_SendString(buf);
+            sprintf(buf, "%d", value);
+            UART_Reply(UART_ST_OK, buf);
         } else {
-            UART_SendString("Hata: ADC okuma başarısız\r\n");
+            UART_SendError(AIO20_ErrorStatus(slot), "Hata: ADC okuma başarısız\r\n");
         }
     }
     else if (strncmp(cmd, "write:", 6) == 0) {
@@ -563,7 +588,7 @@ void AIO20_HandleCommand(const char* cmd) {
         }
         
         if (*cmd != ':') {
-            UART_SendString("Hata: Format hatası\r\n");
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası\r\n");
             return;
         }
         cmd++;
@@ -575,7 +600,7 @@ void AIO20_HandleCommand(const char* cmd) {
         }
         
         if (port >= 20 || value > 4095) {
-            UART_SendString("Hata: Geçersiz parametre\r\n");
+            UART_SendError(UART_ST_ARG, "Hata: Geçersiz parametre\r\n");
             return;
         }
         
@@ -586,8 +611,9 @@ void AIO20_HandleCommand(const char* cmd) {
             sprintf(buf, "OK: Port %d = %d (Voltage=%d.%03dV)\r\n",
                     port, value, voltage / 1000, voltage % 1000);
             UART_SendString(buf);
+            UART_Reply(UART_ST_OK, NULL);
         } else {
-            UART_SendString("Hata: DAC yazma başarısız\r\n");
+            UART_SendError(AIO20_ErrorStatus(slot), "Hata: DAC yazma başarısız\r\n");
         }
     }
     else if (strncmp(cmd, "setvolt:", 8) == 0) {
@@ -603,7 +629,7 @@ void AIO20_HandleCommand(const char* cmd) {
         }
         
         if (*cmd != ':') {
-            UART_SendString("Hata: Format hatası\r\n");
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası\r\n");
             return;
         }
         cmd++;
@@ -615,7 +641,7 @@ void AIO20_HandleCommand(const char* cmd) {
         }
         
         if (port >= 20 || voltage_mv > 10000) {
-            UART_SendString("Hata: Geçersiz parametre\r\n");
+            UART_SendError(UART_ST_ARG, "Hata: Geçersiz parametre\r\n");
             return;
         }
         
@@ -626,8 +652,9 @@ void AIO20_HandleCommand(const char* cmd) {
             sprintf(buf, "OK: Port %d = %d.%03dV (Raw=%d)\r\n",
                     port, voltage_mv / 1000, voltage_mv % 1000, value);
             UART_SendString(buf);
+            UART_Reply(UART_ST_OK, NULL);
         } else {
-            UART_SendString("Hata: DAC yazma başarısız\r\n");
+            UART_SendError(AIO20_ErrorStatus(slot), "Hata: DAC yazma başarısız\r\n");
         }
     }
     else if (strcmp(cmd, "status") == 0) {
@@ -642,16 +669,32 @@ void AIO20_HandleCommand(const char* cmd) {
             // Init sonrası AFE kartlarını algıla
             AIO20_DetectAFECards(slot);
         } else {
-            UART_SendString("Hata: Init failed\r\n");
+            UART_SendError(AIO20_ErrorStatus(slot), "Hata: Init failed\r\n");
         }
     }
+    else if (strcmp(cmd, "readall") == 0) {
+        // readall: 20 portun ham ADC değerleri tek satırda
+        uint16_t values[20];
+        char list[20 * 5 + 1];
+        char* p = list;
+        
+        AIO20_ReadAllADC(slot, values);
+        for (uint8_t port = 0; port < 20; port++) {
+            p += sprintf(p, port ? ",%d" : "%d", values[port]);
+        }
+        UART_SendString("ADC:");
+        UART_SendString(list);
+        UART_SendString("\r\n");
+        UART_Reply(UART_ST_OK, list);
+    }
     else if (strcmp(cmd, "detectafe") == 0) {
         AIO20_DetectAFECards(slot);
     }
     else {
-        UART_SendString("Hata: Bilinmeyen komut\r\n");
+        UART_SendError(UART_ST_SYNTAX, "Hata: Bilinmeyen komut\r\n");
         UART_SendString("Kullanım:\r\n");
         UART_SendString("  aio20:SLOT:read:PORT\r\n");
+        UART_SendString("  aio20:SLOT:readall\r\n");
         UART_SendString("  aio20:SLOT:write:PORT:VALUE\r\n");
         UART_SendString("  aio20:SLOT:setvolt:PORT:MV\r\n");
         UART_SendString("  aio20:SLOT:status\r\n");
@@ -659,4 +702,7 @@ void AIO20_HandleCommand(const char* cmd) {
         UART_SendString("  aio20:SLOT:init\r\n");
         UART_SendString("  aio20:SLOT:detectafe\r\n");
     }
+    
+    // Komut tamamlandı mesajı (burjuva_manager için)
+    UART_SendComplete("aio20");
 }
@@ -10,6 +10,7 @@
 
 // Modül yönetimi
 void AIO20_Register(uint8_t slot);
+void AIO20_Unregister(uint8_t slot);
 
 // Chip operasyonları
 int AIO20_ChipInit(uint8_t slot);
@@ -0,0 +1,878 @@
+/**
+ * Burjuva Motor Controller - Betik (Bytecode) Yorumlayıcı
+ *
+ * Bytecode yüklemede bir kez doğrulanır (işlenen sınırları, sıçrama
+ * hedeflerinin komut başı olması), yorumlayıcı bu yüzden yalnızca yığın
+ * ve çalışma zamanı hatalarını denetler. Tarama sırası: bekleme süresi
+ * dolmadıysa hiçbir şey yapılmaz; aksi halde bütçe kadar komut, ardından
+ * biriken IO16 çıkışları tek IO16_CommitDeferred ile yazılır (atomic: ve
+ * kural.c ile aynı yol).
+ *
+ * USART1 RX yoklamalı ve FIFO'suz: komut satırı alınırken tarama yapılmaz,
+ * tarama başına en fazla BETIK_SPI_MAX SPI işlemi yapılır ve RX byte'ı
+ * beklerken yenisine geçilmez. SPI isteyen komut çalıştırılmadan tarama
+ * biter, sonraki taramada aynı komuttan devam edilir. DIN ve AIN değerleri
+ * tarama içinde önbelleklenir.
+ */
+
+#include "stm32f10x.h"
+#include "stm32f10x_usart.h"
+#include "betik.h"
+#include "fpga.h"
+#include "hareket.h"
+#include "pid.h"
+#include "kuyruk.h"
+#include "disli.h"
+#include "referans.h"
+#include "16kanaldijital.h"
+#include "20kanalanalogio.h"
+#include "modul_algilama.h"
+#include "yukleme.h"
+#include "istatistik.h"
+#include "komut.h"
+#include "tick.h"
+#include "uart_helper.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SLOT_SAYISI         4
+#define AIO20_PORT_SAYISI   20
+#define OLAY_SAYISI         32          // EVENT n, n < 32
+
+#define BILDIR_BITTI        0x01
+#define BILDIR_HATA         0x02
+
+static uint8_t kod[BETIK_BOYUT_MAX];
+static uint16_t boyut = 0;
+
+// Makine
+static uint8_t durum = BETIK_BOS;
+static uint8_t hata = BETIK_HATA_YOK;
+static uint16_t pc = 0;
+static int32_t yigin[BETIK_YIGIN];
+static uint8_t sp = 0;
+static int32_t degiskenler[BETIK_DEGISKEN];
+static uint8_t bekliyor = 0;
+static uint32_t uyanma_ms = 0;
+static uint16_t butce = BETIK_BUTCE_VARSAYILAN;
+
+// Tarama
+static uint16_t girisler[SLOT_SAYISI];
+static uint16_t adc[SLOT_SAYISI][AIO20_PORT_SAYISI];
+static uint8_t okunan_io;
+static uint32_t okunan_adc[SLOT_SAYISI];
+static uint8_t spi_islem;
+static uint8_t ertelenen;
+static uint32_t olaylar = 0;
+static uint8_t bildir_son = 0;
+static Betik_Bilgi sayac;
+
+// Yükleme
+static struct {
+    uint8_t aktif;
+    uint16_t boyut;
+    uint16_t yazilan;
+    uint32_t crc;
+    uint8_t veri[BETIK_BOYUT_MAX];
+} yukleme;
+
+static uint16_t oku16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t oku32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint8_t aio20_var(uint8_t slot) {
+    const Modul_Slot* s = Modul_GetSlot(slot);
+    return s && s->registered == MODUL_AIO20;
+}
+
+/**
+ * @return Komuttan sonraki işlenen byte sayısı, -1: geçersiz komut
+ */
+static int islenen_boyu(uint8_t op) {
+    switch (op) {
+    case BETIK_NOP: case BETIK_END: case BETIK_DUP: case BETIK_DROP: case BETIK_SWAP:
+    case BETIK_ADD: case BETIK_SUB: case BETIK_MUL: case BETIK_DIV: case BETIK_MOD:
+    case BETIK_AND: case BETIK_OR: case BETIK_XOR: case BETIK_NOT: case BETIK_NEG:
+    case BETIK_SHL: case BETIK_SHR:
+    case BETIK_EQ: case BETIK_NE: case BETIK_LT: case BETIK_LE: case BETIK_GT: case BETIK_GE:
+    case BETIK_YIELD: case BETIK_WAIT: case BETIK_TIME:
+        return 0;
+    case BETIK_PUSH8: case BETIK_LOAD: case BETIK_STORE: case BETIK_EVENT:
+        return 1;
+    case BETIK_PUSH16: case BETIK_JMP: case BETIK_JZ: case BETIK_JNZ:
+    case BETIK_DIN: case BETIK_DOUT: case BETIK_AIN:
+    case BETIK_MPOS: case BETIK_MGOTO: case BETIK_MSPEED: case BETIK_MSTOP:
+        return 2;
+    case BETIK_MRD: case BETIK_MWR:
+        return 3;
+    case BETIK_PUSH32:
+        return 4;
+    }
+    return -1;
+}
+
+/**
+ * İşlenen sınırları ve sıçrama hedefleri
+ * @return -1: geçerli, aksi halde hatalı komutun adresi
+ */
+static int kod_dogrula(const uint8_t* k, uint16_t n) {
+    static uint8_t baslar[BETIK_BOYUT_MAX / 8];
+    uint16_t a = 0;
+    
+    memset(baslar, 0, sizeof(baslar));
+    while (a < n) {
+        const uint8_t* p = &k[a];
+        int m = islenen_boyu(p[0]);
+        uint8_t gecerli = 1;
+        
+        if (m < 0 || a + 1 + m > n) {
+            return a;
+        }
+        switch (p[0]) {
+        case BETIK_LOAD:
+        case BETIK_STORE:
+            gecerli = p[1] < BETIK_DEGISKEN;
+            break;
+        case BETIK_EVENT:
+            gecerli = p[1] < OLAY_SAYISI;
+            break;
+        case BETIK_DIN:
+        case BETIK_DOUT:
+            gecerli = p[1] < SLOT_SAYISI && p[2] <= 15;
+            break;
+        case BETIK_AIN:
+            gecerli = p[1] < SLOT_SAYISI && p[2] < AIO20_PORT_SAYISI;
+            break;
+        case BETIK_MRD:
+        case BETIK_MWR:
+            gecerli = p[1] < SLOT_SAYISI && p[2] <= 15 && p[3] <= 15;
+            break;
+        case BETIK_MPOS:
+        case BETIK_MGOTO:
+        case BETIK_MSPEED:
+        case BETIK_MSTOP:
+            gecerli = p[1] < SLOT_SAYISI && p[2] <= 15;
+            break;
+        }
+        if (!gecerli) {
+            return a;
+        }
+        baslar[a / 8] |= (uint8_t)(1 << (a % 8));
+        a += (uint16_t)(1 + m);
+    }
+    
+    for (a = 0; a < n; a += (uint16_t)(1 + islenen_boyu(k[a]))) {
+        if (k[a] == BETIK_JMP || k[a] == BETIK_JZ || k[a] == BETIK_JNZ) {
+            uint16_t hedef = oku16(&k[a + 1]);
+            if (hedef >= n || !(baslar[hedef / 8] & (1 << (hedef % 8)))) {
+                return a;
+            }
+        }
+    }
+    return -1;
+}
+
+// ============================================================================
+// Yükleme
+// ============================================================================
+
+Betik_Sonuc Betik_Yukle(const uint8_t* k, uint16_t n) {
+    int hatali;
+    
+    if (n == 0 || n > BETIK_BOYUT_MAX) {
+        return BETIK_HATA_SIRA;
+    }
+    hatali = kod_dogrula(k, n);
+    if (hatali >= 0) {
+        sayac.hatali_adres = (uint16_t)hatali;
+        return BETIK_HATA_KOD;
+    }
+    
+    // DOUT pinleri önceden çıkış yapılır (tarama yön yazmaz)
+    UART_QuietBegin();
+    for (uint16_t a = 0; a < n; a += (uint16_t)(1 + islenen_boyu(k[a]))) {
+        if (k[a] == BETIK_DOUT) {
+            IO16_EnsureOutput(k[a + 1], k[a + 2]);
+        }
+    }
+    UART_QuietEnd();
+    
+    if (k != kod) {
+        memcpy(kod, k, n);
+    }
+    boyut = n;
+    durum = BETIK_HAZIR;
+    hata = BETIK_HATA_YOK;
+    pc = 0;
+    sp = 0;
+    bekliyor = 0;
+    olaylar = 0;
+    bildir_son = 0;
+    return BETIK_OK;
+}
+
+Betik_Sonuc Betik_Baslat(uint16_t n, uint32_t crc) {
+    if (n == 0 || n > BETIK_BOYUT_MAX) {
+        return BETIK_HATA_SIRA;
+    }
+    yukleme.aktif = 1;
+    yukleme.boyut = n;
+    yukleme.yazilan = 0;
+    yukleme.crc = crc;
+    return BETIK_OK;
+}
+
+Betik_Sonuc Betik_Parca(uint16_t ofset, const uint8_t* veri, uint16_t uzunluk) {
+    if (!yukleme.aktif || ofset != yukleme.yazilan ||
+        uzunluk > yukleme.boyut - yukleme.yazilan) {
+        return BETIK_HATA_SIRA;
+    }
+    memcpy(&yukleme.veri[ofset], veri, uzunluk);
+    yukleme.yazilan += uzunluk;
+    return BETIK_OK;
+}
+
+Betik_Sonuc Betik_Bitir(void) {
+    if (!yukleme.aktif || yukleme.yazilan != yukleme.boyut) {
+        return BETIK_HATA_SIRA;
+    }
+    yukleme.aktif = 0;
+    if (Yukleme_Crc32(0, yukleme.veri, yukleme.boyut) != yukleme.crc) {
+        return BETIK_HATA_CRC;
+    }
+    return Betik_Yukle(yukleme.veri, yukleme.boyut);
+}
+
+int Betik_Calistir(void) {
+    if (durum == BETIK_BOS) {
+        return -1;
+    }
+    durum = BETIK_CALISIYOR;
+    hata = BETIK_HATA_YOK;
+    pc = 0;
+    sp = 0;
+    bekliyor = 0;
+    return 0;
+}
+
+void Betik_Durdur(void) {
+    if (durum == BETIK_CALISIYOR) {
+        durum = BETIK_HATA;
+        hata = BETIK_HATA_DURDURULDU;
+        bekliyor = 0;
+    }
+}
+
+int Betik_Butce(uint16_t n) {
+    if (n == 0 || n > BETIK_BUTCE_MAX) {
+        return -1;
+    }
+    butce = n;
+    return 0;
+}
+
+int Betik_DegiskenOku(uint8_t n, int32_t* deger) {
+    if (n >= BETIK_DEGISKEN) {
+        return -1;
+    }
+    *deger = degiskenler[n];
+    return 0;
+}
+
+int Betik_DegiskenYaz(uint8_t n, int32_t deger) {
+    if (n >= BETIK_DEGISKEN) {
+        return -1;
+    }
+    degiskenler[n] = deger;
+    return 0;
+}
+
+void Betik_Oku(Betik_Bilgi* bilgi) {
+    *bilgi = sayac;
+    bilgi->durum = durum;
+    bilgi->hata = hata;
+    bilgi->pc = pc;
+    bilgi->boyut = boyut;
+    bilgi->butce = butce;
+    bilgi->yigin = sp;
+}
+
+void Betik_Sifirla(void) {
+    uint16_t hatali = sayac.hatali_adres;
+    memset(&sayac, 0, sizeof(sayac));
+    sayac.hatali_adres = hatali;
+}
+
+// ============================================================================
+// Yorumlayıcı
+// ============================================================================
+
+static void dur(uint8_t h) {
+    durum = (h == BETIK_HATA_YOK) ? BETIK_BITTI : BETIK_HATA;
+    hata = h;
+    bildir_son = (h == BETIK_HATA_YOK) ? BILDIR_BITTI : BILDIR_HATA;
+}
+
+static int cek(int32_t* v) {
+    if (sp == 0) {
+        dur(BETIK_HATA_YIGIN);
+        return -1;
+    }
+    *v = yigin[--sp];
+    return 0;
+}
+
+static int it(int32_t v) {
+    if (sp >= BETIK_YIGIN) {
+        dur(BETIK_HATA_YIGIN);
+        return -1;
+    }
+    yigin[sp++] = v;
+    return 0;
+}
+
+static uint8_t bayt(int32_t v) {
+    return (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+static int32_t islem(uint8_t op, int32_t a, int32_t b) {
+    uint32_t ua = (uint32_t)a, ub = (uint32_t)b;
+    
+    switch (op) {
+    case BETIK_ADD: return (int32_t)(ua + ub);
+    case BETIK_SUB: return (int32_t)(ua - ub);
+    case BETIK_MUL: return (int32_t)(ua * ub);
+    case BETIK_DIV: return (b == -1) ? (int32_t)(0 - ua) : a / b;
+    case BETIK_MOD: return (b == -1) ? 0 : a % b;
+    case BETIK_AND: return a & b;
+    case BETIK_OR:  return a | b;
+    case BETIK_XOR: return a ^ b;
+    case BETIK_SHL: return (int32_t)(ua << (ub & 31));
+    case BETIK_SHR: return a >> (ub & 31);
+    case BETIK_EQ:  return a == b;
+    case BETIK_NE:  return a != b;
+    case BETIK_LT:  return a < b;
+    case BETIK_LE:  return a <= b;
+    case BETIK_GT:  return a > b;
+    case BETIK_GE:  return a >= b;
+    }
+    return 0;
+}
+
+/**
+ * Motor komutu öncesi: servo tick'i ve kuyruk eksene yeniden yazmasın
+ */
+static void eksen_birak(uint8_t slot, uint8_t ch) {
+    Hareket_Iptal(slot, ch);
+    PID_Kapat(slot, ch);
+    Disli_Coz(slot, ch);
+    Referans_Iptal(slot, ch);
+    Kuyruk_Durdur(slot, ch);
+}
+
+/**
+ * Süreç imajı komutları
+ * @return 0: başarılı, -1: modül hatası / geçersiz değer
+ */
+static int io_komut(const uint8_t* p) {
+    uint8_t slot = p[1], ch = p[2];
+    FPGA_Motor_t motor = { slot, ch };
+    uint8_t reg[3];
+    int32_t a, b;
+    int sonuc;
+    
+    switch (p[0]) {
+    case BETIK_DIN:
+        if (!(okunan_io & (1 << slot))) {
+            if (IO16_ReadInputs(slot, &girisler[slot]) != 0) {
+                return -1;
+            }
+            okunan_io |= (uint8_t)(1 << slot);
+        }
+        it((girisler[slot] >> ch) & 1);
+        return 0;
+    
+    case BETIK_DOUT:
+        if (cek(&a) != 0) {
+            return 0;
+        }
+        if (!ertelenen) {
+            IO16_BeginDeferred();
+            ertelenen = 1;
+        }
+        return IO16_ApplyOutputs(slot, (uint16_t)(1 << ch), a ? (uint16_t)(1 << ch) : 0);
+    
+    case BETIK_AIN:
+        if (!(okunan_adc[slot] & (1UL << ch))) {
+            if (!aio20_var(slot) || (sonuc = AIO20_ReadADC(slot, ch)) < 0) {
+                return -1;
+            }
+            adc[slot][ch] = (uint16_t)sonuc;
+            okunan_adc[slot] |= 1UL << ch;
+        }
+        it(adc[slot][ch]);
+        return 0;
+    
+    case BETIK_MRD:
+        if (FPGA_ReadRegister(slot, FPGA_MOTOR_REG_BASE(ch) + p[3], reg) != 0) {
+            return -1;
+        }
+        it(reg[0]);
+        return 0;
+    
+    case BETIK_MWR:
+        if (cek(&a) != 0) {
+            return 0;
+        }
+        return FPGA_WriteRegister(slot, FPGA_MOTOR_REG_BASE(ch) + p[3], (uint8_t)a);
+    
+    case BETIK_MPOS:
+        if (FPGA_ReadBlock(slot, FPGA_MOTOR_REG_BASE(ch) + REG_CURRENT_POS_HIGH, reg, 3) != 0) {
+            return -1;
+        }
+        a = ((int32_t)reg[0] << 16) | ((int32_t)reg[1] << 8) | reg[2];
+        it((a & 0x800000) ? a - 0x1000000 : a);
+        return 0;
+    
+    case BETIK_MGOTO:
+        if (cek(&b) != 0 || cek(&a) != 0) {
+            return 0;
+        }
+        eksen_birak(slot, ch);
+        return FPGA_Motor_GoToPosition(&motor, a, bayt(b));
+    
+    case BETIK_MSPEED:
+        if (cek(&b) != 0 || cek(&a) != 0) {
+            return 0;
+        }
+        eksen_birak(slot, ch);
+        return FPGA_Motor_SetSpeedDirection(&motor, bayt(a), bayt(b));
+    
+    case BETIK_MSTOP:
+        eksen_birak(slot, ch);
+        return FPGA_Motor_Stop(&motor);
+    }
+    return -1;
+}
+
+/**
+ * Komut SPI işlemi yapacak mı (bu taramada okunan DIN / AIN önbellekten)
+ */
+static uint8_t spi_gerekir(const uint8_t* p) {
+    switch (p[0]) {
+    case BETIK_DIN:
+        return !(okunan_io & (1 << p[1]));
+    case BETIK_AIN:
+        return !(okunan_adc[p[1]] & (1UL << p[2]));
+    case BETIK_DOUT:
+        return 0;                       // Tarama sonunda tek çerçeve
+    }
+    return 1;
+}
+
+/**
+ * Tek komut
+ * @return 0: devam, 1: tarama bitti, -1: SPI sınırı, komut çalıştırılmadan
+ *         tarama bitti (sonraki taramada aynı komut)
+ */
+static int adim(void) {
+    const uint8_t* p;
+    int32_t a, b;
+    
+    if (pc >= boyut) {
+        dur(BETIK_HATA_SON);
+        return 1;
+    }
+    p = &kod[pc];
+    pc += (uint16_t)(1 + islenen_boyu(p[0]));
+    
+    switch (p[0]) {
+    case BETIK_NOP:
+        break;
+    case BETIK_END:
+        dur(BETIK_HATA_YOK);
+        return 1;
+    case BETIK_PUSH8:
+        it((int8_t)p[1]);
+        break;
+    case BETIK_PUSH16:
+        it((int16_t)oku16(&p[1]));
+        break;
+    case BETIK_PUSH32:
+        it((int32_t)oku32(&p[1]));
+        break;
+    case BETIK_LOAD:
+        it(degiskenler[p[1]]);
+        break;
+    case BETIK_STORE:
+        if (cek(&a) == 0) {
+            degiskenler[p[1]] = a;
+        }
+        break;
+    case BETIK_DUP:
+        if (cek(&a) == 0 && it(a) == 0) {
+            it(a);
+        }
+        break;
+    case BETIK_DROP:
+        cek(&a);
+        break;
+    case BETIK_SWAP:
+        if (cek(&b) == 0 && cek(&a) == 0) {
+            it(b);
+            it(a);
+        }
+        break;
+    case BETIK_NOT:
+    case BETIK_NEG:
+        if (cek(&a) == 0) {
+            it(p[0] == BETIK_NOT ? !a : (int32_t)(0 - (uint32_t)a));
+        }
+        break;
+    case BETIK_JMP:
+        pc = oku16(&p[1]);
+        break;
+    case BETIK_JZ:
+    case BETIK_JNZ:
+        if (cek(&a) == 0 && ((a == 0) == (p[0] == BETIK_JZ))) {
+            pc = oku16(&p[1]);
+        }
+        break;
+    case BETIK_YIELD:
+        return 1;
+    case BETIK_WAIT:
+        if (cek(&a) != 0) {
+            return 1;
+        }
+        uyanma_ms = Tick_Ms() + (uint32_t)(a < 0 ? 0 : a);
+        bekliyor = 1;
+        return 1;
+    case BETIK_TIME:
+        it((int32_t)Tick_Ms());
+        break;
+    case BETIK_EVENT:
+        olaylar |= 1UL << p[1];
+        break;
+    
+    case BETIK_DIN: case BETIK_DOUT: case BETIK_AIN:
+    case BETIK_MRD: case BETIK_MWR: case BETIK_MPOS:
+    case BETIK_MGOTO: case BETIK_MSPEED: case BETIK_MSTOP:
+        if (spi_gerekir(p)) {
+            if (spi_islem >= BETIK_SPI_MAX ||
+                USART_GetFlagStatus(USART1, USART_FLAG_RXNE) != RESET) {
+                pc = (uint16_t)(p - kod);
+                return -1;
+            }
+            spi_islem++;
+        }
+        if (io_komut(p) != 0 && durum == BETIK_CALISIYOR) {
+            dur(BETIK_HATA_IO);
+        }
+        break;
+    
+    default:
+        if (cek(&b) == 0 && cek(&a) == 0) {
+            if (b == 0 && (p[0] == BETIK_DIV || p[0] == BETIK_MOD)) {
+                dur(BETIK_HATA_SIFIR);
+            } else {
+                it(islem(p[0], a, b));
+            }
+        }
+        break;
+    }
+    return durum != BETIK_CALISIYOR;
+}
+
+static void bildir(void) {
+    char event[16];
+    char message[64];
+    
+    // Olay satırı yarım komut satırıyla karışmasın
+    if ((!olaylar && !bildir_son) || !Komut_SatirBos()) {
+        return;
+    }
+    for (uint8_t i = 0; i < OLAY_SAYISI; i++) {
+        if (olaylar & (1UL << i)) {
+            sprintf(event, "betik:%u", i);
+            sprintf(message, "\r\n[BETIK] Olay %u\r\n", i);
+            UART_SendEvent(event, message);
+        }
+    }
+    olaylar = 0;
+    
+    if (bildir_son == BILDIR_BITTI) {
+        UART_SendEvent("betik:end", "\r\n[BETIK] Program bitti\r\n");
+    } else if (bildir_son == BILDIR_HATA) {
+        sprintf(message, "\r\n[BETIK] Program durdu: hata %u, adres %u\r\n", hata, pc);
+        UART_SendEvent("betik:fail", message);
+    }
+    bildir_son = 0;
+}
+
+void Betik_Isle(void) {
+    uint32_t bas;
+    uint16_t n = 0;
+    
+    bildir();
+    if (durum != BETIK_CALISIYOR) {
+        return;
+    }
+    
+    // Satır alınırken tarama yok
+    if (!Komut_SatirBos() || USART_GetFlagStatus(USART1, USART_FLAG_RXNE) != RESET) {
+        return;
+    }
+    if (bekliyor) {
+        if ((int32_t)(Tick_Ms() - uyanma_ms) < 0) {
+            return;
+        }
+        bekliyor = 0;
+    }
+    
+    bas = Istatistik_Cycle();
+    okunan_io = 0;
+    memset(okunan_adc, 0, sizeof(okunan_adc));
+    spi_islem = 0;
+    ertelenen = 0;
+    
+    while (n < butce) {
+        int r = adim();
+        if (r >= 0) {
+            n++;
+        }
+        if (r != 0) {
+            break;
+        }
+    }
+    
+    if (ertelenen && IO16_CommitDeferred() != 0 && durum == BETIK_CALISIYOR) {
+        dur(BETIK_HATA_IO);
+    }
+    
+    sayac.tarama++;
+    sayac.komut += n;
+    sayac.tarama_son = Istatistik_Cycle() - bas;
+    if (sayac.tarama_son > sayac.tarama_max) {
+        sayac.tarama_max = sayac.tarama_son;
+    }
+}
+
+// ============================================================================
+// Komutlar
+// ============================================================================
+
+/**
+ * Hex dizisini byte'lara çevir
+ * @return byte sayısı, -1: geçersiz karakter / tek hane / taşma
+ */
+static int hex_coz(const char* hex, uint8_t* out, uint16_t max) {
+    uint16_t n = 0;
+    
+    while (hex[0] != '\0') {
+        uint8_t byte = 0;
+        for (uint8_t k = 0; k < 2; k++) {
+            char c = hex[k];
+            byte <<= 4;
+            if (c >= '0' && c <= '9') {
+                byte |= c - '0';
+            } else if (c >= 'a' && c <= 'f') {
+                byte |= c - 'a' + 10;
+            } else {
+                return -1;                  // Küçük harf: komut satırı küçültülür
+            }
+        }
+        if (n >= max) {
+            return -1;
+        }
+        out[n++] = byte;
+        hex += 2;
+    }
+    return n;
+}
+
+static const char* durum_adi(uint8_t d) {
+    static const char* const adlar[] = { "yok", "hazir", "calisiyor", "bitti", "hata" };
+    return d < sizeof(adlar) / sizeof(adlar[0]) ? adlar[d] : "?";
+}
+
+static void komut(const char* arg) {
+    char buf[128];
+    char* son = NULL;
+    
+    if (*arg == '\0') {
+        Betik_Bilgi b;
+        Betik_Oku(&b);
+        
+        // "<durum> <hata> <pc> <boyut> <bütçe> <yığın> <tarama> <komut>
+        //  <tarama son> <tarama max>" (cycle, 72 = 1 µs)
+        sprintf(buf, "%u %u %u %u %u %u %lu %lu %lu %lu", b.durum, b.hata, b.pc, b.boyut,
+                b.butce, b.yigin, (unsigned long)b.tarama, (unsigned long)b.komut,
+                (unsigned long)b.tarama_son, (unsigned long)b.tarama_max);
+        UART_Reply(UART_ST_OK, buf);
+        
+        sprintf(buf, "Betik: %u byte, %s (hata %u), pc %u, yigin %u\r\n", b.boyut,
+                durum_adi(b.durum), b.hata, b.pc, b.yigin);
+        UART_SendString(buf);
+        sprintf(buf, "  %lu tarama, %lu komut, butce %u; tarama son %lu, max %lu cycle\r\n",
+                (unsigned long)b.tarama, (unsigned long)b.komut, b.butce,
+                (unsigned long)b.tarama_son, (unsigned long)b.tarama_max);
+        UART_SendString(buf);
+        return;
+    }
+    
+    if (strcmp(arg, "run") == 0) {
+        if (Betik_Calistir() != 0) {
+            UART_SendError(UART_ST_ARG, "Hata: Program yuklu degil\r\n");
+            return;
+        }
+        UART_SendString("Betik calisiyor\r\n");
+        UART_Reply(UART_ST_OK, NULL);
+        return;
+    }
+    
+    if (strcmp(arg, "stop") == 0) {
+        Betik_Durdur();
+        UART_SendString("Betik durduruldu\r\n");
+        UART_Reply(UART_ST_OK, NULL);
+        return;
+    }
+    
+    if (strcmp(arg, "reset") == 0) {
+        Betik_Sifirla();
+        UART_SendString("Betik sayaclari sifirlandi\r\n");
+        UART_Reply(UART_ST_OK, NULL);
+        return;
+    }
+    
+    if (strcmp(arg, "budget") == 0 || strncmp(arg, "budget:", 7) == 0) {
+        if (arg[6] == ':') {
+            unsigned long n = strtoul(arg + 7, &son, 10);
+            if (son == arg + 7 || *son != '\0') {
+                UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (betik:budget:N)\r\n");
+                return;
+            }
+            if (n > BETIK_BUTCE_MAX || Betik_Butce((uint16_t)n) != 0) {
+                UART_SendError(UART_ST_ARG, "Hata: Bütçe 1-1024 komut\r\n");
+                return;
+            }
+        }
+        sprintf(buf, "%u", butce);
+        UART_Reply(UART_ST_OK, buf);
+        sprintf(buf, "Betik butcesi: %u komut / tarama\r\n", butce);
+        UART_SendString(buf);
+        return;
+    }
+    
+    if (strncmp(arg, "var:", 4) == 0) {
+        unsigned long n = strtoul(arg + 4, &son, 10);
+        int32_t deger;
+        
+        if (son == arg + 4 || (*son != '\0' && *son != ':')) {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (betik:var:N[:V])\r\n");
+            return;
+        }
+        if (n >= BETIK_DEGISKEN) {
+            UART_SendError(UART_ST_ARG, "Hata: Değişken 0-15\r\n");
+            return;
+        }
+        if (*son == ':') {
+            const char* v = son + 1;
+            deger = (int32_t)strtol(v, &son, 0);
+            if (son == v || *son != '\0') {
+                UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (betik:var:N[:V])\r\n");
+                return;
+            }
+            Betik_DegiskenYaz((uint8_t)n, deger);
+        }
+        Betik_DegiskenOku((uint8_t)n, &deger);
+        sprintf(buf, "%ld", (long)deger);
+        UART_Reply(UART_ST_OK, buf);
+        sprintf(buf, "r%lu = %ld\r\n", n, (long)deger);
+        UART_SendString(buf);
+        return;
+    }
+    
+    if (strncmp(arg, "begin:", 6) == 0) {
+        unsigned long n = strtoul(arg + 6, &son, 0);
+        uint32_t crc;
+        
+        if (son == arg + 6 || *son != ':') {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (betik:begin:SIZE:CRC32)\r\n");
+            return;
+        }
+        arg = son + 1;
+        crc = strtoul(arg, &son, 0);
+        if (son == arg || *son != '\0') {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (betik:begin:SIZE:CRC32)\r\n");
+            return;
+        }
+        if (n > BETIK_BOYUT_MAX || Betik_Baslat((uint16_t)n, crc) != BETIK_OK) {
+            UART_SendError(UART_ST_ARG, "Hata: Program 1-1024 byte\r\n");
+            return;
+        }
+        UART_SendString("OK: Betik yukleme basladi\r\n");
+        UART_Reply(UART_ST_OK, NULL);
+        return;
+    }
+    
+    if (strncmp(arg, "data:", 5) == 0) {
+        uint8_t veri[BETIK_PARCA_MAX];
+        unsigned long ofset = strtoul(arg + 5, &son, 0);
+        int n;
+        
+        if (son == arg + 5 || *son != ':' || (n = hex_coz(son + 1, veri, sizeof(veri))) <= 0) {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (betik:data:OFFSET:HEX, en fazla 96 byte)\r\n");
+            return;
+        }
+        if (ofset > BETIK_BOYUT_MAX ||
+            Betik_Parca((uint16_t)ofset, veri, (uint16_t)n) != BETIK_OK) {
+            UART_SendError(UART_ST_ARG, "Hata: Yükleme yok veya parça sırası/boyutu hatalı\r\n");
+            return;
+        }
+        sprintf(buf, "%lu", ofset + n);
+        UART_Reply(UART_ST_OK, buf);
+        return;
+    }
+    
+    if (strcmp(arg, "end") == 0) {
+        Betik_Sonuc sonuc = Betik_Bitir();
+        
+        if (sonuc == BETIK_HATA_CRC) {
+            UART_SendError(UART_ST_ARG, "Hata: CRC32 tutmuyor, program değişmedi\r\n");
+            return;
+        } else if (sonuc == BETIK_HATA_KOD) {
+            Betik_Bilgi b;
+            Betik_Oku(&b);
+            sprintf(buf, "Hata: Adres %u'da geçersiz komut, program değişmedi\r\n", b.hatali_adres);
+            UART_SendError(UART_ST_ARG, buf);
+            return;
+        } else if (sonuc != BETIK_OK) {
+            UART_SendError(UART_ST_ARG, "Hata: Yükleme yok veya eksik\r\n");
+            return;
+        }
+        sprintf(buf, "%u", boyut);
+        UART_Reply(UART_ST_OK, buf);
+        sprintf(buf, "OK: %u byte betik yuklendi (betik:run ile baslat)\r\n", boyut);
+        UART_SendString(buf);
+        return;
+    }
+    
+    UART_SendError(UART_ST_SYNTAX, "Hata: Bilinmeyen betik komutu\r\n");
+    UART_SendString("Kullanım:\r\n");
+    UART_SendString("  betik / betik:run / betik:stop / betik:reset\r\n");
+    UART_SendString("  betik:budget[:N]\r\n");
+    UART_SendString("  betik:begin:SIZE:CRC32\r\n");
+    UART_SendString("  betik:data:OFFSET:HEX\r\n");
+    UART_SendString("  betik:end\r\n");
+    UART_SendString("  betik:var:N[:V]\r\n");
+}
+
+void Betik_Komut_Isle(const char* arg) {
+    komut(arg);
+    UART_SendComplete("betik");
+}
@@ -0,0 +1,198 @@
+/**
+ * Burjuva Motor Controller - Betik (Bytecode) Yorumlayıcı
+ *
+ * "Girişi bekle, çıkışa darbe ver, ekseni sür, analog oku, dallan" gibi
+ * host betiklerinin her adımı bir UART gidiş-dönüşüdür. Bu modül aynı
+ * sıraları firmware'de, ana döngünün her turunda sınırlı bir komut
+ * bütçesiyle çalıştırır. Program host'ta derlenir (betik_asm.py) ve
+ * kural tablosu gibi CRC32 ile yüklenir; aynı bytecode burjuva-sim'de
+ * (--betik) çalışır.
+ *
+ * Makine: 32-bit işaretli yığın (BETIK_YIGIN derinlik), 16 değişken
+ * (r0-r15, host'tan okunur/yazılır). Bir tarama şu durumlarda biter:
+ * YIELD, WAIT, END, hata, bütçe veya BETIK_SPI_MAX SPI işlemi (kalınan
+ * komuttan sonraki taramada devam edilir); komut satırı alınırken tarama
+ * yapılmaz (USART1 RX yoklamalı). Süreç imajı:
+ *
+ *   DIN   IO16 girişleri slot başına taramada bir kez okunur (tek çerçeve)
+ *   DOUT  IO16 çıkışları biriktirilir, tarama sonunda slot başına tek çerçeve
+ *   AIN   AIO20 portu taramada bir kez okunur
+ *   MRD / MWR / MPOS               okunduğu / yazıldığı anda
+ *   MGOTO / MSPEED / MSTOP         eksenin profil, PID, kuyruk, dişli ve
+ *                                  referans araması bırakılır
+ *
+ * Bytecode (işlenen byte'ları komuttan sonra, çok byte'lı alanlar little
+ * endian; yığın etkisi "önce -- sonra"):
+ *
+ *   00 NOP            01 END            02 PUSH8 i8       03 PUSH16 i16
+ *   04 PUSH32 i32     05 LOAD r         06 STORE r  (v --)
+ *   07 DUP            08 DROP           09 SWAP
+ *   10 ADD 11 SUB 12 MUL 13 DIV 14 MOD 15 AND 16 OR 17 XOR 1A SHL 1B SHR
+ *                                       (a b -- a?b)
+ *   18 NOT (mantıksal) 19 NEG           (a -- r)
+ *   20 EQ 21 NE 22 LT 23 LE 24 GT 25 GE (a b -- 0/1)
+ *   30 JMP a16        31 JZ a16 (v --)  32 JNZ a16 (v --)
+ *   33 YIELD          34 WAIT (ms --)   35 TIME (-- ms)
+ *   40 DIN s pin (-- bit)               41 DOUT s pin (v --)
+ *   42 AIN s port (-- adc)              (43 ayrılmış: AIO20 DAC kapalı)
+ *   44 MRD s ch reg (-- byte)           45 MWR s ch reg (v --)
+ *   46 MPOS s ch (-- konum)             47 MGOTO s ch (hedef hız --)
+ *   48 MSPEED s ch (hız yön --)         49 MSTOP s ch
+ *   50 EVENT n        ("!betik:n" olayı)
+ *
+ * Sıçrama adresleri ve işlenen sınırları yüklemede doğrulanır; yığın
+ * taşması, sıfıra bölme ve modül hataları programı HATA durumunda durdurur.
+ *
+ * Komutlar:
+ *   betik                          Durum ve tarama süreleri
+ *   betik:run / betik:stop         Baştan başlat (yığın boşalır) / durdur
+ *   betik:budget[:N]               Tarama başına komut bütçesi
+ *   betik:begin:SIZE:CRC32         Yükleme
+ *   betik:data:OFFSET:HEX          Sıradaki parça (en fazla 96 byte)
+ *   betik:end                      CRC ve bytecode'u doğrula, programı değiştir
+ *   betik:var:N[:V]                Değişken oku / yaz
+ *   betik:reset                    Sayaçları sıfırla
+ */
+
+#ifndef BETIK_H
+#define BETIK_H
+
+#include <stdint.h>
+
+#define BETIK_BOYUT_MAX         1024        // byte
+#define BETIK_PARCA_MAX         96          // betik:data parçası (komut satırı 256)
+#define BETIK_YIGIN             16
+#define BETIK_DEGISKEN          16
+#define BETIK_BUTCE_VARSAYILAN  64          // komut / tarama
+#define BETIK_BUTCE_MAX         1024
+#define BETIK_SPI_MAX           4           // SPI işlemi / tarama (AIO20 okuması ≥250 µs)
+
+typedef enum {
+    BETIK_NOP       = 0x00,
+    BETIK_END       = 0x01,
+    BETIK_PUSH8     = 0x02,
+    BETIK_PUSH16    = 0x03,
+    BETIK_PUSH32    = 0x04,
+    BETIK_LOAD      = 0x05,
+    BETIK_STORE     = 0x06,
+    BETIK_DUP       = 0x07,
+    BETIK_DROP      = 0x08,
+    BETIK_SWAP      = 0x09,
+    BETIK_ADD       = 0x10,
+    BETIK_SUB       = 0x11,
+    BETIK_MUL       = 0x12,
+    BETIK_DIV       = 0x13,
+    BETIK_MOD       = 0x14,
+    BETIK_AND       = 0x15,
+    BETIK_OR        = 0x16,
+    BETIK_XOR       = 0x17,
+    BETIK_NOT       = 0x18,
+    BETIK_NEG       = 0x19,
+    BETIK_SHL       = 0x1A,
+    BETIK_SHR       = 0x1B,
+    BETIK_EQ        = 0x20,
+    BETIK_NE        = 0x21,
+    BETIK_LT        = 0x22,
+    BETIK_LE        = 0x23,
+    BETIK_GT        = 0x24,
+    BETIK_GE        = 0x25,
+    BETIK_JMP       = 0x30,
+    BETIK_JZ        = 0x31,
+    BETIK_JNZ       = 0x32,
+    BETIK_YIELD     = 0x33,
+    BETIK_WAIT      = 0x34,
+    BETIK_TIME      = 0x35,
+    BETIK_DIN       = 0x40,
+    BETIK_DOUT      = 0x41,
+    BETIK_AIN       = 0x42,
+    BETIK_MRD       = 0x44,
+    BETIK_MWR       = 0x45,
+    BETIK_MPOS      = 0x46,
+    BETIK_MGOTO     = 0x47,
+    BETIK_MSPEED    = 0x48,
+    BETIK_MSTOP     = 0x49,
+    BETIK_EVENT     = 0x50
+} Betik_Komut;
+
+typedef enum {
+    BETIK_BOS = 0,              // Program yok
+    BETIK_HAZIR,                // Yüklü, çalışmıyor
+    BETIK_CALISIYOR,
+    BETIK_BITTI,                // END
+    BETIK_HATA
+} Betik_Durum;
+
+typedef enum {
+    BETIK_HATA_YOK = 0,
+    BETIK_HATA_YIGIN,           // Taşma / boş yığından okuma
+    BETIK_HATA_SIFIR,           // DIV / MOD sıfıra
+    BETIK_HATA_IO,              // Modül yok / okunamadı / yazılamadı / geçersiz değer
+    BETIK_HATA_SON,             // Program sonu END'siz aşıldı
+    BETIK_HATA_DURDURULDU       // betik:stop
+} Betik_Hata;
+
+typedef enum {
+    BETIK_OK = 0,
+    BETIK_HATA_SIRA,            // Yükleme yok / parça sırası / boyut
+    BETIK_HATA_CRC,
+    BETIK_HATA_KOD              // Geçersiz bytecode (Betik_Bilgi.hatali_adres)
+} Betik_Sonuc;
+
+typedef struct {
+    uint8_t durum;              // Betik_Durum
+    uint8_t hata;               // Betik_Hata
+    uint16_t pc;
+    uint16_t boyut;
+    uint16_t butce;
+    uint8_t yigin;              // Yığındaki değer sayısı
+    uint32_t tarama;
+    uint32_t komut;             // Çalıştırılan toplam komut
+    uint32_t tarama_son;        // cycle
+    uint32_t tarama_max;
+    uint16_t hatali_adres;      // Son BETIK_HATA_KOD'daki komut adresi
+} Betik_Bilgi;
+
+/**
+ * Host yüklemesi: başlat / sıradaki parça / bitir. Yeni program yalnızca
+ * Betik_Bitir başarılıysa eskisinin yerine geçer (çalışan program durur)
+ */
+Betik_Sonuc Betik_Baslat(uint16_t boyut, uint32_t crc);
+Betik_Sonuc Betik_Parca(uint16_t ofset, const uint8_t* veri, uint16_t uzunluk);
+Betik_Sonuc Betik_Bitir(void);
+
+/**
+ * Bytecode'u doğrula ve CRC'siz yükle (Betik_Bitir, simülatör --betik)
+ */
+Betik_Sonuc Betik_Yukle(const uint8_t* kod, uint16_t boyut);
+
+/**
+ * @return 0: başarılı, -1: program yok
+ */
+int Betik_Calistir(void);
+void Betik_Durdur(void);
+
+/**
+ * @return 0: başarılı, -1: geçersiz bütçe
+ */
+int Betik_Butce(uint16_t butce);
+
+/**
+ * @return 0: başarılı, -1: değişken yok
+ */
+int Betik_DegiskenOku(uint8_t n, int32_t* deger);
+int Betik_DegiskenYaz(uint8_t n, int32_t deger);
+
+void Betik_Oku(Betik_Bilgi* bilgi);
+void Betik_Sifirla(void);
+
+/**
+ * Ana döngünün her turunda: bütçe kadar komut, çıkışları uygula
+ */
+void Betik_Isle(void);
+
+/**
+ * Process "betik[:...]" command
+ */
+void Betik_Komut_Isle(const char* arg);
+
+#endif // BETIK_H
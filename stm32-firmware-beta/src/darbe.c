@@ -0,0 +1,298 @@
+/**
+ * Burjuva Motor Controller - IO16 Zamanlı Çıkış Motoru
+ *
+ * Hashed timing wheel: olay, kenar zamanının (due, Tick_Ms) alt bitleriyle
+ * seçilen yuvanın listesine eklenir. Her ms yalnızca o ms'nin yuvası
+ * taranır; yuvadaki sonraki turların olayları (due > şimdi) atlanır.
+ * Olaylar sabit havuzdan alınır, dinamik bellek yok.
+ */
+
+#include "darbe.h"
+#include "16kanaldijital.h"
+#include "tick.h"
+
+#define TEKER_BOYU          64              // Yuva sayısı (2'nin kuvveti)
+#define TEKER_MASKE         (TEKER_BOYU - 1)
+#define OLAY_YOK            0xFF
+#define SLOT_SAYISI         4
+
+typedef struct {
+    uint32_t due;           // Kenarın Tick_Ms değeri
+    uint16_t on_ms;         // Aktif süre (0: ertelenmiş tek yazım)
+    uint16_t off_ms;        // Pasif süre
+    uint16_t count;         // Kalan darbe (0: iptale kadar)
+    uint8_t slot;
+    uint8_t pin;
+    uint8_t active;         // Darbenin aktif seviyesi
+    uint8_t level;          // Bu kenarda yazılacak seviye
+    uint8_t next;           // Yuva / boş listesinde sonraki olay
+    uint8_t used;
+} Darbe_Olay;
+
+static Darbe_Olay olaylar[DARBE_OLAY_SAYISI];
+static uint8_t teker[TEKER_BOYU];
+static uint8_t bos_liste = OLAY_YOK;
+static uint32_t islenen_ms = 0;             // Son işlenen tick
+
+void Darbe_Init(void) {
+    for (uint8_t i = 0; i < DARBE_OLAY_SAYISI; i++) {
+        olaylar[i].used = 0;
+        olaylar[i].next = (i + 1 < DARBE_OLAY_SAYISI) ? i + 1 : OLAY_YOK;
+    }
+    bos_liste = 0;
+    
+    for (uint8_t i = 0; i < TEKER_BOYU; i++) {
+        teker[i] = OLAY_YOK;
+    }
+    islenen_ms = Tick_Ms();
+}
+
+static uint8_t olay_al(void) {
+    uint8_t idx = bos_liste;
+    if (idx != OLAY_YOK) {
+        bos_liste = olaylar[idx].next;
+        olaylar[idx].used = 1;
+    }
+    return idx;
+}
+
+static void olay_birak(uint8_t idx) {
+    olaylar[idx].used = 0;
+    olaylar[idx].next = bos_liste;
+    bos_liste = idx;
+}
+
+static void teker_ekle(uint8_t idx) {
+    uint8_t* head = &teker[olaylar[idx].due & TEKER_MASKE];
+    olaylar[idx].next = *head;
+    *head = idx;
+}
+
+static void teker_cikar(uint8_t idx) {
+    uint8_t* link = &teker[olaylar[idx].due & TEKER_MASKE];
+    while (*link != OLAY_YOK) {
+        if (*link == idx) {
+            *link = olaylar[idx].next;
+            return;
+        }
+        link = &olaylar[*link].next;
+    }
+}
+
+/**
+ * Slot/maske olaylarını sil; darbe ve dizi pinlerinin pasif seviyeleri
+ * *idle_mask / *idle_value'ya eklenir
+ */
+static uint8_t olaylari_sil(uint8_t slot, uint16_t pin_mask,
+                            uint16_t* idle_mask, uint16_t* idle_value) {
+    uint8_t removed = 0;
+    
+    for (uint8_t i = 0; i < DARBE_OLAY_SAYISI; i++) {
+        Darbe_Olay* ev = &olaylar[i];
+        uint16_t bit = (uint16_t)(1 << ev->pin);
+        
+        if (!ev->used || ev->slot != slot || !(pin_mask & bit)) {
+            continue;
+        }
+        if (ev->on_ms > 0) {
+            *idle_mask |= bit;
+            if (ev->active) {
+                *idle_value &= ~bit;
+            } else {
+                *idle_value |= bit;
+            }
+        }
+        teker_cikar(i);
+        olay_birak(i);
+        removed++;
+    }
+    return removed;
+}
+
+int Darbe_Baslat(uint8_t slot, uint8_t pin, uint8_t level,
+                 uint16_t on_ms, uint16_t off_ms, uint16_t count) {
+    uint16_t bit = (uint16_t)(1 << pin);
+    uint16_t idle_mask = 0, idle_value = 0;
+    uint8_t idx;
+    
+    if (slot >= SLOT_SAYISI || pin >= 16 || on_ms == 0 || on_ms > DARBE_SURE_MAX ||
+        off_ms > DARBE_SURE_MAX || (count != 1 && off_ms == 0)) {
+        return -1;
+    }
+    
+    // Pin'in önceki darbesi yenisiyle değiştirilir (seviye hemen yazılacak)
+    olaylari_sil(slot, bit, &idle_mask, &idle_value);
+    
+    idx = olay_al();
+    if (idx == OLAY_YOK) {
+        return -2;
+    }
+    if (IO16_ApplyOutputs(slot, bit, level ? bit : 0) != 0) {
+        olay_birak(idx);
+        return -1;
+    }
+    
+    Darbe_Olay* ev = &olaylar[idx];
+    ev->slot = slot;
+    ev->pin = pin;
+    ev->active = level ? 1 : 0;
+    ev->level = !ev->active;
+    ev->on_ms = on_ms;
+    ev->off_ms = off_ms;
+    ev->count = count;
+    // Mevcut ms'nin kalanı sayılmaz: aktif süre en az on_ms
+    ev->due = Tick_Ms() + on_ms + 1;
+    teker_ekle(idx);
+    return 0;
+}
+
+int Darbe_Ertele(uint8_t slot, uint8_t pin, uint8_t level, uint16_t delay_ms) {
+    uint8_t idx;
+    
+    if (slot >= SLOT_SAYISI || pin >= 16 || delay_ms > DARBE_SURE_MAX) {
+        return -1;
+    }
+    
+    idx = olay_al();
+    if (idx == OLAY_YOK) {
+        return -2;
+    }
+    
+    Darbe_Olay* ev = &olaylar[idx];
+    ev->slot = slot;
+    ev->pin = pin;
+    ev->active = level ? 1 : 0;
+    ev->level = ev->active;
+    ev->on_ms = 0;
+    ev->off_ms = 0;
+    ev->count = 0;
+    ev->due = Tick_Ms() + delay_ms + 1;
+    teker_ekle(idx);
+    return 0;
+}
+
+uint8_t Darbe_Iptal(uint8_t slot, uint16_t pin_mask) {
+    uint16_t idle_mask = 0, idle_value = 0;
+    uint8_t removed;
+    
+    if (slot >= SLOT_SAYISI) {
+        return 0;
+    }
+    
+    removed = olaylari_sil(slot, pin_mask, &idle_mask, &idle_value);
+    if (idle_mask) {
+        IO16_ApplyOutputs(slot, idle_mask, idle_value);
+    }
+    return removed;
+}
+
+uint16_t Darbe_Bekleyen(uint8_t slot, uint8_t* count) {
+    uint16_t mask = 0;
+    uint8_t n = 0;
+    
+    for (uint8_t i = 0; i < DARBE_OLAY_SAYISI; i++) {
+        if (olaylar[i].used && olaylar[i].slot == slot) {
+            mask |= (uint16_t)(1 << olaylar[i].pin);
+            n++;
+        }
+    }
+    if (count) {
+        *count = n;
+    }
+    return mask;
+}
+
+/**
+ * Dizinin sonraki kenarını zamanla
+ * @return 0: olay bitti (havuza dönecek)
+ */
+static uint8_t sonraki_kenar(Darbe_Olay* ev, uint32_t now) {
+    uint16_t gap;
+    
+    if (ev->on_ms == 0) {
+        return 0;                   // Ertelenmiş tek yazım
+    }
+    if (ev->level == ev->active) {
+        gap = ev->on_ms;
+    } else {
+        if (ev->count > 0 && --ev->count == 0) {
+            return 0;               // Son darbe bitti
+        }
+        gap = ev->off_ms;
+    }
+    
+    ev->level = !ev->level;
+    ev->due += gap;                 // Önceki kenara göre: periyot kaymaz
+    if ((int32_t)(ev->due - now) <= 0) {
+        ev->due = now + 1;          // Ana döngü gecikmesinden sonra
+    }
+    return 1;
+}
+
+/**
+ * Tek ms: yuvadaki zamanı gelmiş olayları uygula
+ */
+static void tick_isle(uint32_t now) {
+    uint16_t mask[SLOT_SAYISI] = { 0 };
+    uint16_t value[SLOT_SAYISI] = { 0 };
+    uint8_t* link = &teker[now & TEKER_MASKE];
+    uint8_t tekrar = OLAY_YOK;      // Yeniden zamanlananlar (tarama bitince eklenir)
+    
+    while (*link != OLAY_YOK) {
+        uint8_t idx = *link;
+        Darbe_Olay* ev = &olaylar[idx];
+        uint16_t bit = (uint16_t)(1 << ev->pin);
+        
+        if ((int32_t)(ev->due - now) > 0) {
+            link = &ev->next;       // Sonraki turun olayı
+            continue;
+        }
+        *link = ev->next;
+        
+        mask[ev->slot] |= bit;
+        if (ev->level) {
+            value[ev->slot] |= bit;
+        } else {
+            value[ev->slot] &= ~bit;
+        }
+        
+        if (sonraki_kenar(ev, now)) {
+            ev->next = tekrar;
+            tekrar = idx;
+        } else {
+            olay_birak(idx);
+        }
+    }
+    
+    while (tekrar != OLAY_YOK) {
+        uint8_t idx = tekrar;
+        tekrar = olaylar[idx].next;
+        teker_ekle(idx);
+    }
+    
+    // Slot başına tek SPI çerçevesi
+    for (uint8_t slot = 0; slot < SLOT_SAYISI; slot++) {
+        if (mask[slot]) {
+            IO16_ApplyOutputs(slot, mask[slot], value[slot]);
+        }
+    }
+}
+
+void Darbe_Isle(void) {
+    uint32_t now = Tick_Ms();
+    
+    if (now == islenen_ms) {
+        return;
+    }
+    
+    // Bir teker turundan uzun gecikmede her yuva bir kez taranır:
+    // gecikmiş olayların hepsi bu turda uygulanır
+    if (now - islenen_ms > TEKER_BOYU) {
+        islenen_ms = now - TEKER_BOYU;
+    }
+    
+    while (islenen_ms != now) {
+        islenen_ms++;
+        tick_isle(islenen_ms);
+    }
+}
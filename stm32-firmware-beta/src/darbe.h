@@ -0,0 +1,58 @@
+/**
+ * Burjuva Motor Controller - IO16 Zamanlı Çıkış Motoru
+ *
+ * Tek darbe (pin N ms aktif), darbe dizisi (aktif/pasif süreleri ve
+ * adet) ve ertelenmiş pin yazımı. Olaylar SysTick milisaniye sayacına
+ * bağlı bir zamanlayıcı tekerinde tutulur; Darbe_Isle ana döngüden
+ * çağrılır ve aynı ms'de düşen kenarları slot başına tek bir 2-byte
+ * OUTPUT_A/B yazımı ile uygular (IO16 gölge çıkış register'ı).
+ *
+ * Kenar gecikmesi en fazla 1 ms + o an çalışan komutun süresidir.
+ */
+
+#ifndef DARBE_H
+#define DARBE_H
+
+#include <stdint.h>
+
+#define DARBE_OLAY_SAYISI   32      // Aynı anda bekleyen olay
+#define DARBE_SURE_MAX      60000   // ms (aktif/pasif/erteleme süresi)
+
+/**
+ * Olay havuzunu ve teker konumunu sıfırla (Tick_Init'ten sonra)
+ */
+void Darbe_Init(void);
+
+/**
+ * Darbe dizisi başlat: pin hemen level'e çekilir, on_ms sonra bırakılır,
+ * off_ms sonra tekrar aktif olur. count: darbe adedi (0 = iptale kadar).
+ * Tek darbe: count=1. Pin'in bekleyen olayları önce iptal edilir.
+ * @return 0: başarılı, -1: IO16 yazımı veya geçersiz süre, -2: havuz dolu
+ */
+int Darbe_Baslat(uint8_t slot, uint8_t pin, uint8_t level,
+                 uint16_t on_ms, uint16_t off_ms, uint16_t count);
+
+/**
+ * delay_ms sonra pin'i level'e yaz (tek seferlik)
+ * @return 0: başarılı, -1: geçersiz süre, -2: havuz dolu
+ */
+int Darbe_Ertele(uint8_t slot, uint8_t pin, uint8_t level, uint16_t delay_ms);
+
+/**
+ * Maskedeki pinlerin olaylarını iptal et; darbe/dizi pinleri pasif
+ * seviyeye çekilir, ertelenmiş yazımlar atılır
+ * @return iptal edilen olay sayısı
+ */
+uint8_t Darbe_Iptal(uint8_t slot, uint16_t pin_mask);
+
+/**
+ * Bekleyen olayı olan pinler (maske), *count: olay sayısı
+ */
+uint16_t Darbe_Bekleyen(uint8_t slot, uint8_t* count);
+
+/**
+ * Zamanı gelen kenarları uygula - ana döngüden çağrılır
+ */
+void Darbe_Isle(void);
+
+#endif // DARBE_H
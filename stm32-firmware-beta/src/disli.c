@@ -0,0 +1,253 @@
+/**
+ * Burjuva Motor Controller - Elektronik Dişli
+ *
+ * Hedef tek formülle hesaplanır, artımlı toplama yoktur: oran ne olursa
+ * olsun yuvarlama hatası birikmez. master * PAY 64-bit'tir (|PAY| < 2^16,
+ * master < 2^47 count). Master okumaları konum.c'nin bu tick'teki
+ * örneğidir: SPI trafiği slave başına değişen hedefin 3-byte yazımıdır.
+ */
+
+#include "disli.h"
+#include "konum.h"
+#include "pid.h"
+#include "servo.h"
+#include "fpga.h"
+#include "olay.h"
+#include <string.h>
+
+#define SLOT_SAYISI         4
+#define HEDEF_MIN           (-8388608)      // 24-bit REG_TARGET_POS
+#define HEDEF_MAX           8388607
+
+typedef struct {
+    volatile uint8_t durum;     // Disli_Durum
+    uint8_t slot;
+    uint8_t ch;
+    uint8_t seri;               // Master konumunun başlangıç serisi
+    Disli_Param param;
+    int32_t baslangic;          // Bağlanırken slave konumu
+    int64_t k;                  // hedef = floor((master * pay + k) / payda)
+    int32_t hedef;              // count
+    int32_t hiz;                // count/tick
+    int32_t yazilan;            // Son yazılan REG_TARGET_POS
+    uint32_t doyum;
+} Disli_Bag;
+
+static Disli_Bag baglar[DISLI_EKSEN_SAYISI];
+
+static Disli_Bag* bag_bul(uint8_t slot, uint8_t ch) {
+    for (uint8_t i = 0; i < DISLI_EKSEN_SAYISI; i++) {
+        if (baglar[i].durum != DISLI_BOS && baglar[i].slot == slot && baglar[i].ch == ch) {
+            return &baglar[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Master'ı kullanan bağ kalmadıysa dişlinin açtığı yakalamayı kapat
+ */
+static void master_birak(uint8_t slot, uint8_t ch) {
+    for (uint8_t i = 0; i < DISLI_EKSEN_SAYISI; i++) {
+        if (baglar[i].durum != DISLI_BOS &&
+            baglar[i].param.master_slot == slot && baglar[i].param.master_ch == ch) {
+            return;
+        }
+    }
+    Konum_Birak(slot, ch);
+}
+
+static int32_t konum_coz(const uint8_t* reg) {
+    int32_t pos = ((int32_t)reg[0] << 16) | ((int32_t)reg[1] << 8) | reg[2];
+    return (pos & 0x800000) ? pos - 0x1000000 : pos;
+}
+
+int Disli_Bagla(uint8_t slot, uint8_t ch, const Disli_Param* param) {
+    Disli_Bag* d;
+    Disli_Param eski;
+    uint8_t reg[3];
+    uint8_t bagliydi;
+    int sonuc;
+    
+    if (slot >= SLOT_SAYISI || ch > 15 || !param || param->master_slot >= SLOT_SAYISI ||
+        param->master_ch > 15 || (param->master_slot == slot && param->master_ch == ch) ||
+        param->payda < 1 || param->payda > DISLI_ORAN_MAX ||
+        param->pay < -DISLI_ORAN_MAX || param->pay > DISLI_ORAN_MAX || param->hiz == 0 ||
+        Olay_Durduruldu(slot, ch)) {
+        return -1;
+    }
+    if (FPGA_ReadBlock(slot, FPGA_MOTOR_REG_BASE(ch) + REG_CURRENT_POS_HIGH, reg, 3) != 0) {
+        return -1;
+    }
+    
+    d = bag_bul(slot, ch);
+    for (uint8_t i = 0; i < DISLI_EKSEN_SAYISI && !d; i++) {
+        if (baglar[i].durum == DISLI_BOS) {
+            d = &baglar[i];
+        }
+    }
+    if (!d) {
+        return -2;
+    }
+    
+    sonuc = Konum_Ac(param->master_slot, param->master_ch, 0);
+    if (sonuc != 0) {
+        return sonuc;
+    }
+    
+    Servo_Kilit();
+    bagliydi = (d->durum != DISLI_BOS);
+    eski = d->param;
+    d->durum = DISLI_BOS;
+    Servo_Birak();
+    
+    d->slot = slot;
+    d->ch = ch;
+    d->param = *param;
+    d->baslangic = konum_coz(reg);
+    d->hedef = d->baslangic;
+    d->yazilan = d->baslangic;
+    d->hiz = 0;
+    d->doyum = 0;
+    
+    // Pozisyon modu, slave bulunduğu yerde: ilk hedef yazımına kadar hareket yok
+    if (!PID_Etkin(slot, ch)) {
+        FPGA_Motor_t motor = { slot, ch };
+        FPGA_Motor_GoToPosition(&motor, d->baslangic, param->hiz);
+    }
+    
+    Servo_Kilit();
+    d->durum = DISLI_BEKLIYOR;
+    Servo_Birak();
+    
+    // Yeniden bağlanan slave'in eski master'ı
+    if (bagliydi) {
+        master_birak(eski.master_slot, eski.master_ch);
+    }
+    return 0;
+}
+
+void Disli_Coz(uint8_t slot, uint8_t ch) {
+    uint8_t cozulen = 0;        // Bağ indeksi maskesi
+    
+    Servo_Kilit();
+    for (uint8_t i = 0; i < DISLI_EKSEN_SAYISI; i++) {
+        Disli_Bag* d = &baglar[i];
+        if (d->durum == DISLI_BOS) {
+            continue;
+        }
+        if ((d->slot == slot && (ch == DISLI_TUM_KANALLAR || d->ch == ch)) ||
+            (ch == DISLI_TUM_KANALLAR && d->param.master_slot == slot)) {
+            d->durum = DISLI_BOS;
+            cozulen |= (uint8_t)(1 << i);
+        }
+    }
+    Servo_Birak();
+    
+    for (uint8_t i = 0; i < DISLI_EKSEN_SAYISI; i++) {
+        if (cozulen & (1 << i)) {
+            master_birak(baglar[i].param.master_slot, baglar[i].param.master_ch);
+        }
+    }
+}
+
+int Disli_Oku(uint8_t slot, uint8_t ch, Disli_Bilgi* bilgi) {
+    Disli_Bag* d = bag_bul(slot, ch);
+    if (!d) {
+        return -1;
+    }
+    
+    Servo_Kilit();
+    bilgi->durum = d->durum;
+    bilgi->param = d->param;
+    bilgi->hedef = d->hedef;
+    bilgi->hiz = d->hiz * SERVO_HZ;
+    bilgi->doyum = d->doyum;
+    Servo_Birak();
+    return 0;
+}
+
+int Disli_Setpoint(uint8_t slot, uint8_t ch, int32_t* pos_q8, int32_t* hiz_q8) {
+    Disli_Bag* d = bag_bul(slot, ch);
+    if (!d) {
+        return -1;
+    }
+    *pos_q8 = d->hedef * 256;
+    // Hedef sıçraması (master yeniden başladı, doyum) 24 bit aralığın iki
+    // katına çıkabilir: Q8 int32'ye sığsın
+    *hiz_q8 = (d->hiz > HEDEF_MAX) ? HEDEF_MAX * 256 :
+              (d->hiz < HEDEF_MIN) ? HEDEF_MIN * 256 : d->hiz * 256;
+    return 0;
+}
+
+uint8_t Disli_Aktif(void) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < DISLI_EKSEN_SAYISI; i++) {
+        if (baglar[i].durum != DISLI_BOS) {
+            n++;
+        }
+    }
+    return n;
+}
+
+// ============================================================================
+// Servo tick
+// ============================================================================
+
+static int64_t taban_bol(int64_t a, int32_t b) {
+    int64_t q = a / b;
+    return (a % b != 0 && a < 0) ? q - 1 : q;      // b > 0
+}
+
+static void bag_tick(Disli_Bag* d) {
+    const Disli_Param* p = &d->param;
+    int64_t master, hedef;
+    uint8_t seri;
+    uint8_t reg[3];
+    
+    if (Konum_Son(p->master_slot, p->master_ch, &master, &seri) != 0) {
+        d->hiz = 0;                 // Master örneği yok: slave yerinde
+        return;
+    }
+    
+    if (d->durum == DISLI_BEKLIYOR) {
+        // Mutlak: hedef = master * pay / payda + ofset; değilse slave'in konumu
+        d->k = p->ofset_var ? (int64_t)p->ofset * p->payda
+                            : (int64_t)d->baslangic * p->payda - master * p->pay;
+        d->seri = seri;
+        d->durum = DISLI_BAGLI;
+    } else if (seri != d->seri) {
+        // Master konumu yeniden başladı: son hedeften devam
+        d->k = (int64_t)d->hedef * p->payda - master * p->pay;
+        d->seri = seri;
+    }
+    
+    hedef = taban_bol(master * p->pay + d->k, p->payda);
+    if (hedef > HEDEF_MAX || hedef < HEDEF_MIN) {
+        hedef = (hedef > HEDEF_MAX) ? HEDEF_MAX : HEDEF_MIN;
+        d->durum = DISLI_DOYUM;
+        d->doyum++;
+    } else {
+        d->durum = DISLI_BAGLI;
+    }
+    d->hiz = (int32_t)hedef - d->hedef;
+    d->hedef = (int32_t)hedef;
+    
+    if (PID_Etkin(d->slot, d->ch) || d->hedef == d->yazilan) {
+        return;                     // PID setpoint'i PID_Tick'te okur
+    }
+    reg[0] = (uint8_t)(d->hedef >> 16);
+    reg[1] = (uint8_t)(d->hedef >> 8);
+    reg[2] = (uint8_t)d->hedef;
+    if (FPGA_WriteBlock(d->slot, FPGA_MOTOR_REG_BASE(d->ch) + REG_TARGET_POS_HIGH, reg, 3) == 0) {
+        d->yazilan = d->hedef;
+    }
+}
+
+void Disli_Tick(void) {
+    for (uint8_t i = 0; i < DISLI_EKSEN_SAYISI; i++) {
+        if (baglar[i].durum != DISLI_BOS) {
+            bag_tick(&baglar[i]);
+        }
+    }
+}
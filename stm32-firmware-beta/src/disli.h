@@ -0,0 +1,98 @@
+/**
+ * Burjuva Motor Controller - Elektronik Dişli
+ *
+ * Slave kanalın hedefi her servo tick'inde master kanalın konumunu
+ * rasyonel oranla izler:
+ *
+ *   hedef = floor((master * PAY + K) / PAYDA)
+ *
+ * Master konumu konum yakalamadan (konum.h) gelir: taşmaları açılmış,
+ * slot başına tek blok okunmuş örnek. Master sürülen bir motor kanalı ya
+ * da yalnızca enkoder sayan bir FPGA kanalı olabilir. K bağlanırken
+ * belirlenir: ofset verilirse hedef = master * PAY / PAYDA + ofset (mutlak),
+ * verilmezse slave bulunduğu yerden başlar (sıçrama yok). Master konumu
+ * yeniden başlarsa (home, reset) K, slave hedefi sıçramayacak şekilde
+ * yeniden hesaplanır.
+ *
+ * Slave FPGA pozisyon modunda sürülür: değişen hedef tek çerçevede
+ * 3-byte blok olarak yazılır. Slave'de PID döngüsü (pid.h) çalışıyorsa
+ * register yazılmaz, dişli çıkışı PID'in setpoint'i olur.
+ *
+ * Komutlar (fpga.c):
+ *   fpga:S:motor:CH:gear:MSLOT:MCH:PAY:PAYDA:SPEED[:OFFSET]
+ *   fpga:S:motor:CH:gear:off
+ *   fpga:S:motor:CH:gearstatus
+ */
+
+#ifndef DISLI_H
+#define DISLI_H
+
+#include <stdint.h>
+
+#define DISLI_EKSEN_SAYISI      8           // Aynı anda bağlı slave
+#define DISLI_ORAN_MAX          65535       // |PAY| ve PAYDA
+#define DISLI_TUM_KANALLAR      0xFF
+
+typedef enum {
+    DISLI_BOS = 0,          // Bağ yok
+    DISLI_BEKLIYOR,         // Master'ın ilk örneği bekleniyor
+    DISLI_BAGLI,            // Hedef master'ı izliyor
+    DISLI_DOYUM             // Hedef 24-bit aralığın dışında, sınırda tutuluyor
+} Disli_Durum;
+
+typedef struct {
+    uint8_t master_slot;
+    uint8_t master_ch;
+    int32_t pay;            // İşaretli: negatif oran ters yön
+    int32_t payda;          // 1..DISLI_ORAN_MAX
+    uint8_t hiz;            // Slave REG_SPEED (PWM, 1-255)
+    uint8_t ofset_var;      // 0: slave bulunduğu yerden başlar
+    int32_t ofset;          // count (ofset_var = 1)
+} Disli_Param;
+
+typedef struct {
+    uint8_t durum;          // Disli_Durum
+    Disli_Param param;
+    int32_t hedef;          // Son slave hedefi, count
+    int32_t hiz;            // Slave hedef hızı, count/s
+    uint32_t doyum;         // Sınırda tutulan tick
+} Disli_Bilgi;
+
+/**
+ * Slave'i master'a bağla (bağlıysa yeni oranla yeniden bağlanır). Master
+ * kanalının konum yakalaması açılır, kapatılmaz
+ * @return 0: başarılı, -1: geçersiz parametre veya modül yok,
+ *         -2: dişli veya konum tablosu dolu
+ */
+int Disli_Bagla(uint8_t slot, uint8_t ch, const Disli_Param* param);
+
+/**
+ * Bağı çöz; slave son hedefinde kalır. ch = DISLI_TUM_KANALLAR: slave'i
+ * veya master'ı bu slotta olan tüm bağlar
+ */
+void Disli_Coz(uint8_t slot, uint8_t ch);
+
+/**
+ * Bağ durumu
+ * @return 0: başarılı, -1: slave bağlı değil
+ */
+int Disli_Oku(uint8_t slot, uint8_t ch, Disli_Bilgi* bilgi);
+
+/**
+ * Dişli çıkışı (Q8 count, Q8 count/tick) - PID döngüsü setpoint'i.
+ * Kesme bağlamından çağrılır.
+ * @return 0: slave bağlı, -1: değil
+ */
+int Disli_Setpoint(uint8_t slot, uint8_t ch, int32_t* pos_q8, int32_t* hiz_q8);
+
+/**
+ * Bağlı slave sayısı
+ */
+uint8_t Disli_Aktif(void);
+
+/**
+ * Bir servo periyodu - Servo_Tick'ten, Konum_Tick'ten sonra, PID_Tick'ten önce
+ */
+void Disli_Tick(void);
+
+#endif // DISLI_H
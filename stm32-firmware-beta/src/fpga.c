@@ -25,6 +25,17 @@
 #include "stm32f10x.h"
 #include "stm32f10x_usart.h"
 #include "fpga.h"
+#include "hareket.h"
+#include "pid.h"
+#include "konum.h"
+#include "disli.h"
+#include "referans.h"
+#include "kuyruk.h"
+#include "16kanaldijital.h"
+#include "darbe.h"
+#include "olay.h"
+#include "servo.h"
+#include "yukleme.h"
 #include "uart_helper.h"
 #include <string.h>
 #include <stdio.h>
@@ -67,6 +78,43 @@ void FPGA_Register(uint8_t slot) {
         UART_SendString("FPGA modül kaydedildi: Slot ");
         UART_SendHex8(slot);
         UART_SendString("\r\n");
+        
+        // Kayıttan önce gelen olay INT'i düşük bırakmış olabilir
+        if (slot == OLAY_SLOT) {
+            Olay_Yokla();
+        }
+    }
+}
+
+/**
+ * @brief Unregister FPGA module in specified slot (module removed)
+ */
+void FPGA_Unregister(uint8_t slot) {
+    for (uint8_t i = 0; i < fpga_module_count; i++) {
+        if (fpga_modules[i].slot == slot) {
+            Hareket_Kapat(slot);
+            PID_Kapat(slot, PID_TUM_KANALLAR);
+            Kuyruk_Temizle(slot, KUYRUK_TUM_KANALLAR);
+            Konum_Kapat(slot, KONUM_TUM_KANALLAR);
+            Disli_Coz(slot, DISLI_TUM_KANALLAR);
+            Referans_Iptal(slot, REFERANS_TUM_KANALLAR);
+            
+            // Kalan modülleri bir sola kaydır; servo ve olay kesmeleri
+            // FPGA_GetModule ile tabloyu okur, kaydırma yarım görülmesin
+            Servo_Kilit();
+            NVIC_DisableIRQ(EXTI0_IRQn);
+            for (uint8_t j = i; j + 1 < fpga_module_count; j++) {
+                fpga_modules[j] = fpga_modules[j + 1];
+            }
+            fpga_module_count--;
+            NVIC_EnableIRQ(EXTI0_IRQn);
+            Servo_Birak();
+            
+            UART_SendString("FPGA modül kaydı silindi: Slot ");
+            UART_SendHex8(slot);
+            UART_SendString("\r\n");
+            return;
+        }
     }
 }
 
@@ -98,6 +146,40 @@ int FPGA_ReadRegister(uint8_t slot, uint8_t address, uint8_t* value) {
     return 0;
 }
 
+/**
+ * Register görüntüsünde FPGA olay mantığı: STATUS'ta yükselen olay
+ * bitleri REG_EVENT_FLAGS'e kilitlenir, REG_EVENT_FLAGS yazımı yazılan
+ * bitleri temizler (W1C), bekleyen kanal özeti güncellenir.
+ */
+static bool FPGA_EventWrite(FPGA_Module* module, uint8_t address, uint8_t value) {
+    uint8_t base = address & 0xF0;
+    uint8_t ch = address >> 4;
+    uint8_t* pending = &module->registers[(ch < 8) ? FPGA_REG_EVENT_PENDING_LOW :
+                                                     FPGA_REG_EVENT_PENDING_HIGH];
+    
+    switch (address & 0x0F) {
+        case REG_STATUS_FLAGS:
+            module->registers[base + REG_EVENT_FLAGS] |=
+                value & (uint8_t)~module->registers[address] & FPGA_EVENT_MASK;
+            module->registers[address] = value;
+            break;
+        case REG_EVENT_FLAGS:
+            module->registers[address] &= (uint8_t)~value;
+            break;
+        case FPGA_REG_EVENT_PENDING_LOW:
+            return true;                        // Olay özeti salt okunur (diğer kanallarda ayrılmış)
+        default:
+            return false;
+    }
+    
+    if (module->registers[base + REG_EVENT_FLAGS]) {
+        *pending |= (uint8_t)(1 << (ch & 7));
+    } else {
+        *pending &= (uint8_t)~(1 << (ch & 7));
+    }
+    return true;
+}
+
 /**
  * @brief Write to FPGA register
  */
@@ -107,13 +189,45 @@ int FPGA_WriteRegister(uint8_t slot, uint8_t address, uint8_t value) {
         return -1;
     }
     
-    module->registers[address] = value;
+    if (!FPGA_EventWrite(module, address, value)) {
+        module->registers[address] = value;
+    }
     
     // TODO: Gerçek donanıma gönder (SPI üzerinden)
     
     return 0;
 }
 
+/**
+ * @brief Read consecutive FPGA registers in one transfer
+ */
+int FPGA_ReadBlock(uint8_t slot, uint8_t address, uint8_t* buffer, uint16_t length) {
+    FPGA_Module* module = FPGA_GetModule(slot);
+    if (!module || !buffer || address + length > 256) {
+        return -1;
+    }
+    
+    // TODO: Gerçek donanımda tek CS çerçevesi (adres otomatik artar)
+    memcpy(buffer, &module->registers[address], length);
+    return 0;
+}
+
+/**
+ * @brief Write consecutive FPGA registers in one transfer
+ */
+int FPGA_WriteBlock(uint8_t slot, uint8_t address, const uint8_t* buffer, uint16_t length) {
+    FPGA_Module* module = FPGA_GetModule(slot);
+    if (!module || !buffer || address + length > 256) {
+        return -1;
+    }
+    
+    memcpy(&module->registers[address], buffer, length);
+    
+    // TODO: Gerçek donanımda tek CS çerçevesi (adres otomatik artar)
+    
+    return 0;
+}
+
 /**
  * @brief Reset FPGA module
  */
@@ -123,6 +237,13 @@ int FPGA_Reset(uint8_t slot) {
         return -1;
     }
     
+    Hareket_Iptal(slot, HAREKET_TUM_KANALLAR);
+    PID_Kapat(slot, PID_TUM_KANALLAR);
+    Kuyruk_Temizle(slot, KUYRUK_TUM_KANALLAR);
+    Konum_Yenile(slot, KONUM_TUM_KANALLAR);     // Konumlar sıfırlanır
+    Disli_Coz(slot, DISLI_TUM_KANALLAR);
+    Referans_Iptal(slot, REFERANS_TUM_KANALLAR);
+    
     // Register file'ı sıfırla
     for (uint16_t i = 0; i < 256; i++) {
         module->registers[i] = 0;
@@ -130,7 +251,8 @@ int FPGA_Reset(uint8_t slot) {
     
     module->initialized = false;
     
-    // TODO: Gerçek donanıma reset sinyali gönder (CRESET pin)
+    // CRESET darbesi FPGA'yı yapılandırmasız bırakır: donanım reset'i
+    // bitstream ile birlikte fpga:2:config (yukleme.c)
     
     UART_SendString("FPGA reset edildi: Slot ");
     UART_SendHex8(slot);
@@ -163,9 +285,7 @@ int FPGA_Motor_GoToPosition(FPGA_Motor_t *motor, int32_t target_pos, uint8_t spe
     
     // 3. Position mode enable
     uint8_t ctrl = CTRL_FLAG_ENABLE;  // CONTROL_MODE = 0 (position)
-    FPGA_WriteRegister(motor->slot, base + REG_CONTROL_FLAGS, ctrl);
-    
-    return 0;
+    return FPGA_Motor_Enable(motor, ctrl);
 }
 
 /**
@@ -206,9 +326,7 @@ int FPGA_Motor_SetSpeedDirection(FPGA_Motor_t *motor, uint8_t speed, uint8_t dir
     
     // 3. Speed/Dir mode enable
     uint8_t ctrl = CTRL_FLAG_ENABLE | CTRL_FLAG_CONTROL_MODE;  // Speed/Dir mode
-    FPGA_WriteRegister(motor->slot, base + REG_CONTROL_FLAGS, ctrl);
-    
-    return 0;
+    return FPGA_Motor_Enable(motor, ctrl);
 }
 
 /**
@@ -244,6 +362,26 @@ int FPGA_Motor_EmergencyStop(FPGA_Motor_t *motor) {
     return 0;
 }
 
+/**
+ * @brief Enable motor unless an event e-stop is pending
+ */
+int FPGA_Motor_Enable(FPGA_Motor_t *motor, uint8_t ctrl) {
+    int result = -1;
+    
+    if (!motor || motor->channel > 15) {
+        return -1;
+    }
+    
+    // Kontrol ile yazım arasında olay kesmesi acil durdurma yazmasın
+    NVIC_DisableIRQ(EXTI0_IRQn);
+    if (!Olay_Durduruldu(motor->slot, motor->channel)) {
+        result = FPGA_WriteRegister(motor->slot, FPGA_MOTOR_REG_BASE(motor->channel) + REG_CONTROL_FLAGS,
+                                    ctrl);
+    }
+    NVIC_EnableIRQ(EXTI0_IRQn);
+    return result;
+}
+
 /**
  * @brief Set motor speed/direction with timer (auto-stop after duration)
  */
@@ -277,9 +415,7 @@ int FPGA_Motor_SetSpeedDirectionTimed(FPGA_Motor_t *motor, uint8_t speed,
     
     // 4. Timer mode enable
     uint8_t ctrl = CTRL_FLAG_ENABLE | CTRL_FLAG_CONTROL_MODE | CTRL_FLAG_TIMER_MODE;
-    FPGA_WriteRegister(motor->slot, base + REG_CONTROL_FLAGS, ctrl);
-    
-    return 0;
+    return FPGA_Motor_Enable(motor, ctrl);
 }
 
 /**
@@ -324,13 +460,9 @@ int FPGA_Motor_Home(FPGA_Motor_t *motor) {
         return -1;
     }
     
-    uint8_t base = FPGA_MOTOR_REG_BASE(motor->channel);
-    
     // HOME_REQUEST flag
     uint8_t ctrl = CTRL_FLAG_ENABLE | CTRL_FLAG_HOME_REQUEST;
-    FPGA_WriteRegister(motor->slot, base + REG_CONTROL_FLAGS, ctrl);
-    
-    return 0;
+    return FPGA_Motor_Enable(motor, ctrl);
 }
 
 /**
@@ -497,7 +629,7 @@ void FPGA_Motor_PrintStatus(FPGA_Motor_t *motor) {
         pos = -pos;
     }
     char buf[12];
-    sprintf(buf, "%ld", pos);
+    sprintf(buf, "%ld", (long)pos);
     UART_SendString(buf);
     UART_SendString("\r\n");
     
@@ -567,7 +699,7 @@ void FPGA_PrintStatus(uint8_t slot) {
             UART_SendString("  ");
             
             char buf[8];
-            sprintf(buf, "%6ld", pos);
+            sprintf(buf, "%6ld", (long)pos);
             UART_SendString(buf);
             UART_SendString("  ");
             
@@ -637,6 +769,180 @@ static int32_t parse_int(const char** str) {
     return negative ? -value : value;
 }
 
+/**
+ * Machine mode hata kodu: slotta modül yoksa NOMODULE, varsa HW
+ */
+static uint8_t FPGA_ErrorStatus(uint8_t slot) {
+    return FPGA_GetModule(slot) ? UART_ST_HW : UART_ST_NOMODULE;
+}
+
+/**
+ * Hex dizisini byte'lara çevir
+ * @return byte sayısı, -1: geçersiz karakter / tek hane / taşma
+ */
+static int hex_coz(const char* hex, uint8_t* out, uint16_t max) {
+    uint16_t n = 0;
+    
+    while (hex[0] != '\0') {
+        uint8_t byte = 0;
+        for (uint8_t k = 0; k < 2; k++) {
+            char c = hex[k];
+            byte <<= 4;
+            if (c >= '0' && c <= '9') {
+                byte |= c - '0';
+            } else if (c >= 'a' && c <= 'f') {
+                byte |= c - 'a' + 10;
+            } else {
+                return -1;                  // Küçük harf: komut satırı küçültülür
+            }
+        }
+        if (n >= max) {
+            return -1;
+        }
+        out[n++] = byte;
+        hex += 2;
+    }
+    return n;
+}
+
+/**
+ * Bitstream komutları (yukleme.c): bit, bit:begin/data/end, config
+ */
+static void FPGA_YuklemeKomutu(uint8_t slot, const char* cmd) {
+    Yukleme_Sonuc sonuc;
+    char buf[96];
+    
+    if (slot != YUKLEME_SLOT) {
+        UART_SendError(UART_ST_ARG, "Hata: CRESET/CDONE yalnızca slot 2'de\r\n");
+        return;
+    }
+    
+    if (strcmp(cmd, "bit") == 0) {
+        Yukleme_Bilgi bilgi;
+        Yukleme_Oku(&bilgi);
+        
+        // "<geçerli> <boyut> <crc> <cdone> <son sonuç> <süre us> <yapılandırma> <yüklenen>"
+        sprintf(buf, "%u %lu %lu %u %u %lu %lu %lu", bilgi.gecerli, (unsigned long)bilgi.boyut,
+                (unsigned long)bilgi.crc, bilgi.cdone, bilgi.son_sonuc,
+                (unsigned long)bilgi.son_sure_us, (unsigned long)bilgi.yapilandirma,
+                (unsigned long)bilgi.yuklenen);
+        UART_Reply(UART_ST_OK, buf);
+        
+        if (bilgi.gecerli) {
+            sprintf(buf, "Bitstream: %lu byte, CRC32 %08lX\r\n", (unsigned long)bilgi.boyut,
+                    (unsigned long)bilgi.crc);
+        } else {
+            sprintf(buf, "Bitstream: flash'ta gecerli imaj yok\r\n");
+        }
+        UART_SendString(buf);
+        sprintf(buf, "CDONE: %s, son yapilandirma: %s (%lu us), toplam %lu\r\n",
+                bilgi.cdone ? "HIGH" : "LOW", bilgi.son_sonuc == YUKLEME_OK ? "OK" : "HATA",
+                (unsigned long)bilgi.son_sure_us, (unsigned long)bilgi.yapilandirma);
+        UART_SendString(buf);
+        return;
+    }
+    
+    if (strncmp(cmd, "bit:begin:", 10) == 0) {
+        cmd += 10;
+        int32_t boyut = parse_int(&cmd);
+        char* son = NULL;
+        uint32_t crc;
+        
+        if (*cmd != ':') {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (bit:begin:SIZE:CRC32)\r\n");
+            return;
+        }
+        crc = strtoul(cmd + 1, &son, 0);
+        if (son == cmd + 1 || *son != '\0') {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (bit:begin:SIZE:CRC32)\r\n");
+            return;
+        }
+        if (boyut <= 0 || (uint32_t)boyut > YUKLEME_BOYUT_MAX) {
+            UART_SendError(UART_ST_ARG, "Hata: Bitstream boyutu 1-65520 olmalı\r\n");
+            return;
+        }
+        
+        if (Yukleme_Baslat((uint32_t)boyut, crc) != YUKLEME_OK) {
+            UART_SendError(UART_ST_HW, "Hata: Flash silinemedi\r\n");
+            return;
+        }
+        UART_SendString("OK: Bitstream yukleme basladi\r\n");
+        UART_Reply(UART_ST_OK, NULL);
+        return;
+    }
+    
+    if (strncmp(cmd, "bit:data:", 9) == 0) {
+        uint8_t veri[YUKLEME_PARCA_MAX];
+        cmd += 9;
+        int32_t ofset = parse_int(&cmd);
+        int n;
+        
+        if (*cmd != ':' || ofset < 0 || (n = hex_coz(cmd + 1, veri, sizeof(veri))) <= 0) {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (bit:data:OFFSET:HEX, en fazla 96 byte)\r\n");
+            return;
+        }
+        
+        sonuc = Yukleme_Parca((uint32_t)ofset, veri, (uint16_t)n);
+        if (sonuc == YUKLEME_HATA_FLASH) {
+            UART_SendError(UART_ST_HW, "Hata: Flash yazılamadı, yükleme iptal\r\n");
+            return;
+        } else if (sonuc != YUKLEME_OK) {
+            UART_SendError(UART_ST_ARG, "Hata: Yükleme yok veya parça sırası/boyutu hatalı\r\n");
+            return;
+        }
+        
+        sprintf(buf, "%lu", (unsigned long)(ofset + n));
+        UART_Reply(UART_ST_OK, buf);
+        return;
+    }
+    
+    if (strcmp(cmd, "bit:end") == 0) {
+        sonuc = Yukleme_Bitir();
+        if (sonuc == YUKLEME_HATA_IMAJ) {
+            UART_SendError(UART_ST_ARG, "Hata: CRC32 tutmuyor, imaj geçersiz\r\n");
+            return;
+        } else if (sonuc == YUKLEME_HATA_FLASH) {
+            UART_SendError(UART_ST_HW, "Hata: Başlık yazılamadı\r\n");
+            return;
+        } else if (sonuc != YUKLEME_OK) {
+            UART_SendError(UART_ST_ARG, "Hata: Yükleme yok veya eksik\r\n");
+            return;
+        }
+        
+        Yukleme_Bilgi bilgi;
+        Yukleme_Oku(&bilgi);
+        sprintf(buf, "%lu %lu", (unsigned long)bilgi.boyut, (unsigned long)bilgi.crc);
+        UART_Reply(UART_ST_OK, buf);
+        UART_SendString("OK: Bitstream flash'a yazildi\r\n");
+        return;
+    }
+    
+    if (strcmp(cmd, "config") == 0) {
+        sonuc = Yukleme_Yapilandir();
+        if (sonuc == YUKLEME_HATA_IMAJ) {
+            UART_SendError(UART_ST_ARG, "Hata: Flash'ta geçerli bitstream yok\r\n");
+            return;
+        } else if (sonuc != YUKLEME_OK) {
+            UART_SendError(UART_ST_HW, "Hata: FPGA yapılandırılamadı (CDONE LOW)\r\n");
+            return;
+        }
+        
+        // Yeni yapılandırmada FPGA register'ları sıfırdan başlar
+        FPGA_Reset(slot);
+        
+        Yukleme_Bilgi bilgi;
+        Yukleme_Oku(&bilgi);
+        sprintf(buf, "%lu", (unsigned long)bilgi.son_sure_us);
+        UART_Reply(UART_ST_OK, buf);
+        sprintf(buf, "OK: FPGA yapilandirildi (%lu byte, %lu us)\r\n",
+                (unsigned long)bilgi.boyut, (unsigned long)bilgi.son_sure_us);
+        UART_SendString(buf);
+        return;
+    }
+    
+    UART_SendError(UART_ST_SYNTAX, "Hata: Bilinmeyen bitstream komutu\r\n");
+}
+
 /**
  * @brief Handle FPGA commands from UART
  * Format: fpga:SLOT:KOMUT
@@ -655,6 +961,56 @@ static int32_t parse_int(const char** str) {
  *   fpga:2:motor:0:position           - Read position
  *   fpga:2:motor:0:status             - Read status
  *   fpga:2:motor:0:clearerror         - Clear error
+ * 
+ * Profil Commands (hareket.c):
+ *   fpga:2:motor:0:profile:20000:200000:10000000 - VMAX, AMAX, JMAX (0=trapez)
+ *   fpga:2:motor:0:move:5000          - Profilli pozisyon hareketi
+ *   fpga:2:motor:0:movestatus         - Profil durumu
+ * 
+ * PID Commands (pid.c):
+ *   fpga:2:motor:0:pid:800000:0:2000  - KP, KI, KD (micro birim)
+ *   fpga:2:motor:0:pid:on             - Döngüyü başlat (FPGA hız/yön modu)
+ *   fpga:2:motor:0:pid:off            - Döngüyü durdur
+ *   fpga:2:motor:0:pidstatus          - Döngü durumu
+ * 
+ * Capture Commands (konum.c):
+ *   fpga:2:motor:0:capture:on         - Servo tick'inde konum/hız/ivme örnekle
+ *   fpga:2:motor:0:capture:off        - Yakalamayı durdur
+ *   fpga:2:motor:0:capture            - Son örnek (tur, konum, hız, ivme, zaman)
+ *   fpga:2:snapshot                   - Slotun yakalanan eksenleri, tek zaman damgası
+ * 
+ * Gear Commands (disli.c):
+ *   fpga:2:motor:1:gear:2:0:3:2:200   - Kanal 1 = slot 2 kanal 0 konumu x 3/2, SPEED 200
+ *   fpga:2:motor:1:gear:2:0:-1:1:200:5000 - Mutlak: hedef = -master + 5000
+ *   fpga:2:motor:1:gear:off           - Bağı çöz (slave son hedefte kalır)
+ *   fpga:2:motor:1:gearstatus         - Bağ durumu
+ * 
+ * Homing Commands (referans.c):
+ *   fpga:2:motor:0:homecfg:0:3:1:2:200:40:500 - IO16 slot 0 pin 3 HIGH'ta, geri yönde
+ *                                       ara; hızlı 200, yavaş 40, 500 count bırak
+ *   fpga:2:motor:0:homecfg            - Ayar
+ *   fpga:2:motor:0:homing             - Aramayı başlat (bitişte homed/homefail olayı)
+ *   fpga:2:motor:0:homestatus         - Arama durumu
+ * 
+ * Queue Commands (kuyruk.c):
+ *   fpga:2:motor:0:qadd:5000:128:200  - Hedef, hız (0=profilli), bekleme ms
+ *   fpga:2:motor:0:qadd:8000:128:0:300 - 300 count kala sonrakine harmanla
+ *   fpga:2:motor:0:qadd:0:128:0:0:0:3:1:50 - Varışta IO16 slot 0 pin 3, 50 ms darbe
+ *   fpga:2:motor:0:qstatus            - Kuyruk durumu
+ *   fpga:2:motor:0:qclear             - Kuyruğu boşalt
+ * 
+ * Event Commands (olay.c, FPGA INT slot 2):
+ *   fpga:2:motor:0:link:0x0006        - Kanal 0 olayında 1 ve 2'yi de durdur
+ *   fpga:2:motor:0:link               - Bağlı kanal maskesi
+ *   fpga:2:events                     - Olay sayaçları ve tepki süresi
+ *   fpga:2:events:reset               - Sayaçları sıfırla
+ * 
+ * Bitstream Commands (yukleme.c, CRESET/CDONE slot 2):
+ *   fpga:2:bit:begin:32220:0x1A2B3C4D - Yüklemeyi başlat (boyut, CRC32)
+ *   fpga:2:bit:data:0:7eaa997e...     - Sıradaki parça (hex, en fazla 96 byte)
+ *   fpga:2:bit:end                    - CRC doğrula, imajı geçerli yap
+ *   fpga:2:bit                        - İmaj / CDONE / son yapılandırma
+ *   fpga:2:config                     - FPGA'yı flash imajından yapılandır
  */
 void FPGA_HandleCommand(const char* cmd) {
     // ACK gönder (komut alındı onayı)
@@ -664,13 +1020,13 @@ void FPGA_HandleCommand(const char* cmd) {
     
     // Slot'u parse et
     if (cmd[0] < '0' || cmd[0] > '3') {
-        UART_SendString("Hata: Geçersiz slot (0-3)\r\n");
+        UART_SendError(UART_ST_ARG, "Hata: Geçersiz slot (0-3)\r\n");
         return;
     }
     uint8_t slot = cmd[0] - '0';
     
     if (cmd[1] != ':') {
-        UART_SendString("Hata: Format hatası\r\n");
+        UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası\r\n");
         return;
     }
     cmd += 2;
@@ -708,8 +1064,11 @@ void FPGA_HandleCommand(const char* cmd) {
             UART_SendString(" = 0x");
             UART_SendHex8(value);
             UART_SendString("\r\n");
+            char buf[4];
+            sprintf(buf, "%02X", value);
+            UART_Reply(UART_ST_OK, buf);
         } else {
-            UART_SendString("Hata: Register okunamadı\r\n");
+            UART_SendError(FPGA_ErrorStatus(slot), "Hata: Register okunamadı\r\n");
         }
     }
     else if (strncmp(cmd, "writereg:", 9) == 0) {
@@ -738,7 +1097,7 @@ void FPGA_HandleCommand(const char* cmd) {
         }
         
         if (*cmd != ':') {
-            UART_SendString("Hata: Format hatası\r\n");
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası\r\n");
             return;
         }
         cmd++;
@@ -771,19 +1130,83 @@ void FPGA_HandleCommand(const char* cmd) {
             UART_SendHex8(value);
             UART_SendString("\r\n");
         } else {
-            UART_SendString("Hata: Register yazılamadı\r\n");
+            UART_SendError(FPGA_ErrorStatus(slot), "Hata: Register yazılamadı\r\n");
         }
     }
     else if (strcmp(cmd, "reset") == 0) {
         if (FPGA_Reset(slot) == 0) {
             UART_SendString("OK: FPGA reset edildi\r\n");
         } else {
-            UART_SendString("Hata: Reset başarısız\r\n");
+            UART_SendError(FPGA_ErrorStatus(slot), "Hata: Reset başarısız\r\n");
         }
     }
     else if (strcmp(cmd, "status") == 0) {
+        if (!FPGA_GetModule(slot)) {
+            UART_Reply(UART_ST_NOMODULE, NULL);
+        }
         FPGA_PrintStatus(slot);
     }
+    else if (strcmp(cmd, "bit") == 0 || strncmp(cmd, "bit:", 4) == 0 ||
+             strcmp(cmd, "config") == 0) {
+        FPGA_YuklemeKomutu(slot, cmd);
+    }
+    else if (strcmp(cmd, "snapshot") == 0) {
+        uint8_t kanallar[KONUM_KANAL_SAYISI];
+        Konum_Durum durum[KONUM_KANAL_SAYISI];
+        uint8_t n = Konum_Anlik(slot, kanallar, durum, KONUM_KANAL_SAYISI);
+        uint8_t gecerli = 0;
+        static char buf[32 + KONUM_KANAL_SAYISI * 56];
+        char* p;
+        
+        for (uint8_t i = 0; i < n; i++) {
+            gecerli += durum[i].gecerli;
+        }
+        
+        // "<zaman us> <örnek> <n> [<kanal> <tur> <konum> <hız> <ivme>]..." (geçerli eksenler)
+        p = buf + sprintf(buf, "%lu %lu %u", (unsigned long)(n ? durum[0].zaman_us : 0),
+                          (unsigned long)(n ? durum[0].ornek : 0), gecerli);
+        for (uint8_t i = 0; i < n; i++) {
+            if (durum[i].gecerli) {
+                p += sprintf(p, " %u %ld %ld %ld %ld", kanallar[i], (long)durum[i].tur,
+                             (long)durum[i].ham, (long)durum[i].hiz, (long)durum[i].ivme);
+            }
+        }
+        UART_Reply(UART_ST_OK, buf);
+        
+        UART_SendString("Konum anlik goruntu: ");
+        UART_SendString(buf);
+        UART_SendString("\r\n");
+    }
+    else if (strcmp(cmd, "events") == 0 || strcmp(cmd, "events:reset") == 0) {
+        Olay_Sayac sayac;
+        
+        if (slot != OLAY_SLOT) {
+            UART_SendError(UART_ST_ARG, "Hata: FPGA INT yalnızca slot 2'de\r\n");
+            return;
+        }
+        Olay_Oku(&sayac);
+        if (cmd[6] == ':') {
+            Olay_Sifirla();
+        }
+        
+        // "<kesme> <varış> <arıza> <zaman aşımı> <sıcaklık> <durdurma> <tepki son> <tepki max>"
+        char buf[128];
+        sprintf(buf, "%lu %lu %lu %lu %lu %lu %lu %lu", (unsigned long)sayac.kesme,
+                (unsigned long)sayac.varis, (unsigned long)sayac.ariza,
+                (unsigned long)sayac.zaman_asimi, (unsigned long)sayac.sicaklik,
+                (unsigned long)sayac.durdurma, (unsigned long)sayac.tepki_son,
+                (unsigned long)sayac.tepki_max);
+        UART_Reply(UART_ST_OK, buf);
+        
+        sprintf(buf, "FPGA INT: %lu kesme, %lu varis, %lu ariza, %lu zaman asimi, %lu sicaklik\r\n",
+                (unsigned long)sayac.kesme, (unsigned long)sayac.varis, (unsigned long)sayac.ariza,
+                (unsigned long)sayac.zaman_asimi, (unsigned long)sayac.sicaklik);
+        UART_SendString(buf);
+        sprintf(buf, "Durdurulan kanal: %lu, tepki: son %lu us, max %lu us\r\n",
+                (unsigned long)sayac.durdurma, (unsigned long)(sayac.tepki_son / 72),
+                (unsigned long)(sayac.tepki_max / 72));
+        UART_SendString(buf);
+    }
     else if (strncmp(cmd, "motor:", 6) == 0) {
         // Motor komutları: motor:CH:COMMAND:PARAMS
         cmd += 6;
@@ -793,18 +1216,41 @@ void FPGA_HandleCommand(const char* cmd) {
         int32_t channel = parse_int(&cmd);
         
         if (channel < 0 || channel > 15) {
-            UART_SendString("Hata: Geçersiz motor channel (0-15)\r\n");
+            UART_SendError(UART_ST_ARG, "Hata: Geçersiz motor channel (0-15)\r\n");
             return;
         }
         
         if (*cmd != ':') {
-            UART_SendString("Hata: Format hatası\r\n");
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası\r\n");
             return;
         }
         cmd++;
         
         FPGA_Motor_t motor = { slot, (uint8_t)channel };
         
+        // Doğrudan hareket komutları çalışan profili, PID döngüsünü ve kuyruğu durdurur
+        if (strncmp(cmd, "goto:", 5) == 0 || strncmp(cmd, "speed:", 6) == 0 ||
+            strncmp(cmd, "speedtimed:", 11) == 0 || strcmp(cmd, "stop") == 0 ||
+            strcmp(cmd, "home") == 0 || strcmp(cmd, "homing") == 0) {
+            Hareket_Iptal(slot, motor.channel);
+            PID_Kapat(slot, motor.channel);
+            Kuyruk_Temizle(slot, motor.channel);
+            Disli_Coz(slot, motor.channel);
+        } else if (strncmp(cmd, "move:", 5) == 0 || strcmp(cmd, "pid:on") == 0) {
+            Kuyruk_Temizle(slot, motor.channel);    // Host eksenin kontrolünü alır
+        }
+        if (strncmp(cmd, "move:", 5) == 0 || strncmp(cmd, "qadd:", 5) == 0 ||
+            strcmp(cmd, "pid:off") == 0) {
+            Disli_Coz(slot, motor.channel);         // Hedefi başka kaynak yazacak / motor durur
+        }
+        if (strncmp(cmd, "goto:", 5) == 0 || strncmp(cmd, "speed:", 6) == 0 ||
+            strncmp(cmd, "speedtimed:", 11) == 0 || strcmp(cmd, "stop") == 0 ||
+            strcmp(cmd, "home") == 0 || strcmp(cmd, "homing") == 0 ||
+            strncmp(cmd, "move:", 5) == 0 || strcmp(cmd, "pid:on") == 0 ||
+            strncmp(cmd, "qadd:", 5) == 0 || strncmp(cmd, "gear:", 5) == 0) {
+            Referans_Iptal(slot, motor.channel);    // Süren referans araması homefail ile biter
+        }
+        
         // Motor komutları
         if (strncmp(cmd, "goto:", 5) == 0) {
             // goto:POSITION:SPEED
@@ -813,7 +1259,7 @@ void FPGA_HandleCommand(const char* cmd) {
             int32_t target_pos = parse_int(&cmd);
             
             if (*cmd != ':') {
-                UART_SendString("Hata: Format hatası (goto:POS:SPEED)\r\n");
+                UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (goto:POS:SPEED)\r\n");
                 return;
             }
             cmd++;
@@ -821,7 +1267,7 @@ void FPGA_HandleCommand(const char* cmd) {
             int32_t speed = parse_int(&cmd);
             
             if (speed < 0 || speed > 255) {
-                UART_SendString("Hata: Geçersiz hız (0-255)\r\n");
+                UART_SendError(UART_ST_ARG, "Hata: Geçersiz hız (0-255)\r\n");
                 return;
             }
             
@@ -830,13 +1276,13 @@ void FPGA_HandleCommand(const char* cmd) {
                 UART_SendHex8(motor.channel);
                 UART_SendString(": GoTo pozisyon ");
                 char buf[12];
-                sprintf(buf, "%ld", target_pos);
+                sprintf(buf, "%ld", (long)target_pos);
                 UART_SendString(buf);
                 UART_SendString(" @ hiz ");
                 UART_SendHex8((uint8_t)speed);
                 UART_SendString("\r\n");
             } else {
-                UART_SendString("Hata: Pozisyon komutu gönderilemedi\r\n");
+                UART_SendError(FPGA_ErrorStatus(slot), "Hata: Pozisyon komutu gönderilemedi\r\n");
             }
         }
         else if (strncmp(cmd, "speed:", 6) == 0) {
@@ -846,7 +1292,7 @@ void FPGA_HandleCommand(const char* cmd) {
             int32_t speed = parse_int(&cmd);
             
             if (*cmd != ':') {
-                UART_SendString("Hata: Format hatası (speed:SPEED:DIR)\r\n");
+                UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (speed:SPEED:DIR)\r\n");
                 return;
             }
             cmd++;
@@ -854,12 +1300,12 @@ void FPGA_HandleCommand(const char* cmd) {
             int32_t direction = parse_int(&cmd);
             
             if (speed < 0 || speed > 255) {
-                UART_SendString("Hata: Geçersiz hız (0-255)\r\n");
+                UART_SendError(UART_ST_ARG, "Hata: Geçersiz hız (0-255)\r\n");
                 return;
             }
             
             if (direction < 0 || direction > 2) {
-                UART_SendString("Hata: Geçersiz yön (0=stop, 1=ileri, 2=geri)\r\n");
+                UART_SendError(UART_ST_ARG, "Hata: Geçersiz yön (0=stop, 1=ileri, 2=geri)\r\n");
                 return;
             }
             
@@ -872,7 +1318,7 @@ void FPGA_HandleCommand(const char* cmd) {
                 UART_SendString(FPGA_Motor_DirectionToString((uint8_t)direction));
                 UART_SendString("\r\n");
             } else {
-                UART_SendString("Hata: Hız komutu gönderilemedi\r\n");
+                UART_SendError(FPGA_ErrorStatus(slot), "Hata: Hız komutu gönderilemedi\r\n");
             }
         }
         else if (strcmp(cmd, "stop") == 0) {
@@ -881,16 +1327,17 @@ void FPGA_HandleCommand(const char* cmd) {
                 UART_SendHex8(motor.channel);
                 UART_SendString(": Durduruldu\r\n");
             } else {
-                UART_SendString("Hata: Dur komutu gönderilemedi\r\n");
+                UART_SendError(FPGA_ErrorStatus(slot), "Hata: Dur komutu gönderilemedi\r\n");
             }
         }
         else if (strcmp(cmd, "home") == 0) {
             if (FPGA_Motor_Home(&motor) == 0) {
+                Konum_Yenile(slot, motor.channel);
                 UART_SendString("Motor ");
                 UART_SendHex8(motor.channel);
                 UART_SendString(": Homing (pozisyon=0)\r\n");
             } else {
-                UART_SendString("Hata: Home komutu gönderilemedi\r\n");
+                UART_SendError(FPGA_ErrorStatus(slot), "Hata: Home komutu gönderilemedi\r\n");
             }
         }
         else if (strcmp(cmd, "position") == 0) {
@@ -899,11 +1346,25 @@ void FPGA_HandleCommand(const char* cmd) {
             UART_SendHex8(motor.channel);
             UART_SendString(" pozisyon: ");
             char buf[12];
-            sprintf(buf, "%ld", pos);
+            sprintf(buf, "%ld", (long)pos);
             UART_SendString(buf);
             UART_SendString("\r\n");
+            if (FPGA_GetModule(slot)) {
+                UART_Reply(UART_ST_OK, buf);
+            } else {
+                UART_Reply(UART_ST_NOMODULE, NULL);
+            }
         }
         else if (strcmp(cmd, "status") == 0) {
+            if (FPGA_GetModule(slot)) {
+                // Kısa durum: "<status> <error> <pozisyon>"
+                char buf[24];
+                sprintf(buf, "%02X %02X %ld", FPGA_Motor_GetStatus(&motor),
+                        FPGA_Motor_GetError(&motor), (long)FPGA_Motor_GetPosition(&motor));
+                UART_Reply(UART_ST_OK, buf);
+            } else {
+                UART_Reply(UART_ST_NOMODULE, NULL);
+            }
             FPGA_Motor_PrintStatus(&motor);
         }
         else if (strcmp(cmd, "clearerror") == 0) {
@@ -912,7 +1373,7 @@ void FPGA_HandleCommand(const char* cmd) {
                 UART_SendHex8(motor.channel);
                 UART_SendString(": Hata temizlendi\r\n");
             } else {
-                UART_SendString("Hata: Clear error komutu gönderilemedi\r\n");
+                UART_SendError(FPGA_ErrorStatus(slot), "Hata: Clear error komutu gönderilemedi\r\n");
             }
         }
         else if (strncmp(cmd, "speedtimed:", 11) == 0) {
@@ -922,7 +1383,7 @@ void FPGA_HandleCommand(const char* cmd) {
             int32_t speed = parse_int(&cmd);
             
             if (*cmd != ':') {
-                UART_SendString("Hata: Format hatası (speedtimed:SPEED:DIR:MS)\r\n");
+                UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (speedtimed:SPEED:DIR:MS)\r\n");
                 return;
             }
             cmd++;
@@ -930,7 +1391,7 @@ void FPGA_HandleCommand(const char* cmd) {
             int32_t direction = parse_int(&cmd);
             
             if (*cmd != ':') {
-                UART_SendString("Hata: Format hatası (speedtimed:SPEED:DIR:MS)\r\n");
+                UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (speedtimed:SPEED:DIR:MS)\r\n");
                 return;
             }
             cmd++;
@@ -938,17 +1399,17 @@ void FPGA_HandleCommand(const char* cmd) {
             int32_t duration_ms = parse_int(&cmd);
             
             if (speed < 0 || speed > 255) {
-                UART_SendString("Hata: Geçersiz hız (0-255)\r\n");
+                UART_SendError(UART_ST_ARG, "Hata: Geçersiz hız (0-255)\r\n");
                 return;
             }
             
             if (direction < 0 || direction > 2) {
-                UART_SendString("Hata: Geçersiz yön (0=stop, 1=ileri, 2=geri)\r\n");
+                UART_SendError(UART_ST_ARG, "Hata: Geçersiz yön (0=stop, 1=ileri, 2=geri)\r\n");
                 return;
             }
             
             if (duration_ms < 0 || duration_ms > 6553500) {
-                UART_SendString("Hata: Geçersiz süre (0-6553500ms)\r\n");
+                UART_SendError(UART_ST_ARG, "Hata: Geçersiz süre (0-6553500ms)\r\n");
                 return;
             }
             
@@ -961,11 +1422,11 @@ void FPGA_HandleCommand(const char* cmd) {
                 UART_SendString(FPGA_Motor_DirectionToString((uint8_t)direction));
                 UART_SendString(", Süre=");
                 char buf[12];
-                sprintf(buf, "%ld", duration_ms);
+                sprintf(buf, "%ld", (long)duration_ms);
                 UART_SendString(buf);
                 UART_SendString("ms\r\n");
             } else {
-                UART_SendString("Hata: Zamanlı kontrol komutu gönderilemedi\r\n");
+                UART_SendError(FPGA_ErrorStatus(slot), "Hata: Zamanlı kontrol komutu gönderilemedi\r\n");
             }
         }
         else if (strcmp(cmd, "timerinfo") == 0) {
@@ -982,12 +1443,597 @@ void FPGA_HandleCommand(const char* cmd) {
                 sprintf(buf, "%u", remaining);
                 UART_SendString(buf);
                 UART_SendString("ms\r\n");
+                UART_Reply(UART_ST_OK, buf);
             } else {
                 UART_SendString("DURDU\r\n");
+                UART_Reply(UART_ST_OK, "0");
+            }
+        }
+        else if (strcmp(cmd, "profile") == 0 || strncmp(cmd, "profile:", 8) == 0) {
+            // profile[:VMAX:AMAX[:JMAX[:PWM[:PWMMIN]]]]
+            Hareket_Param param;
+            Hareket_Parametre(slot, motor.channel, &param);
+            
+            if (cmd[7] == ':') {
+                int32_t values[5] = { 0, 0, 0, param.pwm_max, param.pwm_min };
+                uint8_t n = 0;
+                
+                cmd += 8;
+                while (n < 5) {
+                    values[n++] = parse_int(&cmd);
+                    if (*cmd != ':') {
+                        break;
+                    }
+                    cmd++;
+                }
+                
+                if (*cmd != '\0' || n < 2) {
+                    UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (profile:VMAX:AMAX[:JMAX[:PWM[:PWMMIN]]])\r\n");
+                    return;
+                }
+                if (values[0] <= 0 || values[1] <= 0 || values[2] < 0 ||
+                    values[3] < 1 || values[3] > 255 || values[4] < 0 || values[4] > 255) {
+                    UART_SendError(UART_ST_ARG, "Hata: Geçersiz profil parametresi\r\n");
+                    return;
+                }
+                
+                param.vmax = (uint32_t)values[0];
+                param.amax = (uint32_t)values[1];
+                param.jmax = (uint32_t)values[2];
+                param.pwm_max = (uint8_t)values[3];
+                param.pwm_min = (uint8_t)values[4];
+                
+                int result = Hareket_Ayarla(slot, motor.channel, &param);
+                if (result == -2) {
+                    UART_SendError(UART_ST_OVERFLOW, "Hata: Profil eksen tablosu dolu\r\n");
+                    return;
+                } else if (result != 0) {
+                    UART_SendError(UART_ST_ARG, "Hata: Geçersiz profil parametresi "
+                                   "(VMAX 1-1000000, AMAX 16-100000000, PWMMIN <= PWM)\r\n");
+                    return;
+                }
+            } else if (cmd[7] != '\0') {
+                UART_SendError(UART_ST_SYNTAX, "Hata: Bilinmeyen motor komutu\r\n");
+                return;
+            }
+            
+            // "<vmax> <amax> <jmax> <pwm> <pwmmin>"
+            char buf[64];
+            sprintf(buf, "%lu %lu %lu %u %u", (unsigned long)param.vmax,
+                    (unsigned long)param.amax, (unsigned long)param.jmax,
+                    param.pwm_max, param.pwm_min);
+            UART_Reply(UART_ST_OK, buf);
+            
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(" profil: vmax/amax/jmax/pwm/pwmmin = ");
+            UART_SendString(buf);
+            UART_SendString(param.jmax ? " (S-egrisi)\r\n" : " (trapez)\r\n");
+        }
+        else if (strncmp(cmd, "move:", 5) == 0) {
+            // move:POSITION
+            cmd += 5;
+            
+            int32_t target_pos = parse_int(&cmd);
+            
+            if (*cmd != '\0') {
+                UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (move:POS)\r\n");
+                return;
+            }
+            
+            int result = Hareket_Git(slot, motor.channel, target_pos);
+            if (result == 0) {
+                UART_SendString("Motor ");
+                UART_SendHex8(motor.channel);
+                UART_SendString(": Profilli hareket -> ");
+                char buf[12];
+                sprintf(buf, "%ld", (long)target_pos);
+                UART_SendString(buf);
+                UART_SendString("\r\n");
+            } else if (result == -2) {
+                UART_SendError(UART_ST_OVERFLOW, "Hata: Profil eksen tablosu dolu\r\n");
+            } else if (!FPGA_GetModule(slot)) {
+                UART_SendError(UART_ST_NOMODULE, "Hata: Modül yok\r\n");
+            } else if (Olay_Durduruldu(slot, motor.channel)) {
+                UART_SendError(UART_ST_HW, "Hata: Eksen acil durduruldu\r\n");
+            } else {
+                UART_SendError(UART_ST_ARG, "Hata: Geçersiz hedef (24-bit)\r\n");
+            }
+        }
+        else if (strcmp(cmd, "movestatus") == 0) {
+            Hareket_Bilgi bilgi;
+            
+            if (Hareket_Oku(slot, motor.channel, &bilgi) != 0) {
+                memset(&bilgi, 0, sizeof(bilgi));
+            }
+            
+            // "<durum> <hedef> <setpoint> <hız count/s> <pwm>"
+            char buf[80];
+            sprintf(buf, "%u %ld %ld %ld %u", bilgi.durum, (long)bilgi.hedef,
+                    (long)bilgi.setpoint, (long)bilgi.hiz, bilgi.pwm);
+            UART_Reply(UART_ST_OK, buf);
+            
+            static const char* const durumlar[] = { "BOS", "SURUYOR", "BITTI" };
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(" profil: ");
+            UART_SendString(durumlar[bilgi.durum]);
+            sprintf(buf, ", hedef=%ld setpoint=%ld hiz=%ld pwm=%u\r\n", (long)bilgi.hedef,
+                    (long)bilgi.setpoint, (long)bilgi.hiz, bilgi.pwm);
+            UART_SendString(buf);
+        }
+        else if (strcmp(cmd, "pid:on") == 0) {
+            int result = PID_Ac(slot, motor.channel);
+            if (result == 0) {
+                UART_SendString("Motor ");
+                UART_SendHex8(motor.channel);
+                UART_SendString(": PID dongusu acik\r\n");
+                UART_Reply(UART_ST_OK, NULL);
+            } else if (result == -2) {
+                UART_SendError(UART_ST_OVERFLOW, "Hata: PID kanal tablosu dolu\r\n");
+            } else if (Olay_Durduruldu(slot, motor.channel)) {
+                UART_SendError(UART_ST_HW, "Hata: Eksen acil durduruldu\r\n");
+            } else {
+                UART_SendError(UART_ST_NOMODULE, "Hata: Modül yok\r\n");
+            }
+        }
+        else if (strcmp(cmd, "pid:off") == 0) {
+            PID_Kapat(slot, motor.channel);
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(": PID dongusu kapali\r\n");
+            UART_Reply(UART_ST_OK, NULL);
+        }
+        else if (strcmp(cmd, "pid") == 0 || strncmp(cmd, "pid:", 4) == 0) {
+            // pid[:KP:KI:KD[:KVFF[:KAFF[:OUTMAX]]]]
+            PID_Kazanc kazanc;
+            PID_Kazanclar(slot, motor.channel, &kazanc);
+            
+            if (cmd[3] == ':') {
+                int32_t values[6] = { 0, 0, 0, kazanc.kvff, kazanc.kaff, kazanc.out_max };
+                uint8_t n = 0;
+                
+                cmd += 4;
+                while (n < 6) {
+                    values[n++] = parse_int(&cmd);
+                    if (*cmd != ':') {
+                        break;
+                    }
+                    cmd++;
+                }
+                
+                if (*cmd != '\0' || n < 3) {
+                    UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (pid:KP:KI:KD[:KVFF[:KAFF[:OUTMAX]]])\r\n");
+                    return;
+                }
+                if (values[5] < 1 || values[5] > 255) {
+                    UART_SendError(UART_ST_ARG, "Hata: OUTMAX 1-255 olmalı\r\n");
+                    return;
+                }
+                
+                kazanc.kp = values[0];
+                kazanc.ki = values[1];
+                kazanc.kd = values[2];
+                kazanc.kvff = values[3];
+                kazanc.kaff = values[4];
+                kazanc.out_max = (uint8_t)values[5];
+                
+                int result = PID_Ayarla(slot, motor.channel, &kazanc);
+                if (result == -2) {
+                    UART_SendError(UART_ST_OVERFLOW, "Hata: PID kanal tablosu dolu\r\n");
+                    return;
+                } else if (result != 0) {
+                    UART_SendError(UART_ST_ARG, "Hata: Geçersiz kazanç (0-1000000000 micro)\r\n");
+                    return;
+                }
+            }
+            
+            // "<kp> <ki> <kd> <kvff> <kaff> <outmax>"
+            char buf[80];
+            sprintf(buf, "%ld %ld %ld %ld %ld %u", (long)kazanc.kp, (long)kazanc.ki,
+                    (long)kazanc.kd, (long)kazanc.kvff, (long)kazanc.kaff, kazanc.out_max);
+            UART_Reply(UART_ST_OK, buf);
+            
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(" PID (micro): kp/ki/kd/kvff/kaff/outmax = ");
+            UART_SendString(buf);
+            UART_SendString("\r\n");
+        }
+        else if (strcmp(cmd, "pidstatus") == 0) {
+            PID_Durum durum;
+            
+            if (PID_Oku(slot, motor.channel, &durum) != 0) {
+                memset(&durum, 0, sizeof(durum));
+            }
+            
+            // "<etkin> <setpoint> <konum> <hata> <çıkış> <integral> <max hata>"
+            char buf[128];
+            sprintf(buf, "%u %ld %ld %ld %d %d %ld", durum.etkin, (long)durum.setpoint,
+                    (long)durum.konum, (long)durum.hata, durum.cikis, durum.integral,
+                    (long)durum.max_hata);
+            UART_Reply(UART_ST_OK, buf);
+            
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(durum.etkin ? " PID: ACIK" : " PID: KAPALI");
+            sprintf(buf, ", setpoint=%ld konum=%ld hata=%ld cikis=%d I=%d max_hata=%ld\r\n",
+                    (long)durum.setpoint, (long)durum.konum, (long)durum.hata, durum.cikis,
+                    durum.integral, (long)durum.max_hata);
+            UART_SendString(buf);
+        }
+        else if (strncmp(cmd, "qadd:", 5) == 0) {
+            // qadd:POS:SPEED[:DWELL[:BLEND[:IOSLOT:IOPIN:LEVEL[:MS]]]]
+            int32_t values[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+            uint8_t n = 0;
+            
+            cmd += 5;
+            while (n < 8) {
+                values[n++] = parse_int(&cmd);
+                if (*cmd != ':') {
+                    break;
+                }
+                cmd++;
+            }
+            
+            if (*cmd != '\0' || n < 2 || n == 5 || n == 6) {
+                UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası "
+                               "(qadd:POS:SPEED[:DWELL[:BLEND[:IOSLOT:IOPIN:LEVEL[:MS]]]])\r\n");
+                return;
+            }
+            if (values[1] < 0 || values[1] > 255 || values[2] < 0 || values[2] > DARBE_SURE_MAX ||
+                values[3] < 0 || values[3] > 65535 || values[7] < 0 || values[7] > DARBE_SURE_MAX ||
+                (n >= 7 && (values[4] < 0 || values[4] > 3 || values[5] < 0 || values[5] > 15))) {
+                UART_SendError(UART_ST_ARG, "Hata: Geçersiz segment parametresi\r\n");
+                return;
+            }
+            
+            Kuyruk_Segment seg;
+            seg.hedef = values[0];
+            seg.hiz = (uint8_t)values[1];
+            seg.bekleme = (uint16_t)values[2];
+            seg.yaklasma = (uint16_t)values[3];
+            seg.io_slot = (n >= 7) ? (uint8_t)values[4] : KUYRUK_TETIK_YOK;
+            seg.io_pin = (uint8_t)values[5];
+            seg.io_level = values[6] ? 1 : 0;
+            seg.io_ms = (uint16_t)values[7];
+            
+            // Tetik pini şimdiden çıkış yapılır (varışta SPI yön yazımı olmasın)
+            if (n >= 7 && IO16_EnsureOutput(seg.io_slot, seg.io_pin) != 0) {
+                UART_SendError(UART_ST_NOMODULE, "Hata: Tetik IO16 modülü yok\r\n");
+                return;
+            }
+            
+            int result = Kuyruk_Ekle(slot, motor.channel, &seg);
+            if (result == -2) {
+                UART_SendError(UART_ST_OVERFLOW, "Hata: Kuyruk dolu\r\n");
+                return;
+            } else if (result != 0) {
+                if (!FPGA_GetModule(slot)) {
+                    UART_SendError(UART_ST_NOMODULE, "Hata: Modül yok\r\n");
+                } else {
+                    UART_SendError(UART_ST_ARG, "Hata: Geçersiz hedef (24-bit)\r\n");
+                }
+                return;
+            }
+            
+            Kuyruk_Bilgi bilgi;
+            Kuyruk_Oku(slot, motor.channel, &bilgi);
+            
+            char buf[12];
+            sprintf(buf, "%u", bilgi.derinlik);
+            UART_Reply(UART_ST_OK, buf);
+            
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(": Kuyruga eklendi, derinlik ");
+            UART_SendString(buf);
+            UART_SendString("\r\n");
+        }
+        else if (strcmp(cmd, "qstatus") == 0) {
+            Kuyruk_Bilgi bilgi;
+            Kuyruk_Oku(slot, motor.channel, &bilgi);
+            
+            // "<durum> <derinlik> <boş yer> <tamamlanan> <aktif hedef>"
+            char buf[80];
+            sprintf(buf, "%u %u %u %lu %ld", bilgi.durum, bilgi.derinlik,
+                    KUYRUK_DERINLIK - bilgi.derinlik, (unsigned long)bilgi.tamamlanan,
+                    (long)bilgi.hedef);
+            UART_Reply(UART_ST_OK, buf);
+            
+            static const char* const durumlar[] = { "BOS", "HAREKET", "BEKLEME", "HATA" };
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(" kuyruk: ");
+            UART_SendString(durumlar[bilgi.durum]);
+            sprintf(buf, ", %u/%u segment, %lu tamamlandi, hedef=%ld\r\n", bilgi.derinlik,
+                    KUYRUK_DERINLIK, (unsigned long)bilgi.tamamlanan, (long)bilgi.hedef);
+            UART_SendString(buf);
+        }
+        else if (strcmp(cmd, "qclear") == 0) {
+            Kuyruk_Temizle(slot, motor.channel);
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(": Kuyruk bosaltildi\r\n");
+            UART_Reply(UART_ST_OK, NULL);
+        }
+        else if (strcmp(cmd, "capture:on") == 0) {
+            int result = Konum_Ac(slot, motor.channel, 1);
+            if (result == 0) {
+                UART_SendString("Motor ");
+                UART_SendHex8(motor.channel);
+                UART_SendString(": Konum yakalama acik\r\n");
+                UART_Reply(UART_ST_OK, NULL);
+            } else if (result == -2) {
+                UART_SendError(UART_ST_OVERFLOW, "Hata: Konum kanal tablosu dolu\r\n");
+            } else {
+                UART_SendError(UART_ST_NOMODULE, "Hata: Modül yok\r\n");
+            }
+        }
+        else if (strcmp(cmd, "capture:off") == 0) {
+            Konum_Kapat(slot, motor.channel);
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(": Konum yakalama kapali\r\n");
+            UART_Reply(UART_ST_OK, NULL);
+        }
+        else if (strcmp(cmd, "capture") == 0) {
+            Konum_Durum durum;
+            
+            if (Konum_Oku(slot, motor.channel, &durum) != 0) {
+                memset(&durum, 0, sizeof(durum));
+            }
+            
+            // "<geçerli> <tur> <konum> <hız count/s> <ivme count/s²> <zaman us> <örnek>"
+            char buf[96];
+            sprintf(buf, "%u %ld %ld %ld %ld %lu %lu", durum.gecerli, (long)durum.tur,
+                    (long)durum.ham, (long)durum.hiz, (long)durum.ivme,
+                    (unsigned long)durum.zaman_us, (unsigned long)durum.ornek);
+            UART_Reply(UART_ST_OK, buf);
+            
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(durum.gecerli ? " konum: " : " konum: GECERSIZ ");
+            sprintf(buf, "tur=%ld konum=%ld hiz=%ld ivme=%ld t=%lu us\r\n", (long)durum.tur,
+                    (long)durum.ham, (long)durum.hiz, (long)durum.ivme,
+                    (unsigned long)durum.zaman_us);
+            UART_SendString(buf);
+        }
+        else if (strcmp(cmd, "gear:off") == 0) {
+            Disli_Coz(slot, motor.channel);
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(": Disli bagi cozuldu\r\n");
+            UART_Reply(UART_ST_OK, NULL);
+        }
+        else if (strncmp(cmd, "gear:", 5) == 0) {
+            // gear:MSLOT:MCH:NUM:DEN:SPEED[:OFFSET]
+            int32_t values[6] = { 0, 0, 0, 0, 0, 0 };
+            uint8_t n = 0;
+            
+            cmd += 5;
+            while (n < 6) {
+                values[n++] = parse_int(&cmd);
+                if (*cmd != ':') {
+                    break;
+                }
+                cmd++;
+            }
+            
+            if (*cmd != '\0' || n < 5) {
+                UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası "
+                               "(gear:MSLOT:MCH:NUM:DEN:SPEED[:OFFSET])\r\n");
+                return;
+            }
+            if (values[0] < 0 || values[0] > 3 || values[1] < 0 || values[1] > 15 ||
+                values[4] < 1 || values[4] > 255) {
+                UART_SendError(UART_ST_ARG, "Hata: Geçersiz dişli parametresi\r\n");
+                return;
+            }
+            
+            Disli_Param param;
+            param.master_slot = (uint8_t)values[0];
+            param.master_ch = (uint8_t)values[1];
+            param.pay = values[2];
+            param.payda = values[3];
+            param.hiz = (uint8_t)values[4];
+            param.ofset_var = (n == 6);
+            param.ofset = values[5];
+            
+            // Slave hedefini artık dişli yazar
+            Hareket_Iptal(slot, motor.channel);
+            Kuyruk_Temizle(slot, motor.channel);
+            
+            int result = Disli_Bagla(slot, motor.channel, &param);
+            if (result == -2) {
+                UART_SendError(UART_ST_OVERFLOW, "Hata: Dişli / konum tablosu dolu\r\n");
+                return;
+            } else if (result != 0) {
+                if (!FPGA_GetModule(slot) || !FPGA_GetModule(param.master_slot)) {
+                    UART_SendError(UART_ST_NOMODULE, "Hata: Modül yok\r\n");
+                } else if (Olay_Durduruldu(slot, motor.channel)) {
+                    UART_SendError(UART_ST_HW, "Hata: Eksen acil durduruldu\r\n");
+                } else {
+                    UART_SendError(UART_ST_ARG, "Hata: Geçersiz oran (|NUM| <= 65535, "
+                                   "1 <= DEN <= 65535, master != slave)\r\n");
+                }
+                return;
+            }
+            
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(": Disli bagli, master slot ");
+            UART_SendHex8(param.master_slot);
+            UART_SendString(" kanal ");
+            UART_SendHex8(param.master_ch);
+            UART_SendString("\r\n");
+            UART_Reply(UART_ST_OK, NULL);
+        }
+        else if (strcmp(cmd, "gearstatus") == 0) {
+            Disli_Bilgi bilgi;
+            
+            if (Disli_Oku(slot, motor.channel, &bilgi) != 0) {
+                memset(&bilgi, 0, sizeof(bilgi));
+            }
+            
+            // "<durum> <master slot> <master kanal> <pay> <payda> <hedef> <hız count/s> <doyum tick>"
+            char buf[96];
+            sprintf(buf, "%u %u %u %ld %ld %ld %ld %lu", bilgi.durum, bilgi.param.master_slot,
+                    bilgi.param.master_ch, (long)bilgi.param.pay, (long)bilgi.param.payda,
+                    (long)bilgi.hedef, (long)bilgi.hiz, (unsigned long)bilgi.doyum);
+            UART_Reply(UART_ST_OK, buf);
+            
+            static const char* const durumlar[] = { "BOS", "BEKLIYOR", "BAGLI", "DOYUM" };
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(" disli: ");
+            UART_SendString(durumlar[bilgi.durum]);
+            sprintf(buf, ", oran %ld/%ld, hedef=%ld hiz=%ld doyum=%lu\r\n",
+                    (long)bilgi.param.pay, (long)bilgi.param.payda, (long)bilgi.hedef,
+                    (long)bilgi.hiz, (unsigned long)bilgi.doyum);
+            UART_SendString(buf);
+        }
+        else if (strcmp(cmd, "homecfg") == 0 || strncmp(cmd, "homecfg:", 8) == 0) {
+            Referans_Param param;
+            
+            if (cmd[7] == ':') {
+                // homecfg:IOSLOT:IOPIN:LEVEL:DIR:FAST:SLOW[:BACKOFF[:TIMEOUT]]
+                int32_t values[8] = { 0, 0, 0, 0, 0, 0, 0, REFERANS_SURE_VARSAYILAN };
+                uint8_t n = 0;
+                
+                cmd += 8;
+                while (n < 8) {
+                    values[n++] = parse_int(&cmd);
+                    if (*cmd != ':') {
+                        break;
+                    }
+                    cmd++;
+                }
+                
+                if (*cmd != '\0' || n < 6) {
+                    UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası "
+                                   "(homecfg:IOSLOT:IOPIN:LEVEL:DIR:FAST:SLOW[:BACKOFF[:TIMEOUT]])\r\n");
+                    return;
+                }
+                if (values[0] < 0 || values[0] > 3 || values[1] < 0 || values[1] > 15 ||
+                    values[2] < 0 || values[2] > 1 ||
+                    (values[3] != DIRECTION_FORWARD && values[3] != DIRECTION_REVERSE) ||
+                    values[4] < 1 || values[4] > 255 || values[5] < 1 || values[5] > 255 ||
+                    values[6] < 0 || values[6] > 65535 || values[7] < 1) {
+                    UART_SendError(UART_ST_ARG, "Hata: Geçersiz referans parametresi\r\n");
+                    return;
+                }
+                
+                param.io_slot = (uint8_t)values[0];
+                param.io_pin = (uint8_t)values[1];
+                param.seviye = (uint8_t)values[2];
+                param.yon = (uint8_t)values[3];
+                param.hiz_hizli = (uint8_t)values[4];
+                param.hiz_yavas = (uint8_t)values[5];
+                param.geri = (uint16_t)values[6];
+                param.sure_max = (uint32_t)values[7];
+                
+                int result = Referans_Ayarla(slot, motor.channel, &param);
+                if (result == -2) {
+                    UART_SendError(UART_ST_OVERFLOW, "Hata: Referans tablosu dolu\r\n");
+                    return;
+                } else if (result != 0) {
+                    UART_SendError(UART_ST_ARG, "Hata: Referans araması sürüyor\r\n");
+                    return;
+                }
+            }
+            
+            if (Referans_Parametre(slot, motor.channel, &param) != 0) {
+                UART_SendError(UART_ST_ARG, "Hata: Referans ayarı yok\r\n");
+                return;
+            }
+            
+            // "<io slot> <io pin> <seviye> <yön> <hızlı> <yavaş> <geri count> <süre ms>"
+            char buf[64];
+            sprintf(buf, "%u %u %u %u %u %u %u %lu", param.io_slot, param.io_pin, param.seviye,
+                    param.yon, param.hiz_hizli, param.hiz_yavas, param.geri,
+                    (unsigned long)param.sure_max);
+            UART_Reply(UART_ST_OK, buf);
+            
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            sprintf(buf, " referans: IO16 slot %u pin %u = %u, yon %u\r\n", param.io_slot,
+                    param.io_pin, param.seviye, param.yon);
+            UART_SendString(buf);
+        }
+        else if (strcmp(cmd, "homing") == 0) {
+            Referans_Param param;
+            
+            if (Referans_Parametre(slot, motor.channel, &param) != 0) {
+                UART_SendError(UART_ST_ARG, "Hata: Referans ayarı yok (homecfg)\r\n");
+                return;
             }
+            if (Referans_Baslat(slot, motor.channel) != 0) {
+                UART_SendError(UART_ST_NOMODULE, "Hata: FPGA veya IO16 modülü yok\r\n");
+                return;
+            }
+            
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(": Referans aranıyor\r\n");
+            UART_Reply(UART_ST_OK, NULL);
+        }
+        else if (strcmp(cmd, "homestatus") == 0) {
+            Referans_Bilgi bilgi;
+            
+            if (Referans_Oku(slot, motor.channel, &bilgi) != 0) {
+                memset(&bilgi, 0, sizeof(bilgi));
+            }
+            
+            // "<durum> <hata> <giriş> <tetik count> <süre ms>"
+            char buf[64];
+            sprintf(buf, "%u %u %u %ld %lu", bilgi.durum, bilgi.hata, bilgi.giris,
+                    (long)bilgi.tetik, (unsigned long)bilgi.sure_ms);
+            UART_Reply(UART_ST_OK, buf);
+            
+            static const char* const durumlar[] = {
+                "BOS", "ARAMA", "BIRAKMA", "YAKLASMA", "DONUS", "TAMAM", "HATA"
+            };
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(" referans: ");
+            UART_SendString(durumlar[bilgi.durum]);
+            sprintf(buf, ", hata=%u anahtar=%u tetik=%ld sure=%lu ms\r\n", bilgi.hata,
+                    bilgi.giris, (long)bilgi.tetik, (unsigned long)bilgi.sure_ms);
+            UART_SendString(buf);
+        }
+        else if (strcmp(cmd, "link") == 0 || strncmp(cmd, "link:", 5) == 0) {
+            if (slot != OLAY_SLOT) {
+                UART_SendError(UART_ST_ARG, "Hata: FPGA INT yalnızca slot 2'de\r\n");
+                return;
+            }
+            if (cmd[4] == ':') {
+                cmd += 5;
+                int32_t maske = parse_int(&cmd);
+                if (*cmd != '\0') {
+                    UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (link:MASK)\r\n");
+                    return;
+                }
+                if (maske < 0 || maske > 0xFFFF) {
+                    UART_SendError(UART_ST_ARG, "Hata: Maske 0-0xFFFF olmalı\r\n");
+                    return;
+                }
+                Olay_Bagla(motor.channel, (uint16_t)maske);
+            }
+            
+            char buf[16];
+            sprintf(buf, "%u", Olay_Bagli(motor.channel));
+            UART_Reply(UART_ST_OK, buf);
+            
+            UART_SendString("Motor ");
+            UART_SendHex8(motor.channel);
+            UART_SendString(" olayinda durdurulan: 0x");
+            UART_SendHex8((uint8_t)(Olay_Bagli(motor.channel) >> 8));
+            UART_SendHex8((uint8_t)Olay_Bagli(motor.channel));
+            UART_SendString(" + kendisi\r\n");
         }
         else {
-            UART_SendString("Hata: Bilinmeyen motor komutu\r\n");
+            UART_SendError(UART_ST_SYNTAX, "Hata: Bilinmeyen motor komutu\r\n");
             UART_SendString("Kullanım:\r\n");
             UART_SendString("  fpga:SLOT:motor:CH:goto:POS:SPEED\r\n");
             UART_SendString("  fpga:SLOT:motor:CH:speed:SPEED:DIR\r\n");
@@ -998,15 +2044,33 @@ void FPGA_HandleCommand(const char* cmd) {
             UART_SendString("  fpga:SLOT:motor:CH:status\r\n");
             UART_SendString("  fpga:SLOT:motor:CH:timerinfo\r\n");
             UART_SendString("  fpga:SLOT:motor:CH:clearerror\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:profile[:VMAX:AMAX[:JMAX[:PWM[:PWMMIN]]]]\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:move:POS\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:movestatus\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:pid[:KP:KI:KD[:KVFF[:KAFF[:OUTMAX]]]]\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:pid:on / pid:off\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:pidstatus\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:capture[:on | :off]\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:gear:MSLOT:MCH:NUM:DEN:SPEED[:OFFSET] / gear:off\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:gearstatus\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:homecfg[:IOSLOT:IOPIN:LEVEL:DIR:FAST:SLOW[:BACKOFF[:TIMEOUT]]]\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:homing / homestatus\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:qadd:POS:SPEED[:DWELL[:BLEND[:IOSLOT:IOPIN:LEVEL[:MS]]]]\r\n");
+            UART_SendString("  fpga:SLOT:motor:CH:qstatus / qclear\r\n");
+            UART_SendString("  fpga:2:motor:CH:link[:MASK]\r\n");
         }
     }
     else {
-        UART_SendString("Hata: Bilinmeyen komut\r\n");
+        UART_SendError(UART_ST_SYNTAX, "Hata: Bilinmeyen komut\r\n");
         UART_SendString("Kullanım:\r\n");
         UART_SendString("  fpga:SLOT:readreg:ADDR\r\n");
         UART_SendString("  fpga:SLOT:writereg:ADDR:VALUE\r\n");
         UART_SendString("  fpga:SLOT:reset\r\n");
         UART_SendString("  fpga:SLOT:status\r\n");
+        UART_SendString("  fpga:SLOT:snapshot\r\n");
+        UART_SendString("  fpga:2:events[:reset]\r\n");
+        UART_SendString("  fpga:2:bit[:begin:SIZE:CRC32 | :data:OFFSET:HEX | :end]\r\n");
+        UART_SendString("  fpga:2:config\r\n");
         UART_SendString("  fpga:SLOT:motor:CH:goto:POS:SPEED\r\n");
         UART_SendString("  fpga:SLOT:motor:CH:speed:SPEED:DIR\r\n");
         UART_SendString("  fpga:SLOT:motor:CH:stop\r\n");
@@ -1016,5 +2080,5 @@ void FPGA_HandleCommand(const char* cmd) {
     }
     
     // Komut tamamlandı mesajı (burjuva_manager için)
-    UART_SendString("\r\nKomut tamamlandi: fpga\r\n");
+    UART_SendComplete("fpga");
 }
@@ -30,7 +30,7 @@
 #define REG_CONTROL_FLAGS       0x00    // R/W: Control flags
 #define REG_STATUS_FLAGS        0x01    // R  : Status flags
 #define REG_ERROR_CODE          0x02    // R  : Error code
-#define REG_RESERVED_03         0x03    // Reserved
+#define REG_EVENT_FLAGS         0x03    // R/W1C: Latched events (STATUS bit positions)
 #define REG_CURRENT_POS_HIGH    0x04    // R  : Current position[23:16]
 #define REG_CURRENT_POS_MID     0x05    // R  : Current position[15:8]
 #define REG_CURRENT_POS_LOW     0x06    // R  : Current position[7:0]
@@ -44,6 +44,10 @@
 #define REG_TIMER_HIGH          0x0E    // R/W: Timer duration[15:8] (in 100ms units)
 #define REG_TIMER_LOW           0x0F    // R/W: Timer duration[7:0] (max 6553.5s)
 
+// Slot-wide event summary (reserved byte 0x07 of channels 0 and 1)
+#define FPGA_REG_EVENT_PENDING_LOW  0x07    // R: Channels 0-7 with REG_EVENT_FLAGS != 0
+#define FPGA_REG_EVENT_PENDING_HIGH 0x17    // R: Channels 8-15
+
 // ============================================================================
 // Control Flags (REG_CONTROL_FLAGS) Bits
 // ============================================================================
@@ -68,6 +72,10 @@
 #define STATUS_FLAG_OTW             (1 << 1)    // Over-temperature warning
 #define STATUS_FLAG_TIMER_RUNNING   (1 << 0)    // Timer-based control active
 
+// STATUS bits that latch into REG_EVENT_FLAGS on a rising edge and assert INT
+#define FPGA_EVENT_MASK             (STATUS_FLAG_POSITION_REACHED | STATUS_FLAG_FAULT | \
+                                     STATUS_FLAG_TIMEOUT | STATUS_FLAG_OTW)
+
 // ============================================================================
 // Error Codes (REG_ERROR_CODE)
 // ============================================================================
@@ -101,8 +109,11 @@ typedef struct {
 // ============================================================================
 
 void FPGA_Register(uint8_t slot);
+void FPGA_Unregister(uint8_t slot);
 int FPGA_ReadRegister(uint8_t slot, uint8_t address, uint8_t* value);
 int FPGA_WriteRegister(uint8_t slot, uint8_t address, uint8_t value);
+int FPGA_ReadBlock(uint8_t slot, uint8_t address, uint8_t* buffer, uint16_t length);
+int FPGA_WriteBlock(uint8_t slot, uint8_t address, const uint8_t* buffer, uint16_t length);
 int FPGA_Reset(uint8_t slot);
 void FPGA_PrintStatus(uint8_t slot);
 void FPGA_HandleCommand(const char* cmd);
@@ -154,6 +165,15 @@ int FPGA_Motor_Stop(FPGA_Motor_t *motor);
  */
 int FPGA_Motor_EmergencyStop(FPGA_Motor_t *motor);
 
+/**
+ * @brief Write an enabling CONTROL_FLAGS value unless the channel's event
+ *        e-stop is still waiting for Olay_Isle (checked with EXTI0 masked)
+ * @param motor Motor handle
+ * @param ctrl CONTROL_FLAGS value
+ * @return 0 if successful, -1 on error or pending e-stop
+ */
+int FPGA_Motor_Enable(FPGA_Motor_t *motor, uint8_t ctrl);
+
 /**
  * @brief Set motor speed/direction with timer (auto-stop after duration)
  * @param motor Motor handle
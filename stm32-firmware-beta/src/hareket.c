@@ -0,0 +1,430 @@
+/**
+ * Burjuva Motor Controller - Hareket Profili Üreteci
+ *
+ * Trapez referansı her tick yeniden planlanır (çevrimiçi): hedefe doğru
+ * hız için ivmelen / sabit / yavaşla adaylarından, adımdan sonra kalan
+ * yol o hızdan durma yoluna yeten en büyüğü seçilir. Durma yolu ayrık
+ * toplamdır (c-a, c-2a, ...), böylece son adım tam hedefe iner.
+ *
+ * Birimler: konum Q16 count, hız Q16 count/tick, ivme Q16 count/tick².
+ * Kutu filtresi Q8 count tutar (24-bit konum + 8 bit kesir = 32 bit).
+ * Tick başına bölme yalnızca kutu ortalamasında (S-eğrisi eksenleri).
+ *
+ * FPGA register erişimi şimdilik RAM gölgesi olduğu için kesmeden
+ * yazılabilir; SPI yoluna geçildiğinde fpga.c erişimi Servo_Kilit ile
+ * korunmalı.
+ */
+
+#include "hareket.h"
+#include "servo.h"
+#include "pid.h"
+#include "fpga.h"
+#include "olay.h"
+#include <string.h>
+
+#define VARSAYILAN_VMAX     10000
+#define VARSAYILAN_AMAX     50000
+#define VARSAYILAN_PWM      255
+#define VARSAYILAN_PWM_MIN  32
+
+#define Q16(x)              ((int64_t)(x) * 65536)
+
+typedef struct {
+    uint8_t used;
+    uint8_t ayarli;             // Parametreler host'tan (profile): kayıt tutulur
+    uint8_t slot;
+    uint8_t ch;
+    volatile uint8_t durum;     // Hareket_Durum (kesme yazar)
+    Hareket_Param param;        // Kullanıcı birimleri
+    
+    // Çalışan hareketin parametreleri (move anında kopyalanır)
+    int32_t v_max;              // Q16 count/tick
+    int32_t a_max;              // Q16 count/tick²
+    uint64_t pwm_olcek;         // pwm_max << 32 / v_max
+    uint8_t pwm_max;
+    uint8_t pwm_min;
+    uint8_t pencere;            // Kutu uzunluğu (1: trapez)
+    
+    // Trapez referansı
+    int64_t p;                  // Q16 count
+    int32_t v;                  // Q16 count/tick
+    int32_t hedef;              // count
+    
+    // Kutu filtresi
+    int32_t kutu[HAREKET_PENCERE_MAX];  // Q8 count
+    int64_t toplam;
+    uint8_t head;
+    uint8_t bekleme;            // Referans hedefte durduktan sonraki tick
+    int32_t cikis;              // Q8 count
+    int32_t cikis_v;            // Q8 count/tick
+    
+    // Son yazılan register değerleri
+    int32_t yazilan_hedef;
+    uint8_t yazilan_pwm;
+} Eksen;
+
+static Eksen eksenler[HAREKET_EKSEN_SAYISI];
+
+static Eksen* eksen_bul(uint8_t slot, uint8_t ch) {
+    for (uint8_t i = 0; i < HAREKET_EKSEN_SAYISI; i++) {
+        if (eksenler[i].used && eksenler[i].slot == slot && eksenler[i].ch == ch) {
+            return &eksenler[i];
+        }
+    }
+    return NULL;
+}
+
+static void varsayilan(Hareket_Param* param) {
+    param->vmax = VARSAYILAN_VMAX;
+    param->amax = VARSAYILAN_AMAX;
+    param->jmax = 0;
+    param->pwm_max = VARSAYILAN_PWM;
+    param->pwm_min = VARSAYILAN_PWM_MIN;
+}
+
+static Eksen* eksen_al(uint8_t slot, uint8_t ch) {
+    Eksen* e = eksen_bul(slot, ch);
+    Eksen* bitmis = NULL;
+    if (e) {
+        return e;
+    }
+    
+    // Boş kayıt yoksa varsayılan parametreli bitmiş profilin kaydı alınır
+    for (uint8_t i = 0; i < HAREKET_EKSEN_SAYISI && !e; i++) {
+        if (!eksenler[i].used) {
+            e = &eksenler[i];
+        } else if (!bitmis && !eksenler[i].ayarli && eksenler[i].durum == HAREKET_BITTI) {
+            bitmis = &eksenler[i];
+        }
+    }
+    if (!e) {
+        e = bitmis;
+    }
+    if (!e) {
+        return NULL;
+    }
+    
+    Servo_Kilit();
+    memset(e, 0, sizeof(*e));
+    e->slot = slot;
+    e->ch = ch;
+    varsayilan(&e->param);
+    e->used = 1;
+    Servo_Birak();
+    return e;
+}
+
+int Hareket_Ayarla(uint8_t slot, uint8_t ch, const Hareket_Param* param) {
+    Eksen* e;
+    
+    if (slot > 3 || ch > 15 || !param ||
+        param->vmax == 0 || param->vmax > HAREKET_HIZ_MAX ||
+        param->amax < HAREKET_IVME_MIN || param->amax > HAREKET_IVME_MAX ||
+        param->pwm_max == 0 || param->pwm_min > param->pwm_max) {
+        return -1;
+    }
+    
+    e = eksen_al(slot, ch);
+    if (!e) {
+        return -2;
+    }
+    e->param = *param;          // Kesme param'ı okumaz
+    e->ayarli = 1;
+    return 0;
+}
+
+void Hareket_Parametre(uint8_t slot, uint8_t ch, Hareket_Param* param) {
+    Eksen* e = eksen_bul(slot, ch);
+    if (e) {
+        *param = e->param;
+    } else {
+        varsayilan(param);
+    }
+}
+
+/**
+ * Kullanıcı birimlerini tick birimlerine çevir
+ */
+static void parametre_yukle(Eksen* e) {
+    const Hareket_Param* prm = &e->param;
+    uint32_t pencere = 1;
+    
+    e->v_max = (int32_t)(((uint64_t)prm->vmax << 16) / SERVO_HZ);
+    e->a_max = (int32_t)(((uint64_t)prm->amax << 16) / ((uint32_t)SERVO_HZ * SERVO_HZ));
+    if (e->a_max < 1) {
+        e->a_max = 1;
+    }
+    e->pwm_olcek = ((uint64_t)prm->pwm_max << 32) / (uint32_t)e->v_max;
+    e->pwm_max = prm->pwm_max;
+    e->pwm_min = prm->pwm_min;
+    
+    // İvme rampası amax / jmax saniye; jerk yetmezse pencere sınırda kalır
+    if (prm->jmax > 0) {
+        pencere = (uint32_t)(((uint64_t)prm->amax * SERVO_HZ + prm->jmax - 1) / prm->jmax);
+        if (pencere < 1) {
+            pencere = 1;
+        } else if (pencere > HAREKET_PENCERE_MAX) {
+            pencere = HAREKET_PENCERE_MAX;
+        }
+    }
+    e->pencere = (uint8_t)pencere;
+}
+
+static int konum_oku(uint8_t slot, uint8_t ch, int32_t* pos) {
+    uint8_t base = FPGA_MOTOR_REG_BASE(ch);
+    uint8_t high, mid, low;
+    
+    if (FPGA_ReadRegister(slot, base + REG_CURRENT_POS_HIGH, &high) != 0 ||
+        FPGA_ReadRegister(slot, base + REG_CURRENT_POS_MID, &mid) != 0 ||
+        FPGA_ReadRegister(slot, base + REG_CURRENT_POS_LOW, &low) != 0) {
+        return -1;
+    }
+    
+    // 24-bit işaret genişletme
+    *pos = ((int32_t)high << 16) | ((int32_t)mid << 8) | low;
+    if (*pos & 0x800000) {
+        *pos |= (int32_t)0xFF000000;
+    }
+    return 0;
+}
+
+static void hedef_yaz(Eksen* e, int32_t pos) {
+    uint8_t base = FPGA_MOTOR_REG_BASE(e->ch);
+    
+    FPGA_WriteRegister(e->slot, base + REG_TARGET_POS_HIGH, (pos >> 16) & 0xFF);
+    FPGA_WriteRegister(e->slot, base + REG_TARGET_POS_MID, (pos >> 8) & 0xFF);
+    FPGA_WriteRegister(e->slot, base + REG_TARGET_POS_LOW, pos & 0xFF);
+    e->yazilan_hedef = pos;
+}
+
+int Hareket_Git(uint8_t slot, uint8_t ch, int32_t hedef) {
+    Eksen* e;
+    int32_t pos;
+    
+    if (slot > 3 || ch > 15 || hedef < HAREKET_KONUM_MIN || hedef > HAREKET_KONUM_MAX ||
+        Olay_Durduruldu(slot, ch)) {
+        return -1;
+    }
+    
+    e = eksen_al(slot, ch);
+    if (!e) {
+        return -2;
+    }
+    
+    // Çalışan hareket: yalnızca hedef değişir, hız/ivme sürekli kalır
+    Servo_Kilit();
+    if (e->durum == HAREKET_SURUYOR) {
+        e->hedef = hedef;
+        e->bekleme = 0;
+        Servo_Birak();
+        return 0;
+    }
+    Servo_Birak();
+    
+    if (konum_oku(slot, ch, &pos) != 0) {
+        return -1;
+    }
+    
+    parametre_yukle(e);
+    e->p = Q16(pos);
+    e->v = 0;
+    e->hedef = hedef;
+    for (uint8_t i = 0; i < e->pencere; i++) {
+        e->kutu[i] = pos * 256;
+    }
+    e->toplam = (int64_t)pos * 256 * e->pencere;
+    e->head = 0;
+    e->bekleme = 0;
+    e->cikis = pos * 256;
+    e->cikis_v = 0;
+    
+    // Pozisyon modu, hedef = mevcut konum: profil buradan başlar
+    e->yazilan_hedef = pos;
+    e->yazilan_pwm = e->pwm_min;
+    if (!PID_Etkin(slot, ch)) {
+        FPGA_Motor_t motor = { slot, ch };
+        hedef_yaz(e, pos);
+        FPGA_WriteRegister(slot, FPGA_MOTOR_REG_BASE(ch) + REG_SPEED, e->pwm_min);
+        if (FPGA_Motor_Enable(&motor, CTRL_FLAG_ENABLE) != 0) {
+            return -1;
+        }
+    }
+    
+    e->durum = HAREKET_SURUYOR;     // Kesme bundan sonra ekseni alır
+    return 0;
+}
+
+void Hareket_Iptal(uint8_t slot, uint8_t ch) {
+    Servo_Kilit();
+    for (uint8_t i = 0; i < HAREKET_EKSEN_SAYISI; i++) {
+        Eksen* e = &eksenler[i];
+        if (e->used && e->slot == slot && (ch == HAREKET_TUM_KANALLAR || e->ch == ch)) {
+            e->durum = HAREKET_BOS;
+            e->used = e->ayarli;
+        }
+    }
+    Servo_Birak();
+}
+
+void Hareket_Kapat(uint8_t slot) {
+    Servo_Kilit();
+    for (uint8_t i = 0; i < HAREKET_EKSEN_SAYISI; i++) {
+        Eksen* e = &eksenler[i];
+        if (e->used && e->slot == slot) {
+            e->durum = HAREKET_BOS;
+            e->used = 0;
+        }
+    }
+    Servo_Birak();
+}
+
+int Hareket_Oku(uint8_t slot, uint8_t ch, Hareket_Bilgi* bilgi) {
+    Eksen* e = eksen_bul(slot, ch);
+    if (!e) {
+        return -1;
+    }
+    
+    Servo_Kilit();
+    bilgi->durum = e->durum;
+    bilgi->hedef = e->hedef;
+    bilgi->setpoint = e->yazilan_hedef;
+    bilgi->hiz = (int32_t)(((int64_t)e->cikis_v * SERVO_HZ) >> 8);
+    bilgi->pwm = e->yazilan_pwm;
+    bilgi->pencere = e->pencere;
+    Servo_Birak();
+    return 0;
+}
+
+int Hareket_Setpoint(uint8_t slot, uint8_t ch, int32_t* pos_q8, int32_t* hiz_q8) {
+    for (uint8_t i = 0; i < HAREKET_EKSEN_SAYISI; i++) {
+        Eksen* e = &eksenler[i];
+        if (e->durum != HAREKET_BOS && e->slot == slot && e->ch == ch) {
+            *pos_q8 = e->cikis;
+            *hiz_q8 = e->cikis_v;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+uint8_t Hareket_Aktif(void) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < HAREKET_EKSEN_SAYISI; i++) {
+        if (eksenler[i].used && eksenler[i].durum == HAREKET_SURUYOR) {
+            n++;
+        }
+    }
+    return n;
+}
+
+// ============================================================================
+// Servo tick
+// ============================================================================
+
+/**
+ * c hızından her tick a yavaşlayarak durana kadar gidilen yol (Q16)
+ */
+static int64_t durma_yolu(int32_t c, int32_t a) {
+    int32_t k;
+    if (c <= 0) {
+        return 0;
+    }
+    k = c / a;
+    return (int64_t)k * c - (int64_t)a * k * (k + 1) / 2;
+}
+
+static void trapez_adim(Eksen* e) {
+    int64_t d = Q16(e->hedef) - e->p;
+    int32_t yon = (d >= 0) ? 1 : -1;
+    int64_t kalan = (yon > 0) ? d : -d;
+    int32_t vd = e->v * yon;            // Hedefe doğru hız
+    int32_t a = e->a_max;
+    int32_t c;
+    
+    if (vd >= 0 && vd <= a && kalan <= (int64_t)vd + a) {
+        c = (int32_t)kalan;             // Son adım: hız değişimi <= a
+    } else if (vd < 0) {
+        c = vd + a;                     // Hedeften uzaklaşıyor: önce fren
+    } else {
+        c = vd + a;
+        if (c > e->v_max) {
+            c = (vd > e->v_max) ? vd - a : e->v_max;
+        }
+        if (kalan - c < durma_yolu(c, a)) {
+            c = vd;
+            if (kalan - c < durma_yolu(c, a)) {
+                c = vd - a;             // Tam fren (yeni hedef çok yakınsa aşar)
+            }
+        }
+    }
+    
+    e->v = c * yon;
+    e->p += e->v;
+}
+
+static void eksen_tick(Eksen* e) {
+    int32_t yeni, cikis, setpoint;
+    uint32_t hiz, pwm;
+    
+    if (e->v != 0 || e->p != Q16(e->hedef)) {
+        trapez_adim(e);
+    }
+    if (e->v == 0 && e->p == Q16(e->hedef)) {
+        if (e->bekleme < 0xFF) {
+            e->bekleme++;
+        }
+    } else {
+        e->bekleme = 0;
+    }
+    
+    // Kutu filtresi: son pencere referansın ortalaması
+    yeni = (int32_t)(e->p >> 8);
+    if (e->pencere > 1) {
+        e->toplam += yeni - e->kutu[e->head];
+        e->kutu[e->head] = yeni;
+        if (++e->head >= e->pencere) {
+            e->head = 0;
+        }
+        cikis = (int32_t)(e->toplam / e->pencere);
+    } else {
+        cikis = yeni;
+    }
+    e->cikis_v = cikis - e->cikis;
+    e->cikis = cikis;
+    
+    setpoint = (cikis + 128) >> 8;
+    hiz = (uint32_t)((e->cikis_v < 0) ? -e->cikis_v : e->cikis_v) << 8;
+    pwm = (uint32_t)((hiz * e->pwm_olcek) >> 32);
+    if (pwm > e->pwm_max) {
+        pwm = e->pwm_max;           // Q8 yuvarlama vmax'ı bir LSB aşabilir
+    } else if (pwm < e->pwm_min) {
+        pwm = e->pwm_min;
+    }
+    
+    // Referans hedefte ve kutu tamamen hedefle dolu
+    if (e->bekleme >= e->pencere) {
+        setpoint = e->hedef;
+        pwm = e->pwm_min;
+        e->durum = HAREKET_BITTI;
+    }
+    
+    if (PID_Etkin(e->slot, e->ch)) {
+        e->yazilan_hedef = setpoint;    // Çıkış PID_Tick'te okunur
+        return;
+    }
+    if (setpoint != e->yazilan_hedef) {
+        hedef_yaz(e, setpoint);
+    }
+    if (pwm != e->yazilan_pwm) {
+        FPGA_WriteRegister(e->slot, FPGA_MOTOR_REG_BASE(e->ch) + REG_SPEED, (uint8_t)pwm);
+        e->yazilan_pwm = (uint8_t)pwm;
+    }
+}
+
+void Hareket_Tick(void) {
+    for (uint8_t i = 0; i < HAREKET_EKSEN_SAYISI; i++) {
+        if (eksenler[i].durum == HAREKET_SURUYOR) {
+            eksen_tick(&eksenler[i]);
+        }
+    }
+}
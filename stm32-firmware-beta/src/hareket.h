@@ -0,0 +1,111 @@
+/**
+ * Burjuva Motor Controller - Hareket Profili Üreteci
+ *
+ * FPGA motor kanalları için trapez ve jerk sınırlı (S-eğrisi) profil.
+ * Servo tick'inde (servo.h) her aktif eksenin REG_TARGET_POS ve
+ * REG_SPEED register'ları güncellenir; FPGA pozisyon döngüsü bu ara
+ * hedefleri izler. Kanalda PID döngüsü (pid.h) çalışıyorsa register
+ * yazılmaz, profil çıkışı PID'in setpoint'i olur. Hesap sabit noktalı
+ * (Q16 count/tick), FPU yok.
+ *
+ * S-eğrisi: trapez referansı N tick'lik kutu filtresinden geçer; ivme
+ * rampası N tick sürer (jerk = amax / N), bitiş konumu tam korunur.
+ *
+ * Komutlar (fpga.c):
+ *   fpga:S:motor:CH:profile[:VMAX:AMAX[:JMAX[:PWM[:PWMMIN]]]]
+ *   fpga:S:motor:CH:move:POS
+ *   fpga:S:motor:CH:movestatus
+ */
+
+#ifndef HAREKET_H
+#define HAREKET_H
+
+#include <stdint.h>
+
+#define HAREKET_EKSEN_SAYISI    8           // Profil tutulan eksen (slot+kanal)
+#define HAREKET_PENCERE_MAX     64          // S-eğrisi ivme rampası (tick)
+#define HAREKET_HIZ_MAX         1000000     // count/s
+#define HAREKET_IVME_MIN        16          // count/s² (Q16 çözünürlüğü)
+#define HAREKET_IVME_MAX        100000000   // count/s²
+#define HAREKET_KONUM_MIN       (-8388608)  // 24-bit FPGA pozisyonu
+#define HAREKET_KONUM_MAX       8388607
+#define HAREKET_TUM_KANALLAR    0xFF
+
+typedef enum {
+    HAREKET_BOS = 0,        // Profil yok / iptal edildi
+    HAREKET_SURUYOR,        // Servo tick'i hedef yazıyor
+    HAREKET_BITTI           // Setpoint hedefte
+} Hareket_Durum;
+
+typedef struct {
+    uint32_t vmax;          // count/s
+    uint32_t amax;          // count/s²
+    uint32_t jmax;          // count/s³ (0: trapez)
+    uint8_t pwm_max;        // vmax'ta REG_SPEED
+    uint8_t pwm_min;        // Düşük hızda ve hedefte REG_SPEED
+} Hareket_Param;
+
+typedef struct {
+    uint8_t durum;          // Hareket_Durum
+    int32_t hedef;          // count
+    int32_t setpoint;       // Son yazılan REG_TARGET_POS
+    int32_t hiz;            // count/s (işaretli, filtre çıkışı)
+    uint8_t pwm;            // Son yazılan REG_SPEED
+    uint8_t pencere;        // Kutu filtresi (tick, 1: trapez)
+} Hareket_Bilgi;
+
+/**
+ * Eksen parametrelerini ayarla; çalışan hareket eskileriyle biter,
+ * yeniler sonraki move'da geçerli olur
+ * @return 0: başarılı, -1: geçersiz parametre, -2: eksen tablosu dolu
+ */
+int Hareket_Ayarla(uint8_t slot, uint8_t ch, const Hareket_Param* param);
+
+/**
+ * Eksenin parametreleri (ayarlanmamışsa varsayılanlar)
+ */
+void Hareket_Parametre(uint8_t slot, uint8_t ch, Hareket_Param* param);
+
+/**
+ * Profilli harekete başla; eksen hareket ediyorsa mevcut hız ve ivme
+ * korunarak yeni hedefe yönelir
+ * @return 0: başarılı, -1: geçersiz hedef veya modül yok, -2: eksen tablosu dolu
+ */
+int Hareket_Git(uint8_t slot, uint8_t ch, int32_t hedef);
+
+/**
+ * Profili bırak (FPGA register'larına dokunmaz: doğrudan motor
+ * komutları kendi değerlerini yazar). ch = HAREKET_TUM_KANALLAR: slotun tümü.
+ * Parametreleri profile ile ayarlanmamış eksenin kaydı boşalır.
+ */
+void Hareket_Iptal(uint8_t slot, uint8_t ch);
+
+/**
+ * Slotun tüm profil kayıtlarını parametreleriyle sil (modül çıkarıldı)
+ */
+void Hareket_Kapat(uint8_t slot);
+
+/**
+ * Eksen durumu
+ * @return 0: başarılı, -1: eksen için profil kaydı yok
+ */
+int Hareket_Oku(uint8_t slot, uint8_t ch, Hareket_Bilgi* bilgi);
+
+/**
+ * Profil çıkışı (Q8 count, Q8 count/tick) - PID döngüsü setpoint'i.
+ * Kesme bağlamından çağrılır.
+ * @return 0: eksenin profili var (sürüyor/bitti), -1: yok
+ */
+int Hareket_Setpoint(uint8_t slot, uint8_t ch, int32_t* pos_q8, int32_t* hiz_q8);
+
+/**
+ * Profili çalışan eksen sayısı
+ */
+uint8_t Hareket_Aktif(void);
+
+/**
+ * Bir servo periyodu - Servo_Tick'ten (kesme bağlamı)
+ */
+void Hareket_Tick(void);
+
+#endif // HAREKET_H
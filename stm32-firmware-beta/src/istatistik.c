@@ -0,0 +1,233 @@
+/**
+ * Burjuva Motor Controller - Performans Sayaçları
+ * 
+ * Süreler DWT CYCCNT ile ölçülür (72 cycle = 1 µs). Histogram kovaları
+ * 4'ün katları: <16, <64, <256, <1024, <4096, <16384, <65536 µs ve üstü.
+ */
+
+#include "istatistik.h"
+#include "uart_helper.h"
+#include "tick.h"
+#include <string.h>
+#include <stdio.h>
+
+#define CYCLES_PER_US       72
+#define HIST_ILK_SINIR_US   16
+
+typedef struct {
+    uint32_t count;
+    uint64_t total_us;
+    uint32_t max_us;
+    uint32_t hist[IST_HIST_SAYISI];
+} Komut_Sayac;
+
+typedef struct {
+    Komut_Sayac komut[IST_KOMUT_SAYISI];
+    uint32_t spi_islem[IST_SLOT_SAYISI];
+    uint32_t spi_byte[IST_SLOT_SAYISI];
+    uint32_t echo[IST_SLOT_SAYISI][IST_ECHO_SAYISI];
+    uint32_t rx_tasma;
+    uint32_t satir_tasma;
+    uint32_t dongu_count;
+    uint64_t dongu_total;           // cycle
+    uint32_t dongu_max;             // cycle
+    uint32_t dongu_last;
+    uint8_t dongu_started;
+    uint32_t reset_ms;              // Son sıfırlama (Tick_Ms)
+} Istatistik;
+
+static Istatistik ist;
+
+static const char* const komut_names[IST_KOMUT_SAYISI] = {
+    "modul", "io16", "aio20", "fpga", "diger"
+};
+
+static void reset_counters(void) {
+    memset(&ist, 0, sizeof(ist));
+    ist.reset_ms = Tick_Ms();
+}
+
+void Istatistik_Init(void) {
+    // Trace aç, cycle sayacını başlat (modul_algilama.c de aynı sayacı kullanır)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    
+    reset_counters();
+}
+
+void Istatistik_KomutBitti(Istatistik_Komut kind, uint32_t start) {
+    uint32_t us = (Istatistik_Cycle() - start) / CYCLES_PER_US;
+    uint32_t limit = HIST_ILK_SINIR_US;
+    uint8_t bucket = 0;
+    Komut_Sayac* s;
+    
+    if (kind >= IST_KOMUT_SAYISI) {
+        return;
+    }
+    s = &ist.komut[kind];
+    
+    while (bucket < IST_HIST_SAYISI - 1 && us >= limit) {
+        limit <<= 2;
+        bucket++;
+    }
+    
+    s->count++;
+    s->total_us += us;
+    if (us > s->max_us) {
+        s->max_us = us;
+    }
+    s->hist[bucket]++;
+}
+
+void Istatistik_SpiIslem(uint8_t slot) {
+    if (slot < IST_SLOT_SAYISI) {
+        ist.spi_islem[slot]++;
+    }
+}
+
+void Istatistik_SpiByte(uint8_t slot) {
+    if (slot < IST_SLOT_SAYISI) {
+        ist.spi_byte[slot]++;
+    }
+}
+
+void Istatistik_EchoHata(uint8_t slot, Istatistik_Echo type) {
+    if (slot < IST_SLOT_SAYISI && type < IST_ECHO_SAYISI) {
+        ist.echo[slot][type]++;
+    }
+}
+
+void Istatistik_RxTasma(void) {
+    ist.rx_tasma++;
+}
+
+void Istatistik_SatirTasma(void) {
+    ist.satir_tasma++;
+}
+
+void Istatistik_Dongu(void) {
+    uint32_t now = Istatistik_Cycle();
+    
+    if (ist.dongu_started) {
+        uint32_t delta = now - ist.dongu_last;
+        ist.dongu_count++;
+        ist.dongu_total += delta;
+        if (delta > ist.dongu_max) {
+            ist.dongu_max = delta;
+        }
+    }
+    ist.dongu_last = now;
+    ist.dongu_started = 1;
+}
+
+static uint32_t average(uint64_t total, uint32_t count) {
+    return count ? (uint32_t)(total / count) : 0;
+}
+
+/**
+ * Human mode: tablo
+ */
+static void print_table(void) {
+    char line[160];
+    
+    sprintf(line, "\r\n=== Istatistik (%lu ms) ===\r\n",
+            (unsigned long)(Tick_Ms() - ist.reset_ms));
+    UART_SendString(line);
+    
+    sprintf(line, "Ana dongu: %lu tur, ort %lu us, max %lu us\r\n",
+            (unsigned long)ist.dongu_count,
+            (unsigned long)(average(ist.dongu_total, ist.dongu_count) / CYCLES_PER_US),
+            (unsigned long)(ist.dongu_max / CYCLES_PER_US));
+    UART_SendString(line);
+    
+    sprintf(line, "UART: rx overrun %lu, satir tasmasi %lu\r\n",
+            (unsigned long)ist.rx_tasma, (unsigned long)ist.satir_tasma);
+    UART_SendString(line);
+    
+    UART_SendString("Komut   adet     ort us   max us  | <16 <64 <256 <1k <4k <16k <64k >=64k\r\n");
+    for (int k = 0; k < IST_KOMUT_SAYISI; k++) {
+        const Komut_Sayac* s = &ist.komut[k];
+        
+        sprintf(line, "%-6s %6lu %9lu %8lu  |", komut_names[k], (unsigned long)s->count,
+                (unsigned long)average(s->total_us, s->count), (unsigned long)s->max_us);
+        UART_SendString(line);
+        for (int b = 0; b < IST_HIST_SAYISI; b++) {
+            sprintf(line, " %lu", (unsigned long)s->hist[b]);
+            UART_SendString(line);
+        }
+        UART_SendString("\r\n");
+    }
+    
+    for (int slot = 0; slot < IST_SLOT_SAYISI; slot++) {
+        const uint32_t* e = ist.echo[slot];
+        
+        sprintf(line, "Slot %d: SPI %lu islem %lu byte, echo hata addr %lu count %lu data %lu ctrl %lu\r\n",
+                slot, (unsigned long)ist.spi_islem[slot], (unsigned long)ist.spi_byte[slot],
+                (unsigned long)e[IST_ECHO_ADDR], (unsigned long)e[IST_ECHO_COUNT],
+                (unsigned long)e[IST_ECHO_DATA], (unsigned long)e[IST_ECHO_CTRL]);
+        UART_SendString(line);
+    }
+}
+
+/**
+ * Machine mode: '|' ile ayrılmış kayıtlar
+ * "up <ms>|loop <n> <ort_us> <max_us>|uart <overrun> <satir>|
+ *  cmd <grup> <n> <ort_us> <max_us> <h0>,...,<h7>|... |
+ *  spi <slot> <islem> <byte>|... |echo <slot> <addr> <count> <data> <ctrl>|..."
+ */
+static void send_reply(void) {
+    static char reply[1024];        // Uç değerlerde ~900 byte; stack'e konmaz
+    char* p = reply;
+    
+    p += sprintf(p, "up %lu|loop %lu %lu %lu|uart %lu %lu",
+                 (unsigned long)(Tick_Ms() - ist.reset_ms),
+                 (unsigned long)ist.dongu_count,
+                 (unsigned long)(average(ist.dongu_total, ist.dongu_count) / CYCLES_PER_US),
+                 (unsigned long)(ist.dongu_max / CYCLES_PER_US),
+                 (unsigned long)ist.rx_tasma, (unsigned long)ist.satir_tasma);
+    
+    for (int k = 0; k < IST_KOMUT_SAYISI; k++) {
+        const Komut_Sayac* s = &ist.komut[k];
+        
+        p += sprintf(p, "|cmd %s %lu %lu %lu ", komut_names[k], (unsigned long)s->count,
+                     (unsigned long)average(s->total_us, s->count), (unsigned long)s->max_us);
+        for (int b = 0; b < IST_HIST_SAYISI; b++) {
+            p += sprintf(p, b ? ",%lu" : "%lu", (unsigned long)s->hist[b]);
+        }
+    }
+    
+    for (int slot = 0; slot < IST_SLOT_SAYISI; slot++) {
+        p += sprintf(p, "|spi %d %lu %lu", slot,
+                     (unsigned long)ist.spi_islem[slot], (unsigned long)ist.spi_byte[slot]);
+    }
+    
+    for (int slot = 0; slot < IST_SLOT_SAYISI; slot++) {
+        const uint32_t* e = ist.echo[slot];
+        p += sprintf(p, "|echo %d %lu %lu %lu %lu", slot,
+                     (unsigned long)e[IST_ECHO_ADDR], (unsigned long)e[IST_ECHO_COUNT],
+                     (unsigned long)e[IST_ECHO_DATA], (unsigned long)e[IST_ECHO_CTRL]);
+    }
+    
+    UART_Reply(UART_ST_OK, reply);
+}
+
+void Istatistik_Komut_Isle(const char* arg) {
+    if (strcmp(arg, "reset") == 0) {
+        reset_counters();
+        UART_SendString("Istatistik sifirlandi\r\n");
+        UART_Reply(UART_ST_OK, NULL);
+    }
+    else if (*arg == '\0') {
+        if (UART_GetMode() == UART_MODE_MACHINE) {
+            send_reply();
+        } else {
+            print_table();
+        }
+    }
+    else {
+        UART_SendError(UART_ST_ARG, "Hata: stats[:reset]\r\n");
+        return;
+    }
+    UART_SendComplete("stats");
+}
@@ -0,0 +1,75 @@
+/**
+ * Burjuva Motor Controller - Performans Sayaçları
+ *
+ * DWT cycle sayacı (72 MHz) ile komut süresi histogramları, slot başına
+ * SPI işlem/byte sayıları, IO16 echo hataları, UART taşmaları ve ana
+ * döngü süresi. "stats" komutu ile okunur, "stats:reset" ile sıfırlanır.
+ * Sayaçlar ana döngüden güncellenir (kesme içinden çağrılmaz).
+ */
+
+#ifndef ISTATISTIK_H
+#define ISTATISTIK_H
+
+#include "stm32f10x.h"
+
+#define IST_SLOT_SAYISI     4
+#define IST_HIST_SAYISI     8       // Süre kovaları: <16, <64, ... <65536 µs, üstü
+
+// Komut grupları (süre histogramı başına bir tane)
+typedef enum {
+    IST_KOMUT_MODUL = 0,    // modul-algila, modul-izle
+    IST_KOMUT_IO16,
+    IST_KOMUT_AIO20,
+    IST_KOMUT_FPGA,
+    IST_KOMUT_DIGER,        // mode, help, stats, bilinmeyen
+    IST_KOMUT_SAYISI
+} Istatistik_Komut;
+
+// IO16 (iC-JX) çerçeve echo kontrolleri
+typedef enum {
+    IST_ECHO_ADDR = 0,
+    IST_ECHO_COUNT,
+    IST_ECHO_DATA,
+    IST_ECHO_CTRL,
+    IST_ECHO_SAYISI
+} Istatistik_Echo;
+
+/**
+ * DWT cycle sayacını aç ve sayaçları sıfırla (açılışta bir kez)
+ */
+void Istatistik_Init(void);
+
+/**
+ * Serbest çalışan cycle sayacı (59.6 s'de taşar, farklar taşmaya dayanıklı)
+ */
+static inline uint32_t Istatistik_Cycle(void) {
+    return DWT->CYCCNT;
+}
+
+/**
+ * start'tan (Istatistik_Cycle) beri süren komutu kind grubuna ekle
+ */
+void Istatistik_KomutBitti(Istatistik_Komut kind, uint32_t start);
+
+// SPI: CS ile başlayan çerçeve ve aktarılan byte (spisurucu.c)
+void Istatistik_SpiIslem(uint8_t slot);
+void Istatistik_SpiByte(uint8_t slot);
+
+// IO16 echo uyuşmazlığı (16kanaldijital.c)
+void Istatistik_EchoHata(uint8_t slot, Istatistik_Echo type);
+
+// UART: RX overrun (byte kaçtı) ve komut satırı tamponu doldu
+void Istatistik_RxTasma(void);
+void Istatistik_SatirTasma(void);
+
+/**
+ * Ana döngü iterasyonu - her turun başında çağrılır
+ */
+void Istatistik_Dongu(void);
+
+/**
+ * Process "stats[:reset]" command
+ */
+void Istatistik_Komut_Isle(const char* arg);
+
+#endif // ISTATISTIK_H
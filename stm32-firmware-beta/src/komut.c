@@ -0,0 +1,422 @@
+/**
+ ******************************************************************************
+ * @file    komut.c
+ * @brief   UART komut satırı ve komut dağıtımı
+ * 
+ * @description
+ * main.c'den ayrıldı: satır düzenleme (echo, backspace) ve komut
+ * dağıtımı donanımdan bağımsızdır, böylece aynı kod host simülatöründe
+ * (sim/) sahte SPI slot cihazlarına karşı çalıştırılabilir.
+ ******************************************************************************
+ */
+
+#include "komut.h"
+#include "modul_algilama.h"
+#include "16kanaldijital.h"
+#include "20kanalanalogio.h"
+#include "fpga.h"
+#include "istatistik.h"
+#include "servo.h"
+#include "kural.h"
+#include "betik.h"
+#include "uart_helper.h"
+#include <string.h>
+#include <stdio.h>
+
+static char cmdBuffer[CMD_BUFFER_SIZE];
+static uint16_t cmdIndex = 0;
+
+static void Send_ACK(const char* cmd);
+static int Dispatch_Command(char* lowerCmd);
+static int Run_Command(char* lowerCmd);
+static uint8_t Batch_Count(const char* lowerCmd);
+static void Process_Batch(char* lowerCmd, uint8_t atomic);
+static void Mode_Command(const char* arg);
+
+/**
+ * @brief  Handle one received byte
+ */
+void Komut_RxByte(uint8_t rx)
+{
+    /* Echo sadece human mode'da */
+    if (UART_GetMode() == UART_MODE_HUMAN)
+    {
+        UART_SendBytes(&rx, 1);
+    }
+    
+    /* Process command on Enter (CR or LF) */
+    if (rx == '\r' || rx == '\n')
+    {
+        if (cmdIndex > 0)
+        {
+            cmdBuffer[cmdIndex] = '\0';
+            
+            /* Echo newline */
+            UART_SendString("\r\n");
+            
+            /* Process command */
+            Process_Command(cmdBuffer);
+            
+            /* Reset buffer */
+            cmdIndex = 0;
+        }
+    }
+    /* Backspace */
+    else if (rx == 0x08 || rx == 0x7F)
+    {
+        if (cmdIndex > 0)
+        {
+            cmdIndex--;
+            /* Echo backspace sequence: BS + SPACE + BS */
+            UART_SendString(" \b");
+        }
+    }
+    /* Normal character */
+    else if (rx >= 32 && rx < 127)
+    {
+        if (cmdIndex < sizeof(cmdBuffer) - 1)
+        {
+            cmdBuffer[cmdIndex++] = rx;
+        }
+        else
+        {
+            Istatistik_SatirTasma();
+        }
+    }
+}
+
+/**
+ * @brief  No partial command line pending
+ */
+uint8_t Komut_SatirBos(void)
+{
+    return cmdIndex == 0;
+}
+
+/**
+ * @brief  Send ACK message (human mode)
+ */
+static void Send_ACK(const char* cmd)
+{
+    UART_SendString("\r\n[ACK] Komut alindi: ");
+    UART_SendString(cmd);
+    UART_SendString("\r\n");
+}
+
+/**
+ * @brief  Process received command line
+ *         Tek komut veya ';' ile ayrılmış komut listesi (batch)
+ */
+void Process_Command(char* cmd)
+{
+    /* Convert to lowercase for case-insensitive comparison */
+    char lowerCmd[CMD_BUFFER_SIZE];
+    int i = 0;
+    while (cmd[i] && i < CMD_BUFFER_SIZE - 1)
+    {
+        lowerCmd[i] = (cmd[i] >= 'A' && cmd[i] <= 'Z') ? (cmd[i] + 32) : cmd[i];
+        i++;
+    }
+    lowerCmd[i] = '\0';
+    
+    /* Batch: "atomic:..." veya ';' içeren satır */
+    if (strncmp(lowerCmd, "atomic:", 7) == 0)
+    {
+        Process_Batch(lowerCmd + 7, 1);
+        return;
+    }
+    if (strchr(lowerCmd, ';') != NULL)
+    {
+        Process_Batch(lowerCmd, 0);
+        return;
+    }
+    
+    UART_ReplyBegin();
+    if (Run_Command(lowerCmd) != 0)
+    {
+        UART_SendError(UART_ST_SYNTAX, "\r\nBilinmeyen komut! 'help' yazin.\r\n\r\n");
+    }
+    
+    /* Handler kısa yanıt vermediyse başarılı say */
+    UART_Reply(UART_ST_OK, NULL);
+}
+
+/**
+ * @brief  Count the non-empty segments of a ';' separated command list
+ */
+static uint8_t Batch_Count(const char* lowerCmd)
+{
+    uint8_t count = 0;
+    uint8_t empty = 1;
+    
+    for (const char* c = lowerCmd; ; c++)
+    {
+        if (*c == ';' || *c == '\0')
+        {
+            count += !empty;
+            empty = 1;
+            if (*c == '\0')
+            {
+                return count;
+            }
+        }
+        else if (*c != ' ')
+        {
+            empty = 0;
+        }
+    }
+}
+
+/**
+ * @brief  Execute a ';' separated command list back-to-back
+ *         Tek ACK, tek "Komut tamamlandi: batch" satırı gönderilir.
+ *         Hata durumu (UART_SendError / UART_Reply != OK) veren komut
+ *         başarısız sayılır.
+ *         atomic=1 ise IO16 çıkış yazımları biriktirilir ve batch sonunda
+ *         her modül için tek SPI yazımı ile aynı taramada uygulanır. İlk
+ *         başarısız komutta kalan komutlar çalıştırılmaz, biriken çıkışlar
+ *         atılır.
+ */
+static void Process_Batch(char* lowerCmd, uint8_t atomic)
+{
+    uint8_t total = 0;
+    uint8_t failed = 0;
+    uint8_t skipped = 0;
+    uint8_t aborted = 0;
+    char* seg = lowerCmd;
+    
+    Send_ACK(atomic ? "atomic" : "batch");
+    
+    /* Yanıt sayısı: boş olmayan komutlar + atomic commit hatası kaydı */
+    UART_BatchBegin((uint8_t)(Batch_Count(lowerCmd) + atomic));
+    if (atomic)
+    {
+        IO16_BeginDeferred();
+    }
+    
+    while (seg != NULL)
+    {
+        char* next = strchr(seg, ';');
+        if (next != NULL)
+        {
+            *next++ = '\0';
+        }
+        
+        /* Baştaki/sondaki boşlukları at */
+        while (*seg == ' ')
+        {
+            seg++;
+        }
+        char* end = seg + strlen(seg);
+        while (end > seg && end[-1] == ' ')
+        {
+            *--end = '\0';
+        }
+        
+        if (*seg)
+        {
+            total++;
+            if (aborted)
+            {
+                skipped++;
+            }
+            else
+            {
+                UART_ReplyBegin();
+                if (Run_Command(seg) != 0)
+                {
+                    UART_SendString("Hata: Bilinmeyen komut: ");
+                    UART_SendString(seg);
+                    UART_SendString("\r\n");
+                    UART_Reply(UART_ST_SYNTAX, NULL);
+                }
+                UART_Reply(UART_ST_OK, NULL);
+                
+                if (UART_ReplyStatus() != UART_ST_OK)
+                {
+                    failed++;
+                    aborted = atomic;
+                }
+            }
+        }
+        seg = next;
+    }
+    
+    if (aborted)
+    {
+        /* Yanıt listesi başarısız komutta biter */
+        IO16_DiscardDeferred();
+        UART_SendString("Hata: atomic batch durduruldu, çıkışlar uygulanmadı\r\n");
+    }
+    else if (atomic && IO16_CommitDeferred() != 0)
+    {
+        /* Commit hatası batch yanıtına ek bir kayıt olarak eklenir */
+        UART_ReplyBegin();
+        UART_SendError(UART_ST_HW, "Hata: IO16 commit başarısız\r\n");
+    }
+    UART_BatchEnd();
+    
+    /* Tek toplu tamamlanma satırı: "Komut tamamlandi: batch OK/TOPLAM" */
+    char summary[48];
+    sprintf(summary, "\r\nKomut tamamlandi: %s %d/%d",
+            atomic ? "atomic" : "batch", total - failed - skipped, total);
+    UART_SendString(summary);
+    UART_SendString("\r\n");
+}
+
+/**
+ * @brief  "mode" komutları
+ *         mode:machine -> echo/ACK/açıklama kapalı, kısa yanıt
+ *         mode:human   -> interaktif terminal (varsayılan)
+ *         mode         -> aktif modu döndür
+ */
+static void Mode_Command(const char* arg)
+{
+    if (strcmp(arg, "machine") == 0)
+    {
+        UART_SetMode(UART_MODE_MACHINE);
+    }
+    else if (strcmp(arg, "human") == 0)
+    {
+        UART_SetMode(UART_MODE_HUMAN);
+        UART_SendString("OK: mode human\r\n");
+    }
+    else if (*arg != '\0')
+    {
+        UART_SendError(UART_ST_ARG, "Hata: Geçersiz mod (machine/human)\r\n");
+        return;
+    }
+    
+    if (UART_GetMode() == UART_MODE_MACHINE)
+    {
+        UART_Reply(UART_ST_OK, "machine");
+    }
+    else if (*arg == '\0')
+    {
+        UART_SendString("Mod: human\r\n");
+    }
+}
+
+/**
+ * @brief  Dispatch a single command and record its execution time
+ */
+static int Run_Command(char* lowerCmd)
+{
+    uint32_t start = Istatistik_Cycle();
+    Istatistik_Komut kind = IST_KOMUT_DIGER;
+    
+    if (strncmp(lowerCmd, "modul-", 6) == 0)
+    {
+        kind = IST_KOMUT_MODUL;
+    }
+    else if (strncmp(lowerCmd, "io16:", 5) == 0)
+    {
+        kind = IST_KOMUT_IO16;
+    }
+    else if (strncmp(lowerCmd, "aio20:", 6) == 0)
+    {
+        kind = IST_KOMUT_AIO20;
+    }
+    else if (strncmp(lowerCmd, "fpga:", 5) == 0)
+    {
+        kind = IST_KOMUT_FPGA;
+    }
+    
+    int result = Dispatch_Command(lowerCmd);
+    Istatistik_KomutBitti(kind, start);
+    return result;
+}
+
+/**
+ * @brief  Dispatch a single lowercase command
+ * @retval 0: komut tanındı, -1: bilinmeyen komut
+ */
+static int Dispatch_Command(char* lowerCmd)
+{
+    /* Batch içinde her komut için ayrı ACK gönderilmez */
+    uint8_t ack = !UART_InBatch();
+    
+    /* Process commands */
+    if (strcmp(lowerCmd, "mode") == 0 || strncmp(lowerCmd, "mode:", 5) == 0)
+    {
+        Mode_Command(lowerCmd[4] == ':' ? lowerCmd + 5 : "");
+    }
+    else if (strncmp(lowerCmd, "modul-algila", 12) == 0 &&
+             (lowerCmd[12] == '\0' || lowerCmd[12] == ':'))
+    {
+        if (ack) Send_ACK("modul-algila");
+        Modul_Komut_Isle(lowerCmd[12] == ':' ? lowerCmd + 13 : "");
+    }
+    else if (strncmp(lowerCmd, "modul-izle", 10) == 0 &&
+             (lowerCmd[10] == '\0' || lowerCmd[10] == ':'))
+    {
+        if (ack) Send_ACK("modul-izle");
+        Modul_Izle_Komut(lowerCmd[10] == ':' ? lowerCmd + 11 : "");
+    }
+    else if (strncmp(lowerCmd, "io16:", 5) == 0)
+    {
+        if (ack) Send_ACK("io16");
+        IO16_HandleCommand(lowerCmd + 5);  // "io16:" sonrasını gönder
+    }
+    else if (strncmp(lowerCmd, "aio20:", 6) == 0)
+    {
+        if (ack) Send_ACK("aio20");
+        AIO20_HandleCommand(lowerCmd + 6);  // "aio20:" sonrasını gönder
+    }
+    else if (strncmp(lowerCmd, "fpga:", 5) == 0)
+    {
+        if (ack) Send_ACK("fpga");
+        FPGA_HandleCommand(lowerCmd + 5);  // "fpga:" sonrasını gönder
+    }
+    else if (strcmp(lowerCmd, "stats") == 0 || strncmp(lowerCmd, "stats:", 6) == 0)
+    {
+        if (ack) Send_ACK("stats");
+        Istatistik_Komut_Isle(lowerCmd[5] == ':' ? lowerCmd + 6 : "");
+    }
+    else if (strcmp(lowerCmd, "servo") == 0 || strncmp(lowerCmd, "servo:", 6) == 0)
+    {
+        if (ack) Send_ACK("servo");
+        Servo_Komut_Isle(lowerCmd[5] == ':' ? lowerCmd + 6 : "");
+    }
+    else if (strcmp(lowerCmd, "kural") == 0 || strncmp(lowerCmd, "kural:", 6) == 0)
+    {
+        if (ack) Send_ACK("kural");
+        Kural_Komut_Isle(lowerCmd[5] == ':' ? lowerCmd + 6 : "");
+    }
+    else if (strcmp(lowerCmd, "betik") == 0 || strncmp(lowerCmd, "betik:", 6) == 0)
+    {
+        if (ack) Send_ACK("betik");
+        Betik_Komut_Isle(lowerCmd[5] == ':' ? lowerCmd + 6 : "");
+    }
+    else if (strcmp(lowerCmd, "help") == 0 || strcmp(lowerCmd, "yardim") == 0)
+    {
+        if (ack) Send_ACK("help");
+        UART_SendString("\r\nMevcut Komutlar:\r\n"
+                    "  modul-algila              -> Bagli modulleri tara\r\n"
+                    "  modul-algila:rapor        -> Slot basina tek kayit\r\n"
+                    "  modul-izle:on / :off      -> Hot-plug izleme\r\n"
+                    "  io16:SLOT:KOMUT           -> IO16 modul kontrolu\r\n"
+                    "  aio20:SLOT:KOMUT          -> AIO20 modul kontrolu\r\n"
+                    "  fpga:SLOT:KOMUT           -> FPGA modul kontrolu\r\n"
+                    "  KOMUT1;KOMUT2;...         -> Coklu komut (tek yanit)\r\n"
+                    "  atomic:KOMUT1;KOMUT2      -> IO16 cikislari tek seferde\r\n"
+                    "  mode:machine / mode:human -> Host / terminal modu\r\n"
+                    "  stats / stats:reset       -> Performans sayaclari\r\n"
+                    "  servo / servo:reset       -> Servo tick suresi (profil)\r\n"
+                    "  kural / kural:on|off      -> Kilitleme/refleks kurallari\r\n"
+                    "  betik / betik:run|stop    -> Bytecode betik yorumlayici\r\n"
+                    "  help                      -> Bu yardim mesaji\r\n"
+                    "\r\n"
+                    "Ornek:\r\n"
+                    "  io16:0:set:5:high         -> Slot 0, Pin 5 = HIGH\r\n"
+                    "  aio20:1:readin:3          -> Slot 1, AI3 oku\r\n"
+                    "  fpga:2:status             -> Slot 2 durumu\r\n"
+                    "  io16:0:set:1:high;aio20:1:readall\r\n"
+                    "\r\n");
+    }
+    else
+    {
+        return -1;
+    }
+    return 0;
+}
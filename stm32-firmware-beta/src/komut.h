@@ -0,0 +1,35 @@
+/**
+ * Burjuva Motor Controller - Komut Katmanı
+ * 
+ * UART'tan gelen byte'lardan komut satırı oluşturur ve satırı
+ * modül handler'larına dağıtır (tek komut, ';' batch, atomic batch).
+ * Donanıma doğrudan dokunmaz: UART çıkışı uart_helper üzerinden,
+ * modül erişimi handler'lar üzerinden yapılır (host simülatörü de
+ * aynı katmanı kullanır).
+ */
+
+#ifndef KOMUT_H
+#define KOMUT_H
+
+#include <stdint.h>
+
+/* Komut satırı tamponu (batch satırları için geniş tutuldu) */
+#define CMD_BUFFER_SIZE     256
+
+/**
+ * Alınan tek byte'ı işle: human mode'da echo, CR/LF'de satırı çalıştır,
+ * backspace ile sil. Satır tamamlanınca Process_Command çağrılır.
+ */
+void Komut_RxByte(uint8_t rx);
+
+/**
+ * Satır ortasında değilse 1 (arka plan işleri olay basabilir)
+ */
+uint8_t Komut_SatirBos(void);
+
+/**
+ * Tek komut veya ';' ile ayrılmış komut listesi (batch) çalıştır
+ */
+void Process_Command(char* cmd);
+
+#endif // KOMUT_H
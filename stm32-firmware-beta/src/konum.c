@@ -0,0 +1,292 @@
+/**
+ * Burjuva Motor Controller - Konum Yakalama ve Hız Kestirimi
+ *
+ * Konumlar slot başına tek blok okuma ile alınır (pid.c ile aynı: en düşük
+ * ve en yüksek yakalanan kanalın CURRENT_POS'ları arası). Örnek zamanı
+ * okumanın ortasıdır. µs saati DWT farklarından biriktirilir (kalan cycle
+ * taşınır), her tick'te ilerletildiği için DWT'nin 59.6 s taşması görünmez.
+ *
+ * İç birimler: hız Q8 count/s, ivme count/s². İki örnek arası çeyrek
+ * tick'ten kısaysa (birleşen tick, host simülatörü) fark bir sonraki
+ * örneğe eklenir: bölen hiçbir zaman sıfıra yakın olmaz.
+ */
+
+#include "konum.h"
+#include "servo.h"
+#include "istatistik.h"
+#include "fpga.h"
+#include <string.h>
+
+#define SLOT_SAYISI         4
+#define CYCLE_HZ            72000000LL
+#define CYCLE_PER_US        72
+#define DT_MIN              (CYCLE_HZ / SERVO_HZ / 4)
+#define SINIR_32            0x7FFFFFFFLL
+
+typedef struct {
+    uint8_t used;
+    uint8_t host;               // capture:on ile açıldı
+    uint8_t slot;
+    uint8_t ch;
+    volatile uint8_t yenile;    // Sıradaki örnek yeni başlangıç
+    uint8_t gecerli;
+    uint8_t seri;               // Yeni başlangıç sayacı
+    uint32_t ham24;             // Son okunan register değeri
+    int64_t konum;              // count
+    int64_t ref_konum;          // Son hız hesabındaki konum
+    uint32_t ref_cycle;         // ve zamanı
+    int32_t hiz;                // Q8 count/s
+    int32_t ivme;               // count/s²
+    uint32_t zaman_us;
+    uint32_t ornek;
+} Konum_Eksen;
+
+static Konum_Eksen eksenler[KONUM_KANAL_SAYISI];
+static volatile uint16_t slot_maske[SLOT_SAYISI];  // Yakalanan kanallar
+static uint32_t slot_ornek[SLOT_SAYISI];
+static uint8_t blok[256];
+static uint8_t seri_sayac = 0;      // Eksenler arası ortak: yeniden açılan eksen yeni seri alır
+
+// µs saati
+static uint32_t saat_cycle = 0;
+static uint32_t saat_kalan = 0;
+static uint32_t saat_us = 0;
+
+static Konum_Eksen* eksen_bul(uint8_t slot, uint8_t ch) {
+    for (uint8_t i = 0; i < KONUM_KANAL_SAYISI; i++) {
+        if (eksenler[i].used && eksenler[i].slot == slot && eksenler[i].ch == ch) {
+            return &eksenler[i];
+        }
+    }
+    return NULL;
+}
+
+static int64_t sinirla(int64_t x, int64_t sinir) {
+    return (x > sinir) ? sinir : (x < -sinir) ? -sinir : x;
+}
+
+int Konum_Ac(uint8_t slot, uint8_t ch, uint8_t host) {
+    Konum_Eksen* e;
+    uint8_t status;
+    
+    if (slot >= SLOT_SAYISI || ch > 15 ||
+        FPGA_ReadRegister(slot, FPGA_MOTOR_REG_BASE(ch) + REG_STATUS_FLAGS, &status) != 0) {
+        return -1;
+    }
+    
+    e = eksen_bul(slot, ch);
+    if (!e) {
+        for (uint8_t i = 0; i < KONUM_KANAL_SAYISI && !e; i++) {
+            if (!eksenler[i].used) {
+                e = &eksenler[i];
+            }
+        }
+        if (!e) {
+            return -2;
+        }
+    }
+    
+    host |= e->used && e->host;     // Yeniden açılan eksen host kaydını korur
+    
+    Servo_Kilit();
+    memset(e, 0, sizeof(*e));
+    e->slot = slot;
+    e->ch = ch;
+    e->host = host;
+    e->yenile = 1;
+    e->used = 1;
+    slot_maske[slot] |= (uint16_t)(1 << ch);
+    Servo_Birak();
+    return 0;
+}
+
+void Konum_Kapat(uint8_t slot, uint8_t ch) {
+    if (slot >= SLOT_SAYISI) {
+        return;
+    }
+    
+    Servo_Kilit();
+    for (uint8_t i = 0; i < KONUM_KANAL_SAYISI; i++) {
+        Konum_Eksen* e = &eksenler[i];
+        if (e->used && e->slot == slot && (ch == KONUM_TUM_KANALLAR || e->ch == ch)) {
+            e->used = 0;
+            slot_maske[slot] &= (uint16_t)~(1 << e->ch);
+        }
+    }
+    Servo_Birak();
+}
+
+void Konum_Birak(uint8_t slot, uint8_t ch) {
+    Konum_Eksen* e = eksen_bul(slot, ch);
+    if (e && !e->host) {
+        Konum_Kapat(slot, ch);
+    }
+}
+
+void Konum_Yenile(uint8_t slot, uint8_t ch) {
+    for (uint8_t i = 0; i < KONUM_KANAL_SAYISI; i++) {
+        Konum_Eksen* e = &eksenler[i];
+        if (e->used && e->slot == slot && (ch == KONUM_TUM_KANALLAR || e->ch == ch)) {
+            e->yenile = 1;
+        }
+    }
+}
+
+static void durum_doldur(const Konum_Eksen* e, Konum_Durum* durum) {
+    durum->gecerli = e->gecerli;
+    durum->konum = e->konum;
+    durum->tur = (int32_t)((e->konum + 0x800000) >> 24);
+    durum->ham = (int32_t)(e->konum - ((int64_t)durum->tur << 24));
+    durum->hiz = (e->hiz + ((e->hiz < 0) ? -128 : 128)) / 256;
+    durum->ivme = e->ivme;
+    durum->zaman_us = e->zaman_us;
+    durum->ornek = e->ornek;
+}
+
+int Konum_Oku(uint8_t slot, uint8_t ch, Konum_Durum* durum) {
+    Konum_Eksen* e = eksen_bul(slot, ch);
+    if (!e) {
+        return -1;
+    }
+    
+    Servo_Kilit();
+    durum_doldur(e, durum);
+    Servo_Birak();
+    return 0;
+}
+
+int Konum_Son(uint8_t slot, uint8_t ch, int64_t* konum, uint8_t* seri) {
+    Konum_Eksen* e = eksen_bul(slot, ch);
+    if (!e || !e->gecerli) {
+        return -1;
+    }
+    *konum = e->konum;
+    *seri = e->seri;
+    return 0;
+}
+
+uint8_t Konum_Anlik(uint8_t slot, uint8_t* kanallar, Konum_Durum* durum, uint8_t max) {
+    uint8_t n = 0;
+    
+    if (slot >= SLOT_SAYISI) {
+        return 0;
+    }
+    
+    // Tek kilit: tüm eksenler aynı tick'in örneği
+    Servo_Kilit();
+    for (uint8_t ch = 0; ch < 16 && n < max; ch++) {
+        Konum_Eksen* e;
+        if (!(slot_maske[slot] & (1 << ch)) || !(e = eksen_bul(slot, ch))) {
+            continue;
+        }
+        kanallar[n] = ch;
+        durum_doldur(e, &durum[n]);
+        n++;
+    }
+    Servo_Birak();
+    return n;
+}
+
+uint8_t Konum_Aktif(void) {
+    uint8_t n = 0;
+    for (uint8_t slot = 0; slot < SLOT_SAYISI; slot++) {
+        for (uint16_t m = slot_maske[slot]; m; m &= m - 1) {
+            n++;
+        }
+    }
+    return n;
+}
+
+// ============================================================================
+// Servo tick
+// ============================================================================
+
+static uint32_t saat_ilerlet(uint32_t cycle) {
+    saat_kalan += cycle - saat_cycle;
+    saat_cycle = cycle;
+    saat_us += saat_kalan / CYCLE_PER_US;
+    saat_kalan %= CYCLE_PER_US;
+    return saat_us;
+}
+
+static void eksen_ornek(Konum_Eksen* e, const uint8_t* reg, uint32_t cycle, uint32_t zaman,
+                        uint32_t ornek) {
+    uint32_t ham = ((uint32_t)reg[0] << 16) | ((uint32_t)reg[1] << 8) | reg[2];
+    
+    if (e->yenile || !e->gecerli) {
+        e->konum = (int32_t)(ham << 8) >> 8;
+        e->ref_konum = e->konum;
+        e->ref_cycle = cycle;
+        e->hiz = 0;
+        e->ivme = 0;
+        e->yenile = 0;
+        e->gecerli = 1;
+        e->seri = ++seri_sayac;
+    } else {
+        // İşaretli 24-bit fark: sayaç taşması burada açılır
+        uint32_t dt = cycle - e->ref_cycle;
+        e->konum += (int32_t)((ham - e->ham24) << 8) >> 8;
+        
+        if (dt >= DT_MIN) {
+            int64_t v_ham = (e->konum - e->ref_konum) * (CYCLE_HZ * 256) / dt;
+            int32_t v_eski = e->hiz;
+            int64_t a_ham;
+            
+            v_ham = sinirla(v_ham, SINIR_32);
+            e->hiz += (int32_t)((v_ham - e->hiz) >> KONUM_HIZ_SUZGEC);
+            
+            a_ham = sinirla(((int64_t)e->hiz - v_eski) * CYCLE_HZ / dt / 256, SINIR_32);
+            e->ivme += (int32_t)((a_ham - e->ivme) >> KONUM_IVME_SUZGEC);
+            
+            e->ref_konum = e->konum;
+            e->ref_cycle = cycle;
+        }
+    }
+    
+    e->ham24 = ham;
+    e->zaman_us = zaman;
+    e->ornek = ornek;
+}
+
+void Konum_Tick(void) {
+    saat_ilerlet(Istatistik_Cycle());
+    
+    for (uint8_t slot = 0; slot < SLOT_SAYISI; slot++) {
+        uint16_t maske = slot_maske[slot];
+        uint8_t ilk = 0, son = 15;
+        uint8_t adres;
+        uint32_t start, cycle, zaman;
+        int sonuc;
+        
+        if (!maske) {
+            continue;
+        }
+        while (!(maske & (1 << ilk))) {
+            ilk++;
+        }
+        while (!(maske & (1 << son))) {
+            son--;
+        }
+        
+        adres = FPGA_MOTOR_REG_BASE(ilk) + REG_CURRENT_POS_HIGH;
+        start = Istatistik_Cycle();
+        sonuc = FPGA_ReadBlock(slot, adres, blok,
+                               FPGA_MOTOR_REG_BASE(son) + REG_CURRENT_POS_LOW + 1 - adres);
+        cycle = start + (Istatistik_Cycle() - start) / 2;
+        zaman = saat_ilerlet(cycle);
+        slot_ornek[slot]++;
+        
+        for (uint8_t i = 0; i < KONUM_KANAL_SAYISI; i++) {
+            Konum_Eksen* e = &eksenler[i];
+            if (!e->used || e->slot != slot) {
+                continue;
+            }
+            if (sonuc != 0) {
+                e->gecerli = 0;     // Sıradaki başarılı okuma yeni başlangıç
+                continue;
+            }
+            eksen_ornek(e, &blok[FPGA_MOTOR_REG_BASE(e->ch) + REG_CURRENT_POS_HIGH - adres],
+                        cycle, zaman, slot_ornek[slot]);
+        }
+    }
+}
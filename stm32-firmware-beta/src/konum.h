@@ -0,0 +1,103 @@
+/**
+ * Burjuva Motor Controller - Konum Yakalama ve Hız Kestirimi
+ *
+ * Yakalaması açık eksenlerin CURRENT_POS register'ları her servo tick'inde
+ * (SERVO_HZ) slot başına tek blok okumayla örneklenir ve DWT ile zaman
+ * damgalanır: aynı slottaki eksenler aynı çerçevede, aynı anda okunur.
+ *
+ * 24-bit sayaç taşması örnekler arası işaretli farkla açılır (tick başına
+ * ±2^23 count'tan az hareket varsayılır); konum 64-bit tutulur, dışarıya
+ * tur (2^24 count) + işaretli 24-bit kalan olarak verilir:
+ *
+ *   konum = tur * 16777216 + ham
+ *
+ * Hız ve ivme sabit noktalı süzülmüş farklardır (birinci dereceden IIR):
+ *
+ *   v_ham = dx / dt               v += (v_ham - v) / 2^KONUM_HIZ_SUZGEC
+ *   a_ham = dv / dt               a += (a_ham - a) / 2^KONUM_IVME_SUZGEC
+ *
+ * dt örnekler arası DWT farkıdır (tick gecikmesi hızı bozmaz).
+ *
+ * Komutlar (fpga.c):
+ *   fpga:S:motor:CH:capture:on / capture:off
+ *   fpga:S:motor:CH:capture          Eksenin son örneği
+ *   fpga:S:snapshot                  Slottaki tüm eksenler, tek zaman damgası
+ */
+
+#ifndef KONUM_H
+#define KONUM_H
+
+#include <stdint.h>
+
+#define KONUM_KANAL_SAYISI      16          // Yakalanan kanal (slot+kanal)
+#define KONUM_HIZ_SUZGEC        3           // ~8 tick zaman sabiti
+#define KONUM_IVME_SUZGEC       4           // ~16 tick zaman sabiti
+#define KONUM_TUM_KANALLAR      0xFF
+
+typedef struct {
+    uint8_t gecerli;        // En az bir örnek alındı, son okuma başarılı
+    int64_t konum;          // count, taşmalar açılmış
+    int32_t tur;            // 24-bit sayaç turu
+    int32_t ham;            // count, işaretli 24-bit (konum - tur * 2^24)
+    int32_t hiz;            // count/s
+    int32_t ivme;           // count/s²
+    uint32_t zaman_us;      // Örnek zamanı, açılıştan beri µs (~71 dk'da taşar)
+    uint32_t ornek;         // Slot örnek numarası
+} Konum_Durum;
+
+/**
+ * Yakalamayı başlat: bir sonraki tick'te ilk örnek alınır (hız sıfırdan).
+ * host = 1: capture:on ile açıldı, Konum_Birak kapatmaz
+ * @return 0: başarılı, -1: modül yok, -2: kanal tablosu dolu
+ */
+int Konum_Ac(uint8_t slot, uint8_t ch, uint8_t host);
+
+/**
+ * Yakalamayı durdur. ch = KONUM_TUM_KANALLAR: slotun tümü
+ */
+void Konum_Kapat(uint8_t slot, uint8_t ch);
+
+/**
+ * Firmware'in açtığı yakalama artık kullanılmıyor (dişli master'ı):
+ * host açmadıysa kapat
+ */
+void Konum_Birak(uint8_t slot, uint8_t ch);
+
+/**
+ * Konum sıçraması bekleniyor (home, reset): sıradaki örnek yeni başlangıç
+ * olur, hız sıçramaz. ch = KONUM_TUM_KANALLAR: slotun tümü
+ */
+void Konum_Yenile(uint8_t slot, uint8_t ch);
+
+/**
+ * Eksenin son örneği
+ * @return 0: başarılı, -1: eksen yakalanmıyor
+ */
+int Konum_Oku(uint8_t slot, uint8_t ch, Konum_Durum* durum);
+
+/**
+ * Servo tick içinden (kilitsiz) son konum. seri her yeni başlangıçta
+ * (capture:on, home, reset, okuma hatası sonrası) artar: konum sıçramış
+ * olabilir, farkı alan kod referansını yenilemeli
+ * @return 0: başarılı, -1: eksen yakalanmıyor veya son örnek geçersiz
+ */
+int Konum_Son(uint8_t slot, uint8_t ch, int64_t* konum, uint8_t* seri);
+
+/**
+ * Slotun tüm yakalanan eksenleri, aynı servo tick'inden. durum[] kanal
+ * sırasıyla doldurulur, kanallar[] kanal numaraları
+ * @return eksen sayısı
+ */
+uint8_t Konum_Anlik(uint8_t slot, uint8_t* kanallar, Konum_Durum* durum, uint8_t max);
+
+/**
+ * Yakalanan eksen sayısı
+ */
+uint8_t Konum_Aktif(void);
+
+/**
+ * Bir servo periyodu - Servo_Tick'ten, Hareket_Tick ve Disli_Tick'ten önce
+ */
+void Konum_Tick(void);
+
+#endif // KONUM_H
@@ -0,0 +1,715 @@
+/**
+ * Burjuva Motor Controller - Kilitleme / Refleks Kuralları
+ *
+ * Tablo yüklenirken kaynak özetleri (IO16 slotları, AIO20 port maskeleri,
+ * FPGA kanal aralıkları) bir kez çıkarılır; tarama yalnızca bunları okur.
+ * Okunamayan kaynağın kuralları o taramada değerlendirilmez, koşulları
+ * korunur. Aynı taramada tetiklenen CIKIS eylemleri IO16 ertelenmiş
+ * yazımıyla toplanır (atomic: ile aynı yol), tepki süresi çıkış çerçevesi
+ * dahil ölçülür.
+ *
+ * USART1 RX yoklamalı ve FIFO'suz (115200'de ~87 µs'de bir byte): tarama
+ * ms'de bir yapılır, komut satırı alınırken veya RX byte'ı beklerken
+ * atlanır. AIO20 okuması ≥250 µs olduğundan tarama başına tek port okunur
+ * (sırayla); diğer portların son değeri kullanılır. kural:on ve tablo
+ * yüklemesi (komut bağlamı) tüm portları bir kez okur.
+ */
+
+#include "stm32f10x.h"
+#include "stm32f10x_usart.h"
+#include "kural.h"
+#include "fpga.h"
+#include "hareket.h"
+#include "pid.h"
+#include "kuyruk.h"
+#include "disli.h"
+#include "referans.h"
+#include "16kanaldijital.h"
+#include "20kanalanalogio.h"
+#include "modul_algilama.h"
+#include "yukleme.h"
+#include "istatistik.h"
+#include "komut.h"
+#include "tick.h"
+#include "uart_helper.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SLOT_SAYISI         4
+#define AIO20_PORT_SAYISI   20
+#define ADC_MAX             4095
+
+typedef struct {
+    uint8_t tetik;
+    uint8_t t_slot;
+    uint8_t t_kanal;
+    uint8_t t_param;
+    uint16_t esik;
+    uint16_t hist;
+    uint8_t eylem;
+    uint8_t e_slot;
+    uint8_t e_kanal;
+    uint8_t e_param;
+    uint16_t deger;
+    uint8_t bayrak;
+    // Çalışma durumu
+    uint8_t kosul;
+    uint32_t sayac;
+    uint32_t tepki;
+} Kural;
+
+static Kural kurallar[KURAL_SAYISI];
+static uint8_t kural_sayisi = 0;
+static uint8_t etkin = 0;
+
+// Kaynak özeti (tablo yüklenince)
+static uint8_t io_maske;                    // Okunan IO16 slotları
+static uint16_t fpga_maske[SLOT_SAYISI];    // STATUS'u okunan kanallar
+static uint32_t adc_maske[SLOT_SAYISI];     // Okunan AIO20 portları
+
+// Tarama
+static uint16_t girisler[SLOT_SAYISI];
+static uint16_t adc[SLOT_SAYISI][AIO20_PORT_SAYISI];
+static uint8_t durumlar[SLOT_SAYISI][16];    // Kanal STATUS'ları
+static uint8_t blok[256];
+static uint8_t fpga_ilk[SLOT_SAYISI];
+static uint32_t adc_gecerli[SLOT_SAYISI];   // Son okuması başarılı portlar
+static uint8_t adc_sira;                    // Sıradaki port: slot * 20 + port
+static uint8_t okunan_io, okunan_fpga;
+static uint32_t son_ms = 0;
+static uint32_t onceki_bas = 0;
+static uint32_t bildirilecek = 0;
+static Kural_Bilgi sayac;
+
+// Yükleme
+static struct {
+    uint8_t aktif;
+    uint16_t boyut;
+    uint16_t yazilan;
+    uint32_t crc;
+    uint8_t veri[KURAL_TABLO_MAX];
+} yukleme;
+
+static uint16_t oku16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint8_t aio20_var(uint8_t slot) {
+    const Modul_Slot* s = Modul_GetSlot(slot);
+    return s && s->registered == MODUL_AIO20;
+}
+
+/**
+ * Tek kuralın alan sınırları
+ * @return 0: geçerli, -1: geçersiz
+ */
+static int kural_coz(const uint8_t* p, Kural* k) {
+    memset(k, 0, sizeof(*k));
+    k->tetik = p[0];
+    k->t_slot = p[1];
+    k->t_kanal = p[2];
+    k->t_param = p[3];
+    k->esik = oku16(&p[4]);
+    k->hist = oku16(&p[6]);
+    k->eylem = p[8];
+    k->e_slot = p[9];
+    k->e_kanal = p[10];
+    k->e_param = p[11];
+    k->deger = oku16(&p[12]);
+    k->bayrak = p[14];
+    
+    if (k->t_slot >= SLOT_SAYISI || k->e_slot >= SLOT_SAYISI ||
+        (k->bayrak & ~KURAL_BAYRAK_OLAY) || p[15] != 0) {
+        return -1;
+    }
+    
+    switch (k->tetik) {
+    case KURAL_TETIK_DIJITAL:
+        if (k->t_kanal > 15 || k->t_param > 1) {
+            return -1;
+        }
+        break;
+    case KURAL_TETIK_ANALOG_UST:
+    case KURAL_TETIK_ANALOG_ALT:
+        if (k->t_kanal >= AIO20_PORT_SAYISI || k->esik > ADC_MAX || k->hist > ADC_MAX) {
+            return -1;
+        }
+        break;
+    case KURAL_TETIK_MOTOR:
+        if (k->t_kanal > 15 || k->t_param == 0) {
+            return -1;
+        }
+        break;
+    default:
+        return -1;
+    }
+    
+    switch (k->eylem) {
+    case KURAL_EYLEM_CIKIS:
+        if (k->e_kanal > 15 || k->e_param > 1) {
+            return -1;
+        }
+        break;
+    case KURAL_EYLEM_DUR:
+    case KURAL_EYLEM_ACIL:
+        if (k->e_kanal > 15) {
+            return -1;
+        }
+        break;
+    case KURAL_EYLEM_HIZ:
+        if (k->e_kanal > 15 || k->deger < 1 || k->deger > 255 ||
+            (k->e_param != DIRECTION_FORWARD && k->e_param != DIRECTION_REVERSE)) {
+            return -1;
+        }
+        break;
+    default:
+        return -1;
+    }
+    return 0;
+}
+
+static void ozet_cikar(void) {
+    io_maske = 0;
+    memset(fpga_maske, 0, sizeof(fpga_maske));
+    memset(adc_maske, 0, sizeof(adc_maske));
+    
+    for (uint8_t i = 0; i < kural_sayisi; i++) {
+        const Kural* k = &kurallar[i];
+        switch (k->tetik) {
+        case KURAL_TETIK_DIJITAL:
+            io_maske |= (uint8_t)(1 << k->t_slot);
+            break;
+        case KURAL_TETIK_ANALOG_UST:
+        case KURAL_TETIK_ANALOG_ALT:
+            adc_maske[k->t_slot] |= 1UL << k->t_kanal;
+            break;
+        case KURAL_TETIK_MOTOR:
+            fpga_maske[k->t_slot] |= (uint16_t)(1 << k->t_kanal);
+            break;
+        }
+    }
+    
+    for (uint8_t slot = 0; slot < SLOT_SAYISI; slot++) {
+        uint8_t ilk = 0;
+        while (ilk < 15 && !(fpga_maske[slot] & (1 << ilk))) {
+            ilk++;
+        }
+        fpga_ilk[slot] = ilk;
+    }
+}
+
+/**
+ * AIO20 portunu oku; okunamazsa port geçersiz (koşulu değerlendirilmez)
+ */
+static void adc_oku(uint8_t slot, uint8_t port) {
+    int deger = aio20_var(slot) ? AIO20_ReadADC(slot, port) : -1;
+    
+    if (deger < 0) {
+        adc_gecerli[slot] &= ~(1UL << port);
+    } else {
+        adc[slot][port] = (uint16_t)deger;
+        adc_gecerli[slot] |= 1UL << port;
+    }
+}
+
+/**
+ * Kullanılan tüm portlar (komut bağlamı: kural:on, tablo yüklemesi)
+ */
+static void adc_hepsini_oku(void) {
+    for (uint8_t slot = 0; slot < SLOT_SAYISI; slot++) {
+        adc_gecerli[slot] = 0;
+        for (uint8_t port = 0; port < AIO20_PORT_SAYISI; port++) {
+            if (adc_maske[slot] & (1UL << port)) {
+                adc_oku(slot, port);
+            }
+        }
+    }
+}
+
+/**
+ * Sıradaki kullanılan port (tarama başına bir)
+ */
+static void adc_sonraki(void) {
+    for (uint8_t n = 0; n < SLOT_SAYISI * AIO20_PORT_SAYISI; n++) {
+        adc_sira = (uint8_t)((adc_sira + 1) % (SLOT_SAYISI * AIO20_PORT_SAYISI));
+        if (adc_maske[adc_sira / AIO20_PORT_SAYISI] & (1UL << (adc_sira % AIO20_PORT_SAYISI))) {
+            adc_oku(adc_sira / AIO20_PORT_SAYISI, adc_sira % AIO20_PORT_SAYISI);
+            return;
+        }
+    }
+}
+
+// ============================================================================
+// Yükleme
+// ============================================================================
+
+Kural_Sonuc Kural_Baslat(uint16_t boyut, uint32_t crc) {
+    if (boyut > KURAL_TABLO_MAX || boyut % KURAL_BOYU != 0) {
+        return KURAL_HATA_SIRA;
+    }
+    yukleme.aktif = 1;
+    yukleme.boyut = boyut;
+    yukleme.yazilan = 0;
+    yukleme.crc = crc;
+    return KURAL_OK;
+}
+
+Kural_Sonuc Kural_Parca(uint16_t ofset, const uint8_t* veri, uint16_t uzunluk) {
+    if (!yukleme.aktif || ofset != yukleme.yazilan ||
+        uzunluk > yukleme.boyut - yukleme.yazilan) {
+        return KURAL_HATA_SIRA;
+    }
+    memcpy(&yukleme.veri[ofset], veri, uzunluk);
+    yukleme.yazilan += uzunluk;
+    return KURAL_OK;
+}
+
+Kural_Sonuc Kural_Bitir(void) {
+    static Kural yeni[KURAL_SAYISI];
+    uint8_t n;
+    
+    if (!yukleme.aktif || yukleme.yazilan != yukleme.boyut) {
+        return KURAL_HATA_SIRA;
+    }
+    yukleme.aktif = 0;
+    if (Yukleme_Crc32(0, yukleme.veri, yukleme.boyut) != yukleme.crc) {
+        return KURAL_HATA_CRC;
+    }
+    
+    n = (uint8_t)(yukleme.boyut / KURAL_BOYU);
+    for (uint8_t i = 0; i < n; i++) {
+        if (kural_coz(&yukleme.veri[i * KURAL_BOYU], &yeni[i]) != 0) {
+            sayac.hatali_kural = i;
+            return KURAL_HATA_KURAL;
+        }
+    }
+    
+    // Çıkış eylemlerinin pinleri önceden çıkış yapılır (tarama yön yazmaz)
+    UART_QuietBegin();
+    for (uint8_t i = 0; i < n; i++) {
+        if (yeni[i].eylem == KURAL_EYLEM_CIKIS) {
+            IO16_EnsureOutput(yeni[i].e_slot, yeni[i].e_kanal);
+        }
+    }
+    UART_QuietEnd();
+    
+    memcpy(kurallar, yeni, sizeof(Kural) * n);
+    kural_sayisi = n;
+    bildirilecek = 0;
+    ozet_cikar();
+    if (etkin) {
+        adc_hepsini_oku();
+    }
+    return KURAL_OK;
+}
+
+void Kural_Etkin(uint8_t e) {
+    if (e && !etkin) {
+        for (uint8_t i = 0; i < kural_sayisi; i++) {
+            kurallar[i].kosul = 0;
+        }
+        onceki_bas = 0;
+        adc_hepsini_oku();
+    }
+    etkin = e ? 1 : 0;
+}
+
+void Kural_Oku(Kural_Bilgi* bilgi) {
+    *bilgi = sayac;
+    bilgi->etkin = etkin;
+    bilgi->sayi = kural_sayisi;
+}
+
+int Kural_DurumOku(uint8_t n, Kural_Durum* durum) {
+    if (n >= kural_sayisi) {
+        return -1;
+    }
+    durum->tetik = kurallar[n].tetik;
+    durum->eylem = kurallar[n].eylem;
+    durum->kosul = kurallar[n].kosul;
+    durum->sayac = kurallar[n].sayac;
+    durum->tepki = kurallar[n].tepki;
+    return 0;
+}
+
+void Kural_Sifirla(void) {
+    uint8_t hatali = sayac.hatali_kural;
+    memset(&sayac, 0, sizeof(sayac));
+    sayac.hatali_kural = hatali;
+    for (uint8_t i = 0; i < kural_sayisi; i++) {
+        kurallar[i].sayac = 0;
+        kurallar[i].tepki = 0;
+    }
+    onceki_bas = 0;
+}
+
+// ============================================================================
+// Tarama
+// ============================================================================
+
+static void kaynaklari_oku(void) {
+    okunan_io = 0;
+    okunan_fpga = 0;
+    
+    for (uint8_t slot = 0; slot < SLOT_SAYISI; slot++) {
+        if ((io_maske & (1 << slot)) && IO16_ReadInputs(slot, &girisler[slot]) == 0) {
+            okunan_io |= (uint8_t)(1 << slot);
+        }
+        
+        if (fpga_maske[slot]) {
+            uint8_t son = 15;
+            uint8_t adres = FPGA_MOTOR_REG_BASE(fpga_ilk[slot]) + REG_STATUS_FLAGS;
+            while (!(fpga_maske[slot] & (1 << son))) {
+                son--;
+            }
+            if (FPGA_ReadBlock(slot, adres, blok,
+                               FPGA_MOTOR_REG_BASE(son) + REG_STATUS_FLAGS + 1 - adres) == 0) {
+                for (uint8_t ch = fpga_ilk[slot]; ch <= son; ch++) {
+                    durumlar[slot][ch] = blok[FPGA_MOTOR_REG_BASE(ch) + REG_STATUS_FLAGS - adres];
+                }
+                okunan_fpga |= (uint8_t)(1 << slot);
+            }
+        }
+    }
+    
+    // Okumalar sürerken byte geldiyse ADC sonraki taramaya
+    if (USART_GetFlagStatus(USART1, USART_FLAG_RXNE) == RESET) {
+        adc_sonraki();
+    }
+}
+
+/**
+ * @return 1/0: koşul, -1: kaynak bu taramada okunamadı
+ */
+static int kosul_hesapla(const Kural* k) {
+    uint8_t bit = (uint8_t)(1 << k->t_slot);
+    int32_t x, esik = k->esik;
+    
+    switch (k->tetik) {
+    case KURAL_TETIK_DIJITAL:
+        if (!(okunan_io & bit)) {
+            return -1;
+        }
+        return ((girisler[k->t_slot] >> k->t_kanal) & 1) == k->t_param;
+    
+    case KURAL_TETIK_ANALOG_UST:
+    case KURAL_TETIK_ANALOG_ALT:
+        if (!(adc_gecerli[k->t_slot] & (1UL << k->t_kanal))) {
+            return -1;
+        }
+        x = adc[k->t_slot][k->t_kanal];
+        if (k->tetik == KURAL_TETIK_ANALOG_UST) {
+            return x >= (k->kosul ? esik - k->hist : esik);
+        }
+        return x <= (k->kosul ? esik + k->hist : esik);
+    
+    case KURAL_TETIK_MOTOR:
+        if (!(okunan_fpga & bit)) {
+            return -1;
+        }
+        return (durumlar[k->t_slot][k->t_kanal] & k->t_param) != 0;
+    }
+    return -1;
+}
+
+/**
+ * @return 0: başarılı, -1: hedef modül yok / yazılamadı
+ */
+static int eylem_uygula(const Kural* k, uint8_t* ertelenen) {
+    uint8_t slot = k->e_slot;
+    uint8_t ch = k->e_kanal;
+    uint8_t status;
+    
+    switch (k->eylem) {
+    case KURAL_EYLEM_CIKIS:
+        if (!*ertelenen) {
+            IO16_BeginDeferred();
+            *ertelenen = 1;
+        }
+        return IO16_ApplyOutputs(slot, (uint16_t)(1 << ch), (uint16_t)(k->e_param << ch));
+    
+    default:
+        break;
+    }
+    
+    if (FPGA_ReadRegister(slot, FPGA_MOTOR_REG_BASE(ch) + REG_STATUS_FLAGS, &status) != 0) {
+        return -1;
+    }
+    
+    // Servo tick'i ve kuyruk eksene yeniden yazmasın
+    Hareket_Iptal(slot, ch);
+    PID_Kapat(slot, ch);
+    Disli_Coz(slot, ch);
+    Referans_Iptal(slot, ch);
+    Kuyruk_Durdur(slot, ch);
+    
+    if (k->eylem == KURAL_EYLEM_ACIL) {
+        return FPGA_WriteRegister(slot, FPGA_MOTOR_REG_BASE(ch) + REG_CONTROL_FLAGS,
+                                  CTRL_FLAG_EMERGENCY_STOP);
+    } else if (k->eylem == KURAL_EYLEM_HIZ) {
+        FPGA_Motor_t motor = { slot, ch };
+        return FPGA_Motor_SetSpeedDirection(&motor, (uint8_t)k->deger, k->e_param);
+    }
+    return FPGA_WriteRegister(slot, FPGA_MOTOR_REG_BASE(ch) + REG_DIRECTION, DIRECTION_STOP);
+}
+
+static void bildir(void) {
+    char event[16];
+    char message[48];
+    
+    // Olay satırı yarım komut satırıyla karışmasın
+    if (!bildirilecek || !Komut_SatirBos()) {
+        return;
+    }
+    for (uint8_t i = 0; i < KURAL_SAYISI; i++) {
+        if (bildirilecek & (1UL << i)) {
+            sprintf(event, "kural:%u", i);
+            sprintf(message, "\r\n[KURAL] Kural %u tetiklendi\r\n", i);
+            UART_SendEvent(event, message);
+        }
+    }
+    bildirilecek = 0;
+}
+
+void Kural_Isle(void) {
+    uint32_t bas, son;
+    uint32_t tetiklenen = 0;
+    uint8_t ertelenen = 0;
+    
+    bildir();
+    if (!etkin || !kural_sayisi) {
+        return;
+    }
+    
+    // Satır alınırken tarama yok; ms'de bir
+    if (!Komut_SatirBos() || USART_GetFlagStatus(USART1, USART_FLAG_RXNE) != RESET ||
+        Tick_Ms() == son_ms) {
+        return;
+    }
+    son_ms = Tick_Ms();
+    
+    bas = Istatistik_Cycle();
+    if (onceki_bas != 0 && bas - onceki_bas > sayac.aralik_max) {
+        sayac.aralik_max = bas - onceki_bas;
+    }
+    onceki_bas = bas;
+    
+    kaynaklari_oku();
+    
+    for (uint8_t i = 0; i < kural_sayisi; i++) {
+        Kural* k = &kurallar[i];
+        int kosul = kosul_hesapla(k);
+        
+        if (kosul < 0) {
+            sayac.okuma_hatasi++;
+            continue;
+        }
+        if (kosul && !k->kosul) {
+            if (eylem_uygula(k, &ertelenen) != 0) {
+                sayac.eylem_hatasi++;
+            }
+            k->sayac++;
+            sayac.tetiklenen++;
+            tetiklenen |= 1UL << i;
+        }
+        k->kosul = (uint8_t)kosul;
+    }
+    
+    if (ertelenen && IO16_CommitDeferred() != 0) {
+        sayac.eylem_hatasi++;
+    }
+    
+    son = Istatistik_Cycle();
+    sayac.tarama++;
+    sayac.tarama_son = son - bas;
+    if (sayac.tarama_son > sayac.tarama_max) {
+        sayac.tarama_max = sayac.tarama_son;
+    }
+    
+    for (uint8_t i = 0; i < kural_sayisi; i++) {
+        if (tetiklenen & (1UL << i)) {
+            kurallar[i].tepki = son - bas;
+            if (kurallar[i].bayrak & KURAL_BAYRAK_OLAY) {
+                bildirilecek |= 1UL << i;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Komutlar
+// ============================================================================
+
+/**
+ * Hex dizisini byte'lara çevir
+ * @return byte sayısı, -1: geçersiz karakter / tek hane / taşma
+ */
+static int hex_coz(const char* hex, uint8_t* out, uint16_t max) {
+    uint16_t n = 0;
+    
+    while (hex[0] != '\0') {
+        uint8_t byte = 0;
+        for (uint8_t k = 0; k < 2; k++) {
+            char c = hex[k];
+            byte <<= 4;
+            if (c >= '0' && c <= '9') {
+                byte |= c - '0';
+            } else if (c >= 'a' && c <= 'f') {
+                byte |= c - 'a' + 10;
+            } else {
+                return -1;                  // Küçük harf: komut satırı küçültülür
+            }
+        }
+        if (n >= max) {
+            return -1;
+        }
+        out[n++] = byte;
+        hex += 2;
+    }
+    return n;
+}
+
+static void komut(const char* arg) {
+    char buf[128];
+    char* son = NULL;
+    
+    if (*arg == '\0') {
+        Kural_Bilgi b;
+        Kural_Oku(&b);
+        
+        // "<etkin> <kural> <tarama> <tetiklenen> <okuma hatası> <eylem hatası>
+        //  <tarama son> <tarama max> <aralık max>" (cycle, 72 = 1 µs)
+        sprintf(buf, "%u %u %lu %lu %lu %lu %lu %lu %lu", b.etkin, b.sayi,
+                (unsigned long)b.tarama, (unsigned long)b.tetiklenen,
+                (unsigned long)b.okuma_hatasi, (unsigned long)b.eylem_hatasi,
+                (unsigned long)b.tarama_son, (unsigned long)b.tarama_max,
+                (unsigned long)b.aralik_max);
+        UART_Reply(UART_ST_OK, buf);
+        
+        sprintf(buf, "Kurallar: %u, %s, %lu tarama, %lu tetiklenme\r\n", b.sayi,
+                b.etkin ? "acik" : "kapali", (unsigned long)b.tarama,
+                (unsigned long)b.tetiklenen);
+        UART_SendString(buf);
+        sprintf(buf, "  Tarama: son %lu, max %lu cycle; taramalar arasi max %lu us\r\n",
+                (unsigned long)b.tarama_son, (unsigned long)b.tarama_max,
+                (unsigned long)(b.aralik_max / 72));
+        UART_SendString(buf);
+        return;
+    }
+    
+    if (strcmp(arg, "on") == 0 || strcmp(arg, "off") == 0) {
+        Kural_Etkin(arg[1] == 'n');
+        UART_SendString(arg[1] == 'n' ? "Kurallar acik\r\n" : "Kurallar kapali\r\n");
+        UART_Reply(UART_ST_OK, NULL);
+        return;
+    }
+    
+    if (strcmp(arg, "reset") == 0) {
+        Kural_Sifirla();
+        UART_SendString("Kural sayaclari sifirlandi\r\n");
+        UART_Reply(UART_ST_OK, NULL);
+        return;
+    }
+    
+    if (strncmp(arg, "begin:", 6) == 0) {
+        unsigned long boyut = strtoul(arg + 6, &son, 0);
+        uint32_t crc;
+        
+        if (son == arg + 6 || *son != ':') {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (kural:begin:SIZE:CRC32)\r\n");
+            return;
+        }
+        arg = son + 1;
+        crc = strtoul(arg, &son, 0);
+        if (son == arg || *son != '\0') {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (kural:begin:SIZE:CRC32)\r\n");
+            return;
+        }
+        if (boyut > KURAL_TABLO_MAX || Kural_Baslat((uint16_t)boyut, crc) != KURAL_OK) {
+            UART_SendError(UART_ST_ARG, "Hata: Tablo boyutu 16'nın katı, en fazla 512 byte\r\n");
+            return;
+        }
+        UART_SendString("OK: Kural tablosu yukleme basladi\r\n");
+        UART_Reply(UART_ST_OK, NULL);
+        return;
+    }
+    
+    if (strncmp(arg, "data:", 5) == 0) {
+        uint8_t veri[KURAL_PARCA_MAX];
+        unsigned long ofset = strtoul(arg + 5, &son, 0);
+        int n;
+        
+        if (son == arg + 5 || *son != ':' || (n = hex_coz(son + 1, veri, sizeof(veri))) <= 0) {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (kural:data:OFFSET:HEX, en fazla 96 byte)\r\n");
+            return;
+        }
+        if (ofset > KURAL_TABLO_MAX ||
+            Kural_Parca((uint16_t)ofset, veri, (uint16_t)n) != KURAL_OK) {
+            UART_SendError(UART_ST_ARG, "Hata: Yükleme yok veya parça sırası/boyutu hatalı\r\n");
+            return;
+        }
+        sprintf(buf, "%lu", ofset + n);
+        UART_Reply(UART_ST_OK, buf);
+        return;
+    }
+    
+    if (strcmp(arg, "end") == 0) {
+        Kural_Sonuc sonuc = Kural_Bitir();
+        
+        if (sonuc == KURAL_HATA_CRC) {
+            UART_SendError(UART_ST_ARG, "Hata: CRC32 tutmuyor, tablo değişmedi\r\n");
+            return;
+        } else if (sonuc == KURAL_HATA_KURAL) {
+            Kural_Bilgi b;
+            Kural_Oku(&b);
+            sprintf(buf, "Hata: Kural %u geçersiz, tablo değişmedi\r\n", b.hatali_kural);
+            UART_SendError(UART_ST_ARG, buf);
+            return;
+        } else if (sonuc != KURAL_OK) {
+            UART_SendError(UART_ST_ARG, "Hata: Yükleme yok veya eksik\r\n");
+            return;
+        }
+        sprintf(buf, "%u", kural_sayisi);
+        UART_Reply(UART_ST_OK, buf);
+        sprintf(buf, "OK: %u kural yuklendi (%s)\r\n", kural_sayisi, etkin ? "acik" : "kapali");
+        UART_SendString(buf);
+        return;
+    }
+    
+    if (*arg >= '0' && *arg <= '9') {
+        unsigned long n = strtoul(arg, &son, 10);
+        Kural_Durum d;
+        
+        if (*son != '\0') {
+            UART_SendError(UART_ST_SYNTAX, "Hata: Format hatası (kural:N)\r\n");
+            return;
+        }
+        if (n >= KURAL_SAYISI || Kural_DurumOku((uint8_t)n, &d) != 0) {
+            UART_SendError(UART_ST_ARG, "Hata: Kural yok\r\n");
+            return;
+        }
+        
+        // "<tetik> <eylem> <koşul> <tetiklenme> <tepki cycle>"
+        sprintf(buf, "%u %u %u %lu %lu", d.tetik, d.eylem, d.kosul,
+                (unsigned long)d.sayac, (unsigned long)d.tepki);
+        UART_Reply(UART_ST_OK, buf);
+        sprintf(buf, "Kural %lu: tetik %u, eylem %u, kosul %u, %lu kez, son tepki %lu cycle\r\n",
+                n, d.tetik, d.eylem, d.kosul, (unsigned long)d.sayac, (unsigned long)d.tepki);
+        UART_SendString(buf);
+        return;
+    }
+    
+    UART_SendError(UART_ST_SYNTAX, "Hata: Bilinmeyen kural komutu\r\n");
+    UART_SendString("Kullanım:\r\n");
+    UART_SendString("  kural / kural:on / kural:off / kural:reset\r\n");
+    UART_SendString("  kural:begin:SIZE:CRC32\r\n");
+    UART_SendString("  kural:data:OFFSET:HEX\r\n");
+    UART_SendString("  kural:end\r\n");
+    UART_SendString("  kural:N\r\n");
+}
+
+void Kural_Komut_Isle(const char* arg) {
+    komut(arg);
+    UART_SendComplete("kural");
+}
@@ -0,0 +1,132 @@
+/**
+ * Burjuva Motor Controller - Kilitleme / Refleks Kuralları
+ *
+ * Host'un tarama + gidiş-dönüş gecikmesiyle uyguladığı "giriş olunca çıkış"
+ * kuralları firmware'de, ana döngüde ms'de bir değerlendirilir. Her
+ * kural bir tetik ve bir eylemdir; eylem koşul yanlıştan doğruya geçtiği
+ * taramada bir kez uygulanır:
+ *
+ *   DIJITAL      IO16 pini PARAM seviyesinde (1: yükselen, 0: düşen kenar)
+ *   ANALOG_UST   AIO20 portu >= ESIK; < ESIK - HIST olunca koşul düşer
+ *   ANALOG_ALT   AIO20 portu <= ESIK; > ESIK + HIST olunca koşul düşer
+ *   MOTOR        FPGA kanalının STATUS & PARAM (maske) != 0
+ *
+ *   CIKIS        IO16 pini = PARAM (aynı taramadaki çıkışlar slot başına
+ *                tek çerçeve)
+ *   DUR / ACIL   FPGA kanalı DIRECTION_STOP / EMERGENCY_STOP; profil, PID,
+ *                kuyruk, dişli ve referans araması bırakılır
+ *   HIZ          FPGA kanalı hız/yön modunda DEGER hızla PARAM yönünde
+ *
+ * Tablo yüklenince koşulu zaten doğru olan kural ilk taramada tetiklenir
+ * (kilitleme güvenli tarafta başlar). Kaynaklar tarama başına bir kez
+ * okunur: IO16 slot başına tek INPUT_A/B çerçevesi, FPGA slot başına
+ * kullanılan kanalların STATUS'larını kapsayan tek blok, AIO20'nin
+ * kullanılan portlarından sıradaki biri (N analog port: değer en fazla
+ * N ms eski). Komut satırı alınırken tarama yapılmaz.
+ *
+ * Tablo ikili, kural başına KURAL_BOYU byte (çok byte'lı alanlar little
+ * endian):
+ *
+ *   0  tetik tipi       1  tetik slot       2  tetik kanal/pin/port
+ *   3  tetik param      4  eşik (u16)       6  histerezis (u16)
+ *   8  eylem tipi       9  eylem slot       10 eylem kanal/pin/port
+ *   11 eylem param      12 eylem değer (u16)
+ *   14 bayrak (bit 0: "!kural:N" olayı)     15 ayrılmış (0)
+ *
+ * Komutlar:
+ *   kural                           Durum ve tarama süreleri
+ *   kural:on / kural:off            Değerlendirmeyi aç / kapat
+ *   kural:begin:SIZE:CRC32          Yükleme (SIZE = n * KURAL_BOYU)
+ *   kural:data:OFFSET:HEX           Sıradaki parça (en fazla 96 byte)
+ *   kural:end                       CRC ve kuralları doğrula, tabloyu değiştir
+ *   kural:N                         Kural N'nin durumu
+ *   kural:reset                     Sayaçları sıfırla
+ */
+
+#ifndef KURAL_H
+#define KURAL_H
+
+#include <stdint.h>
+
+#define KURAL_SAYISI            32
+#define KURAL_BOYU              16          // byte / kural
+#define KURAL_TABLO_MAX         (KURAL_SAYISI * KURAL_BOYU)
+#define KURAL_PARCA_MAX         96          // kural:data parçası (komut satırı 256)
+
+#define KURAL_BAYRAK_OLAY       0x01
+
+typedef enum {
+    KURAL_TETIK_DIJITAL = 1,
+    KURAL_TETIK_ANALOG_UST,
+    KURAL_TETIK_ANALOG_ALT,
+    KURAL_TETIK_MOTOR
+} Kural_Tetik;
+
+typedef enum {
+    KURAL_EYLEM_CIKIS = 1,
+    KURAL_EYLEM_DUR = 3,        // 2 ayrılmış: AIO20 sürücüsünde DAC kapalı
+    KURAL_EYLEM_ACIL,
+    KURAL_EYLEM_HIZ
+} Kural_Eylem;
+
+typedef enum {
+    KURAL_OK = 0,
+    KURAL_HATA_SIRA,            // Yükleme yok / parça sırası / boyut
+    KURAL_HATA_CRC,
+    KURAL_HATA_KURAL            // Geçersiz kural (Kural_Bilgi.hatali_kural)
+} Kural_Sonuc;
+
+typedef struct {
+    uint8_t etkin;
+    uint8_t sayi;               // Tablodaki kural
+    uint32_t tarama;
+    uint32_t tetiklenen;
+    uint32_t okuma_hatasi;
+    uint32_t eylem_hatasi;
+    uint32_t tarama_son;        // cycle
+    uint32_t tarama_max;
+    uint32_t aralik_max;        // İki tarama başı arası en uzun süre, cycle
+    uint8_t hatali_kural;       // Son KURAL_HATA_KURAL'daki kural
+} Kural_Bilgi;
+
+typedef struct {
+    uint8_t tetik;              // Kural_Tetik
+    uint8_t eylem;              // Kural_Eylem
+    uint8_t kosul;              // Son taramadaki koşul
+    uint32_t sayac;             // Tetiklenme
+    uint32_t tepki;             // Son tetiklenmede tarama başından eylem sonuna, cycle
+} Kural_Durum;
+
+/**
+ * Host yüklemesi: başlat / sıradaki parça / bitir. Yeni tablo yalnızca
+ * Kural_Bitir başarılıysa eskisinin yerine geçer
+ */
+Kural_Sonuc Kural_Baslat(uint16_t boyut, uint32_t crc);
+Kural_Sonuc Kural_Parca(uint16_t ofset, const uint8_t* veri, uint16_t uzunluk);
+Kural_Sonuc Kural_Bitir(void);
+
+/**
+ * Değerlendirmeyi aç / kapat (açılışta koşullar yanlıştan başlar)
+ */
+void Kural_Etkin(uint8_t etkin);
+
+void Kural_Oku(Kural_Bilgi* bilgi);
+
+/**
+ * @return 0: başarılı, -1: kural yok
+ */
+int Kural_DurumOku(uint8_t n, Kural_Durum* durum);
+
+void Kural_Sifirla(void);
+
+/**
+ * Ana döngüden: ms'de bir kaynakları oku, koşulları değerlendir
+ */
+void Kural_Isle(void);
+
+/**
+ * Process "kural[:...]" command
+ */
+void Kural_Komut_Isle(const char* arg);
+
+#endif // KURAL_H
@@ -0,0 +1,291 @@
+/**
+ * Burjuva Motor Controller - Eksen Başına Hareket Kuyruğu
+ *
+ * Her eksende sabit boyutlu halka (bas + adet); aktif segment seg[bas].
+ * Kuyruk_Isle ms'de bir, çalışan her eksen için STATUS..CURRENT_POS
+ * register'larını tek blok okur. Segment tablosu yalnızca ana döngüden
+ * değişir, kilit gerekmez.
+ */
+
+#include "kuyruk.h"
+#include "hareket.h"
+#include "pid.h"
+#include "darbe.h"
+#include "16kanaldijital.h"
+#include "fpga.h"
+#include "olay.h"
+#include "tick.h"
+#include <string.h>
+
+#define SLOT_SAYISI         4
+#define OKUMA_BOYU          (REG_CURRENT_POS_LOW - REG_STATUS_FLAGS + 1)
+
+typedef struct {
+    uint8_t used;
+    uint8_t slot;
+    uint8_t ch;
+    uint8_t durum;                      // Kuyruk_Durum
+    Kuyruk_Segment seg[KUYRUK_DERINLIK];
+    uint8_t bas;                        // Aktif / sıradaki segment
+    uint8_t adet;                       // Bekleyen segment (aktif dahil)
+    uint32_t varis_ms;                  // Bekleme başlangıcı
+    uint32_t tamamlanan;
+} Eksen_Kuyrugu;
+
+static Eksen_Kuyrugu kuyruklar[KUYRUK_EKSEN_SAYISI];
+static uint32_t son_ms = 0;
+
+static Eksen_Kuyrugu* kuyruk_bul(uint8_t slot, uint8_t ch) {
+    for (uint8_t i = 0; i < KUYRUK_EKSEN_SAYISI; i++) {
+        if (kuyruklar[i].used && kuyruklar[i].slot == slot && kuyruklar[i].ch == ch) {
+            return &kuyruklar[i];
+        }
+    }
+    return NULL;
+}
+
+static Eksen_Kuyrugu* kuyruk_al(uint8_t slot, uint8_t ch) {
+    Eksen_Kuyrugu* k = kuyruk_bul(slot, ch);
+    if (k) {
+        return k;
+    }
+    
+    // Boş kuyruklar yeniden kullanılabilir
+    for (uint8_t i = 0; i < KUYRUK_EKSEN_SAYISI; i++) {
+        k = &kuyruklar[i];
+        if (!k->used || (k->adet == 0 && k->durum == KUYRUK_BOS)) {
+            memset(k, 0, sizeof(*k));
+            k->slot = slot;
+            k->ch = ch;
+            k->used = 1;
+            return k;
+        }
+    }
+    return NULL;
+}
+
+static void durdur(Eksen_Kuyrugu* k) {
+    FPGA_Motor_t motor = { k->slot, k->ch };
+    
+    Hareket_Iptal(k->slot, k->ch);
+    PID_Kapat(k->slot, k->ch);
+    FPGA_Motor_Stop(&motor);
+    k->durum = KUYRUK_HATA;
+}
+
+static void segment_baslat(Eksen_Kuyrugu* k) {
+    const Kuyruk_Segment* s = &k->seg[k->bas];
+    
+    k->durum = KUYRUK_HAREKET;
+    if (s->hiz == 0) {
+        // Profilli: çalışan profil hızını koruyarak yeni hedefe döner
+        if (Hareket_Git(k->slot, k->ch, s->hedef) != 0) {
+            durdur(k);
+        }
+        return;
+    }
+    
+    FPGA_Motor_t motor = { k->slot, k->ch };
+    Hareket_Iptal(k->slot, k->ch);
+    PID_Kapat(k->slot, k->ch);
+    if (FPGA_Motor_GoToPosition(&motor, s->hedef, s->hiz) != 0) {
+        durdur(k);
+    }
+}
+
+static void tetikle(const Kuyruk_Segment* s) {
+    uint16_t bit;
+    
+    if (s->io_slot == KUYRUK_TETIK_YOK) {
+        return;
+    }
+    if (s->io_ms > 0) {
+        Darbe_Baslat(s->io_slot, s->io_pin, s->io_level, s->io_ms, 0, 1);
+    } else {
+        bit = (uint16_t)(1 << s->io_pin);
+        IO16_ApplyOutputs(s->io_slot, bit, s->io_level ? bit : 0);
+    }
+}
+
+static void ilerle(Eksen_Kuyrugu* k) {
+    k->bas = (uint8_t)((k->bas + 1) % KUYRUK_DERINLIK);
+    k->adet--;
+    k->tamamlanan++;
+    
+    if (k->adet > 0) {
+        segment_baslat(k);
+    } else {
+        k->durum = KUYRUK_BOS;
+    }
+}
+
+static int32_t konum_coz(const uint8_t* reg) {
+    int32_t pos = ((int32_t)reg[0] << 16) | ((int32_t)reg[1] << 8) | reg[2];
+    return (pos & 0x800000) ? pos - 0x1000000 : pos;
+}
+
+static uint8_t varis_kontrol(Eksen_Kuyrugu* k, uint8_t status, int32_t pos) {
+    const Kuyruk_Segment* s = &k->seg[k->bas];
+    Hareket_Bilgi bilgi;
+    int32_t fark = s->hedef - pos;
+    
+    if (fark < 0) {
+        fark = -fark;
+    }
+    
+    // Harmanlama: durmadan sonraki segmente geç
+    if (s->yaklasma > 0 && s->bekleme == 0 && k->adet > 1 && fark <= s->yaklasma) {
+        return 1;
+    }
+    if (fark > KUYRUK_VARIS_PENCERE) {
+        return 0;
+    }
+    
+    if (s->hiz == 0) {
+        if (Hareket_Oku(k->slot, k->ch, &bilgi) != 0 || bilgi.durum != HAREKET_BITTI) {
+            return 0;
+        }
+        // PID açıkken FPGA hız modunda, REACHED bayrağı güncellenmez
+        if (PID_Etkin(k->slot, k->ch)) {
+            return 1;
+        }
+    }
+    return (status & STATUS_FLAG_POSITION_REACHED) != 0;
+}
+
+static void eksen_isle(Eksen_Kuyrugu* k, uint32_t now) {
+    const Kuyruk_Segment* s = &k->seg[k->bas];
+    uint8_t reg[OKUMA_BOYU];
+    Hareket_Bilgi bilgi;
+    
+    if (k->durum == KUYRUK_BOS) {
+        segment_baslat(k);
+        return;
+    }
+    if (k->durum == KUYRUK_BEKLEME) {
+        if (now - k->varis_ms >= s->bekleme) {
+            ilerle(k);
+        }
+        return;
+    }
+    
+    // KUYRUK_HAREKET
+    if (FPGA_ReadBlock(k->slot, FPGA_MOTOR_REG_BASE(k->ch) + REG_STATUS_FLAGS,
+                       reg, OKUMA_BOYU) != 0) {
+        durdur(k);
+        return;
+    }
+    if (reg[0] & (STATUS_FLAG_ERROR | STATUS_FLAG_FAULT)) {
+        durdur(k);
+        return;
+    }
+    if (s->hiz == 0 && (Hareket_Oku(k->slot, k->ch, &bilgi) != 0 ||
+                        bilgi.durum == HAREKET_BOS)) {
+        durdur(k);                      // Profil dışarıdan iptal edildi
+        return;
+    }
+    
+    if (!varis_kontrol(k, reg[0], konum_coz(&reg[REG_CURRENT_POS_HIGH - REG_STATUS_FLAGS]))) {
+        return;
+    }
+    
+    tetikle(s);
+    if (s->bekleme > 0) {
+        k->varis_ms = now;
+        k->durum = KUYRUK_BEKLEME;
+    } else {
+        ilerle(k);
+    }
+}
+
+int Kuyruk_Ekle(uint8_t slot, uint8_t ch, const Kuyruk_Segment* seg) {
+    Eksen_Kuyrugu* k;
+    uint8_t status;
+    
+    if (slot >= SLOT_SAYISI || ch > 15 || !seg ||
+        seg->hedef < HAREKET_KONUM_MIN || seg->hedef > HAREKET_KONUM_MAX ||
+        seg->bekleme > DARBE_SURE_MAX || seg->io_ms > DARBE_SURE_MAX ||
+        (seg->io_slot != KUYRUK_TETIK_YOK && (seg->io_slot >= SLOT_SAYISI || seg->io_pin >= 16))) {
+        return -1;
+    }
+    if (FPGA_ReadRegister(slot, FPGA_MOTOR_REG_BASE(ch) + REG_STATUS_FLAGS, &status) != 0) {
+        return -1;
+    }
+    
+    k = kuyruk_al(slot, ch);
+    if (!k || k->adet >= KUYRUK_DERINLIK) {
+        return -2;
+    }
+    
+    k->seg[(k->bas + k->adet) % KUYRUK_DERINLIK] = *seg;
+    k->adet++;
+    
+    // Boş kuyruk hemen başlar; HATA'da qclear beklenir
+    if (k->adet == 1 && k->durum == KUYRUK_BOS) {
+        segment_baslat(k);
+    }
+    return 0;
+}
+
+void Kuyruk_Temizle(uint8_t slot, uint8_t ch) {
+    for (uint8_t i = 0; i < KUYRUK_EKSEN_SAYISI; i++) {
+        Eksen_Kuyrugu* k = &kuyruklar[i];
+        if (k->used && k->slot == slot && (ch == KUYRUK_TUM_KANALLAR || k->ch == ch)) {
+            k->adet = 0;
+            k->durum = KUYRUK_BOS;
+            k->tamamlanan = 0;
+        }
+    }
+}
+
+void Kuyruk_Durdur(uint8_t slot, uint8_t ch) {
+    Eksen_Kuyrugu* k = kuyruk_bul(slot, ch);
+    if (k && k->adet > 0) {
+        k->durum = KUYRUK_HATA;
+    }
+}
+
+void Kuyruk_Uyandir(uint8_t slot, uint16_t kanal_maske) {
+    uint32_t now = Tick_Ms();
+    
+    for (uint8_t i = 0; i < KUYRUK_EKSEN_SAYISI; i++) {
+        Eksen_Kuyrugu* k = &kuyruklar[i];
+        if (k->used && k->slot == slot && (kanal_maske & (1 << k->ch)) &&
+            k->adet > 0 && k->durum == KUYRUK_HAREKET) {
+            eksen_isle(k, now);
+        }
+    }
+}
+
+void Kuyruk_Oku(uint8_t slot, uint8_t ch, Kuyruk_Bilgi* bilgi) {
+    Eksen_Kuyrugu* k = kuyruk_bul(slot, ch);
+    
+    memset(bilgi, 0, sizeof(*bilgi));
+    if (!k) {
+        return;
+    }
+    bilgi->durum = k->durum;
+    bilgi->derinlik = k->adet;
+    bilgi->tamamlanan = k->tamamlanan;
+    if (k->adet > 0) {
+        bilgi->hedef = k->seg[k->bas].hedef;
+    }
+}
+
+void Kuyruk_Isle(void) {
+    uint32_t now = Tick_Ms();
+    
+    if (now == son_ms) {
+        return;
+    }
+    son_ms = now;
+    
+    for (uint8_t i = 0; i < KUYRUK_EKSEN_SAYISI; i++) {
+        Eksen_Kuyrugu* k = &kuyruklar[i];
+        // Kesmenin acil durdurduğu eksen Olay_Isle'de durdurulur
+        if (k->used && k->adet > 0 && k->durum != KUYRUK_HATA &&
+            !Olay_Durduruldu(k->slot, k->ch)) {
+            eksen_isle(k, now);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * Burjuva Motor Controller - Eksen Başına Hareket Kuyruğu
+ *
+ * Her eksen için segment halkası: hedef konum, hız, bekleme, yaklaşma
+ * yarıçapı ve IO16 tetiği. Kuyruk_Isle ana döngüden ms'de bir çağrılır;
+ * aktif segment FPGA POSITION_REACHED bildirdiğinde (profilli segmentte
+ * profil de bittiğinde) tetik uygulanır, bekleme süresi dolunca sonraki
+ * segment başlar. Host'un her nokta için yoklayıp goto göndermesi gerekmez.
+ *
+ * Segment hızı (REG_SPEED) 0 ise segment eksenin hareket profiliyle
+ * (hareket.h) yürür, aksi halde FPGA pozisyon döngüsüne goto yazılır.
+ *
+ * Harmanlama: yaklaşma yarıçapı verilen, beklemesiz ve ardında segment
+ * olan segmentte konum hedefe bu kadar yaklaşınca durmadan sonraki hedefe
+ * geçilir (profilli segmentte hız korunarak devralınır).
+ *
+ * Komutlar (fpga.c):
+ *   fpga:S:motor:CH:qadd:POS:SPEED[:DWELL[:BLEND[:IOSLOT:IOPIN:LEVEL[:MS]]]]
+ *   fpga:S:motor:CH:qstatus
+ *   fpga:S:motor:CH:qclear
+ */
+
+#ifndef KUYRUK_H
+#define KUYRUK_H
+
+#include <stdint.h>
+
+#define KUYRUK_EKSEN_SAYISI     8           // Kuyruk tutulan eksen (slot+kanal)
+#define KUYRUK_DERINLIK         16          // Eksen başına segment
+#define KUYRUK_VARIS_PENCERE    16          // count: eski hedefin REACHED bayrağına karşı
+#define KUYRUK_TETIK_YOK        0xFF        // io_slot: segmentte IO tetiği yok
+#define KUYRUK_TUM_KANALLAR     0xFF
+
+typedef enum {
+    KUYRUK_BOS = 0,         // Çalışan segment yok
+    KUYRUK_HAREKET,         // Aktif segment hedefe gidiyor
+    KUYRUK_BEKLEME,         // Hedefte, bekleme süresi sayılıyor
+    KUYRUK_HATA             // FPGA hatası / profil kayboldu: qclear'a kadar durur
+} Kuyruk_Durum;
+
+typedef struct {
+    int32_t hedef;          // count
+    uint16_t bekleme;       // ms, varıştan sonra
+    uint16_t yaklasma;      // count, 0: harmanlama yok
+    uint16_t io_ms;         // Tetik darbe süresi (0: seviye yazılır)
+    uint8_t hiz;            // REG_SPEED (0: profilli)
+    uint8_t io_slot;        // KUYRUK_TETIK_YOK: tetik yok
+    uint8_t io_pin;
+    uint8_t io_level;
+} Kuyruk_Segment;
+
+typedef struct {
+    uint8_t durum;          // Kuyruk_Durum
+    uint8_t derinlik;       // Bekleyen segment (aktif dahil)
+    uint32_t tamamlanan;    // qclear'dan beri biten segment
+    int32_t hedef;          // Aktif segmentin hedefi
+} Kuyruk_Bilgi;
+
+/**
+ * Segmenti kuyruğa ekle; kuyruk boşsa hemen başlar
+ * @return 0: başarılı, -1: geçersiz segment veya modül yok, -2: kuyruk/eksen tablosu dolu
+ */
+int Kuyruk_Ekle(uint8_t slot, uint8_t ch, const Kuyruk_Segment* seg);
+
+/**
+ * Segmentleri at (aktif segmentin hareketini durdurmaz: doğrudan motor
+ * komutları kendi değerlerini yazar). ch = KUYRUK_TUM_KANALLAR: slotun tümü
+ */
+void Kuyruk_Temizle(uint8_t slot, uint8_t ch);
+
+/**
+ * Eksen dışarıdan durduruldu (FPGA olayı): segmentler korunur, kuyruk
+ * qclear'a kadar hata durumunda kalır
+ */
+void Kuyruk_Durdur(uint8_t slot, uint8_t ch);
+
+/**
+ * Maskedeki kanalların varış kontrolünü ms beklemeden yap (FPGA INT
+ * POSITION_REACHED olayı) - ana döngüden
+ */
+void Kuyruk_Uyandir(uint8_t slot, uint16_t kanal_maske);
+
+/**
+ * Kuyruk durumu (kayıt yoksa boş kuyruk)
+ */
+void Kuyruk_Oku(uint8_t slot, uint8_t ch, Kuyruk_Bilgi* bilgi);
+
+/**
+ * Varış / bekleme kontrolü, segment geçişi - ana döngüden çağrılır
+ */
+void Kuyruk_Isle(void);
+
+#endif // KUYRUK_H
@@ -8,9 +8,13 @@
  * UART command processing firmware using Standard Peripheral Library (SPL)
  * - USART1: PA9 (TX), PA10 (RX)  
  * - Baud: 115200, 8N1, No flow control
- * - Echoes back any received data
+ * - Echoes back any received data (human mode)
+ * - "mode:machine" -> echo/ACK/açıklama yok, tek satır "=<kod> <değer>" yanıt
  * - Komutlar:
  *   - "modul-algila" -> Modül algılama sistemi
+ *   - "modul-izle:on|off" -> Hot-plug izleme ("!slot:<n>:<tip>" olayları)
+ *   - "cmd1;cmd2;..." -> Tek satırda çoklu komut (batch)
+ *   - "atomic:cmd1;cmd2" -> Batch, IO16 çıkışları tek taramada uygulanır
  * 
  * Pin Configuration:
  * - PA9  (USART1_TX) -> RPi GPIO15 (RXD)
@@ -24,27 +28,32 @@
 #include "stm32f10x_usart.h"
 #include "stm32f10x_flash.h"
 #include "modul_algilama.h"
-#include "16kanaldijital.h"
-#include "20kanalanalogio.h"
-#include "fpga.h"
 #include "spisurucu.h"
-#include <string.h>
+#include "uart_helper.h"
+#include "komut.h"
+#include "istatistik.h"
+#include "darbe.h"
+#include "servo.h"
+#include "kuyruk.h"
+#include "olay.h"
+#include "referans.h"
+#include "kural.h"
+#include "betik.h"
+#include "yukleme.h"
+#include "tick.h"
 
 /* Private function prototypes */
 void RCC_Configuration(void);
 void GPIO_Configuration(void);
 void USART1_Configuration(void);
 void Delay(__IO uint32_t nCount);
-void Process_Command(char* cmd);
 
 /**
  * @brief  Main program
  */
 int main(void)
 {
-    uint16_t rxData;
-    static char cmdBuffer[64];
-    static uint8_t cmdIndex = 0;
+    uint8_t rxData;
     
     /* Configure clocks */
     RCC_Configuration();
@@ -58,6 +67,24 @@ int main(void)
     /* Initialize SPI for module communication */
     SPI_Module_Init();
     
+    /* 1 ms SysTick time base (hot-plug polling) */
+    Tick_Init();
+    
+    /* DWT cycle counter and performance counters ("stats") */
+    Istatistik_Init();
+    
+    /* Slot 2 iCE40: CRESET/CDONE, bitstream from flash if not configured */
+    Yukleme_Init();
+    
+    /* IO16 timed outputs (pulse/train/after) on the SysTick timer wheel */
+    Darbe_Init();
+    
+    /* TIM2 1 kHz servo tick (FPGA axis motion profiles) */
+    Servo_Init();
+    
+    /* PB0 EXTI0: FPGA INT (slot 2 olayları) */
+    Olay_Init();
+    
     /* Initialize Module Detection System */
     Modul_Init();
     
@@ -69,168 +96,62 @@ int main(void)
                          "Komutlar:\r\n"
                          "  modul-algila  -> Modul algilama\r\n"
                          "========================================\r\n\r\n";
-    while (*welcome)
-    {
-        while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-        USART_SendData(USART1, *welcome++);
-    }
+    UART_SendString(welcome);
     
     /* Infinite loop - Process UART commands */
     while (1)
     {
+        /* Ana döngü tur süresi */
+        Istatistik_Dongu();
+        
         /* Check if data is received */
         if (USART_GetFlagStatus(USART1, USART_FLAG_RXNE) != RESET)
         {
-            /* Read received byte */
-            rxData = USART_ReceiveData(USART1);
-            
-            /* Echo it back */
-            while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-            USART_SendData(USART1, rxData);
-            
-            /* Toggle LED to show activity */
-            GPIO_WriteBit(GPIOC, GPIO_Pin_13, 
-                (BitAction)(1 - GPIO_ReadOutputDataBit(GPIOC, GPIO_Pin_13)));
-            
-            /* Process command on Enter (CR or LF) */
-            if (rxData == '\r' || rxData == '\n')
-            {
-                if (cmdIndex > 0)
-                {
-                    cmdBuffer[cmdIndex] = '\0';
-                    
-                    /* Echo newline */
-                    while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-                    USART_SendData(USART1, '\r');
-                    while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-                    USART_SendData(USART1, '\n');
-                    
-                    /* Process command */
-                    Process_Command(cmdBuffer);
-                    
-                    /* Reset buffer */
-                    cmdIndex = 0;
-                }
-            }
-            /* Backspace */
-            else if (rxData == 0x08 || rxData == 0x7F)
+            /* Önceki byte okunmadan yenisi geldi (SR + DR okuması ORE'yi temizler) */
+            if (USART_GetFlagStatus(USART1, USART_FLAG_ORE) != RESET)
             {
-                if (cmdIndex > 0)
-                {
-                    cmdIndex--;
-                    /* Echo backspace sequence: BS + SPACE + BS */
-                    while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-                    USART_SendData(USART1, ' ');
-                    while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-                    USART_SendData(USART1, 0x08);
-                }
+                Istatistik_RxTasma();
             }
-            /* Normal character */
-            else if (rxData >= 32 && rxData < 127)
+            
+            /* Read received byte */
+            rxData = (uint8_t)USART_ReceiveData(USART1);
+            
+            /* LED sadece human mode'da
+             * (PC13 aynı zamanda IO16 slot 0 CS hattı - machine mode'da dokunma) */
+            if (UART_GetMode() == UART_MODE_HUMAN)
             {
-                if (cmdIndex < sizeof(cmdBuffer) - 1)
-                {
-                    cmdBuffer[cmdIndex++] = rxData;
-                }
+                /* Toggle LED to show activity */
+                GPIO_WriteBit(GPIOC, GPIO_Pin_13, 
+                    (BitAction)(1 - GPIO_ReadOutputDataBit(GPIOC, GPIO_Pin_13)));
             }
+            
+            /* Echo, satır düzenleme ve komut çalıştırma */
+            Komut_RxByte(rxData);
         }
-    }
-}
-
-/**
- * @brief  Send ACK message
- */
-void Send_ACK(const char* cmd)
-{
-    const char* ack_prefix = "\r\n[ACK] Komut alindi: ";
-    const char* ack_suffix = "\r\n";
-    
-    /* Send ACK prefix */
-    while (*ack_prefix)
-    {
-        while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-        USART_SendData(USART1, *ack_prefix++);
-    }
-    
-    /* Send command name */
-    while (*cmd)
-    {
-        while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-        USART_SendData(USART1, *cmd++);
-    }
-    
-    /* Send suffix */
-    while (*ack_suffix)
-    {
-        while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-        USART_SendData(USART1, *ack_suffix++);
-    }
-}
-
-/**
- * @brief  Process received command
- */
-void Process_Command(char* cmd)
-{
-    /* Convert to lowercase for case-insensitive comparison */
-    char lowerCmd[64];
-    int i = 0;
-    while (cmd[i] && i < 63)
-    {
-        lowerCmd[i] = (cmd[i] >= 'A' && cmd[i] <= 'Z') ? (cmd[i] + 32) : cmd[i];
-        i++;
-    }
-    lowerCmd[i] = '\0';
-    
-    /* Process commands */
-    if (strcmp(lowerCmd, "modul-algila") == 0)
-    {
-        Send_ACK("modul-algila");
-        Modul_Komut_Isle();
-    }
-    else if (strncmp(lowerCmd, "io16:", 5) == 0)
-    {
-        Send_ACK("io16");
-        IO16_HandleCommand(lowerCmd + 5);  // "io16:" sonrasını gönder
-    }
-    else if (strncmp(lowerCmd, "aio20:", 6) == 0)
-    {
-        Send_ACK("aio20");
-        AIO20_HandleCommand(lowerCmd + 6);  // "aio20:" sonrasını gönder
-    }
-    else if (strncmp(lowerCmd, "fpga:", 5) == 0)
-    {
-        Send_ACK("fpga");
-        FPGA_HandleCommand(lowerCmd + 5);  // "fpga:" sonrasını gönder
-    }
-    else if (strcmp(lowerCmd, "help") == 0 || strcmp(lowerCmd, "yardim") == 0)
-    {
-        Send_ACK("help");
-        const char* help = "\r\nMevcut Komutlar:\r\n"
-                          "  modul-algila              -> Bagli modulleri tara\r\n"
-                          "  io16:SLOT:KOMUT           -> IO16 modul kontrolu\r\n"
-                          "  aio20:SLOT:KOMUT          -> AIO20 modul kontrolu\r\n"
-                          "  fpga:SLOT:KOMUT           -> FPGA modul kontrolu\r\n"
-                          "  help                      -> Bu yardim mesaji\r\n"
-                          "\r\n"
-                          "Ornek:\r\n"
-                          "  io16:0:set:5:high         -> Slot 0, Pin 5 = HIGH\r\n"
-                          "  aio20:1:readin:3          -> Slot 1, AI3 oku\r\n"
-                          "  fpga:2:status             -> Slot 2 durumu\r\n"
-                          "\r\n";
-        while (*help)
-        {
-            while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-            USART_SendData(USART1, *help++);
-        }
-    }
-    else
-    {
-        const char* unknown = "\r\nBilinmeyen komut! 'help' yazin.\r\n\r\n";
-        while (*unknown)
+        
+        /* Zamanı gelen IO16 darbe kenarları */
+        Darbe_Isle();
+        
+        /* Hareket kuyruğu: varış kontrolü ve segment geçişi */
+        Kuyruk_Isle();
+        
+        /* FPGA olaylarının durdurduğu eksenler, host bildirimi */
+        Olay_Isle();
+        
+        /* Referans araması: IO16 anahtar girişleri, eksen durum makineleri */
+        Referans_Isle();
+        
+        /* Kilitleme/refleks kuralları: kaynak okuma, koşul kenarında eylem */
+        Kural_Isle();
+        
+        /* Betik yorumlayıcı: tarama başına komut bütçesi */
+        Betik_Isle();
+        
+        /* Hot-plug izleme - sadece satır ortasında değilken (olay satırı
+         * yarım komutla karışmasın); RX byte'ı bekliyorsa yoklama atlanır */
+        if (Komut_SatirBos())
         {
-            while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-            USART_SendData(USART1, *unknown++);
+            Modul_Izle();
         }
     }
 }
@@ -7,6 +7,11 @@
  * - HID (Hardware ID - 0x00-0x07)
  * - FID (Firmware ID - 0x08-0x0F)
  * - 4 Slot: PC2(0), PC0(1), PC3(2), PC1(3)
+ * 
+ * Paralel algılama: 4 hat da GPIOC üzerinde olduğu için tüm slotlar aynı
+ * anda (lockstep) sürülür. BSRR/BRR ile tek yazımda 4 pin, IDR'den tek
+ * okumada 4 bit alınır. UID/HID/FID slot başına RAM'de tutulur; EEPROM
+ * sadece UID değiştiğinde tekrar okunur.
  */
 
 #include "stm32f10x.h"
@@ -16,176 +21,188 @@
 #include "16kanaldijital.h"
 #include "20kanalanalogio.h"
 #include "fpga.h"
+#include "uart_helper.h"
+#include "tick.h"
 #include <string.h>
+#include <stdio.h>
 
 // ========== Forward Declarations ==========
-static void UART_SendString(const char* str);
-static void UART_SendHex8(uint8_t val);
 static const char* get_module_type(uint8_t* hid, uint8_t* fid);
 
-// ========== DWT Delay (72MHz) ==========
-static inline uint32_t dwt_get_cycles(void) {
-    return *((volatile uint32_t*)0xE0001004);  // DWT_CYCCNT
+// ========== DWT Timing (72MHz) ==========
+#define DWT_CTRL            (*((volatile uint32_t*)0xE0001000))
+#define DWT_CYCCNT          (*((volatile uint32_t*)0xE0001004))
+#define DEMCR               (*((volatile uint32_t*)0xE000EDFC))
+
+#define CYCLES_PER_US       72
+
+// 0.1 µs birimindeki süreyi DWT cycle'a çevir (derleme zamanı sabiti)
+#define OW_CYCLES(t10)      ((uint32_t)(t10) * CYCLES_PER_US / 10)
+
+static inline void delay_cycles(uint32_t cycles) {
+    uint32_t start = DWT_CYCCNT;
+    while ((DWT_CYCCNT - start) < cycles);
 }
 
-static inline void delay_us(float us) {
-    uint32_t start = dwt_get_cycles();
-    uint32_t cycles = (uint32_t)(us * 72.0f);  // 72MHz = 72 cycles per μs
-    while ((dwt_get_cycles() - start) < cycles);
+// start noktasından itibaren cycles geçene kadar bekle
+static inline void wait_until(uint32_t start, uint32_t cycles) {
+    while ((DWT_CYCCNT - start) < cycles);
 }
 
 // ========== 1-Wire Timing ==========
-// OVERDRIVE SPEED - EXACT FROM module_detection_working.c (72MHz)
-#define DELAY_A 1.0      // Write 1 low time
-#define DELAY_B 7.5      // Write 1 release to end
-#define DELAY_C 7.5      // Write 0 low time
-#define DELAY_D 2.5      // Write 0 release to end
-#define DELAY_E 1.0      // Read sampling delay
-#define DELAY_F 7.0      // Read recovery time
-#define DELAY_H 70.0     // Reset pulse (Overdrive Speed)
-#define DELAY_I 8.5      // Presence detect sample delay
-#define DELAY_J 40.0     // Presence detect to next operation
-
-// OPTION 2: Overdrive Speed (uncomment if modules support overdrive)
-// #define DELAY_A 1.0
-// #define DELAY_B 7.5
-// #define DELAY_C 7.5
-// #define DELAY_D 2.5
-// #define DELAY_E 1.0
-// #define DELAY_F 7.0
-// #define DELAY_H 70.0
-// #define DELAY_I 8.5
-// #define DELAY_J 40.0
+// OVERDRIVE SPEED - module_detection_working.c değerleri, 0.1 µs biriminde
+#define DELAY_A 10       // Write 1 low time (1.0 µs)
+#define DELAY_B 75       // Write 1 release to end (7.5 µs)
+#define DELAY_C 75       // Write 0 low time (7.5 µs)
+#define DELAY_D 25       // Write 0 release to end (2.5 µs)
+#define DELAY_E 10       // Read sampling delay (1.0 µs)
+#define DELAY_F 70       // Read recovery time (7.0 µs)
+#define DELAY_H 700      // Reset pulse - Overdrive (70 µs)
+#define DELAY_I 85       // Presence detect sample delay (8.5 µs)
+#define DELAY_J 400      // Presence detect to next operation (40 µs)
 
 // ========== Module Slot Mapping (EXACT from module_detection_working.c) ==========
-static uint16_t module_to_pin(int module) {
-    if (module == 0) return GPIO_Pin_2;  // PC2 - Slot 0
-    if (module == 1) return GPIO_Pin_0;  // PC0 - Slot 1
-    if (module == 2) return GPIO_Pin_3;  // PC3 - Slot 2
-    return GPIO_Pin_1;                    // PC1 - Slot 3
-}
+static const uint16_t slot_pins[MODUL_SLOT_SAYISI] = {
+    GPIO_Pin_2,   // PC2 - Slot 0
+    GPIO_Pin_0,   // PC0 - Slot 1
+    GPIO_Pin_3,   // PC3 - Slot 2
+    GPIO_Pin_1    // PC1 - Slot 3
+};
 
-// ========== 1-Wire Pin Control (EXACT from module_detection_working.c) ==========
-static void set_pin_output(int module) {
-    GPIO_InitTypeDef pin;
-    GPIO_StructInit(&pin);  // Initialize with defaults
-    pin.GPIO_Pin = module_to_pin(module);
-    pin.GPIO_Speed = GPIO_Speed_50MHz;
-    pin.GPIO_Mode = GPIO_Mode_Out_OD;  // Open drain - CRITICAL!
-    GPIO_Init(GPIOC, &pin);
-    
-    // Set HIGH initially (internal pull-up assist)
-    GPIO_WriteBit(GPIOC, pin.GPIO_Pin, Bit_SET);
-}
+static const char* const slot_pin_names[MODUL_SLOT_SAYISI] = { "PC2", "PC0", "PC3", "PC1" };
 
-static void set_pin_input(int module) {
-    GPIO_InitTypeDef pin;
-    GPIO_StructInit(&pin);  // Initialize with defaults
-    pin.GPIO_Pin = module_to_pin(module);
-    pin.GPIO_Speed = GPIO_Speed_50MHz;
-    pin.GPIO_Mode = GPIO_Mode_IN_FLOATING;
-    GPIO_Init(GPIOC, &pin);
-}
+#define OW_ALL_PINS         (GPIO_Pin_0 | GPIO_Pin_1 | GPIO_Pin_2 | GPIO_Pin_3)
 
-static uint8_t read_bus(int module) {
-    return GPIO_ReadInputDataBit(GPIOC, module_to_pin(module));
+// IO16 chip init tekrar denemesi (iC-JX power-on sonrası birkaç deneme isteyebilir)
+// Tek çerçeve hataları 16kanaldijital.c işlem katmanında tekrarlanır; bu döngü
+// yalnızca chip'in power-on sonrası cevap vermeye başlamasını bekler
+#define IO16_INIT_TRIES     20
+#define IO16_INIT_RETRY_US  1000
+
+// Hot-plug izleme: periyodik presence kontrolü (tek lockstep reset ~120 µs)
+#define MODUL_IZLE_PERIYOT_MS   250
+
+// Slot başına kimlik önbelleği
+static Modul_Slot slots[MODUL_SLOT_SAYISI];
+
+static uint8_t izle_aktif = 1;
+static uint32_t izle_son_ms = 0;
+
+// ========== 1-Wire Lockstep Bus (EXACT timing from module_detection_working.c) ==========
+// Pinler Modul_Init'te bir kez open-drain çıkış olarak ayarlanır; ODR=1 hattı
+// bırakır (HIGH-Z), IDR open-drain modda da okunabilir. Bit başına GPIO_Init yok.
+
+static uint16_t slot_mask_to_pins(uint8_t slot_mask) {
+    uint16_t pins = 0;
+    for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+        if (slot_mask & (1 << slot)) {
+            pins |= slot_pins[slot];
+        }
+    }
+    return pins;
 }
 
-// ========== 1-Wire Protocol (EXACT from module_detection_working.c) ==========
+static uint8_t pins_to_slot_mask(uint16_t pins) {
+    uint8_t mask = 0;
+    for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+        if (pins & slot_pins[slot]) {
+            mask |= (1 << slot);
+        }
+    }
+    return mask;
+}
 
-// Reset pulse - returns 1 if device present
-static uint8_t onewire_reset(int module) {
-    uint8_t presence;
-    uint16_t pin = module_to_pin(module);
+// Reset pulse + presence örneği, sonraki işlem için DELAY_J beklenmez
+// (hot-plug yoklaması: blok süresi bir UART byte süresinin altında kalır)
+static uint8_t onewire_presence(uint8_t slot_mask) {
+    uint16_t pins = slot_mask_to_pins(slot_mask);
+    uint16_t idr;
     
-    set_pin_output(module);
+    // Drive LOW for reset pulse
+    GPIOC->BRR = pins;
+    delay_cycles(OW_CYCLES(DELAY_H));
     
-    // DEBUG: Check bus state BEFORE reset
-    uint8_t bus_before = (GPIOC->IDR & pin) ? 1 : 0;
+    // Release bus, sample presence pulse (slave pulls LOW)
+    __disable_irq();
+    GPIOC->BSRR = pins;
+    delay_cycles(OW_CYCLES(DELAY_I));
+    idr = GPIOC->IDR;
+    __enable_irq();
     
-    // Drive LOW for reset pulse
-    GPIO_WriteBit(GPIOC, pin, Bit_RESET);
-    delay_us(DELAY_H);
-    
-    // Release bus
-    GPIO_WriteBit(GPIOC, pin, Bit_SET);
-    delay_us(DELAY_I);
-    
-    // Sample presence pulse (slave pulls LOW)
-    uint8_t bus_after = (GPIOC->IDR & pin) ? 1 : 0;
-    presence = (GPIOC->IDR & pin) ? 0 : 1;  // LOW = device present
-    delay_us(DELAY_J);
-    
-    // DEBUG: Show bus levels
-    UART_SendString(" [BUS:before=");
-    UART_SendHex8(bus_before);
-    UART_SendString(",after=");
-    UART_SendHex8(bus_after);
-    UART_SendString(",presence=");
-    UART_SendHex8(presence);
-    UART_SendString("]");
-    
-    return presence;
+    return pins_to_slot_mask(~idr & pins);  // LOW = device present
 }
 
-// Write bit (EXACT - stay in OUTPUT mode)
-static void onewire_write_bit(int module, uint8_t bit) {
-    uint16_t pin = module_to_pin(module);
-    
-    set_pin_output(module);
+// Reset pulse - seçili slotlarda aynı anda, presence olan slot maskesini döndürür
+static uint8_t onewire_reset(uint8_t slot_mask) {
+    uint8_t present = onewire_presence(slot_mask);
     
+    delay_cycles(OW_CYCLES(DELAY_J));
+    return present;
+}
+
+// Write bit - tüm seçili hatlara aynı bit
+static void onewire_write_bit(uint16_t pins, uint8_t bit) {
+    __disable_irq();
+    GPIOC->BRR = pins;
     if (bit) {
         // Write 1: SHORT pulse LOW, then release
-        GPIO_WriteBit(GPIOC, pin, Bit_RESET);
-        delay_us(DELAY_A);
-        GPIO_WriteBit(GPIOC, pin, Bit_SET);  // Release (HIGH in open-drain = HIGH-Z)
-        delay_us(DELAY_B);
+        delay_cycles(OW_CYCLES(DELAY_A));
+        GPIOC->BSRR = pins;
+        __enable_irq();
+        delay_cycles(OW_CYCLES(DELAY_B));
     } else {
         // Write 0: LONG pulse LOW
-        GPIO_WriteBit(GPIOC, pin, Bit_RESET);
-        delay_us(DELAY_C);
-        GPIO_WriteBit(GPIOC, pin, Bit_SET);  // Release
-        delay_us(DELAY_D);
+        delay_cycles(OW_CYCLES(DELAY_C));
+        GPIOC->BSRR = pins;
+        __enable_irq();
+        delay_cycles(OW_CYCLES(DELAY_D));
     }
 }
 
-// Read bit (CRITICAL: stay in OUTPUT mode!)
-static uint8_t onewire_read_bit(int module) {
-    uint8_t bit;
-    uint16_t pin = module_to_pin(module);
-    
-    // Drive LOW
-    set_pin_output(module);
-    GPIO_WriteBit(GPIOC, pin, Bit_RESET);
-    delay_us(DELAY_A);
-    
-    // Release bus (write HIGH in open-drain = HIGH-Z)
-    GPIO_WriteBit(GPIOC, pin, Bit_SET);
-    // DON'T switch to input! Stay in output mode with HIGH
-    delay_us(DELAY_E);
-    
-    // Sample bus (read from IDR register directly)
-    bit = (GPIOC->IDR & pin) ? 1 : 0;
-    delay_us(DELAY_F);
-    
-    return bit;
+// Read bit slot - tek IDR okuması ile tüm hatların biti
+static uint16_t onewire_read_bits(uint16_t pins) {
+    uint16_t idr;
+    
+    __disable_irq();
+    GPIOC->BRR = pins;
+    delay_cycles(OW_CYCLES(DELAY_A));
+    GPIOC->BSRR = pins;
+    delay_cycles(OW_CYCLES(DELAY_E));
+    idr = GPIOC->IDR;
+    __enable_irq();
+    
+    return idr;
 }
 
 // Write byte LSB first
-static void onewire_write_byte(int module, uint8_t byte) {
+static void onewire_write_byte(uint8_t slot_mask, uint8_t byte) {
+    uint16_t pins = slot_mask_to_pins(slot_mask);
     for (int i = 0; i < 8; i++) {
-        onewire_write_bit(module, (byte >> i) & 0x01);
+        onewire_write_bit(pins, (byte >> i) & 0x01);
     }
 }
 
-// Read byte LSB first
-static uint8_t onewire_read_byte(int module) {
-    uint8_t byte = 0;
-    for (int i = 0; i < 8; i++) {
-        if (onewire_read_bit(module))
-            byte |= (1 << i);
+// Read len bytes LSB first; out[slot][i] - her slot kendi byte dizisini alır
+static void onewire_read_bytes(uint8_t slot_mask, uint8_t out[][16], int len) {
+    uint16_t pins = slot_mask_to_pins(slot_mask);
+    
+    for (int i = 0; i < len; i++) {
+        for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+            out[slot][i] = 0;
+        }
+        for (int b = 0; b < 8; b++) {
+            uint16_t idr = onewire_read_bits(pins);
+            uint32_t sampled = DWT_CYCCNT;
+            
+            // Recovery süresi içinde bitleri slotlara dağıt
+            for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+                if (idr & slot_pins[slot]) {
+                    out[slot][i] |= (1 << b);
+                }
+            }
+            wait_until(sampled, OW_CYCLES(DELAY_F));
+        }
     }
-    return byte;
 }
 
 // CRC8 calculation
@@ -203,22 +220,6 @@ static uint8_t crc8(uint8_t *data, int len) {
     return crc;
 }
 
-// ========== UART Helper Functions ==========
-static void UART_SendString(const char* str) {
-    while (*str) {
-        while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-        USART_SendData(USART1, *str++);
-    }
-}
-
-static void UART_SendHex8(uint8_t val) {
-    const char hex[] = "0123456789ABCDEF";
-    while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-    USART_SendData(USART1, hex[val >> 4]);
-    while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-    USART_SendData(USART1, hex[val & 0x0F]);
-}
-
 // ========== Module Type Detection ==========
 /**
  * Identify module type based on FID ASCII string
@@ -364,240 +365,360 @@ static const char* get_module_type(uint8_t* hid, uint8_t* fid) {
     return "UNKNOWN - Unrecognized Module";
 }
 
-// ========== Module Detection Functions (EXACT from module_detection_working.c) ==========
 
-// Read 1-Wire ROM (8 bytes: family + serial + CRC)
-static uint8_t read_module_uid(int module, uint8_t *uid) {
-    uint8_t presence = onewire_reset(module);
+
+/**
+ * 8 byte'lık EEPROM alanını yazdırılabilir ASCII olarak gönder
+ */
+static void send_ascii8(const uint8_t* data, uint8_t mark_nonprintable) {
+    char text[9];
+    uint8_t n = 0;
+    for (int i = 0; i < 8; i++) {
+        if (data[i] >= 0x20 && data[i] <= 0x7E) {  // Printable ASCII
+            text[n++] = data[i];
+        } else if (data[i] == 0x00) {
+            break;  // Null terminator
+        } else if (mark_nonprintable) {
+            text[n++] = '.';  // Non-printable
+        }
+    }
+    text[n] = '\0';
+    UART_SendString(text);
+}
+
+
+// ========== Module Detection Functions ==========
+
+/**
+ * FID/HID ASCII önekinden handler tipini bul
+ */
+static Modul_Tip classify_module(const uint8_t* hid, const uint8_t* fid) {
+    if (strncmp((const char*)fid, "io16", 4) == 0 || strncmp((const char*)hid, "io16", 4) == 0) {
+        return MODUL_IO16;
+    }
+    if (strncmp((const char*)fid, "aio20", 5) == 0 || strncmp((const char*)hid, "aio20", 5) == 0) {
+        return MODUL_AIO20;
+    }
+    if (strncmp((const char*)fid, "fpga", 4) == 0 || strncmp((const char*)hid, "fpga", 4) == 0) {
+        return MODUL_FPGA;
+    }
+    return MODUL_BILINMEYEN;
+}
+
+static const char* module_kind_name(Modul_Tip type) {
+    switch (type) {
+        case MODUL_IO16:  return "io16";
+        case MODUL_AIO20: return "aio20";
+        case MODUL_FPGA:  return "fpga";
+        case MODUL_BILINMEYEN: return "?";
+        default: return "-";
+    }
+}
+
+// Read 1-Wire ROM (8 bytes: family + serial + CRC) - tüm slotlarda aynı anda
+// *presence: presence pulse veren slotlar
+// Returns: geçerli CRC'li UID okunan slot maskesi
+static uint8_t read_module_uids(uint8_t rom[][16], uint8_t* presence) {
+    uint8_t all = (1 << MODUL_SLOT_SAYISI) - 1;
+    uint8_t present = onewire_reset(all);
+    uint8_t valid = 0;
+    
+    *presence = present;
+    if (!present)
+        return 0;  // No device
     
-    // DEBUG: Show presence detection
-    UART_SendString(" [RESET:");
-    if (presence) {
-        UART_SendString("OK");
-    } else {
-        UART_SendString("NO_DEVICE");
+    onewire_write_byte(present, 0x33);  // READ ROM command
+    onewire_read_bytes(present, rom, 8);
+    
+    // Verify CRC (family 0x00 = hat LOW'da takılı, geçersiz)
+    for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+        if ((present & (1 << slot)) && rom[slot][0] != 0x00 &&
+            crc8(rom[slot], 7) == rom[slot][7]) {
+            valid |= (1 << slot);
+        }
     }
-    UART_SendString("]");
+    return valid;
+}
+
+// Read EEPROM memory 0x00-0x0F (HID + FID tek okumada) - seçili slotlarda aynı anda
+// Returns: okuma yapılan slot maskesi
+static uint8_t read_module_memory(uint8_t slot_mask, uint8_t mem[][16]) {
+    uint8_t present = onewire_reset(slot_mask);
+    if (!present)
+        return 0;
     
-    if (!presence)
-        return 0;  // No device
+    onewire_write_byte(present, 0xCC);  // SKIP ROM
+    onewire_write_byte(present, 0xF0);  // READ MEMORY
+    onewire_write_byte(present, 0x00);  // Address
+    onewire_write_byte(present, 0x00);  // Address high byte
+    onewire_read_bytes(present, mem, 16);
     
-    onewire_write_byte(module, 0x33);  // READ ROM command
+    onewire_reset(present);
+    return present;
+}
+
+/**
+ * IO16 chip init (iC-JX power-on sonrası birkaç deneme isteyebilir)
+ * Init'in SPI debug çıktısı bastırılır, süre DWT ile ölçülür
+ */
+static void init_io16(uint8_t slot, Modul_Slot* s) {
+    uint32_t start = DWT_CYCCNT;
+    int status = -1;
+    uint8_t tries = 0;
+    
+    UART_QuietBegin();
+    while (status != 0 && tries < IO16_INIT_TRIES) {
+        if (tries > 0) {
+            delay_cycles(IO16_INIT_RETRY_US * CYCLES_PER_US);
+        }
+        status = IO16_ChipInit(slot);
+        tries++;
+    }
+    UART_QuietEnd();
     
-    for (int i = 0; i < 8; i++) {
-        uid[i] = onewire_read_byte(module);
+    s->init_status = (status == 0) ? 0 : -1;
+    s->init_tries = tries;
+    s->init_us = (DWT_CYCCNT - start) / CYCLES_PER_US;
+}
+
+/**
+ * Tek slot için özet satırı
+ */
+static void report_slot(uint8_t slot, uint8_t changed) {
+    const Modul_Slot* s = &slots[slot];
+    char line[48];
+    
+    UART_SendString("Slot ");
+    UART_SendHex8(slot);
+    UART_SendString(" (");
+    UART_SendString(slot_pin_names[slot]);
+    UART_SendString("): ");
+    
+    if (!s->present) {
+        UART_SendString("EMPTY\r\n");
+        return;
     }
     
-    // DEBUG: Show raw UID
-    UART_SendString(" RAW:");
+    UART_SendString(module_kind_name(s->type));
+    UART_SendString(changed ? " [NEW]" : " [CACHED]");
+    UART_SendString("\r\n  UID: ");
     for (int i = 0; i < 8; i++) {
-        UART_SendHex8(uid[i]);
+        UART_SendHex8(s->uid[i]);
         UART_SendString(" ");
     }
-    
-    // Verify CRC
-    uint8_t crc = crc8(uid, 7);
-    UART_SendString("CRC:calc=");
-    UART_SendHex8(crc);
-    UART_SendString(" read=");
-    UART_SendHex8(uid[7]);
-    
-    return (crc == uid[7]) ? 1 : 0;
+    UART_SendString("\r\n  NAME: ");
+    send_ascii8(s->fid, 0);
+    UART_SendString("  TYPE: ");
+    UART_SendString(get_module_type((uint8_t*)s->hid, (uint8_t*)s->fid));
+    UART_SendString("\r\n");
+    
+    if (s->type == MODUL_IO16) {
+        sprintf(line, "  INIT: %s (%u tries, %lu us)\r\n",
+                s->init_status == 0 ? "OK" : "FAILED",
+                (unsigned)s->init_tries, (unsigned long)s->init_us);
+        UART_SendString(line);
+    }
 }
 
-// Read EEPROM memory
-static uint8_t read_module_memory(int module, uint8_t addr, uint8_t *data, int len) {
-    if (!onewire_reset(module))
-        return 0;
+/**
+ * Handler kaydını slot tipiyle eşitle (kayıt / kayıt silme)
+ */
+static void sync_registration(uint8_t slot, Modul_Slot* s) {
+    Modul_Tip want = s->present ? s->type : MODUL_YOK;
     
-    onewire_write_byte(module, 0xCC);  // SKIP ROM
-    onewire_write_byte(module, 0xF0);  // READ MEMORY
-    onewire_write_byte(module, addr);  // Address
-    onewire_write_byte(module, 0x00);  // Address high byte
+    if (want == s->registered) {
+        return;
+    }
     
-    for (int i = 0; i < len; i++) {
-        data[i] = onewire_read_byte(module);
+    if (s->registered == MODUL_IO16) {
+        IO16_Unregister(slot);
+    } else if (s->registered == MODUL_AIO20) {
+        AIO20_Unregister(slot);
+    } else if (s->registered == MODUL_FPGA) {
+        FPGA_Unregister(slot);
     }
     
-    onewire_reset(module);
-    return 1;
+    if (want == MODUL_IO16) {
+        IO16_Register(slot);
+    } else if (want == MODUL_AIO20) {
+        AIO20_Register(slot);
+    } else if (want == MODUL_FPGA) {
+        FPGA_Register(slot);
+    }
+    s->registered = want;
 }
 
 /**
- * Scan all 4 module slots with detailed debug info
+ * Slot değişikliği olayı: "!slot:<n>:<tip>" (çıkarılınca tip "-")
  */
-static void scan_modules(void) {
-    uint8_t uid[8];
-    uint8_t hid[8];
-    uint8_t fid[8];
-    
-    UART_SendString("\r\n========================================\r\n");
-    UART_SendString("  BURJUVA MODULE DETECTION\r\n");
-    UART_SendString("========================================\r\n");
-    UART_SendString("Protocol: 1-Wire OVERDRIVE SPEED\r\n");
-    UART_SendString("Reset Pulse: 70us (Overdrive)\r\n");
-    UART_SendString("Slots: PC2(0), PC0(1), PC3(2), PC1(3)\r\n");
-    UART_SendString("Clock: 72MHz (HSE + PLL)\r\n");
-    UART_SendString("DWT: 72 cycles/us\r\n");
-    UART_SendString("========================================\r\n\r\n");
-    
-    // Check DWT status
-    uint32_t dwt_ctrl = *((volatile uint32_t*)0xE0001000);
-    UART_SendString("DWT_CTRL: ");
-    UART_SendHex8((dwt_ctrl >> 0) & 0xFF);
-    UART_SendString(" ");
-    UART_SendHex8((dwt_ctrl >> 8) & 0xFF);
-    UART_SendString(" ");
-    UART_SendHex8((dwt_ctrl >> 16) & 0xFF);
-    UART_SendString(" ");
-    UART_SendHex8((dwt_ctrl >> 24) & 0xFF);
-    UART_SendString("\r\n\r\n");
-    
-    for (int slot = 0; slot < 4; slot++) {
-        UART_SendString("Slot ");
-        UART_SendHex8(slot);
-        UART_SendString(" (PC");
-        if (slot == 0) UART_SendString("2");
-        else if (slot == 1) UART_SendString("0");
-        else if (slot == 2) UART_SendString("3");
-        else UART_SendString("1");
-        UART_SendString("):");
+static void notify_slot(uint8_t slot) {
+    const Modul_Slot* s = &slots[slot];
+    const char* kind = s->present ? module_kind_name(s->type) : "-";
+    char event[24];
+    char message[64];
+    
+    sprintf(event, "slot:%u:%s", (unsigned)slot, kind);
+    if (s->present) {
+        sprintf(message, "\r\n[HOTPLUG] Slot %02X (%s): %s takildi\r\n",
+                (unsigned)slot, slot_pin_names[slot], kind);
+    } else {
+        sprintf(message, "\r\n[HOTPLUG] Slot %02X (%s): modul cikarildi\r\n",
+                (unsigned)slot, slot_pin_names[slot]);
+    }
+    UART_SendEvent(event, message);
+}
+
+/**
+ * Scan all 4 module slots in lockstep
+ * EEPROM sadece UID'si değişen slotlarda okunur
+ * notify: durumu değişen slotlar için asenkron olay gönder
+ */
+static uint8_t scan_slots(uint8_t verbose, uint8_t notify) {
+    uint8_t rom[MODUL_SLOT_SAYISI][16];
+    uint8_t mem[MODUL_SLOT_SAYISI][16];
+    uint8_t presence, valid, changed = 0, read_ok = 0, found = 0;
+    uint32_t start = DWT_CYCCNT;
+    char line[48];
+    
+    valid = read_module_uids(rom, &presence);
+    
+    for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+        if ((valid & (1 << slot)) && memcmp(rom[slot], slots[slot].uid, 8) != 0) {
+            changed |= (1 << slot);
+        }
+    }
+    
+    // Sadece yeni/değişen modüllerin HID+FID'i okunur
+    if (changed) {
+        read_ok = read_module_memory(changed, mem);
+    }
+    
+    for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+        Modul_Slot* s = &slots[slot];
+        uint8_t bit = (1 << slot);
+        uint8_t was_present = s->present;
+        Modul_Tip was_type = s->type;
         
-        // Try to read UID with debug info
-        if (read_module_uid(slot, uid)) {
-            UART_SendString(" -> FOUND!\r\n");
-            
-            // Show UID (ROM - 8 bytes)
-            UART_SendString("  UID: ");
-            for (int i = 0; i < 8; i++) {
-                UART_SendHex8(uid[i]);
-                UART_SendString(" ");
-            }
-            
-            // Show 1-Wire device family
-            UART_SendString("(Family: ");
-            UART_SendHex8(uid[0]);
-            if (uid[0] == 0x2B) UART_SendString("=DS2431");
-            else if (uid[0] == 0x0D) UART_SendString("=Unknown-0D");
-            else UART_SendString("=Unknown");
-            UART_SendString(")\r\n");
-            
-            // Read HID (Hardware ID - 0x00-0x07)
-            if (read_module_memory(slot, 0x00, hid, 8)) {
-                UART_SendString("  HID: ");
-                for (int i = 0; i < 8; i++) {
-                    UART_SendHex8(hid[i]);
-                    UART_SendString(" ");
-                }
-                UART_SendString("\r\n");
-            } else {
-                UART_SendString("  HID: Read FAILED\r\n");
-            }
-            
-            // Read FID (Firmware ID - 0x08-0x0F)
-            if (read_module_memory(slot, 0x08, fid, 8)) {
-                UART_SendString("  FID: ");
-                for (int i = 0; i < 8; i++) {
-                    UART_SendHex8(fid[i]);
-                    UART_SendString(" ");
-                }
-                UART_SendString("\r\n");
-            } else {
-                UART_SendString("  FID: Read FAILED\r\n");
-            }
-            
-            // Show module type description (from HID mapping)
-            const char* module_type = get_module_type(hid, fid);
-            UART_SendString("  TYPE: ");
-            UART_SendString(module_type);
-            UART_SendString("\r\n");
-            
-            // Show FID as ASCII string (module name from EEPROM)
-            UART_SendString("  NAME: ");
-            for (int i = 0; i < 8; i++) {
-                if (fid[i] >= 0x20 && fid[i] <= 0x7E) {  // Printable ASCII
-                    while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-                    USART_SendData(USART1, fid[i]);
-                } else if (fid[i] == 0x00) {
-                    break;  // Null terminator
-                }
-            }
-            UART_SendString("\r\n");
-            
-            // DEBUG: Show HID as ASCII too (for unprogrammed modules)
-            UART_SendString("  HID_ASCII: ");
-            for (int i = 0; i < 8; i++) {
-                if (hid[i] >= 0x20 && hid[i] <= 0x7E) {  // Printable ASCII
-                    while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
-                    USART_SendData(USART1, hid[i]);
-                } else if (hid[i] == 0x00) {
-                    break;  // Null terminator
-                } else {
-                    UART_SendString(".");  // Non-printable
-                }
-            }
-            UART_SendString("\r\n");
-            
-            // Show CON number (slot-based connection number)
-            UART_SendString("  CON: CON");
-            UART_SendHex8(slot);
-            UART_SendString(" (Connector ");
-            UART_SendHex8(slot);
-            UART_SendString(")\r\n");
-            
-            // Register module to its handler
-            if (strncmp((char*)fid, "io16", 4) == 0 || strncmp((char*)hid, "io16", 4) == 0) {
-                IO16_Register(slot);
-                UART_SendString("  [REGISTERED] IO16 module at slot ");
-                UART_SendHex8(slot);
-                UART_SendString("\r\n");
-                
-                // CRITICAL: Retry init like mevcut-sistem (up to 100 tries with 10ms delay)
-                // iC-JX may need multiple attempts after power-on
-                UART_SendString("  [INIT] Initializing IO678 chip (with retry)...\r\n");
-                int init_status = -1;
-                int tries = 0;
-                while (init_status != 0 && tries < 100) {
-                    if (tries > 0) {
-                        for (volatile int d = 0; d < 80000; d++);  // ~10ms delay at 8MHz
-                    }
-                    init_status = IO16_ChipInit(slot);
-                    tries++;
-                }
-                
-                if (init_status == 0) {
-                    UART_SendString("  [SUCCESS] IO16 chip initialized after ");
-                    UART_SendHex8(tries);
-                    UART_SendString(" tries!\r\n");
-                } else {
-                    UART_SendString("  [ERROR] IO16 chip initialization FAILED after 100 tries!\r\n");
-                }
-            }
-            else if (strncmp((char*)fid, "aio20", 5) == 0 || strncmp((char*)hid, "aio20", 5) == 0) {
-                AIO20_Register(slot);
-                UART_SendString("  [REGISTERED] AIO20 module at slot ");
-                UART_SendHex8(slot);
-                UART_SendString("\r\n");
-            }
-            else if (strncmp((char*)fid, "fpga", 4) == 0 || strncmp((char*)hid, "fpga", 4) == 0) {
-                FPGA_Register(slot);
-                UART_SendString("  [REGISTERED] FPGA module at slot ");
-                UART_SendHex8(slot);
-                UART_SendString("\r\n");
-            }
-            
-            UART_SendString("\r\n");
+        if (!(presence & bit)) {
+            // Presence yok: modül çıkarıldı. UID önbellekte kalır,
+            // aynı modül geri takılırsa EEPROM tekrar okunmaz
+            s->present = 0;
+        } else if (!(valid & bit) || ((changed & bit) && !(read_ok & bit))) {
+            // Presence var ama ROM CRC / EEPROM okuması bozuk:
+            // önceki durum korunur, sonraki taramada tekrar denenir
         } else {
-            UART_SendString(" -> EMPTY\r\n\r\n");
+            if (changed & bit) {
+                memcpy(s->uid, rom[slot], 8);
+                memcpy(s->hid, &mem[slot][0], 8);
+                memcpy(s->fid, &mem[slot][8], 8);
+                s->type = classify_module(s->hid, s->fid);
+            }
+            s->present = 1;
+        }
+        
+        if (s->present) {
+            found++;
         }
         
-        // Small delay between slots (100ms at 8MHz)
-        for (volatile int d = 0; d < 800000; d++);
+        sync_registration(slot, s);
+        
+        // Yeni takılan (ya da geri takılan) IO16 chip'i tekrar init edilir
+        if (s->present && s->type == MODUL_IO16 && ((changed & read_ok & bit) || !was_present)) {
+            init_io16(slot, s);
+        } else if (s->type != MODUL_IO16) {
+            s->init_status = 0;
+            s->init_tries = 0;
+            s->init_us = 0;
+        }
+        
+        if (notify && (s->present != was_present || (s->present && s->type != was_type) ||
+                       (changed & read_ok & bit))) {
+            notify_slot(slot);
+        }
+    }
+    
+    if (verbose) {
+        UART_SendString("\r\n========================================\r\n");
+        UART_SendString("  BURJUVA MODULE DETECTION\r\n");
+        UART_SendString("========================================\r\n");
+        for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+            report_slot(slot, (changed & read_ok) & (1 << slot));
+        }
+        sprintf(line, "Scan Complete: %u module(s), %lu us\r\n",
+                (unsigned)found, (unsigned long)((DWT_CYCCNT - start) / CYCLES_PER_US));
+        UART_SendString("========================================\r\n");
+        UART_SendString(line);
+        UART_SendString("========================================\r\n\r\n");
+    }
+    
+    return found;
+}
+
+uint8_t Modul_Tara(uint8_t verbose) {
+    return scan_slots(verbose, 0);
+}
+
+/**
+ * Hot-plug izleme (ana döngüden, komut satırı boşken çağrılır)
+ * Her periyotta tek lockstep reset ile presence maskesi alınır; sadece
+ * önbellekteki maskeden farklıysa UID okunur ve değişen slotlar bildirilir
+ *
+ * USART1 RX yoklamalı ve FIFO'suz: bekleyen byte varken yoklama başlamaz,
+ * başladıktan sonra gelen byte'ın ardılı (~87 µs @115200) yoklama
+ * (~78 µs, DELAY_J'siz) bitmeden tamamlanmaz
+ */
+void Modul_Izle(void) {
+    uint8_t all = (1 << MODUL_SLOT_SAYISI) - 1;
+    uint8_t cached = 0;
+    
+    if (!izle_aktif) {
+        return;
+    }
+    
+    for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+        if (slots[slot].present) {
+            cached |= (1 << slot);
+        }
+    }
+    
+    // Periyot tüketilmeden: byte okununca sonraki turda yeniden denenir
+    if (USART_GetFlagStatus(USART1, USART_FLAG_RXNE) != RESET ||
+        !Tick_Elapsed(&izle_son_ms, MODUL_IZLE_PERIYOT_MS)) {
+        return;
+    }
+    
+    if (onewire_presence(all) != cached) {
+        delay_cycles(OW_CYCLES(DELAY_J));
+        scan_slots(0, 1);
+    }
+}
+
+/**
+ * "modul-izle[:on|off]" command handler
+ */
+void Modul_Izle_Komut(const char* arg) {
+    if (strcmp(arg, "on") == 0) {
+        izle_aktif = 1;
+    } else if (strcmp(arg, "off") == 0) {
+        izle_aktif = 0;
+    } else if (*arg) {
+        UART_SendError(UART_ST_ARG, "Hata: modul-izle:on veya modul-izle:off\r\n");
+        return;
     }
     
-    UART_SendString("========================================\r\n");
-    UART_SendString("Scan Complete!\r\n");
-    UART_SendString("========================================\r\n\r\n");
+    UART_SendString(izle_aktif ? "Hot-plug izleme: acik\r\n" : "Hot-plug izleme: kapali\r\n");
+    UART_Reply(UART_ST_OK, izle_aktif ? "on" : "off");
+    UART_SendComplete("modul-izle");
+}
+
+/**
+ * Son taramadaki slot bilgisi
+ */
+const Modul_Slot* Modul_GetSlot(uint8_t slot) {
+    if (slot >= MODUL_SLOT_SAYISI) {
+        return NULL;
+    }
+    return &slots[slot];
 }
 
 /**
@@ -605,30 +726,165 @@ static void scan_modules(void) {
  */
 void Modul_Init(void) {
     // Enable DWT cycle counter for precise timing (CRITICAL for 1-Wire!)
-    *((volatile uint32_t*)0xE000EDFC) |= (1 << 24);  // DEMCR |= DEMCR_TRCENA
-    *((volatile uint32_t*)0xE0001004) = 0;           // DWT_CYCCNT = 0
-    *((volatile uint32_t*)0xE0001000) |= 1;          // DWT_CTRL |= CYCCNTENA
-    
-    // Initialize GPIO for 1-Wire pins (PC0, PC1, PC2, PC3)
-    GPIO_InitTypeDef inputs;
-    GPIO_StructInit(&inputs);  // Initialize with defaults (EXACT from module_detection_working.c)
-    inputs.GPIO_Pin = GPIO_Pin_0 | GPIO_Pin_1 | GPIO_Pin_2 | GPIO_Pin_3;
-    inputs.GPIO_Speed = GPIO_Speed_50MHz;
-    inputs.GPIO_Mode = GPIO_Mode_IN_FLOATING;
-    GPIO_Init(GPIOC, &inputs);
-    
-    // Debug: Send init message
+    DEMCR |= (1 << 24);     // DEMCR_TRCENA
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= 1;          // CYCCNTENA
+    
+    // 1-Wire pinleri (PC0-PC3) bir kez open-drain çıkış olarak ayarlanır
+    // Önce ODR=1: hat init sırasında LOW'a çekilmez
+    GPIOC->BSRR = OW_ALL_PINS;
+    
+    GPIO_InitTypeDef pins;
+    GPIO_StructInit(&pins);
+    pins.GPIO_Pin = OW_ALL_PINS;
+    pins.GPIO_Speed = GPIO_Speed_50MHz;
+    pins.GPIO_Mode = GPIO_Mode_Out_OD;  // Open drain - CRITICAL!
+    GPIO_Init(GPIOC, &pins);
+    
+    memset(slots, 0, sizeof(slots));
+    
+    // Açılışta sessiz tarama: modüller komut beklemeden kullanıma hazır
+    uint32_t start = DWT_CYCCNT;
+    uint8_t found = Modul_Tara(0);
+    char line[48];
+    
     UART_SendString("\r\n[INIT] Module detection system initialized\r\n");
-    UART_SendString("[INIT] DWT cycle counter enabled\r\n");
-    UART_SendString("[INIT] 1-Wire GPIO configured (PC0, PC1, PC2, PC3)\r\n");
-    UART_SendString("[INIT] Clock: 72MHz (HSE + PLL x9)\r\n");
-    UART_SendString("[INIT] Timing: Overdrive Speed (70us reset)\r\n\r\n");
+    UART_SendString("[INIT] 1-Wire GPIO configured (PC0, PC1, PC2, PC3), lockstep scan\r\n");
+    sprintf(line, "[INIT] %u module(s) ready in %lu us\r\n",
+            (unsigned)found, (unsigned long)((DWT_CYCCNT - start) / CYCLES_PER_US));
+    UART_SendString(line);
+}
+
+// Binary rapor çerçevesi: [B5][versiyon][slot sayısı] + 4 x 32 byte kayıt + CRC8
+#define RAPOR_MAGIC         0xB5
+#define RAPOR_VERSIYON      1
+#define RAPOR_KAYIT_BOYUTU  32
+#define RAPOR_CERCEVE_BOYUTU (3 + MODUL_SLOT_SAYISI * RAPOR_KAYIT_BOYUTU + 1)
+
+static void hex8_append(char* out, const uint8_t* data) {
+    static const char hex[] = "0123456789ABCDEF";
+    for (int i = 0; i < 8; i++) {
+        *out++ = hex[data[i] >> 4];
+        *out++ = hex[data[i] & 0x0F];
+    }
+    *out = '\0';
 }
 
 /**
- * "modul-algila" command handler
+ * Tek slot kaydı (metin): "<slot> <tip> <uid> <hid> <fid> <init> <init_us>"
+ * Boş slot: "<slot> 0"
  */
-void Modul_Komut_Isle(void) {
-    scan_modules();
-    UART_SendString("Komut tamamlandi: modul-algila\r\n\r\n");
+static void format_record(uint8_t slot, char* out) {
+    const Modul_Slot* s = &slots[slot];
+    char uid[17], hid[17], fid[17];
+    
+    if (!s->present) {
+        sprintf(out, "%u 0", (unsigned)slot);
+        return;
+    }
+    hex8_append(uid, s->uid);
+    hex8_append(hid, s->hid);
+    hex8_append(fid, s->fid);
+    sprintf(out, "%u %u %s %s %s %d %lu", (unsigned)slot, (unsigned)s->type,
+            uid, hid, fid, (int)s->init_status, (unsigned long)s->init_us);
+}
+
+/**
+ * Binary rapor çerçevesi (kayıt: slot, tip, init_status, init_tries,
+ * uid[8], hid[8], fid[8], init_us little-endian)
+ */
+static uint16_t build_frame(uint8_t* frame) {
+    uint16_t n = 0;
+    
+    frame[n++] = RAPOR_MAGIC;
+    frame[n++] = RAPOR_VERSIYON;
+    frame[n++] = MODUL_SLOT_SAYISI;
+    
+    for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+        const Modul_Slot* s = &slots[slot];
+        uint8_t* r = &frame[n];
+        
+        memset(r, 0, RAPOR_KAYIT_BOYUTU);
+        r[0] = slot;
+        if (s->present) {
+            r[1] = (uint8_t)s->type;
+            r[2] = (uint8_t)s->init_status;
+            r[3] = s->init_tries;
+            memcpy(&r[4], s->uid, 8);
+            memcpy(&r[12], s->hid, 8);
+            memcpy(&r[20], s->fid, 8);
+            r[28] = (uint8_t)(s->init_us);
+            r[29] = (uint8_t)(s->init_us >> 8);
+            r[30] = (uint8_t)(s->init_us >> 16);
+            r[31] = (uint8_t)(s->init_us >> 24);
+        }
+        n += RAPOR_KAYIT_BOYUTU;
+    }
+    
+    frame[n] = crc8(frame, n);
+    return n + 1;
+}
+
+/**
+ * "modul-algila[:rapor|:bin]" command handler
+ * - (arg yok) açıklamalı tarama, machine mode: "io16,aio20,-,fpga"
+ * - rapor: slot başına tek kayıt, machine mode: kayıtlar '|' ile tek satırda
+ * - bin:   "=0 bin <n>" satırı ve ardından n byte'lık çerçeve (sadece machine mode)
+ */
+void Modul_Komut_Isle(const char* arg) {
+    if (*arg == '\0') {
+        char summary[32];
+        
+        Modul_Tara(1);
+        
+        // Machine mode: slot 0-3 modül tipleri ("io16,aio20,-,fpga")
+        summary[0] = '\0';
+        for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+            if (slot > 0) {
+                strcat(summary, ",");
+            }
+            strcat(summary, slots[slot].present ? module_kind_name(slots[slot].type) : "-");
+        }
+        UART_Reply(UART_ST_OK, summary);
+    }
+    else if (strcmp(arg, "rapor") == 0) {
+        char report[MODUL_SLOT_SAYISI * 72];
+        char* p = report;
+        
+        Modul_Tara(0);
+        
+        for (int slot = 0; slot < MODUL_SLOT_SAYISI; slot++) {
+            if (slot > 0) {
+                *p++ = '|';
+            }
+            format_record(slot, p);
+            UART_SendString("MODUL ");
+            UART_SendString(p);
+            UART_SendString("\r\n");
+            p += strlen(p);
+        }
+        UART_Reply(UART_ST_OK, report);
+    }
+    else if (strcmp(arg, "bin") == 0) {
+        uint8_t frame[RAPOR_CERCEVE_BOYUTU];
+        char header[12];
+        
+        // Binary çerçeve terminale basılmaz, batch satırına da girmez
+        if (UART_GetMode() != UART_MODE_MACHINE || UART_InBatch()) {
+            UART_SendError(UART_ST_ARG, "Hata: modul-algila:bin sadece machine mode'da, tek komut olarak\r\n");
+            return;
+        }
+        
+        Modul_Tara(0);
+        
+        uint16_t len = build_frame(frame);
+        sprintf(header, "bin %u", (unsigned)len);
+        UART_Reply(UART_ST_OK, header);
+        UART_SendBytes(frame, len);
+    }
+    else {
+        UART_SendError(UART_ST_ARG, "Hata: modul-algila[:rapor|:bin]\r\n");
+        return;
+    }
+    UART_SendComplete("modul-algila");
 }
@@ -3,6 +3,7 @@
  * Date: 17 Kasım 2025
  * 
  * REAL 1-Wire module detection based on module_detection_working.c
+ * 4 slot paralel (lockstep) taranır, kimlikler slot başına önbelleklenir.
  */
 
 #ifndef MODUL_ALGILAMA_H
@@ -10,16 +11,65 @@
 
 #include "stm32f10x.h"
 
+#define MODUL_SLOT_SAYISI   4
+
+// Slotta tanınan modül tipi
+typedef enum {
+    MODUL_YOK = 0,          // Slot boş
+    MODUL_IO16,
+    MODUL_AIO20,
+    MODUL_FPGA,
+    MODUL_BILINMEYEN        // 1-Wire cevap verdi ama FID/HID tanınmadı
+} Modul_Tip;
+
+// Slot başına önbelleklenmiş kimlik (son taramadan)
+typedef struct {
+    uint8_t present;        // Son taramada presence + geçerli ROM CRC
+    uint8_t uid[8];         // 1-Wire ROM (family + serial + CRC)
+    uint8_t hid[8];         // EEPROM 0x00-0x07
+    uint8_t fid[8];         // EEPROM 0x08-0x0F
+    Modul_Tip type;
+    Modul_Tip registered;   // Handler'a kaydedilen tip (tekrar kayıt önlenir)
+    int8_t init_status;     // IO16_ChipInit sonucu (0 = OK), diğer tipler 0
+    uint8_t init_tries;
+    uint32_t init_us;       // Chip init süresi (µs)
+} Modul_Slot;
+
 /**
  * Initialize module detection system (DWT + GPIO)
- * Call once at startup
+ * Call once at startup - modülleri sessizce tarar ve kaydeder
  */
 void Modul_Init(void);
 
 /**
- * Process "modul-algila" command
+ * 4 slotu paralel tara, UID'si değişen slotlarda EEPROM'u oku ve kaydet
+ * verbose: 1 ise slot başına özet satırı basar
+ * Returns: bulunan modül sayısı
+ */
+uint8_t Modul_Tara(uint8_t verbose);
+
+/**
+ * Son taramadaki slot bilgisi (slot >= 4 ise NULL)
+ */
+const Modul_Slot* Modul_GetSlot(uint8_t slot);
+
+/**
+ * Hot-plug izleme - ana döngüden sık çağrılır, kendi periyodunu SysTick ile tutar
+ * Slot değişiminde modülü yeniden tanır/init eder, çıkarılanı kayıttan siler
+ * ve "!slot:<n>:<tip>" olayı gönderir
+ */
+void Modul_Izle(void);
+
+/**
+ * Process "modul-izle[:on|off]" command
+ */
+void Modul_Izle_Komut(const char* arg);
+
+/**
+ * Process "modul-algila[:rapor|:bin]" command
  * Scans all 4 slots and reports results
+ * rapor/bin: slot başına tek kayıt (UID, HID, FID, tip, init durumu/süresi)
  */
-void Modul_Komut_Isle(void);
+void Modul_Komut_Isle(const char* arg);
 
 #endif // MODUL_ALGILAMA_H
@@ -0,0 +1,280 @@
+/**
+ * Burjuva Motor Controller - FPGA INT Olayları
+ *
+ * EXTI0 düşen kenar: kesme girişinde PR temizlenir, bekleyen özet boşalana
+ * kadar (en fazla OLAY_TUR_MAX tur) okunur; işlenirken gelen yeni olay
+ * INT'i düşük tuttuğundan ikinci bir kenar oluşmaz, kayıp olmaz. Özet
+ * OLAY_TUR_MAX turda boşalmazsa veya olay FPGA kaydından önce geldiyse INT
+ * düşük kalır ve kenar oluşmaz: kesme kendini EXTI->SWIER ile yeniden
+ * tetikler, Olay_Yokla ana döngüde (ms'de bir) ve FPGA kaydında hattı
+ * yoklar.
+ *
+ * Durdurma kesmede EMERGENCY_STOP yazımıdır: servo tick'i yalnızca hedef,
+ * hız ve yön yazar, CONTROL_FLAGS'e dokunmaz; FPGA acil durda kalır.
+ * Ana döngüdeki temizlik (profil, PID, kuyruk) yeniden hareketi engeller.
+ */
+
+#include "stm32f10x.h"
+#include "stm32f10x_rcc.h"
+#include "olay.h"
+#include "fpga.h"
+#include "hareket.h"
+#include "pid.h"
+#include "kuyruk.h"
+#include "disli.h"
+#include "referans.h"
+#include "komut.h"
+#include "istatistik.h"
+#include "tick.h"
+#include "uart_helper.h"
+#include <string.h>
+#include <stdio.h>
+
+#define FPGA_INT_HAT        (1UL << 0)      // EXTI0 <- PB0
+#define OLAY_ONCELIK        0               // Servo tick'inden (1) yüksek
+#define OLAY_TUR_MAX        4
+#define DURDURMA_OLAYLARI   (STATUS_FLAG_FAULT | STATUS_FLAG_TIMEOUT | STATUS_FLAG_OTW)
+
+static Olay_Sayac sayac;
+static uint16_t bagli[16];
+
+// Kesme -> ana döngü
+static volatile uint16_t durdurulan;        // Temizlenecek kanallar
+static volatile uint16_t varilan;           // Kuyruk varış kontrolü
+static volatile uint16_t bagli_durdu;       // Bağlı olduğu için durdurulan
+static volatile uint16_t bildirilecek;      // Host bildirimi bekleyen kanallar
+static volatile uint8_t bildirim[16];       // Kanalın kendi olay bitleri
+static uint32_t yokla_ms;
+
+static uint8_t int_dusuk(void) {
+    return GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_0) == Bit_RESET;
+}
+
+void Olay_Init(void) {
+    GPIO_InitTypeDef gpio;
+    
+    memset(&sayac, 0, sizeof(sayac));
+    
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB | RCC_APB2Periph_AFIO, ENABLE);
+    
+    // INT açık-drain, aktif LOW
+    gpio.GPIO_Pin = GPIO_Pin_0;
+    gpio.GPIO_Speed = GPIO_Speed_2MHz;
+    gpio.GPIO_Mode = GPIO_Mode_IPU;
+    GPIO_Init(GPIOB, &gpio);
+    
+    AFIO->EXTICR[0] = (AFIO->EXTICR[0] & ~0x000FUL) | AFIO_EXTICR1_EXTI0_PB;
+    EXTI->RTSR &= ~FPGA_INT_HAT;
+    EXTI->FTSR |= FPGA_INT_HAT;
+    EXTI->PR = FPGA_INT_HAT;
+    EXTI->IMR |= FPGA_INT_HAT;
+    
+    NVIC_SetPriority(EXTI0_IRQn, OLAY_ONCELIK);
+    NVIC_EnableIRQ(EXTI0_IRQn);
+}
+
+int Olay_Bagla(uint8_t ch, uint16_t maske) {
+    if (ch > 15) {
+        return -1;
+    }
+    
+    NVIC_DisableIRQ(EXTI0_IRQn);
+    bagli[ch] = maske;
+    NVIC_EnableIRQ(EXTI0_IRQn);
+    return 0;
+}
+
+uint16_t Olay_Bagli(uint8_t ch) {
+    return (ch <= 15) ? bagli[ch] : 0;
+}
+
+void Olay_Oku(Olay_Sayac* s) {
+    NVIC_DisableIRQ(EXTI0_IRQn);
+    *s = sayac;
+    NVIC_EnableIRQ(EXTI0_IRQn);
+}
+
+void Olay_Sifirla(void) {
+    NVIC_DisableIRQ(EXTI0_IRQn);
+    memset(&sayac, 0, sizeof(sayac));
+    NVIC_EnableIRQ(EXTI0_IRQn);
+}
+
+// ============================================================================
+// Kesme
+// ============================================================================
+
+static void kanal_isle(uint8_t ch, uint32_t start) {
+    uint8_t base = FPGA_MOTOR_REG_BASE(ch);
+    uint8_t olay;
+    uint16_t durdur;
+    uint32_t tepki;
+    
+    if (FPGA_ReadRegister(OLAY_SLOT, base + REG_EVENT_FLAGS, &olay) != 0 || olay == 0) {
+        return;
+    }
+    FPGA_WriteRegister(OLAY_SLOT, base + REG_EVENT_FLAGS, olay);    // W1C
+    
+    if (olay & DURDURMA_OLAYLARI) {
+        durdur = bagli[ch] | (uint16_t)(1 << ch);
+        for (uint8_t c = 0; c < 16; c++) {
+            if (durdur & (1 << c)) {
+                FPGA_WriteRegister(OLAY_SLOT, FPGA_MOTOR_REG_BASE(c) + REG_CONTROL_FLAGS,
+                                   CTRL_FLAG_EMERGENCY_STOP);
+                sayac.durdurma++;
+            }
+        }
+        
+        tepki = Istatistik_Cycle() - start;
+        sayac.tepki_son = tepki;
+        if (tepki > sayac.tepki_max) {
+            sayac.tepki_max = tepki;
+        }
+        
+        durdurulan |= durdur;
+        bagli_durdu |= durdur & (uint16_t)~(1 << ch);
+        bildirim[ch] |= olay & DURDURMA_OLAYLARI;
+        bildirilecek |= durdur;
+    }
+    
+    if (olay & STATUS_FLAG_POSITION_REACHED) {
+        varilan |= (uint16_t)(1 << ch);
+        sayac.varis++;
+    }
+    if (olay & STATUS_FLAG_FAULT) {
+        sayac.ariza++;
+    }
+    if (olay & STATUS_FLAG_TIMEOUT) {
+        sayac.zaman_asimi++;
+    }
+    if (olay & STATUS_FLAG_OTW) {
+        sayac.sicaklik++;
+    }
+}
+
+void EXTI0_IRQHandler(void) {
+    uint32_t start = Istatistik_Cycle();
+    uint8_t lo, hi;
+    uint16_t bekleyen;
+    
+    EXTI->PR = FPGA_INT_HAT;
+    sayac.kesme++;
+    
+    for (uint8_t tur = 0; tur < OLAY_TUR_MAX; tur++) {
+        if (FPGA_ReadRegister(OLAY_SLOT, FPGA_REG_EVENT_PENDING_LOW, &lo) != 0 ||
+            FPGA_ReadRegister(OLAY_SLOT, FPGA_REG_EVENT_PENDING_HIGH, &hi) != 0) {
+            return;                         // Slotta FPGA kayıtlı değil: Olay_Yokla
+        }
+        bekleyen = (uint16_t)(lo | (hi << 8));
+        if (!bekleyen) {
+            return;
+        }
+        
+        for (uint8_t ch = 0; ch < 16; ch++) {
+            if (bekleyen & (1 << ch)) {
+                kanal_isle(ch, start);
+            }
+        }
+    }
+    
+    // Özet boşalmadı: INT düşük kalır, yeni kenar gelmez
+    if (int_dusuk()) {
+        EXTI->SWIER = FPGA_INT_HAT;
+    }
+}
+
+void Olay_Yokla(void) {
+    if (int_dusuk()) {
+        EXTI->SWIER = FPGA_INT_HAT;
+    }
+}
+
+uint8_t Olay_Durduruldu(uint8_t slot, uint8_t ch) {
+    return slot == OLAY_SLOT && ch <= 15 && (durdurulan & (1 << ch)) != 0;
+}
+
+// ============================================================================
+// Ana döngü
+// ============================================================================
+
+static void bildir(uint8_t ch, const char* olay, const char* aciklama) {
+    char event[32];
+    char message[64];
+    
+    sprintf(event, "fpga:%u:motor:%u:%s", OLAY_SLOT, ch, olay);
+    sprintf(message, "\r\n[FPGA] Slot %02X motor %u: %s\r\n", OLAY_SLOT, ch, aciklama);
+    UART_SendEvent(event, message);
+}
+
+void Olay_Isle(void) {
+    uint16_t durdu, vardi, bildir_maske;
+    
+    // Kenarı kaçmış, düşük kalmış INT (kayıttan önce gelen olay vb.)
+    if (Tick_Elapsed(&yokla_ms, 1)) {
+        Olay_Yokla();
+    }
+    
+    if (!(durdurulan | varilan | bildirilecek)) {
+        return;
+    }
+    
+    NVIC_DisableIRQ(EXTI0_IRQn);
+    durdu = durdurulan;
+    vardi = varilan;
+    durdurulan = 0;
+    varilan = 0;
+    NVIC_EnableIRQ(EXTI0_IRQn);
+    
+    // Acil durdaki eksenlere servo tick'i ve kuyruk yeniden yazmasın
+    for (uint8_t ch = 0; ch < 16; ch++) {
+        if (durdu & (1 << ch)) {
+            Hareket_Iptal(OLAY_SLOT, ch);
+            PID_Kapat(OLAY_SLOT, ch);
+            Disli_Coz(OLAY_SLOT, ch);
+            Referans_Iptal(OLAY_SLOT, ch);
+            Kuyruk_Durdur(OLAY_SLOT, ch);
+        }
+    }
+    if (vardi & (uint16_t)~durdu) {
+        Kuyruk_Uyandir(OLAY_SLOT, vardi & (uint16_t)~durdu);
+    }
+    
+    // Olay satırı yarım komut satırıyla karışmasın
+    if (!bildirilecek || !Komut_SatirBos()) {
+        return;
+    }
+    
+    NVIC_DisableIRQ(EXTI0_IRQn);
+    bildir_maske = bildirilecek;
+    bildirilecek = 0;
+    NVIC_EnableIRQ(EXTI0_IRQn);
+    
+    for (uint8_t ch = 0; ch < 16; ch++) {
+        uint8_t olay;
+        uint8_t bagli_bit;
+        
+        if (!(bildir_maske & (1 << ch))) {
+            continue;
+        }
+        
+        NVIC_DisableIRQ(EXTI0_IRQn);
+        olay = bildirim[ch];
+        bildirim[ch] = 0;
+        bagli_bit = (bagli_durdu & (1 << ch)) != 0;
+        bagli_durdu &= (uint16_t)~(1 << ch);
+        NVIC_EnableIRQ(EXTI0_IRQn);
+        
+        if (olay & STATUS_FLAG_FAULT) {
+            bildir(ch, "fault", "Surucu arizasi - acil durdu");
+        }
+        if (olay & STATUS_FLAG_TIMEOUT) {
+            bildir(ch, "timeout", "Enkoder zaman asimi - acil durdu");
+        }
+        if (olay & STATUS_FLAG_OTW) {
+            bildir(ch, "otw", "Asiri sicaklik - acil durdu");
+        }
+        if (bagli_bit && !olay) {
+            bildir(ch, "estop", "Bagli eksen olayi - acil durdu");
+        }
+    }
+}
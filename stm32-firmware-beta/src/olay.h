@@ -0,0 +1,80 @@
+/**
+ * Burjuva Motor Controller - FPGA INT Olayları
+ *
+ * Slot 2 FPGA'sının INT hattı PB0'a bağlıdır (build--CPLD/top.v, fpga_2).
+ * INT düşen kenarında EXTI0 kesmesi bekleyen kanal özetini
+ * (FPGA_REG_EVENT_PENDING_LOW/HIGH) ve kanalların REG_EVENT_FLAGS
+ * register'larını okuyup temizler:
+ *   FAULT / TIMEOUT / OTW  -> kanal ve bağlı kanallar kesme içinde
+ *                             EMERGENCY_STOP ile durdurulur
+ *   POSITION_REACHED       -> hareket kuyruğu (kuyruk.h) beklemeden ilerler
+ * Profil/PID/kuyruk temizliği ve host bildirimi ("!fpga:2:motor:CH:fault")
+ * Olay_Isle'de ana döngüden yapılır. Kesme önceliği servo tick'inden
+ * yüksektir; tepki süresi DWT ile ölçülür.
+ *
+ * Komutlar (fpga.c):
+ *   fpga:2:motor:CH:link[:MASK]     Olayda birlikte durdurulacak kanallar
+ *   fpga:2:events[:reset]           Sayaçlar ve tepki süresi
+ */
+
+#ifndef OLAY_H
+#define OLAY_H
+
+#include <stdint.h>
+
+#define OLAY_SLOT           2           // INT hattı bağlı FPGA slotu
+
+typedef struct {
+    uint32_t kesme;             // EXTI0 kesmesi
+    uint32_t varis;             // POSITION_REACHED
+    uint32_t ariza;             // FAULT
+    uint32_t zaman_asimi;       // Enkoder TIMEOUT
+    uint32_t sicaklik;          // OTW
+    uint32_t durdurma;          // EMERGENCY_STOP yazılan kanal
+    uint32_t tepki_son;         // cycle: kesme girişi -> son durdurma yazımı
+    uint32_t tepki_max;         // cycle
+} Olay_Sayac;
+
+/**
+ * PB0'ı EXTI0 düşen kenar kesmesine bağla (Servo_Init'ten sonra)
+ */
+void Olay_Init(void);
+
+/**
+ * Kanalın olayında birlikte durdurulacak kanallar (kanalın kendisi her
+ * zaman durdurulur)
+ * @return 0: başarılı, -1: geçersiz kanal
+ */
+int Olay_Bagla(uint8_t ch, uint16_t maske);
+uint16_t Olay_Bagli(uint8_t ch);
+
+/**
+ * Sayaçlar / sıfırla
+ */
+void Olay_Oku(Olay_Sayac* sayac);
+void Olay_Sifirla(void);
+
+/**
+ * INT düşükse EXTI0'ı yazılımla tetikle (kenarı
+ * kaçmış olay). Olay_Isle ms'de bir ve FPGA_Register çağırır
+ */
+void Olay_Yokla(void);
+
+/**
+ * Kanalı kesme acil durdurdu, Olay_Isle temizliği bekliyor: motoru
+ * etkinleştiren yazım yapılmamalı. Kontrol ile yazım arası EXTI0
+ * maskelenmeli (FPGA_Motor_Enable)
+ */
+uint8_t Olay_Durduruldu(uint8_t slot, uint8_t ch);
+
+/**
+ * Kesmenin durdurduğu kanalları temizle, host'a bildir - ana döngüden
+ */
+void Olay_Isle(void);
+
+/**
+ * FPGA INT (PB0) kesmesi
+ */
+void EXTI0_IRQHandler(void);
+
+#endif // OLAY_H
@@ -0,0 +1,377 @@
+/**
+ * Burjuva Motor Controller - Kanal Başına PID Pozisyon Döngüsü
+ *
+ * Konumlar slot başına tek blok okuma ile alınır: çalışan en düşük ve en
+ * yüksek kanalın CURRENT_POS register'ları arası tek çerçevede okunur.
+ * Çıkış REG_SPEED + REG_DIRECTION 2-byte blok yazımıdır, değiştiğinde.
+ *
+ * İç kazançlar (tick birimi, Q16 PWM çıkış):
+ *   kp = KP·2^16/1e6             terim = kp·e8 >> 8
+ *   kd = KD·2^16·HZ/1e6          terim = kd·de8 >> 8 (kv aynı)
+ *   ka = KAFF·2^16·HZ²/1e6       terim = ka·a8 >> 8
+ *   ki = KI·2^32/(1e6·HZ)        integral (Q32) += ki·e8 >> 8
+ * e8: Q8 count hata, de8: tick başına değişimi. DIRECTION_FORWARD'ın
+ * konumu artırdığı varsayılır.
+ *
+ * PID_KAZANC_MAX kazançlarda toplam (int64): kp·e8 5.5e14, kd·de8 1.1e18,
+ * kv·v8 6.9e16 (HIZ_MAX), ka·a8 2.2e18 (IVME_MAX); en fazla ~3.4e18 < 9.2e18.
+ */
+
+#include "pid.h"
+#include "hareket.h"
+#include "disli.h"
+#include "servo.h"
+#include "fpga.h"
+#include "olay.h"
+#include <string.h>
+
+#define VARSAYILAN_KP       500000  // 0.5 PWM / count
+#define HIZ_MAX             (1L << 20)  // Q8 count/tick: ileri besleme hızı kırpılır (4096 count/tick)
+#define IVME_MAX            32767   // Q8 count/tick²: ileri besleme ivmesi kırpılır
+#define VARSAYILAN_OUT_MAX  255
+#define SLOT_SAYISI         4
+
+typedef struct {
+    uint8_t used;
+    uint8_t slot;
+    uint8_t ch;
+    volatile uint8_t etkin;
+    PID_Kazanc kazanc;          // Kullanıcı birimleri
+    
+    // İç kazançlar
+    int64_t kp;
+    int64_t ki;
+    int64_t kd;
+    int64_t kv;
+    int64_t ka;
+    int64_t out_max;            // Q16 PWM
+    
+    // Döngü durumu
+    int32_t setpoint;           // Q8 count
+    int32_t v_prev;             // Q8 count/tick (ileri besleme hızı)
+    int32_t e_prev;             // Q8 count
+    int64_t integral;           // Q32 PWM
+    int32_t u;                  // Q16 PWM
+    int32_t konum;              // count
+    int32_t hata;               // count
+    int32_t max_hata;           // count
+    uint8_t yazilan[2];         // REG_SPEED, REG_DIRECTION
+} PID_Dongu;
+
+static PID_Dongu donguler[PID_KANAL_SAYISI];
+static volatile uint16_t slot_maske[SLOT_SAYISI];  // Çalışan kanallar
+static uint8_t blok[256];
+
+static PID_Dongu* dongu_bul(uint8_t slot, uint8_t ch) {
+    for (uint8_t i = 0; i < PID_KANAL_SAYISI; i++) {
+        if (donguler[i].used && donguler[i].slot == slot && donguler[i].ch == ch) {
+            return &donguler[i];
+        }
+    }
+    return NULL;
+}
+
+static void varsayilan(PID_Kazanc* kazanc) {
+    memset(kazanc, 0, sizeof(*kazanc));
+    kazanc->kp = VARSAYILAN_KP;
+    kazanc->out_max = VARSAYILAN_OUT_MAX;
+}
+
+/**
+ * Kullanıcı birimlerini tick birimlerine çevir (ana döngü, kilit altında)
+ */
+static void kazanc_yukle(PID_Dongu* d) {
+    const PID_Kazanc* k = &d->kazanc;
+    
+    d->kp = (int64_t)k->kp * 65536 / 1000000;
+    d->ki = ((int64_t)k->ki << 32) / (1000000LL * SERVO_HZ);
+    d->kd = (int64_t)k->kd * 65536 * SERVO_HZ / 1000000;
+    d->kv = (int64_t)k->kvff * 65536 * SERVO_HZ / 1000000;
+    d->ka = (int64_t)k->kaff * 65536 * SERVO_HZ / 1000 * SERVO_HZ / 1000;
+    d->out_max = (int64_t)k->out_max << 16;
+}
+
+static PID_Dongu* dongu_al(uint8_t slot, uint8_t ch) {
+    PID_Dongu* d = dongu_bul(slot, ch);
+    if (d) {
+        return d;
+    }
+    
+    for (uint8_t i = 0; i < PID_KANAL_SAYISI; i++) {
+        if (!donguler[i].used) {
+            d = &donguler[i];
+            memset(d, 0, sizeof(*d));
+            d->slot = slot;
+            d->ch = ch;
+            varsayilan(&d->kazanc);
+            kazanc_yukle(d);
+            d->used = 1;
+            return d;
+        }
+    }
+    return NULL;
+}
+
+static uint8_t kazanc_gecerli(int32_t k) {
+    return k >= 0 && k <= PID_KAZANC_MAX;
+}
+
+int PID_Ayarla(uint8_t slot, uint8_t ch, const PID_Kazanc* kazanc) {
+    PID_Dongu* d;
+    
+    if (slot >= SLOT_SAYISI || ch > 15 || !kazanc || kazanc->out_max == 0 ||
+        !kazanc_gecerli(kazanc->kp) || !kazanc_gecerli(kazanc->ki) ||
+        !kazanc_gecerli(kazanc->kd) || !kazanc_gecerli(kazanc->kvff) ||
+        !kazanc_gecerli(kazanc->kaff)) {
+        return -1;
+    }
+    
+    d = dongu_al(slot, ch);
+    if (!d) {
+        return -2;
+    }
+    
+    Servo_Kilit();
+    d->kazanc = *kazanc;
+    kazanc_yukle(d);
+    // Yeni sınırın dışında kalan integral kırpılır
+    if (d->integral > (d->out_max << 16)) {
+        d->integral = d->out_max << 16;
+    } else if (d->integral < -(d->out_max << 16)) {
+        d->integral = -(d->out_max << 16);
+    }
+    Servo_Birak();
+    return 0;
+}
+
+void PID_Kazanclar(uint8_t slot, uint8_t ch, PID_Kazanc* kazanc) {
+    PID_Dongu* d = dongu_bul(slot, ch);
+    if (d) {
+        *kazanc = d->kazanc;
+    } else {
+        varsayilan(kazanc);
+    }
+}
+
+static int32_t konum_coz(const uint8_t* reg) {
+    int32_t pos = ((int32_t)reg[0] << 16) | ((int32_t)reg[1] << 8) | reg[2];
+    return (pos & 0x800000) ? pos - 0x1000000 : pos;
+}
+
+static void motor_durdur(uint8_t slot, uint8_t ch) {
+    uint8_t out[2] = { 0, DIRECTION_STOP };
+    FPGA_WriteBlock(slot, FPGA_MOTOR_REG_BASE(ch) + REG_SPEED, out, 2);
+}
+
+int PID_Ac(uint8_t slot, uint8_t ch) {
+    PID_Dongu* d;
+    uint8_t reg[3];
+    
+    if (slot >= SLOT_SAYISI || ch > 15 || Olay_Durduruldu(slot, ch)) {
+        return -1;
+    }
+    if (PID_Etkin(slot, ch)) {
+        return 0;
+    }
+    if (FPGA_ReadBlock(slot, FPGA_MOTOR_REG_BASE(ch) + REG_CURRENT_POS_HIGH, reg, 3) != 0) {
+        return -1;
+    }
+    
+    d = dongu_al(slot, ch);
+    if (!d) {
+        return -2;
+    }
+    
+    // Eski profilin setpoint'i döngüye sıçrama olarak girmesin
+    Hareket_Iptal(slot, ch);
+    
+    d->konum = konum_coz(reg);
+    d->setpoint = d->konum * 256;
+    d->v_prev = 0;
+    d->e_prev = 0;
+    d->integral = 0;
+    d->u = 0;
+    d->hata = 0;
+    d->max_hata = 0;
+    d->yazilan[0] = 0;
+    d->yazilan[1] = DIRECTION_STOP;
+    
+    // Hız/yön modu, motor duruk: FPGA pozisyon döngüsü devre dışı
+    motor_durdur(slot, ch);
+    FPGA_Motor_t motor = { slot, ch };
+    if (FPGA_Motor_Enable(&motor, CTRL_FLAG_ENABLE | CTRL_FLAG_CONTROL_MODE) != 0) {
+        return -1;
+    }
+    
+    Servo_Kilit();
+    d->etkin = 1;
+    slot_maske[slot] |= (uint16_t)(1 << ch);
+    Servo_Birak();
+    return 0;
+}
+
+void PID_Kapat(uint8_t slot, uint8_t ch) {
+    if (slot >= SLOT_SAYISI) {
+        return;
+    }
+    
+    for (uint8_t i = 0; i < PID_KANAL_SAYISI; i++) {
+        PID_Dongu* d = &donguler[i];
+        if (!d->used || !d->etkin || d->slot != slot ||
+            (ch != PID_TUM_KANALLAR && d->ch != ch)) {
+            continue;
+        }
+        
+        Servo_Kilit();
+        d->etkin = 0;
+        slot_maske[slot] &= (uint16_t)~(1 << d->ch);
+        Servo_Birak();
+        
+        motor_durdur(slot, d->ch);
+    }
+}
+
+uint8_t PID_Etkin(uint8_t slot, uint8_t ch) {
+    return slot < SLOT_SAYISI && ch <= 15 && (slot_maske[slot] & (1 << ch)) != 0;
+}
+
+int PID_Oku(uint8_t slot, uint8_t ch, PID_Durum* durum) {
+    PID_Dongu* d = dongu_bul(slot, ch);
+    if (!d) {
+        return -1;
+    }
+    
+    Servo_Kilit();
+    durum->etkin = d->etkin;
+    durum->setpoint = (d->setpoint + 128) >> 8;
+    durum->konum = d->konum;
+    durum->hata = d->hata;
+    durum->cikis = (int16_t)((d->u + ((d->u < 0) ? -0x8000 : 0x8000)) / 65536);
+    durum->integral = (int16_t)(d->integral >> 32);
+    durum->max_hata = d->max_hata;
+    Servo_Birak();
+    return 0;
+}
+
+uint8_t PID_Aktif(void) {
+    uint8_t n = 0;
+    for (uint8_t slot = 0; slot < SLOT_SAYISI; slot++) {
+        for (uint16_t m = slot_maske[slot]; m; m &= m - 1) {
+            n++;
+        }
+    }
+    return n;
+}
+
+// ============================================================================
+// Servo tick
+// ============================================================================
+
+static void dongu_tick(PID_Dongu* d, const uint8_t* pos_reg) {
+    int32_t sp, v, a, e, de;
+    int64_t u, i_yeni, i_sinir;
+    uint32_t mag;
+    uint8_t out[2];
+    
+    d->konum = konum_coz(pos_reg);
+    
+    // Profil veya dişli varsa setpoint ve ileri besleme oradan, yoksa son setpoint
+    if (Hareket_Setpoint(d->slot, d->ch, &sp, &v) == 0 ||
+        Disli_Setpoint(d->slot, d->ch, &sp, &v) == 0) {
+        d->setpoint = sp;
+    } else {
+        v = 0;
+    }
+    if (v > HIZ_MAX) {
+        v = HIZ_MAX;                // Dişli: master konumu yeniden başladığı tick
+    } else if (v < -HIZ_MAX) {
+        v = -HIZ_MAX;
+    }
+    a = v - d->v_prev;
+    d->v_prev = v;
+    if (a > IVME_MAX) {
+        a = IVME_MAX;               // Profil devralındığı tick'teki hız sıçraması
+    } else if (a < -IVME_MAX) {
+        a = -IVME_MAX;
+    }
+    
+    e = d->setpoint - d->konum * 256;
+    if (e > PID_HATA_MAX * 256) {
+        e = PID_HATA_MAX * 256;
+    } else if (e < -PID_HATA_MAX * 256) {
+        e = -PID_HATA_MAX * 256;
+    }
+    de = e - d->e_prev;
+    d->e_prev = e;
+    
+    u = (d->kp * e + d->kd * de + d->kv * v + d->ka * a) >> 8;
+    
+    // Integral: ±OUTMAX ile sınırlı, doyumu büyüten yönde durur
+    i_sinir = d->out_max << 16;
+    i_yeni = d->integral + ((d->ki * e) >> 8);
+    if (i_yeni > i_sinir) {
+        i_yeni = i_sinir;
+    } else if (i_yeni < -i_sinir) {
+        i_yeni = -i_sinir;
+    }
+    if (!((u + (i_yeni >> 16) > d->out_max && e > 0) ||
+          (u + (i_yeni >> 16) < -d->out_max && e < 0))) {
+        d->integral = i_yeni;
+    }
+    
+    u += d->integral >> 16;
+    if (u > d->out_max) {
+        u = d->out_max;
+    } else if (u < -d->out_max) {
+        u = -d->out_max;
+    }
+    d->u = (int32_t)u;
+    
+    d->hata = e / 256;
+    if (d->hata > d->max_hata) {
+        d->max_hata = d->hata;
+    } else if (-d->hata > d->max_hata) {
+        d->max_hata = -d->hata;
+    }
+    
+    mag = (uint32_t)(((u < 0) ? -u : u) + 0x8000) >> 16;
+    out[0] = (uint8_t)mag;
+    out[1] = (mag == 0) ? DIRECTION_STOP : (u > 0) ? DIRECTION_FORWARD : DIRECTION_REVERSE;
+    if (out[0] != d->yazilan[0] || out[1] != d->yazilan[1]) {
+        FPGA_WriteBlock(d->slot, FPGA_MOTOR_REG_BASE(d->ch) + REG_SPEED, out, 2);
+        d->yazilan[0] = out[0];
+        d->yazilan[1] = out[1];
+    }
+}
+
+void PID_Tick(void) {
+    for (uint8_t slot = 0; slot < SLOT_SAYISI; slot++) {
+        uint16_t maske = slot_maske[slot];
+        uint8_t ilk = 0, son = 15;
+        uint8_t adres;
+        
+        if (!maske) {
+            continue;
+        }
+        while (!(maske & (1 << ilk))) {
+            ilk++;
+        }
+        while (!(maske & (1 << son))) {
+            son--;
+        }
+        
+        // ilk kanalın CURRENT_POS'undan son kanalınkine tek çerçeve
+        adres = FPGA_MOTOR_REG_BASE(ilk) + REG_CURRENT_POS_HIGH;
+        if (FPGA_ReadBlock(slot, adres, blok,
+                           FPGA_MOTOR_REG_BASE(son) + REG_CURRENT_POS_LOW + 1 - adres) != 0) {
+            continue;
+        }
+        
+        for (uint8_t i = 0; i < PID_KANAL_SAYISI; i++) {
+            PID_Dongu* d = &donguler[i];
+            if (d->etkin && d->slot == slot) {
+                dongu_tick(d, &blok[FPGA_MOTOR_REG_BASE(d->ch) + REG_CURRENT_POS_HIGH - adres]);
+            }
+        }
+    }
+}
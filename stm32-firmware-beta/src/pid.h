@@ -0,0 +1,100 @@
+/**
+ * Burjuva Motor Controller - Kanal Başına PID Pozisyon Döngüsü
+ *
+ * Servo tick'inde (servo.h) FPGA kanalının konumu okunur, PID çıkışı
+ * REG_SPEED / REG_DIRECTION'a yazılır (FPGA hız/yön modunda, kendi
+ * pozisyon döngüsü devre dışı). Setpoint, eksenin hareket profili
+ * varsa profilin çıkışıdır (hareket.h), dişliyle bağlıysa dişlinin
+ * (disli.h), yoksa son setpoint tutulur.
+ *
+ *   u = Kp e + I + Kd de/dt + Kvff v + Kaff a,   |u| <= OUTMAX (PWM)
+ *
+ * Anti-windup: çıkış doyumdayken doyumu artıran yönde integral alınmaz,
+ * integral terimi de ±OUTMAX ile sınırlıdır. Hesap sabit noktalı
+ * (çıkış Q16 PWM, hata Q8 count).
+ *
+ * Kazançlar milyonda birim (micro) tamsayı olarak verilir:
+ *   KP   PWM / count            KI   PWM / (count s)
+ *   KD   PWM / (count/s)        KVFF PWM / (count/s)
+ *   KAFF PWM / (count/s²)
+ *
+ * Komutlar (fpga.c):
+ *   fpga:S:motor:CH:pid[:KP:KI:KD[:KVFF[:KAFF[:OUTMAX]]]]
+ *   fpga:S:motor:CH:pid:on / pid:off
+ *   fpga:S:motor:CH:pidstatus
+ */
+
+#ifndef PID_H
+#define PID_H
+
+#include <stdint.h>
+
+#define PID_KANAL_SAYISI        16          // Döngü tutulan kanal (slot+kanal)
+#define PID_KAZANC_MAX          1000000000  // micro (1000.0)
+#define PID_HATA_MAX            32767       // count: daha büyük hata kırpılır
+#define PID_TUM_KANALLAR        0xFF
+
+typedef struct {
+    int32_t kp;
+    int32_t ki;
+    int32_t kd;
+    int32_t kvff;
+    int32_t kaff;
+    uint8_t out_max;        // PWM (1-255)
+} PID_Kazanc;
+
+typedef struct {
+    uint8_t etkin;
+    int32_t setpoint;       // count
+    int32_t konum;          // count
+    int32_t hata;           // count
+    int16_t cikis;          // PWM, işaretli (+ ileri, - geri)
+    int16_t integral;       // PWM
+    int32_t max_hata;       // count, pid:on'dan beri
+} PID_Durum;
+
+/**
+ * Kazançları ayarla - çalışan döngüye bir sonraki tick'te uygulanır
+ * @return 0: başarılı, -1: geçersiz kazanç, -2: kanal tablosu dolu
+ */
+int PID_Ayarla(uint8_t slot, uint8_t ch, const PID_Kazanc* kazanc);
+
+/**
+ * Kanalın kazançları (ayarlanmamışsa varsayılanlar)
+ */
+void PID_Kazanclar(uint8_t slot, uint8_t ch, PID_Kazanc* kazanc);
+
+/**
+ * Döngüyü başlat: setpoint = mevcut konum, integral sıfır, FPGA hız/yön modu
+ * @return 0: başarılı, -1: modül yok, -2: kanal tablosu dolu
+ */
+int PID_Ac(uint8_t slot, uint8_t ch);
+
+/**
+ * Döngüyü durdur ve motoru durdur (DIRECTION_STOP).
+ * ch = PID_TUM_KANALLAR: slotun tümü
+ */
+void PID_Kapat(uint8_t slot, uint8_t ch);
+
+/**
+ * Kanal döngüsü çalışıyor mu (kesme bağlamından da çağrılabilir)
+ */
+uint8_t PID_Etkin(uint8_t slot, uint8_t ch);
+
+/**
+ * Döngü durumu
+ * @return 0: başarılı, -1: kanal için kayıt yok
+ */
+int PID_Oku(uint8_t slot, uint8_t ch, PID_Durum* durum);
+
+/**
+ * Çalışan döngü sayısı
+ */
+uint8_t PID_Aktif(void);
+
+/**
+ * Bir servo periyodu - Servo_Tick'ten, Hareket_Tick'ten sonra
+ */
+void PID_Tick(void);
+
+#endif // PID_H
@@ -0,0 +1,310 @@
+/**
+ * Burjuva Motor Controller - Referans (Homing) Arama
+ *
+ * Tümü ana döngüde çalışır: IO16 erişimi kesme bağlamına alınmaz. Ms'de bir
+ * (Kuyruk_Isle gibi; her turda blok SPI okuması USART1 RX'i taşırır) önce
+ * aramadaki eksenlerin IO16 slotları birer kez okunur, sonra her eksen
+ * için STATUS..CURRENT_POS tek blok okunur ve durum makinesi bir adım
+ * ilerler. Hız yazımları yalnızca durum değişiminde yapılır.
+ */
+
+#include "referans.h"
+#include "fpga.h"
+#include "olay.h"
+#include "konum.h"
+#include "komut.h"
+#include "tick.h"
+#include "16kanaldijital.h"
+#include "uart_helper.h"
+#include <string.h>
+#include <stdio.h>
+
+#define SLOT_SAYISI         4
+
+#define BILDIR_YOK          0
+#define BILDIR_TAMAM        1
+#define BILDIR_HATA         2
+
+typedef struct {
+    uint8_t used;
+    uint8_t slot;
+    uint8_t ch;
+    Referans_Param param;
+    uint8_t durum;              // Referans_Durum
+    uint8_t hata;               // Referans_Hata
+    uint8_t giris;
+    uint8_t bildir;             // Host olayı bekliyor
+    int32_t birakma;            // BIRAKMA: giriş pasif olduğu konum
+    uint8_t birakti;
+    int32_t tetik;
+    uint32_t baslangic_ms;
+    uint32_t sure_ms;
+} Referans_Eksen;
+
+static Referans_Eksen eksenler[REFERANS_EKSEN_SAYISI];
+static uint32_t son_ms = 0;
+
+static Referans_Eksen* eksen_bul(uint8_t slot, uint8_t ch) {
+    for (uint8_t i = 0; i < REFERANS_EKSEN_SAYISI; i++) {
+        if (eksenler[i].used && eksenler[i].slot == slot && eksenler[i].ch == ch) {
+            return &eksenler[i];
+        }
+    }
+    return NULL;
+}
+
+static uint8_t araniyor(const Referans_Eksen* e) {
+    return e->used && e->durum >= REFERANS_ARAMA && e->durum <= REFERANS_DONUS;
+}
+
+static uint8_t ters(uint8_t yon) {
+    return (yon == DIRECTION_FORWARD) ? DIRECTION_REVERSE : DIRECTION_FORWARD;
+}
+
+static int32_t konum_coz(const uint8_t* reg) {
+    int32_t pos = ((int32_t)reg[0] << 16) | ((int32_t)reg[1] << 8) | reg[2];
+    return (pos & 0x800000) ? pos - 0x1000000 : pos;
+}
+
+static void bitir(Referans_Eksen* e, uint8_t hata) {
+    if (hata != REFERANS_HATA_YOK) {
+        FPGA_Motor_t motor = { e->slot, e->ch };
+        FPGA_Motor_Stop(&motor);
+    }
+    e->durum = (hata == REFERANS_HATA_YOK) ? REFERANS_TAMAM : REFERANS_HATA;
+    e->hata = hata;
+    e->sure_ms = Tick_Ms() - e->baslangic_ms;
+    e->bildir = (hata == REFERANS_HATA_YOK) ? BILDIR_TAMAM : BILDIR_HATA;
+}
+
+int Referans_Ayarla(uint8_t slot, uint8_t ch, const Referans_Param* param) {
+    Referans_Eksen* e;
+    
+    if (slot >= SLOT_SAYISI || ch > 15 || !param || param->io_slot >= SLOT_SAYISI ||
+        param->io_pin > 15 || param->seviye > 1 ||
+        (param->yon != DIRECTION_FORWARD && param->yon != DIRECTION_REVERSE) ||
+        param->hiz_hizli == 0 || param->hiz_yavas == 0 || param->sure_max == 0) {
+        return -1;
+    }
+    
+    e = eksen_bul(slot, ch);
+    if (e && araniyor(e)) {
+        return -1;                  // Arama sürerken ayar değişmez
+    }
+    for (uint8_t i = 0; i < REFERANS_EKSEN_SAYISI && !e; i++) {
+        if (!eksenler[i].used) {
+            e = &eksenler[i];
+        }
+    }
+    if (!e) {
+        return -2;
+    }
+    
+    memset(e, 0, sizeof(*e));
+    e->slot = slot;
+    e->ch = ch;
+    e->param = *param;
+    e->used = 1;
+    return 0;
+}
+
+int Referans_Parametre(uint8_t slot, uint8_t ch, Referans_Param* param) {
+    Referans_Eksen* e = eksen_bul(slot, ch);
+    if (!e) {
+        return -1;
+    }
+    *param = e->param;
+    return 0;
+}
+
+int Referans_Baslat(uint8_t slot, uint8_t ch) {
+    Referans_Eksen* e = eksen_bul(slot, ch);
+    uint8_t status;
+    uint16_t girisler;
+    
+    if (!e || FPGA_ReadRegister(slot, FPGA_MOTOR_REG_BASE(ch) + REG_STATUS_FLAGS, &status) != 0 ||
+        IO16_ReadInputs(e->param.io_slot, &girisler) != 0) {
+        return -1;
+    }
+    
+    e->durum = REFERANS_ARAMA;
+    e->hata = REFERANS_HATA_YOK;
+    e->giris = ((girisler >> e->param.io_pin) & 1) == e->param.seviye;
+    e->bildir = BILDIR_YOK;
+    e->birakti = 0;
+    e->tetik = 0;
+    e->baslangic_ms = Tick_Ms();
+    e->sure_ms = 0;
+    
+    // Anahtar zaten basılıysa ilk adım BIRAKMA'ya geçer, hızlı hareket yok
+    if (!e->giris) {
+        FPGA_Motor_t motor = { slot, ch };
+        FPGA_Motor_SetSpeedDirection(&motor, e->param.hiz_hizli, e->param.yon);
+    }
+    return 0;
+}
+
+void Referans_Iptal(uint8_t slot, uint8_t ch) {
+    for (uint8_t i = 0; i < REFERANS_EKSEN_SAYISI; i++) {
+        Referans_Eksen* e = &eksenler[i];
+        if (araniyor(e) && e->slot == slot && (ch == REFERANS_TUM_KANALLAR || e->ch == ch)) {
+            bitir(e, REFERANS_HATA_IPTAL);
+        }
+    }
+}
+
+int Referans_Oku(uint8_t slot, uint8_t ch, Referans_Bilgi* bilgi) {
+    Referans_Eksen* e = eksen_bul(slot, ch);
+    if (!e) {
+        return -1;
+    }
+    
+    bilgi->durum = e->durum;
+    bilgi->hata = e->hata;
+    bilgi->giris = e->giris;
+    bilgi->tetik = e->tetik;
+    bilgi->sure_ms = araniyor(e) ? Tick_Ms() - e->baslangic_ms : e->sure_ms;
+    return 0;
+}
+
+uint8_t Referans_Aktif(void) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < REFERANS_EKSEN_SAYISI; i++) {
+        if (araniyor(&eksenler[i])) {
+            n++;
+        }
+    }
+    return n;
+}
+
+// ============================================================================
+// Ana döngü
+// ============================================================================
+
+static void eksen_isle(Referans_Eksen* e, uint8_t basili) {
+    const Referans_Param* p = &e->param;
+    FPGA_Motor_t motor = { e->slot, e->ch };
+    uint8_t reg[6];
+    int32_t pos;
+    
+    if (FPGA_ReadBlock(e->slot, FPGA_MOTOR_REG_BASE(e->ch) + REG_STATUS_FLAGS, reg, 6) != 0 ||
+        (reg[0] & (STATUS_FLAG_ERROR | STATUS_FLAG_FAULT))) {
+        bitir(e, REFERANS_HATA_MOTOR);
+        return;
+    }
+    if (Tick_Ms() - e->baslangic_ms >= p->sure_max) {
+        bitir(e, REFERANS_HATA_SURE);
+        return;
+    }
+    pos = konum_coz(&reg[REG_CURRENT_POS_HIGH - REG_STATUS_FLAGS]);
+    e->giris = basili;
+    
+    switch (e->durum) {
+    case REFERANS_ARAMA:
+        if (basili) {
+            FPGA_Motor_SetSpeedDirection(&motor, p->hiz_yavas, ters(p->yon));
+            e->birakti = 0;
+            e->durum = REFERANS_BIRAKMA;
+        }
+        break;
+    
+    case REFERANS_BIRAKMA:
+        if (!e->birakti) {
+            if (!basili) {
+                e->birakma = pos;
+                e->birakti = 1;
+            }
+        } else if (basili) {
+            e->birakti = 0;         // Anahtar sekmesi: bırakma noktası yeniden
+        }
+        if (e->birakti && (pos - e->birakma >= p->geri || e->birakma - pos >= p->geri)) {
+            FPGA_Motor_SetSpeedDirection(&motor, p->hiz_yavas, p->yon);
+            e->durum = REFERANS_YAKLASMA;
+        }
+        break;
+    
+    case REFERANS_YAKLASMA:
+        if (basili) {
+            e->tetik = pos;
+            FPGA_Motor_Stop(&motor);
+            FPGA_Motor_GoToPosition(&motor, e->tetik, p->hiz_yavas);
+            e->durum = REFERANS_DONUS;
+        }
+        break;
+    
+    case REFERANS_DONUS:
+        if (pos - e->tetik <= REFERANS_VARIS_PENCERE && e->tetik - pos <= REFERANS_VARIS_PENCERE) {
+            FPGA_Motor_Home(&motor);
+            Konum_Yenile(e->slot, e->ch);
+            bitir(e, REFERANS_HATA_YOK);
+        }
+        break;
+    
+    default:
+        break;
+    }
+}
+
+static void bildir(const Referans_Eksen* e) {
+    char event[40];
+    char message[80];
+    
+    if (e->bildir == BILDIR_TAMAM) {
+        sprintf(event, "fpga:%u:motor:%u:homed", e->slot, e->ch);
+        sprintf(message, "\r\n[FPGA] Slot %02X motor %u: Referans bulundu, konum=0\r\n",
+                e->slot, e->ch);
+    } else {
+        sprintf(event, "fpga:%u:motor:%u:homefail", e->slot, e->ch);
+        sprintf(message, "\r\n[FPGA] Slot %02X motor %u: Referans aranamadi (hata %u)\r\n",
+                e->slot, e->ch, e->hata);
+    }
+    UART_SendEvent(event, message);
+}
+
+static void tara(void) {
+    uint16_t girisler[SLOT_SAYISI];
+    uint8_t okunan = 0, hatali = 0;
+    
+    for (uint8_t i = 0; i < REFERANS_EKSEN_SAYISI; i++) {
+        Referans_Eksen* e = &eksenler[i];
+        uint8_t io = e->param.io_slot;
+        
+        // Kesmenin acil durdurduğu eksen Olay_Isle'de iptal edilir
+        if (!araniyor(e) || Olay_Durduruldu(e->slot, e->ch)) {
+            continue;
+        }
+        
+        // Aynı IO16 slotunu kullanan eksenler tek okumayı paylaşır
+        if (!(okunan & (1 << io))) {
+            okunan |= (uint8_t)(1 << io);
+            if (IO16_ReadInputs(io, &girisler[io]) != 0) {
+                hatali |= (uint8_t)(1 << io);
+            }
+        }
+        if (hatali & (1 << io)) {
+            bitir(e, REFERANS_HATA_IO);
+            continue;
+        }
+        eksen_isle(e, ((girisler[io] >> e->param.io_pin) & 1) == e->param.seviye);
+    }
+}
+
+void Referans_Isle(void) {
+    uint32_t now = Tick_Ms();
+    
+    if (now != son_ms) {
+        son_ms = now;
+        tara();
+    }
+    
+    // Olay satırı yarım komut satırıyla karışmasın
+    if (!Komut_SatirBos()) {
+        return;
+    }
+    for (uint8_t i = 0; i < REFERANS_EKSEN_SAYISI; i++) {
+        if (eksenler[i].used && eksenler[i].bildir != BILDIR_YOK) {
+            bildir(&eksenler[i]);
+            eksenler[i].bildir = BILDIR_YOK;
+        }
+    }
+}
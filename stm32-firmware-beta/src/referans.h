@@ -0,0 +1,119 @@
+/**
+ * Burjuva Motor Controller - Referans (Homing) Arama
+ *
+ * Eksen, IO16 girişine bağlı limit/referans anahtarına doğru sürülür ve
+ * anahtarın konumu sıfır yapılır. Eksen başına durum makinesi:
+ *
+ *   ARAMA      Hızlı hızla anahtara doğru (FPGA hız/yön modu), giriş
+ *              aktif olunca dur
+ *   BIRAKMA    Yavaş hızla geri, giriş pasif olduktan sonra GERI count
+ *              daha uzaklaş
+ *   YAKLASMA   Yavaş hızla anahtara doğru; giriş aktif olduğu anki konum
+ *              (tetik) tutulur, motor durur
+ *   DONUS      Pozisyon modunda tetik konumuna dön, varınca FPGA konumu
+ *              sıfırlar (HOME_REQUEST)
+ *
+ * Anahtar başlangıçta basılıysa ARAMA hemen BIRAKMA'ya geçer. Giriş ana
+ * döngünün her turunda IO16 slot başına tek çerçevede okunur (INPUT_A/B);
+ * aynı anda birden fazla eksen referans arayabilir, aynı IO16 slotunu
+ * kullananlar aynı okumayı paylaşır. Tetik konumu yavaş yaklaşmada
+ * alındığından ana döngü gecikmesinin etkisi yavaş hızla sınırlıdır.
+ *
+ * Bitişte "!fpga:S:motor:CH:homed" veya "!fpga:S:motor:CH:homefail"
+ * olayı gönderilir.
+ *
+ * Komutlar (fpga.c):
+ *   fpga:S:motor:CH:homecfg[:IOSLOT:IOPIN:LEVEL:DIR:FAST:SLOW[:BACKOFF[:TIMEOUT]]]
+ *   fpga:S:motor:CH:homing
+ *   fpga:S:motor:CH:homestatus
+ */
+
+#ifndef REFERANS_H
+#define REFERANS_H
+
+#include <stdint.h>
+
+#define REFERANS_EKSEN_SAYISI   8           // Ayarı tutulan eksen (slot+kanal)
+#define REFERANS_VARIS_PENCERE  2           // count: DONUS'ta tetik konumuna varış
+#define REFERANS_SURE_VARSAYILAN 30000      // ms
+#define REFERANS_TUM_KANALLAR   0xFF
+
+typedef enum {
+    REFERANS_BOS = 0,       // Arama yok
+    REFERANS_ARAMA,
+    REFERANS_BIRAKMA,
+    REFERANS_YAKLASMA,
+    REFERANS_DONUS,
+    REFERANS_TAMAM,         // Konum sıfırlandı
+    REFERANS_HATA
+} Referans_Durum;
+
+typedef enum {
+    REFERANS_HATA_YOK = 0,
+    REFERANS_HATA_SURE,     // TIMEOUT ms içinde bitmedi
+    REFERANS_HATA_IO,       // IO16 girişi okunamadı
+    REFERANS_HATA_MOTOR,    // FPGA hata/arıza bayrağı veya modül yok
+    REFERANS_HATA_IPTAL     // Başka komut / olay durdurdu
+} Referans_Hata;
+
+typedef struct {
+    uint8_t io_slot;
+    uint8_t io_pin;
+    uint8_t seviye;         // Anahtar basılıyken giriş seviyesi
+    uint8_t yon;            // Anahtara doğru: DIRECTION_FORWARD / DIRECTION_REVERSE
+    uint8_t hiz_hizli;      // ARAMA REG_SPEED
+    uint8_t hiz_yavas;      // BIRAKMA / YAKLASMA / DONUS REG_SPEED
+    uint16_t geri;          // count: bırakma noktasından sonra uzaklaşma
+    uint32_t sure_max;      // ms
+} Referans_Param;
+
+typedef struct {
+    uint8_t durum;          // Referans_Durum
+    uint8_t hata;           // Referans_Hata
+    uint8_t giris;          // Son okumada anahtar basılı
+    int32_t tetik;          // Sıfırlanmadan önce anahtar konumu, count
+    uint32_t sure_ms;       // Başlangıçtan beri / bitişe kadar
+} Referans_Bilgi;
+
+/**
+ * Eksenin anahtar ve hız ayarı
+ * @return 0: başarılı, -1: geçersiz parametre, -2: eksen tablosu dolu
+ */
+int Referans_Ayarla(uint8_t slot, uint8_t ch, const Referans_Param* param);
+
+/**
+ * Eksenin ayarı
+ * @return 0: başarılı, -1: ayar yok
+ */
+int Referans_Parametre(uint8_t slot, uint8_t ch, Referans_Param* param);
+
+/**
+ * Aramayı başlat (ARAMA). Hareket/PID/kuyruk/dişli çağıran tarafından
+ * bırakılmış olmalı
+ * @return 0: başarılı, -1: ayar yok veya FPGA / IO16 modülü yok
+ */
+int Referans_Baslat(uint8_t slot, uint8_t ch);
+
+/**
+ * Süren aramayı durdur: motor durur, arama HATA_IPTAL ile biter (homefail).
+ * ch = REFERANS_TUM_KANALLAR: slotun tümü. Bitmiş aramalara dokunmaz
+ */
+void Referans_Iptal(uint8_t slot, uint8_t ch);
+
+/**
+ * Arama durumu
+ * @return 0: başarılı, -1: eksen için ayar yok
+ */
+int Referans_Oku(uint8_t slot, uint8_t ch, Referans_Bilgi* bilgi);
+
+/**
+ * Arama süren eksen sayısı
+ */
+uint8_t Referans_Aktif(void);
+
+/**
+ * Ana döngüden: ms'de bir girişleri oku, durum makinelerini ilerlet
+ */
+void Referans_Isle(void);
+
+#endif // REFERANS_H
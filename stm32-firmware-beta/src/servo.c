@@ -0,0 +1,136 @@
+/**
+ * Burjuva Motor Controller - Servo Tick
+ *
+ * TIM2: APB1 36 MHz (prescaler 2) -> timer saati 72 MHz. PSC ile 1 MHz
+ * sayaca bölünür, ARR = 1e6 / SERVO_HZ - 1. Kesme önceliği SysTick'ten
+ * yüksektir; ms sayacı en fazla bir tick süresi gecikir.
+ */
+
+#include "stm32f10x.h"
+#include "stm32f10x_rcc.h"
+#include "servo.h"
+#include "konum.h"
+#include "hareket.h"
+#include "disli.h"
+#include "pid.h"
+#include "istatistik.h"
+#include "uart_helper.h"
+#include <string.h>
+#include <stdio.h>
+
+#define TIM2_CLK_HZ         72000000UL
+#define SAYAC_HZ            1000000UL
+#define SERVO_ONCELIK       1
+#define CYCLES_PER_TICK     (72000000UL / SERVO_HZ)
+
+typedef struct {
+    uint32_t ticks;
+    uint64_t total;                 // cycle
+    uint32_t max;                   // cycle
+    uint32_t last;                  // cycle
+    uint32_t overrun;               // Tick bitmeden sonraki periyot başladı
+} Servo_Sayac;
+
+static Servo_Sayac sayac;
+static uint8_t kilit_derinlik = 0;
+
+void Servo_Init(void) {
+    memset(&sayac, 0, sizeof(sayac));
+    
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+    TIM2->CR1 = 0;
+    TIM2->PSC = TIM2_CLK_HZ / SAYAC_HZ - 1;
+    TIM2->ARR = SAYAC_HZ / SERVO_HZ - 1;
+    TIM2->EGR = TIM_EGR_UG;         // PSC'yi hemen yükle
+    TIM2->SR = 0;
+    TIM2->DIER = TIM_DIER_UIE;
+    
+    NVIC_SetPriority(TIM2_IRQn, SERVO_ONCELIK);
+    NVIC_EnableIRQ(TIM2_IRQn);
+    TIM2->CR1 = TIM_CR1_CEN;
+}
+
+void Servo_Tick(void) {
+    uint32_t start = Istatistik_Cycle();
+    uint32_t cycles;
+    
+    Konum_Tick();
+    Hareket_Tick();
+    Disli_Tick();
+    PID_Tick();
+    
+    cycles = Istatistik_Cycle() - start;
+    sayac.ticks++;
+    sayac.total += cycles;
+    sayac.last = cycles;
+    if (cycles > sayac.max) {
+        sayac.max = cycles;
+    }
+}
+
+void TIM2_IRQHandler(void) {
+    if (TIM2->SR & TIM_SR_UIF) {
+        TIM2->SR = (uint16_t)~TIM_SR_UIF;
+        Servo_Tick();
+        if (TIM2->SR & TIM_SR_UIF) {
+            sayac.overrun++;
+        }
+    }
+}
+
+void Servo_Kilit(void) {
+    NVIC_DisableIRQ(TIM2_IRQn);
+    kilit_derinlik++;
+}
+
+void Servo_Birak(void) {
+    if (kilit_derinlik > 0 && --kilit_derinlik == 0) {
+        NVIC_EnableIRQ(TIM2_IRQn);
+    }
+}
+
+void Servo_Komut_Isle(const char* arg) {
+    Servo_Sayac s;
+    uint32_t avg;
+    char buf[96];
+    
+    if (strcmp(arg, "reset") == 0) {
+        Servo_Kilit();
+        memset(&sayac, 0, sizeof(sayac));
+        Servo_Birak();
+        UART_SendString("Servo sayaclari sifirlandi\r\n");
+        UART_Reply(UART_ST_OK, NULL);
+        UART_SendComplete("servo");
+        return;
+    }
+    if (*arg != '\0') {
+        UART_SendError(UART_ST_ARG, "Hata: servo[:reset]\r\n");
+        UART_SendComplete("servo");
+        return;
+    }
+    
+    // 64-bit toplam kesmeyle yarışmasın
+    Servo_Kilit();
+    s = sayac;
+    Servo_Birak();
+    avg = s.ticks ? (uint32_t)(s.total / s.ticks) : 0;
+    
+    // "<hz> <tick> <ort cycle> <max cycle> <son cycle> <overrun> <aktif eksen> <pid döngü>
+    //  <yakalanan eksen>"
+    sprintf(buf, "%u %lu %lu %lu %lu %lu %u %u %u", SERVO_HZ, (unsigned long)s.ticks,
+            (unsigned long)avg, (unsigned long)s.max, (unsigned long)s.last,
+            (unsigned long)s.overrun, Hareket_Aktif(), PID_Aktif(), Konum_Aktif());
+    UART_Reply(UART_ST_OK, buf);
+    
+    sprintf(buf, "Servo: %u Hz, %lu tick, %u eksen aktif, %u PID dongusu, %u yakalanan\r\n",
+            SERVO_HZ, (unsigned long)s.ticks, Hareket_Aktif(), PID_Aktif(), Konum_Aktif());
+    UART_SendString(buf);
+    sprintf(buf, "  Tick suresi: ort %lu, max %lu, son %lu cycle (%lu.%02lu%% yuk)\r\n",
+            (unsigned long)avg, (unsigned long)s.max, (unsigned long)s.last,
+            (unsigned long)(avg * 100 / CYCLES_PER_TICK),
+            (unsigned long)(avg * 10000 / CYCLES_PER_TICK % 100));
+    UART_SendString(buf);
+    sprintf(buf, "  Overrun: %lu\r\n", (unsigned long)s.overrun);
+    UART_SendString(buf);
+    UART_SendComplete("servo");
+}
@@ -0,0 +1,41 @@
+/**
+ * Burjuva Motor Controller - Servo Tick
+ *
+ * TIM2 update kesmesi SERVO_HZ periyotla sabit aralıklı kontrol işlerini
+ * (hareket profili) çalıştırır. Tick süresi DWT ile ölçülür; "servo"
+ * komutu ile okunur, "servo:reset" ile sıfırlanır.
+ *
+ * Kesmenin kullandığı eksen durumunu ana döngüden değiştiren kod
+ * Servo_Kilit / Servo_Birak arasında çalışır (kısa tutulmalı: kilit bir
+ * tick periyodunu aşarsa tick'ler birleşir).
+ */
+
+#ifndef SERVO_H
+#define SERVO_H
+
+#include <stdint.h>
+
+#define SERVO_HZ            1000
+
+/**
+ * TIM2'yi SERVO_HZ update kesmesiyle başlat (Istatistik_Init'ten sonra)
+ */
+void Servo_Init(void);
+
+/**
+ * Bir servo periyodu - TIM2 kesmesinden (host'ta simülatör döngüsünden)
+ */
+void Servo_Tick(void);
+
+/**
+ * Servo kesmesini maskele / aç (iç içe çağrılabilir)
+ */
+void Servo_Kilit(void);
+void Servo_Birak(void);
+
+/**
+ * Process "servo[:reset]" command
+ */
+void Servo_Komut_Isle(const char* arg);
+
+#endif // SERVO_H
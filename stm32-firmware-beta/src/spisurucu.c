@@ -8,6 +8,7 @@
 #include "stm32f10x_gpio.h"
 #include "stm32f10x_rcc.h"
 #include "stm32f10x_spi.h"
+#include "istatistik.h"
 
 // Chip Select pin tanımları
 typedef struct {
@@ -218,6 +219,7 @@ int SPI_SetCS(spi_slot_t slot, chip_select_t cs) {
             delay_us(100);
             
             current_cs_slot = slot;
+            Istatistik_SpiIslem(slot);
             return 0;
         }
         else if (current_cs_slot == slot) {
@@ -263,6 +265,7 @@ void SPI_Send(spi_slot_t slot, uint8_t data) {
     
     // Veriyi gönder
     SPI_I2S_SendData(SPI2, data);
+    Istatistik_SpiByte(slot);
 }
 
 /**
@@ -287,6 +290,7 @@ uint8_t SPI_DataExchange(spi_slot_t slot, uint8_t mosi) {
     
     // Alınan veriyi oku
     uint8_t miso = (uint8_t)SPI_I2S_ReceiveData(SPI2);
+    Istatistik_SpiByte(slot);
     
     // CRITICAL: Inter-byte delay for IO678 chip processing time
     delay_us(20);
@@ -312,3 +316,35 @@ int SPI_Transfer(spi_slot_t slot, const uint8_t* tx_data, uint8_t* rx_data, uint
     
     return 0;
 }
+
+/**
+ * Tek yönlü blok gönderimi
+ * TXE beklenerek DR sürekli dolu tutulur; alınan byte'lar okunmaz, sonda
+ * OVR/RXNE temizlenir
+ */
+int SPI_BlokGonder(spi_slot_t slot, const uint8_t* tx_data, uint32_t length) {
+    uint32_t timeout;
+    
+    if (slot < 0 || slot > 4 || !tx_data || length == 0) {
+        return -1;
+    }
+    
+    for (uint32_t i = 0; i < length; i++) {
+        timeout = 100000;
+        while (SPI_I2S_GetFlagStatus(SPI2, SPI_I2S_FLAG_TXE) == RESET && timeout--);
+        if (timeout == 0) return -1;
+        
+        SPI_I2S_SendData(SPI2, tx_data[i]);
+        Istatistik_SpiByte(slot);
+    }
+    
+    // Son byte hattan çıkana kadar bekle (CS ondan sonra kalkabilir)
+    timeout = 100000;
+    while (SPI_I2S_GetFlagStatus(SPI2, SPI_I2S_FLAG_BSY) == SET && timeout--);
+    
+    // OVR temizleme sırası: DR, sonra SR oku
+    (void)SPI_I2S_ReceiveData(SPI2);
+    (void)SPI2->SR;
+    
+    return 0;
+}
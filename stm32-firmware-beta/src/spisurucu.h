@@ -71,4 +71,14 @@ uint8_t SPI_DataExchange(spi_slot_t slot, uint8_t mosi);
  */
 int SPI_Transfer(spi_slot_t slot, const uint8_t* tx_data, uint8_t* rx_data, uint16_t length);
 
+/**
+ * Tek yönlü blok gönderimi (bayt arası bekleme yok, MISO atılır)
+ * FPGA bitstream yüklemesi için; CS çağıran tarafından yönetilir
+ * @param slot: Slot numarası
+ * @param tx_data: Gönderilecek veri
+ * @param length: Byte sayısı
+ * @return 0: başarılı, -1: hata
+ */
+int SPI_BlokGonder(spi_slot_t slot, const uint8_t* tx_data, uint32_t length);
+
 #endif // SPISURUCU_H
@@ -0,0 +1,31 @@
+/**
+ * Burjuva Motor Controller - SysTick Zaman Tabanı
+ */
+
+#include "stm32f10x.h"
+#include "tick.h"
+
+#define HCLK_HZ             72000000UL   // HSE 8MHz x PLL 9
+
+static volatile uint32_t tick_ms = 0;
+
+void SysTick_Handler(void) {
+    tick_ms++;
+}
+
+void Tick_Init(void) {
+    SysTick_Config(HCLK_HZ / TICK_HZ);
+}
+
+uint32_t Tick_Ms(void) {
+    return tick_ms;  // 32-bit okuma Cortex-M3'te atomik
+}
+
+uint8_t Tick_Elapsed(uint32_t* last, uint32_t period_ms) {
+    uint32_t now = tick_ms;
+    if ((now - *last) < period_ms) {
+        return 0;
+    }
+    *last = now;
+    return 1;
+}
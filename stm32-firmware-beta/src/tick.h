@@ -0,0 +1,31 @@
+/**
+ * Burjuva Motor Controller - SysTick Zaman Tabanı
+ * 
+ * 1 ms SysTick kesmesi ile serbest çalışan milisaniye sayacı.
+ * Periyodik arka plan işleri (modül izleme vb.) ana döngüden
+ * Tick_Elapsed ile zamanlanır.
+ */
+
+#ifndef TICK_H
+#define TICK_H
+
+#include <stdint.h>
+
+#define TICK_HZ             1000
+
+/**
+ * SysTick'i 1 ms periyotla başlat (72MHz HCLK)
+ */
+void Tick_Init(void);
+
+/**
+ * Açılıştan beri geçen milisaniye (49 günde taşar, farklar taşmaya dayanıklı)
+ */
+uint32_t Tick_Ms(void);
+
+/**
+ * *last'tan beri period_ms geçtiyse *last'ı güncelle ve 1 döndür
+ */
+uint8_t Tick_Elapsed(uint32_t* last, uint32_t period_ms);
+
+#endif // TICK_H
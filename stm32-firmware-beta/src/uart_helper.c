@@ -6,16 +6,58 @@
 #include "stm32f10x.h"
 #include "stm32f10x_usart.h"
 
+// Batch yanıt tamponu (machine mode): 256 byte'lık satırda en fazla 128
+// komut, her biri için ayrılan ";5" kaydı tampona her zaman sığar
+#define UART_REPLY_BUFFER_SIZE  384
+
+static uint8_t uart_mode = UART_MODE_HUMAN;
+
+// UART_QuietBegin/End derinliği (>0: açıklamalı çıktı kapalı)
+static uint8_t uart_quiet_depth = 0;
+
+// Batch aktif mi? (komut.c Process_Command tarafından yönetilir)
+static uint8_t uart_batch_active = 0;
+
+// Bu komut için yanıt verildi mi? (human mode'da da durum kaydedilir)
+static uint8_t uart_replied = 0;
+static uint8_t uart_status = UART_ST_OK;
+
+static char uart_reply_buf[UART_REPLY_BUFFER_SIZE];
+static uint16_t uart_reply_len = 0;
+static uint8_t uart_reply_count = 0;
+static uint8_t uart_reply_expected = 0;     // Batch'teki yanıt sayısı
+
 /**
- * UART üzerinden string gönder
+ * UART üzerinden string gönder (mod kontrolü yok)
  */
-void UART_SendString(const char* str) {
+void UART_SendRaw(const char* str) {
     while (*str) {
         while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
         USART_SendData(USART1, *str++);
     }
 }
 
+/**
+ * Binary veri gönder (0x00 içerebilir, moddan bağımsız)
+ */
+void UART_SendBytes(const uint8_t* data, uint16_t len) {
+    for (uint16_t i = 0; i < len; i++) {
+        while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET);
+        USART_SendData(USART1, data[i]);
+    }
+}
+
+/**
+ * UART üzerinden string gönder
+ * Machine mode'da açıklamalı çıktı gönderilmez
+ */
+void UART_SendString(const char* str) {
+    if (uart_mode == UART_MODE_MACHINE || uart_quiet_depth > 0) {
+        return;
+    }
+    UART_SendRaw(str);
+}
+
 /**
  * UART üzerinden 8-bit hex gönder
  */
@@ -37,3 +79,168 @@ void UART_SendHex16(uint16_t data) {
     UART_SendHex8((data >> 8) & 0xFF);
     UART_SendHex8(data & 0xFF);
 }
+
+/**
+ * Çalışma modunu ayarla / oku
+ */
+void UART_SetMode(uint8_t mode) {
+    uart_mode = (mode == UART_MODE_MACHINE) ? UART_MODE_MACHINE : UART_MODE_HUMAN;
+}
+
+uint8_t UART_GetMode(void) {
+    return uart_mode;
+}
+
+/**
+ * Sessiz bölge başlat / bitir
+ */
+void UART_QuietBegin(void) {
+    if (uart_quiet_depth < 255) {
+        uart_quiet_depth++;
+    }
+}
+
+void UART_QuietEnd(void) {
+    if (uart_quiet_depth > 0) {
+        uart_quiet_depth--;
+    }
+}
+
+/**
+ * Komut tamamlandı satırı gönder
+ * Batch içinde her komut kendi satırını basmaz, batch tek satırla biter
+ */
+void UART_SendComplete(const char* module) {
+    if (uart_batch_active) {
+        return;
+    }
+    UART_SendString("\r\nKomut tamamlandi: ");
+    UART_SendString(module);
+    UART_SendString("\r\n");
+}
+
+/**
+ * Yeni komut başlıyor - yanıt bayrağını temizle
+ */
+void UART_ReplyBegin(void) {
+    uart_replied = 0;
+    uart_status = UART_ST_OK;
+}
+
+uint8_t UART_Replied(void) {
+    return uart_replied;
+}
+
+uint8_t UART_ReplyStatus(void) {
+    return uart_status;
+}
+
+/**
+ * Machine mode kısa yanıtı
+ * Tek komut: "=<kod>[ <payload>]\r\n"
+ * Batch:     her komut "<kod>[ <payload>]" olarak tampona eklenir,
+ *            UART_BatchEnd() tek satır "=" + ';' ile birleşik liste gönderir
+ */
+void UART_Reply(uint8_t status, const char* payload) {
+    if (uart_replied) {
+        return;
+    }
+    uart_replied = 1;
+    uart_status = status;
+    if (uart_mode != UART_MODE_MACHINE) {
+        return;
+    }
+    
+    if (!uart_batch_active) {
+        char code[3] = { '=', (char)('0' + status), '\0' };
+        UART_SendRaw(code);
+        if (payload && *payload) {
+            UART_SendRaw(" ");
+            UART_SendRaw(payload);
+        }
+        UART_SendRaw("\r\n");
+        return;
+    }
+    
+    // Ayırıcı + kod + boşluk + payload + sonlandırıcı sığmalı; sonraki
+    // yanıtların her biri için ";5" yeri ayrılmış kalır (kayıt sırası
+    // komut sırasıyla aynı kalır)
+    uint16_t need = 2;
+    uint16_t reserved = 0;
+    const char* p = payload;
+    if (p) {
+        while (*p++) {
+            need++;
+        }
+        need++;
+    }
+    if (uart_reply_expected > uart_reply_count + 1) {
+        reserved = 2 * (uint16_t)(uart_reply_expected - uart_reply_count - 1);
+    }
+    if (uart_reply_len + need + reserved + 1 > UART_REPLY_BUFFER_SIZE) {
+        // Payload sığmıyor - sadece taşma kodu
+        status = UART_ST_OVERFLOW;
+        payload = 0;
+        if (uart_reply_len + 3 > UART_REPLY_BUFFER_SIZE) {
+            return;                     // expected eksik bildirildiyse
+        }
+    }
+    
+    if (uart_reply_count > 0) {
+        uart_reply_buf[uart_reply_len++] = ';';
+    }
+    uart_reply_buf[uart_reply_len++] = '0' + status;
+    if (payload && *payload) {
+        uart_reply_buf[uart_reply_len++] = ' ';
+        while (*payload) {
+            uart_reply_buf[uart_reply_len++] = *payload++;
+        }
+    }
+    uart_reply_buf[uart_reply_len] = '\0';
+    uart_reply_count++;
+}
+
+/**
+ * Hata satırı gönder (human) / durum kodu döndür (machine)
+ */
+void UART_SendError(uint8_t status, const char* message) {
+    UART_SendString(message);
+    UART_Reply(status, 0);
+}
+
+/**
+ * Asenkron olay gönder ("!slot:2:io16" gibi)
+ */
+void UART_SendEvent(const char* event, const char* message) {
+    if (uart_mode == UART_MODE_MACHINE) {
+        UART_SendRaw("!");
+        UART_SendRaw(event);
+        UART_SendRaw("\r\n");
+        return;
+    }
+    UART_SendString(message);
+}
+
+/**
+ * Batch başlat / bitir
+ */
+void UART_BatchBegin(uint8_t replies) {
+    uart_batch_active = 1;
+    uart_reply_len = 0;
+    uart_reply_count = 0;
+    uart_reply_expected = replies;
+    uart_reply_buf[0] = '\0';
+}
+
+void UART_BatchEnd(void) {
+    uart_batch_active = 0;
+    if (uart_mode == UART_MODE_MACHINE) {
+        UART_SendRaw("=");
+        UART_SendRaw(uart_reply_buf);
+        UART_SendRaw("\r\n");
+    }
+}
+
+uint8_t UART_InBatch(void) {
+    return uart_batch_active;
+}
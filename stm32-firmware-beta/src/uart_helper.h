@@ -8,9 +8,61 @@
 
 #include <stdint.h>
 
+// Çalışma modları
+#define UART_MODE_HUMAN     0   // Echo, ACK, açıklamalı çıktı (terminal)
+#define UART_MODE_MACHINE   1   // Echo yok, tek satır kısa yanıt (host yazılımı)
+
+// Machine mode durum kodları ("=<kod> <değerler>")
+#define UART_ST_OK          0   // Başarılı
+#define UART_ST_SYNTAX      1   // Bilinmeyen komut / format hatası
+#define UART_ST_ARG         2   // Geçersiz parametre (slot, pin, port...)
+#define UART_ST_NOMODULE    3   // Slotta kayıtlı modül yok
+#define UART_ST_HW          4   // SPI / donanım hatası
+#define UART_ST_OVERFLOW    5   // Yanıt batch tamponuna sığmadı
+
 // UART send functions
+// UART_SendString ve hex fonksiyonları machine mode'da sessizdir
 void UART_SendString(const char* str);
 void UART_SendHex8(uint8_t data);
 void UART_SendHex16(uint16_t data);
+void UART_SendRaw(const char* str);     // Moddan bağımsız gönderim
+void UART_SendBytes(const uint8_t* data, uint16_t len);  // Binary çerçeve (moddan bağımsız)
+
+// Mod seçimi
+void UART_SetMode(uint8_t mode);
+uint8_t UART_GetMode(void);
+
+// Sessiz bölge (iç içe kullanılabilir): açıklamalı çıktıyı geçici olarak kapatır
+// Örn. açılışta modül init'i sırasında SPI debug satırlarını bastırmak için
+void UART_QuietBegin(void);
+void UART_QuietEnd(void);
+
+// Komut tamamlandı satırı ("Komut tamamlandi: <modul>")
+// Batch içindeyken ve machine mode'da bastırılır
+void UART_SendComplete(const char* module);
+
+// Machine mode kısa yanıtı: komut başına ilk çağrı geçerlidir
+// Human mode'da hiçbir şey göndermez (açıklamalı çıktı zaten basılmıştır)
+void UART_ReplyBegin(void);
+void UART_Reply(uint8_t status, const char* payload);
+uint8_t UART_Replied(void);
+
+// Komutun ilk UART_Reply / UART_SendError durumu (her iki modda, batch sayımı)
+uint8_t UART_ReplyStatus(void);
+
+// "Hata: ..." satırı + machine mode durum kodu
+void UART_SendError(uint8_t status, const char* message);
+
+// Asenkron olay (komut yanıtı değil): human mode'da message,
+// machine mode'da "!<event>" satırı. Yanıt satırlarıyla karışmaz ('=' değil '!')
+void UART_SendEvent(const char* event, const char* message);
+
+// Batch (';' ile ayrılmış çoklu komut) durumu
+// Machine mode'da batch yanıtları ';' ile birleştirilip tek satırda gönderilir.
+// replies: batch'te beklenen en fazla yanıt sayısı; tampon dolsa da her biri
+// için en az taşma kodu (5) yazılır, kayıtlar komut sırasından kaymaz
+void UART_BatchBegin(uint8_t replies);
+void UART_BatchEnd(void);
+uint8_t UART_InBatch(void);
 
 #endif // UART_HELPER_H
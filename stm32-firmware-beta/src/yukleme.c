@@ -0,0 +1,281 @@
+/**
+ * Burjuva Motor Controller - FPGA Bitstream Yükleme
+ *
+ * iCE40 SPI slave yapılandırma sırası (TN1248): CS LOW, CRESET >= 200 ns
+ * LOW, CRESET HIGH, >= 1200 µs bellek temizleme, bitstream (MSB önce),
+ * CDONE HIGH olana kadar ve ardından >= 49 boş saat.
+ *
+ * CPLD (build--CPLD/fpga.v) SCK ve MOSI'yi yalnızca CS LOW iken FPGA'ya
+ * geçirir: TN1248'deki CS HIGH iken 8 boş saat FPGA'ya ulaşamaz, bu
+ * yüzden atlanır; sondaki boş saatler CS LOW tutularak gönderilir.
+ *
+ * Bitstream SPI_BlokGonder ile bayt arası beklemesiz gider (SPI_Transfer
+ * her bayttan sonra iC-JX için 20 µs bekler). Flash imajı doğrudan
+ * bellekten okunur, RAM'e kopyalanmaz.
+ */
+
+#include "stm32f10x.h"
+#include "stm32f10x_gpio.h"
+#include "stm32f10x_rcc.h"
+#include "stm32f10x_flash.h"
+#include "yukleme.h"
+#include "spisurucu.h"
+#include "istatistik.h"
+#include <string.h>
+
+// Flash okuma işaretçisi (simülatör flash'ı bellekte tutar)
+#ifndef FLASH_ISARET
+#define FLASH_ISARET(adres)     ((const uint8_t*)(adres))
+#endif
+
+#define CRESET_PIN          GPIO_Pin_1      // PB1
+#define CDONE_PIN           GPIO_Pin_10     // PB10
+#define SAYFA_BOYU          2048            // STM32F103RC (yüksek yoğunluk)
+#define IMAJ_ISARETI        ((uint32_t)0x54494246)  // "FBIT"
+#define CRESET_LOW_US       1               // >= 200 ns
+#define TEMIZLEME_US        1200            // HX1K 800 µs, büyük aile 1200 µs
+#define CDONE_BEKLEME_BYTE  64              // Bitstream sonrası CDONE için
+#define SON_SAAT_BYTE       7               // >= 49 saat: kullanıcı IO'ları açılır
+
+typedef struct {
+    uint32_t isaret;                        // IMAJ_ISARETI, en son yazılır
+    uint32_t boyut;
+    uint32_t crc;
+    uint32_t ters_isaret;                   // ~IMAJ_ISARETI
+} Imaj_Basligi;
+
+static struct {
+    uint8_t aktif;                          // Yükleme sürüyor
+    uint32_t boyut;
+    uint32_t crc;
+    uint32_t yazilan;
+    uint16_t silinen_sayfa;
+} yukleme;
+
+static uint8_t son_sonuc = YUKLEME_OK;
+static uint32_t son_sure_us = 0;
+static uint32_t yapilandirma = 0;
+
+static const Imaj_Basligi* baslik(void) {
+    return (const Imaj_Basligi*)FLASH_ISARET(YUKLEME_IMAJ_ADRES);
+}
+
+static const uint8_t* imaj_verisi(void) {
+    return FLASH_ISARET(YUKLEME_IMAJ_ADRES + YUKLEME_BASLIK_BOYU);
+}
+
+static uint8_t imaj_gecerli(void) {
+    const Imaj_Basligi* b = baslik();
+    return b->isaret == IMAJ_ISARETI && b->ters_isaret == ~IMAJ_ISARETI &&
+           b->boyut > 0 && b->boyut <= YUKLEME_BOYUT_MAX;
+}
+
+static uint8_t cdone(void) {
+    return GPIO_ReadInputDataBit(GPIOB, CDONE_PIN);
+}
+
+static void bekle_us(uint32_t us) {
+    uint32_t t0 = Istatistik_Cycle();
+    while (Istatistik_Cycle() - t0 < us * 72);
+}
+
+uint32_t Yukleme_Crc32(uint32_t crc, const uint8_t* veri, uint32_t uzunluk) {
+    // Yarım bayt tablosu: 64 byte flash, bayt başına iki adım
+    static const uint32_t tablo[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+        0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+        0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    
+    crc = ~crc;
+    for (uint32_t i = 0; i < uzunluk; i++) {
+        crc = (crc >> 4) ^ tablo[(crc ^ veri[i]) & 0x0F];
+        crc = (crc >> 4) ^ tablo[(crc ^ (veri[i] >> 4)) & 0x0F];
+    }
+    return ~crc;
+}
+
+void Yukleme_Init(void) {
+    GPIO_InitTypeDef gpio;
+    
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE);
+    
+    // CRESET HIGH başlar: FPGA kendi yapılandırmasını korur
+    GPIO_SetBits(GPIOB, CRESET_PIN);
+    gpio.GPIO_Pin = CRESET_PIN;
+    gpio.GPIO_Speed = GPIO_Speed_2MHz;
+    gpio.GPIO_Mode = GPIO_Mode_Out_PP;
+    GPIO_Init(GPIOB, &gpio);
+    
+    // CDONE açık-drain, FPGA tarafında pull-up
+    gpio.GPIO_Pin = CDONE_PIN;
+    gpio.GPIO_Mode = GPIO_Mode_IPU;
+    GPIO_Init(GPIOB, &gpio);
+    
+    if (!cdone() && imaj_gecerli()) {
+        Yukleme_Yapilandir();
+    }
+}
+
+Yukleme_Sonuc Yukleme_Yapilandir(void) {
+    static const uint8_t bos[SON_SAAT_BYTE] = { 0 };
+    const Imaj_Basligi* b = baslik();
+    uint32_t t0;
+    uint8_t i;
+    
+    if (yukleme.aktif || !imaj_gecerli() ||
+        Yukleme_Crc32(0, imaj_verisi(), b->boyut) != b->crc) {
+        son_sonuc = YUKLEME_HATA_IMAJ;
+        return YUKLEME_HATA_IMAJ;
+    }
+    if (SPI_SetCS((spi_slot_t)YUKLEME_SLOT, CS_ENABLE) != 0) {
+        son_sonuc = YUKLEME_HATA_SIRA;      // SPI hattı başka slotta
+        return YUKLEME_HATA_SIRA;
+    }
+    
+    t0 = Istatistik_Cycle();
+    
+    // CS LOW iken CRESET yükselirse FPGA SPI slave moduna girer
+    GPIO_ResetBits(GPIOB, CRESET_PIN);
+    bekle_us(CRESET_LOW_US);
+    GPIO_SetBits(GPIOB, CRESET_PIN);
+    bekle_us(TEMIZLEME_US);
+    
+    SPI_BlokGonder((spi_slot_t)YUKLEME_SLOT, imaj_verisi(), b->boyut);
+    
+    for (i = 0; i < CDONE_BEKLEME_BYTE && !cdone(); i++) {
+        SPI_BlokGonder((spi_slot_t)YUKLEME_SLOT, bos, 1);
+    }
+    son_sure_us = (Istatistik_Cycle() - t0) / 72;
+    if (cdone()) {
+        SPI_BlokGonder((spi_slot_t)YUKLEME_SLOT, bos, SON_SAAT_BYTE);
+    }
+    SPI_SetCS((spi_slot_t)YUKLEME_SLOT, CS_DISABLE);
+    
+    if (!cdone()) {
+        son_sonuc = YUKLEME_HATA_CDONE;
+        return YUKLEME_HATA_CDONE;
+    }
+    yapilandirma++;
+    son_sonuc = YUKLEME_OK;
+    return YUKLEME_OK;
+}
+
+// ============================================================================
+// Host yüklemesi
+// ============================================================================
+
+static Yukleme_Sonuc sayfa_sil(uint16_t sayfa) {
+    if (FLASH_ErasePage(YUKLEME_IMAJ_ADRES + (uint32_t)sayfa * SAYFA_BOYU) != FLASH_COMPLETE) {
+        return YUKLEME_HATA_FLASH;
+    }
+    return YUKLEME_OK;
+}
+
+Yukleme_Sonuc Yukleme_Baslat(uint32_t boyut, uint32_t crc) {
+    Yukleme_Sonuc sonuc;
+    
+    if (boyut == 0 || boyut > YUKLEME_BOYUT_MAX) {
+        return YUKLEME_HATA_SIRA;
+    }
+    
+    // Başlık sayfası silinir: eski imaj bu andan itibaren geçersiz
+    memset(&yukleme, 0, sizeof(yukleme));
+    FLASH_Unlock();
+    sonuc = sayfa_sil(0);
+    FLASH_Lock();
+    if (sonuc != YUKLEME_OK) {
+        return sonuc;
+    }
+    
+    yukleme.aktif = 1;
+    yukleme.boyut = boyut;
+    yukleme.crc = crc;
+    yukleme.silinen_sayfa = 1;
+    return YUKLEME_OK;
+}
+
+Yukleme_Sonuc Yukleme_Parca(uint32_t ofset, const uint8_t* veri, uint16_t uzunluk) {
+    uint32_t adres;
+    uint32_t son;
+    Yukleme_Sonuc sonuc = YUKLEME_OK;
+    
+    // Sıralı, yarım kelimeye hizalı parçalar; yalnızca son parça tek olabilir
+    if (!yukleme.aktif || ofset != yukleme.yazilan || uzunluk == 0 ||
+        uzunluk > YUKLEME_PARCA_MAX || ofset + uzunluk > yukleme.boyut ||
+        ((uzunluk & 1) && ofset + uzunluk != yukleme.boyut)) {
+        return YUKLEME_HATA_SIRA;
+    }
+    
+    adres = YUKLEME_IMAJ_ADRES + YUKLEME_BASLIK_BOYU + ofset;
+    son = adres + uzunluk - 1;
+    
+    FLASH_Unlock();
+    while (sonuc == YUKLEME_OK &&
+           YUKLEME_IMAJ_ADRES + (uint32_t)yukleme.silinen_sayfa * SAYFA_BOYU <= son) {
+        sonuc = sayfa_sil(yukleme.silinen_sayfa++);
+    }
+    for (uint16_t i = 0; sonuc == YUKLEME_OK && i < uzunluk; i += 2) {
+        uint16_t yarim = veri[i] | ((i + 1 < uzunluk) ? (veri[i + 1] << 8) : 0xFF00);
+        if (FLASH_ProgramHalfWord(adres + i, yarim) != FLASH_COMPLETE) {
+            sonuc = YUKLEME_HATA_FLASH;
+        }
+    }
+    FLASH_Lock();
+    
+    if (sonuc != YUKLEME_OK) {
+        yukleme.aktif = 0;
+        return sonuc;
+    }
+    yukleme.yazilan += uzunluk;
+    return YUKLEME_OK;
+}
+
+Yukleme_Sonuc Yukleme_Bitir(void) {
+    uint32_t adres = YUKLEME_IMAJ_ADRES;
+    uint32_t kelime[3];
+    Yukleme_Sonuc sonuc = YUKLEME_OK;
+    
+    if (!yukleme.aktif || yukleme.yazilan != yukleme.boyut) {
+        return YUKLEME_HATA_SIRA;
+    }
+    yukleme.aktif = 0;
+    
+    // Flash'a yazılanı doğrula (host CRC'si ile)
+    if (Yukleme_Crc32(0, imaj_verisi(), yukleme.boyut) != yukleme.crc) {
+        return YUKLEME_HATA_IMAJ;
+    }
+    
+    kelime[0] = yukleme.boyut;
+    kelime[1] = yukleme.crc;
+    kelime[2] = ~IMAJ_ISARETI;
+    
+    FLASH_Unlock();
+    for (uint8_t i = 0; sonuc == YUKLEME_OK && i < 3; i++) {
+        if (FLASH_ProgramWord(adres + 4 + i * 4, kelime[i]) != FLASH_COMPLETE) {
+            sonuc = YUKLEME_HATA_FLASH;
+        }
+    }
+    if (sonuc == YUKLEME_OK && FLASH_ProgramWord(adres, IMAJ_ISARETI) != FLASH_COMPLETE) {
+        sonuc = YUKLEME_HATA_FLASH;
+    }
+    FLASH_Lock();
+    return sonuc;
+}
+
+void Yukleme_Oku(Yukleme_Bilgi* bilgi) {
+    const Imaj_Basligi* b = baslik();
+    
+    memset(bilgi, 0, sizeof(*bilgi));
+    bilgi->gecerli = imaj_gecerli();
+    if (bilgi->gecerli) {
+        bilgi->boyut = b->boyut;
+        bilgi->crc = b->crc;
+    }
+    bilgi->cdone = cdone();
+    bilgi->son_sonuc = son_sonuc;
+    bilgi->son_sure_us = son_sure_us;
+    bilgi->yapilandirma = yapilandirma;
+    bilgi->yuklenen = yukleme.aktif ? yukleme.yazilan : 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * Burjuva Motor Controller - FPGA Bitstream Yükleme
+ *
+ * Slot 2 iCE40'ı STM32 kendisi yapılandırır (SPI slave config modu):
+ * CS (PA1) LOW iken CRESET (PB1) darbesi, bellek temizleme beklemesi,
+ * bitstream ve ardından en az 49 boş saat; CDONE (PB10) HIGH olunca FPGA
+ * çalışır. Bitstream dahili flash'ın son 64 KB'ında tutulur; açılışta
+ * geçerli imaj varsa ve CDONE LOW ise FPGA otomatik yapılandırılır.
+ *
+ * İmaj host bağlantısı üzerinden parça parça yazılır (hex), CRC32 (zlib)
+ * doğrulanınca başlık en son yazılır: yarım kalan yükleme geçersiz imaj
+ * bırakır, eski imaj kullanılmaz.
+ *
+ * Komutlar (fpga.c):
+ *   fpga:2:bit:begin:SIZE:CRC32       Yüklemeyi başlat (imajı siler)
+ *   fpga:2:bit:data:OFFSET:HEX        Sıradaki parça (en fazla 96 byte)
+ *   fpga:2:bit:end                    CRC doğrula, başlığı yaz
+ *   fpga:2:bit                        İmaj ve son yapılandırma bilgisi
+ *   fpga:2:config                     FPGA'yı flash imajından yapılandır
+ */
+
+#ifndef YUKLEME_H
+#define YUKLEME_H
+
+#include <stdint.h>
+
+#define YUKLEME_SLOT            2               // CRESET/CDONE bağlı FPGA slotu
+#define YUKLEME_IMAJ_ADRES      0x08030000UL    // Linker script FLASH 192K
+#define YUKLEME_IMAJ_ALANI      0x10000UL       // 64 KB
+#define YUKLEME_BASLIK_BOYU     16
+#define YUKLEME_BOYUT_MAX       (YUKLEME_IMAJ_ALANI - YUKLEME_BASLIK_BOYU)
+#define YUKLEME_PARCA_MAX       96              // bit:data parçası (komut satırı 256)
+
+typedef enum {
+    YUKLEME_OK = 0,
+    YUKLEME_HATA_IMAJ,          // Geçerli imaj yok / CRC tutmuyor
+    YUKLEME_HATA_CDONE,         // Bitstream gitti, CDONE yükselmedi
+    YUKLEME_HATA_FLASH,         // Silme / yazma hatası
+    YUKLEME_HATA_SIRA           // Yükleme yok / parça sırası / boyut / SPI hattı meşgul
+} Yukleme_Sonuc;
+
+typedef struct {
+    uint8_t gecerli;            // Flash'ta CRC'si doğrulanmış imaj
+    uint32_t boyut;             // byte
+    uint32_t crc;
+    uint8_t cdone;              // CDONE pini
+    uint8_t son_sonuc;          // Yukleme_Sonuc (son yapılandırma)
+    uint32_t son_sure_us;       // CRESET'ten CDONE'a
+    uint32_t yapilandirma;      // Açılıştan beri başarılı yapılandırma
+    uint32_t yuklenen;          // Süren yüklemede yazılan byte (0: yükleme yok)
+} Yukleme_Bilgi;
+
+/**
+ * CRESET/CDONE pinleri; geçerli imaj varsa ve FPGA yapılandırılmamışsa
+ * yapılandır (SPI_Module_Init ve Istatistik_Init'ten sonra)
+ */
+void Yukleme_Init(void);
+
+/**
+ * Flash imajından yapılandır (imaj CRC'si önce doğrulanır). Bloklar:
+ * HX1K bitstream'i 2.25 MHz SPI'da ~120 ms
+ */
+Yukleme_Sonuc Yukleme_Yapilandir(void);
+
+/**
+ * Host yüklemesi: başlat / sıradaki parça / bitir
+ */
+Yukleme_Sonuc Yukleme_Baslat(uint32_t boyut, uint32_t crc);
+Yukleme_Sonuc Yukleme_Parca(uint32_t ofset, const uint8_t* veri, uint16_t uzunluk);
+Yukleme_Sonuc Yukleme_Bitir(void);
+
+void Yukleme_Oku(Yukleme_Bilgi* bilgi);
+
+/**
+ * CRC32 (zlib / IEEE 802.3), crc = 0 ile başlanır
+ */
+uint32_t Yukleme_Crc32(uint32_t crc, const uint8_t* veri, uint32_t uzunluk);
+
+#endif // YUKLEME_H